@@ -235,6 +235,9 @@ namespace Plugin {
                 newElement = snapshot.Slot[teller];
                 data.ThreadPoolRuns.Add(newElement);
             }
+
+            _pluginServer->Pools(data);
+            _pluginServer->Input(data);
 		}
         void SubSystems();
         void SubSystems(Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>>::ConstIterator& index);
@@ -257,6 +260,9 @@ namespace Plugin {
         uint32_t get_links(Core::JSON::ArrayType<PluginHost::MetaData::Channel>& response) const;
         uint32_t get_processinfo(PluginHost::MetaData::Server& response) const;
         uint32_t get_subsystems(Core::JSON::ArrayType<JsonData::Controller::SubsystemsParamsData>& response) const;
+        uint32_t get_startup(Core::JSON::ArrayType<JsonData::Controller::StartupData>& response) const;
+        uint32_t get_containers(Core::JSON::ArrayType<JsonData::Controller::ContainerData>& response) const;
+        uint32_t get_telemetry(const string& index, JsonData::Controller::TelemetryData& response) const;
         uint32_t get_discoveryresults(Core::JSON::ArrayType<PluginHost::MetaData::Bridge>& response) const;
         uint32_t get_environment(const string& index, Core::JSON::String& response) const;
         uint32_t get_configuration(const string& index, Core::JSON::String& response) const;
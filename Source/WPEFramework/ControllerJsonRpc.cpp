@@ -25,6 +25,9 @@ namespace Plugin {
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Channel>>(_T("links"), &Controller::get_links, nullptr, this);
         Property<PluginHost::MetaData::Server>(_T("processinfo"), &Controller::get_processinfo, nullptr, this);
         Property<Core::JSON::ArrayType<SubsystemsParamsData>>(_T("subsystems"), &Controller::get_subsystems, nullptr, this);
+        Property<Core::JSON::ArrayType<StartupData>>(_T("startup"), &Controller::get_startup, nullptr, this);
+        Property<Core::JSON::ArrayType<ContainerData>>(_T("containers"), &Controller::get_containers, nullptr, this);
+        Property<TelemetryData>(_T("telemetry"), &Controller::get_telemetry, nullptr, this);
         Property<Core::JSON::ArrayType<PluginHost::MetaData::Bridge>>(_T("discoveryresults"), &Controller::get_discoveryresults, nullptr, this);
         Property<Core::JSON::String>(_T("environment"), &Controller::get_environment, nullptr, this);
         Property<Core::JSON::String>(_T("configuration"), &Controller::get_configuration, &Controller::set_configuration, this);
@@ -41,6 +44,9 @@ namespace Plugin {
         Unregister(_T("configuration"));
         Unregister(_T("environment"));
         Unregister(_T("discoveryresults"));
+        Unregister(_T("telemetry"));
+        Unregister(_T("containers"));
+        Unregister(_T("startup"));
         Unregister(_T("subsystems"));
         Unregister(_T("processinfo"));
         Unregister(_T("links"));
@@ -277,6 +283,126 @@ namespace Plugin {
         return Core::ERROR_NONE;
     }
 
+    // Property: startup - Activation timeline of the plugins started at boot
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t Controller::get_startup(Core::JSON::ArrayType<StartupData>& response) const
+    {
+        ASSERT(_pluginServer != nullptr);
+
+        PluginHost::Server::Activator::Timeline timeline;
+        const uint64_t startTime = _pluginServer->Startup().StartTime();
+
+        _pluginServer->Startup().Snapshot(timeline);
+
+        PluginHost::Server::Activator::Timeline::const_iterator index(timeline.begin());
+
+        while (index != timeline.end()) {
+            StartupData& entry(response.Add());
+            uint32_t blockedOn = index->second.BlockedOn;
+            uint8_t subsystem = 0;
+
+            entry.Callsign = index->first;
+            entry.State = static_cast<PluginHost::MetaData::Service::state>(index->second.State);
+
+            while (blockedOn != 0) {
+                if ((blockedOn & 0x01) != 0) {
+                    entry.Blockedon.Add() = static_cast<PluginHost::ISubSystem::subsystem>(subsystem);
+                }
+                blockedOn >>= 1;
+                subsystem++;
+            }
+
+            if (index->second.Start != 0) {
+                entry.Start = static_cast<uint32_t>((index->second.Start - startTime) / Core::Time::TicksPerMillisecond);
+            }
+            if (index->second.End != 0) {
+                entry.End = static_cast<uint32_t>((index->second.End - startTime) / Core::Time::TicksPerMillisecond);
+            }
+
+            index++;
+        }
+
+        return Core::ERROR_NONE;
+    }
+
+    // Property: containers - Resource usage of the plugins hosted in a container
+    // Return codes:
+    //  - ERROR_NONE: Success
+    uint32_t Controller::get_containers(Core::JSON::ArrayType<ContainerData>& response) const
+    {
+        ASSERT(_pluginServer != nullptr);
+
+#ifdef PROCESSCONTAINERS_ENABLED
+        std::list<RPC::ContainerUsage> usages;
+
+        _pluginServer->Services().Containers(usages);
+
+        std::list<RPC::ContainerUsage>::const_iterator index(usages.begin());
+
+        while (index != usages.end()) {
+            ContainerData& entry(response.Add());
+
+            entry.Callsign = index->Callsign;
+            entry.Pid = index->Pid;
+            entry.Cputime = index->Usage.CPUTime;
+            entry.Throttled = index->Usage.Throttled;
+            entry.Memory = index->Usage.Memory;
+            entry.Resident = index->Usage.Resident;
+            entry.Oomevents = index->Usage.OOMEvents;
+
+            index++;
+        }
+#endif
+
+        return Core::ERROR_NONE;
+    }
+
+    // Property: telemetry - Resource usage history of an out-of-process plugin
+    // Return codes:
+    //  - ERROR_NONE: Success
+    //  - ERROR_UNAVAILABLE: Sampling is disabled
+    //  - ERROR_UNKNOWN_KEY: The plugin was never hosted out-of-process
+    uint32_t Controller::get_telemetry(const string& index, TelemetryData& response) const
+    {
+        ASSERT(_pluginServer != nullptr);
+
+        PluginHost::Server::Sampler& sampler(_pluginServer->Telemetry());
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+        if (sampler.Interval() != 0) {
+            Core::JSON::ArrayType<SampleData>* const metrics[] = {
+                &response.Cputime, &response.Resident, &response.Proportional, &response.Shared, &response.Swap, &response.Threads
+            };
+
+            static_assert((sizeof(metrics) / sizeof(metrics[0])) == PluginHost::Server::Sampler::METRICS, "Every metric needs a member in the response");
+
+            result = Core::ERROR_UNKNOWN_KEY;
+
+            for (uint8_t metric = 0; metric < PluginHost::Server::Sampler::METRICS; metric++) {
+                PluginHost::Server::Sampler::History history;
+
+                if (sampler.Snapshot(index, static_cast<PluginHost::Server::Sampler::metric>(metric), history) == true) {
+                    PluginHost::Server::Sampler::History::const_iterator sample(history.begin());
+
+                    while (sample != history.end()) {
+                        SampleData& entry(metrics[metric]->Add());
+
+                        entry.Time = sample->first / Core::Time::TicksPerMillisecond;
+                        entry.Value = sample->second;
+                        sample++;
+                    }
+
+                    result = Core::ERROR_NONE;
+                }
+            }
+
+            response.Interval = sampler.Interval();
+        }
+
+        return result;
+    }
+
     // Property: discoveryresults - SSDP network discovery results
     // Return codes:
     //  - ERROR_NONE: Success
@@ -4,6 +4,7 @@ string(TOLOWER ${NAMESPACE} NAMESPACE_LIB)
 set(PORT 80 CACHE STRING "The port for the webinterface")
 set(BINDING "0.0.0.0" CACHE STRING "The binding interface")
 set(IDLE_TIME 180 CACHE STRING "Idle time")
+set(BACKLOG 256 CACHE STRING "Messages queued per channel before notifications to it are dropped, 0 is unlimited")
 set(PERSISTENT_PATH "/root" CACHE STRING "Persistent path")
 set(DATA_PATH "${CMAKE_INSTALL_PREFIX}/share/${NAMESPACE}" CACHE STRING "Data path")
 set(SYSTEM_PATH "${CMAKE_INSTALL_PREFIX}/lib/${NAMESPACE_LIB}/plugins" CACHE STRING "System path")
@@ -16,6 +17,10 @@ set(PRIORITY 0 CACHE STRING "Change the nice level [-20 - 20]")
 set(POLICY "OTHER" CACHE STRING "NA")
 set(OOMADJUST 0 CACHE STRING "Adapt the OOM score [-15 - 15]")
 set(STACKSIZE 0 CACHE STRING "Default stack size per thread")
+set(ACTIVATORS 1 CACHE STRING "Number of plugins activated concurrently at startup, 1 (the default) activates them one by one")
+set(ZYGOTE false CACHE STRING "Fork out-of-process plugin hosts from a pre-initialized host process")
+set(TELEMETRY_INTERVAL 0 CACHE STRING "Seconds between two samples of the out-of-process plugins, 0 disables sampling")
+set(TELEMETRY_RETENTION 4 CACHE STRING "Recorder blocks (1 KB) kept per plugin and metric")
 
 map()
   key(plugins)
@@ -29,6 +34,9 @@ map_set(${CONFIG} port ${PORT})
 map_set(${CONFIG} binding ${BINDING})
 map_set(${CONFIG} ipv6 ${IPV6_SUPPORT})
 map_set(${CONFIG} idletime ${IDLE_TIME})
+map_set(${CONFIG} backlog ${BACKLOG})
+map_set(${CONFIG} activators ${ACTIVATORS})
+map_set(${CONFIG} zygote ${ZYGOTE})
 map_set(${CONFIG} persistentpath ${PERSISTENT_PATH})
 map_set(${CONFIG} volatilepath ${VOLATILE_PATH})
 map_set(${CONFIG} datapath ${DATA_PATH})
@@ -45,6 +53,13 @@ end()
 ans(PROCESS_CONFIG)
 map_append(${CONFIG} process ${PROCESS_CONFIG})
 
+map()
+    kv(interval ${TELEMETRY_INTERVAL})
+    kv(retention ${TELEMETRY_RETENTION})
+end()
+ans(TELEMETRY_CONFIG)
+map_append(${CONFIG} telemetry ${TELEMETRY_CONFIG})
+
 map()
     kv(callsign Controller)
     key(configuration)
@@ -213,13 +213,25 @@ namespace PluginHost
         }
     }
 
+    /* virtual */ void* Server::ServiceMap::Instantiate(const RPC::Object& object, const uint32_t waitTime, uint32_t& sessionId, const string& className, const string& callsign)
+    {
+        void* result = _processAdministrator.Create(sessionId, object, className, callsign, waitTime);
+
+        if (sessionId != 0) {
+            _server.Telemetry().Track(callsign, sessionId);
+        }
+
+        return (result);
+    }
+
     void Server::ServiceMap::Destroy()
     {
         _adminLock.Lock();
 
-        std::map<const string, Core::ProxyType<Service>>::iterator index(_services.end());
+        std::shared_ptr<Snapshot> services(Current());
+        std::map<const string, Core::ProxyType<Service>>::iterator index(services->Services.end());
 
-        TRACE_L1("Deactivating %d plugins.", static_cast<uint32_t>(_services.size()));
+        TRACE_L1("Deactivating %d plugins.", static_cast<uint32_t>(services->Services.size()));
 
         // First, move them all to deactivated
         do {
@@ -229,21 +241,15 @@ namespace PluginHost
 
             index->second->Deactivate(PluginHost::IShell::SHUTDOWN);
 
-        } while (index != _services.begin());
+        } while (index != services->Services.begin());
 
-        TRACE_L1("Destructing %d plugins.", static_cast<uint32_t>(_services.size()));
-        // Now release them all, once they are deactivated..
-        index = _services.begin();
+        TRACE_L1("Destructing %d plugins.", static_cast<uint32_t>(services->Services.size()));
 
-        while (index != _services.end()) {
-            Core::ProxyType<Service> service(index->second);
+        // Now release them all, once they are deactivated. Requests still in flight hold on to the
+        // snapshot they resolved their service from, new ones find none.
+        Publish(std::make_shared<Snapshot>());
 
-            ASSERT(service.IsValid());
-
-            index = _services.erase(index);
-
-            service.Release();
-        }
+        services.reset();
 
         Core::ServiceAdministrator::Instance().FlushLibraries();
 
@@ -489,9 +495,9 @@ namespace PluginHost
         return (result);
     }
 
-    /* virtual */ uint32_t Server::Service::Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response)
+    /* virtual */ uint32_t Server::Service::Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response, const bool notification)
     {
-        return (_administrator.Submit(id, response));
+        return (_administrator.Submit(id, response, notification));
     }
 
     /* virtual */ ISubSystem* Server::Service::SubSystems()
@@ -559,6 +565,8 @@ namespace PluginHost
         , _security(_parent.Officer())
         , _service()
     {
+        Backlog(static_cast<ChannelMap&>(*parent).Backlog());
+
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
     }
 
@@ -599,7 +607,7 @@ namespace PluginHost
     Server::Server(Server::Config & configuration, const bool background)
         : _accessor()
         , _dispatcher(configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
-        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime)
+        , _connections(*this, DetermineAccessor(configuration, _accessor), configuration.IdleTime, configuration.Backlog)
         , _config(configuration.Version.Value(),
               DetermineProperModel(configuration.Model),
               background,
@@ -616,6 +624,9 @@ namespace PluginHost
               configuration.Redirect.Value())
         , _services(*this, _config, configuration.Process.IsSet() ? configuration.Process.StackSize.Value() : 0)
         , _controller()
+        , _activator(this)
+        , _activators(configuration.Activators.Value() > 0 ? configuration.Activators.Value() : 1)
+        , _sampler(this, configuration.Telemetry, _config.VolatilePath() + _T("telemetry/"))
     {
 
         // See if the persitent path for our-selves exist, if not we will create it :-)
@@ -629,6 +640,10 @@ namespace PluginHost
             _environment.Set(_config, configuration.Environments);
         }
 
+        if ((configuration.Zygote.Value() == true) && (_services.StartZygote() != Core::ERROR_NONE)) {
+            SYSLOG(Logging::Startup, (_T("Zygote host could not be started, out-of-process plugins are launched the regular way")));
+        }
+
         Core::JSON::ArrayType<Plugin::Config>::Iterator index = configuration.Plugins.Elements();
 
         // First register all services, than if we got them, start "activating what is required.
@@ -701,6 +716,386 @@ namespace PluginHost
     {
     }
 
+    /* static */ constexpr uint32_t Server::Activator::MaxActivationTime;
+
+    void Server::Activator::Activate(const uint8_t concurrency)
+    {
+        std::list<Core::ProxyType<Service>> all;
+        std::list<Core::ProxyType<Service>> blocked;
+        std::list<Core::ProxyType<Service>> pending;
+        std::list<Core::ProxyType<Service>> ordered;
+        Timeline timeline;
+        ServiceMap::Iterator iterator(_server.Services().Services());
+
+        _startTime = Core::Time::Now().Ticks();
+
+        while (iterator.Next() == true) {
+
+            Core::ProxyType<Service> service(*iterator);
+
+            if (service->AutoStart() == false) {
+                SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] blocked"), service->ClassName().c_str(), service->Callsign().c_str()));
+            } else if (service->State() != IShell::ACTIVATED) {
+                const uint32_t blockedOn = service->BlockedOn();
+
+                timeline.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(service->Callsign()),
+                    std::forward_as_tuple(service->Callsign(), blockedOn));
+
+                all.push_back(service);
+
+                if (blockedOn != 0) {
+                    blocked.push_back(service);
+                } else if (service->TerminatesOn() != 0) {
+                    // The subsystems it terminates on might be set, or cleared, by the plugins activated concurrently.
+                    ordered.push_back(service);
+                } else {
+                    pending.push_back(service);
+                }
+            }
+        }
+
+        // Keep at least one thread of the pool free, plugins might submit work to it (and wait for
+        // it) during their initialization.
+        const size_t threads = std::min(static_cast<size_t>(concurrency), static_cast<size_t>(THREADPOOL_COUNT - 1));
+        const uint8_t lanes = static_cast<uint8_t>(std::min(threads, pending.size()));
+
+        _adminLock.Lock();
+
+        _timeline = timeline;
+        _outstanding = static_cast<uint32_t>(timeline.size());
+        _settled = false;
+        _lanes = (lanes > 1 ? lanes : 0);
+
+        // One by one, the plugins are activated in the order of the configuration, as they always were.
+        _pending = (_lanes == 0 ? all : pending);
+        _registered = true;
+
+        _adminLock.Unlock();
+
+        // From here on, the timeline follows the state of the plugins.
+        _server.Services().Register(this);
+
+        if (_lanes == 0) {
+            Run();
+        } else {
+            // First park the plugins that wait for subsystems, so the plugins activated next find them
+            // waiting if they set one of these subsystems.
+            while (blocked.empty() == false) {
+                blocked.front()->Activate(PluginHost::IShell::STARTUP);
+                blocked.pop_front();
+            }
+
+            _completed.ResetEvent();
+
+            for (uint8_t index = 0; index < lanes; index++) {
+                _server.Submit(Core::ProxyType<Core::IDispatchType<void>>(Core::ProxyType<Lane>::Create(this)));
+            }
+
+            if (_completed.Lock(MaxActivationTime) != Core::ERROR_NONE) {
+                _adminLock.Lock();
+
+                Timeline::const_iterator index(_timeline.begin());
+
+                while (index != _timeline.end()) {
+                    if (index->second.State == IShell::ACTIVATION) {
+                        SYSLOG(Logging::Startup, (_T("Activation of plugin [%s] did not complete in %d ms, continuing without it"), index->first.c_str(), MaxActivationTime));
+                    }
+                    index++;
+                }
+
+                _adminLock.Unlock();
+            }
+
+            while (ordered.empty() == false) {
+                ordered.front()->Activate(PluginHost::IShell::STARTUP);
+                ordered.pop_front();
+            }
+        }
+
+        _adminLock.Lock();
+
+        uint32_t activated = 0;
+        uint32_t waiting = 0;
+        Timeline::iterator index(_timeline.begin());
+
+        while (index != _timeline.end()) {
+            if (index->second.State == IShell::ACTIVATED) {
+                activated++;
+            } else if (index->second.State == IShell::PRECONDITION) {
+                waiting++;
+            } else if ((index->second.End == 0) && (index->second.State != IShell::ACTIVATION)) {
+                // It did not even start its activation, there is nothing left to follow.
+                index->second.End = Core::Time::Now().Ticks();
+                _outstanding--;
+            }
+            index++;
+        }
+
+        _settled = true;
+
+        SYSLOG(Logging::Startup, (_T("Startup activated %d of %d plugins in %d ms on %d threads, %d waiting for subsystems"), activated, static_cast<uint32_t>(_timeline.size()), static_cast<uint32_t>((Core::Time::Now().Ticks() - _startTime) / Core::Time::TicksPerMillisecond), (lanes > 1 ? lanes : 1), waiting));
+
+        _adminLock.Unlock();
+
+        Settle();
+    }
+
+    void Server::Activator::Close()
+    {
+        _adminLock.Lock();
+        bool registered = _registered;
+        _registered = false;
+        _adminLock.Unlock();
+
+        if (registered == true) {
+            _server.Services().Unregister(this);
+        }
+    }
+
+    // Once every plugin of the timeline completed its activation, there is nothing left to follow.
+    void Server::Activator::Settle()
+    {
+        _adminLock.Lock();
+        bool completed = ((_settled == true) && (_outstanding == 0));
+        _adminLock.Unlock();
+
+        if (completed == true) {
+            Close();
+        }
+    }
+
+    void Server::Activator::Run()
+    {
+        _adminLock.Lock();
+
+        while (_pending.empty() == false) {
+            Core::ProxyType<Service> service(_pending.front());
+            _pending.pop_front();
+
+            _adminLock.Unlock();
+
+            service->Activate(PluginHost::IShell::STARTUP);
+
+            _adminLock.Lock();
+        }
+
+        const bool last = ((_lanes > 0) && (--_lanes == 0));
+
+        _adminLock.Unlock();
+
+        if (last == true) {
+            _completed.SetEvent();
+        }
+    }
+
+    /* virtual */ void Server::Activator::StateChange(PluginHost::IShell* plugin)
+    {
+        const IShell::state state(plugin->State());
+        bool ended = false;
+
+        _adminLock.Lock();
+
+        Timeline::iterator index(_timeline.find(plugin->Callsign()));
+
+        // Only the first activation is followed, not whatever happens to the plugin after it.
+        if ((index != _timeline.end()) && (index->second.End == 0)) {
+            if (state == IShell::ACTIVATION) {
+                index->second.Start = Core::Time::Now().Ticks();
+            } else if ((index->second.Start != 0) && ((state == IShell::ACTIVATED) || (state == IShell::DEACTIVATED))) {
+                index->second.End = Core::Time::Now().Ticks();
+                _outstanding--;
+                ended = true;
+            }
+
+            index->second.State = state;
+        }
+
+        _adminLock.Unlock();
+
+        if (ended == true) {
+            Settle();
+        }
+    }
+
+    Server::Sampler::Plugin::Plugin(const string& storage, const uint8_t retention)
+        : _connectionId(0)
+        , _statistics(nullptr)
+    {
+        static const TCHAR* const names[METRICS] = { _T("cputime"), _T("resident"), _T("proportional"), _T("shared"), _T("swap"), _T("threads") };
+
+        Core::Directory directory(storage.c_str());
+
+        directory.CreatePath();
+
+        // Recordings of a previous run would be picked up as the continuation of the new ones.
+        while (directory.Next() == true) {
+            if (directory.IsDirectory() == false) {
+                Core::File(directory.Current()).Destroy();
+            }
+        }
+
+        for (uint8_t index = 0; index < METRICS; index++) {
+            _recorders[index] = Recorder::Writer::Create(storage + names[index], retention);
+        }
+    }
+
+    void Server::Sampler::Plugin::Publish(Measurement& measurement)
+    {
+        // Tracked to another host in the mean time, the measurement is of no use anymore.
+        if (measurement.ConnectionId == _connectionId) {
+            if (measurement.Hosted == false) {
+                // The host is gone, keep the history but stop sampling until the plugin is hosted again.
+                _connectionId = 0;
+            } else if (measurement.Measured == true) {
+                _recorders[CPUTIME]->Record(measurement.Sample.CPUTime);
+                _recorders[RESIDENT]->Record(measurement.Sample.Resident);
+                _recorders[PROPORTIONAL]->Record(measurement.Sample.Proportional);
+                _recorders[SHARED]->Record(measurement.Sample.Shared);
+                _recorders[SWAP]->Record(measurement.Sample.Swap);
+                _recorders[THREADS]->Record(measurement.Sample.Threads);
+
+                ASSERT(_statistics == nullptr);
+
+                _statistics = measurement.Statistics;
+                measurement.Statistics = nullptr;
+            }
+        }
+
+        if (measurement.Statistics != nullptr) {
+            delete measurement.Statistics;
+            measurement.Statistics = nullptr;
+        }
+    }
+
+    /* static */ void Server::Sampler::Measure(ServiceMap& services, Measurement& measurement)
+    {
+        RPC::IRemoteConnection* connection = (measurement.ConnectionId != 0 ? services.RemoteConnection(measurement.ConnectionId) : nullptr);
+
+        measurement.Hosted = (connection != nullptr);
+        measurement.Measured = false;
+
+        if (connection != nullptr) {
+            const uint32_t pid = connection->RemoteId();
+
+            connection->Release();
+
+            if ((measurement.Statistics == nullptr) || (measurement.Statistics->Id() != pid)) {
+                if (measurement.Statistics != nullptr) {
+                    delete measurement.Statistics;
+                }
+                measurement.Statistics = new Core::ProcessStatistics(pid);
+            }
+
+            measurement.Measured = measurement.Statistics->Measure(measurement.Sample);
+        }
+    }
+
+    void Server::Sampler::Start()
+    {
+        if (_interval != 0) {
+            _server.Schedule(Core::Time::Now().Add(_interval).Ticks(), _job);
+        }
+    }
+
+    void Server::Sampler::Stop()
+    {
+        if (_interval != 0) {
+            _server.Revoke(_job);
+        }
+
+        _adminLock.Lock();
+        _plugins.clear();
+        _adminLock.Unlock();
+    }
+
+    void Server::Sampler::Track(const string& callsign, const uint32_t connectionId)
+    {
+        if (_interval != 0) {
+            _adminLock.Lock();
+
+            Plugins::iterator index(_plugins.find(callsign));
+
+            if (index == _plugins.end()) {
+                index = _plugins.emplace(std::piecewise_construct,
+                                    std::forward_as_tuple(callsign),
+                                    std::forward_as_tuple(_storage + callsign + '/', _retention))
+                            .first;
+            }
+
+            index->second.Track(connectionId);
+
+            _adminLock.Unlock();
+        }
+    }
+
+    bool Server::Sampler::Snapshot(const string& callsign, const metric index, History& history) const
+    {
+        _adminLock.Lock();
+
+        Plugins::const_iterator entry(_plugins.find(callsign));
+        bool result = (entry != _plugins.end());
+
+        if (result == true) {
+            Recorder::Reader reader(entry->second.Recording(index), 0);
+
+            while (reader.Next() == true) {
+                history.emplace_back(reader.Time(), reader.Value());
+            }
+        }
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void Server::Sampler::Timed()
+    {
+        const uint64_t nextTick = Core::Time::Now().Add(_interval).Ticks();
+        std::list<Measurement> measurements;
+
+        _adminLock.Lock();
+
+        Plugins::iterator index(_plugins.begin());
+
+        while (index != _plugins.end()) {
+            measurements.emplace_back();
+            measurements.back().Callsign = index->first;
+            index->second.Checkout(measurements.back());
+            index++;
+        }
+
+        _adminLock.Unlock();
+
+        // Reading /proc can take a while, a Track() or Snapshot() does not have to wait for it.
+        std::list<Measurement>::iterator loop(measurements.begin());
+
+        while (loop != measurements.end()) {
+            Measure(_server.Services(), *loop);
+            loop++;
+        }
+
+        _adminLock.Lock();
+
+        loop = measurements.begin();
+
+        while (loop != measurements.end()) {
+            index = _plugins.find(loop->Callsign);
+
+            if (index != _plugins.end()) {
+                index->second.Publish(*loop);
+            } else if (loop->Statistics != nullptr) {
+                // Stopped in the mean time.
+                delete loop->Statistics;
+            }
+            loop++;
+        }
+
+        _adminLock.Unlock();
+
+        _server.Schedule(nextTick, _job);
+    }
+
 	void Server::Notification(const ForwardMessage& data)
     {
         _controller->ClassType<Plugin::Controller>()->Notification(data);
@@ -742,24 +1137,18 @@ namespace PluginHost
         _dispatcher.Run();
 
         // Right we have the shells for all possible services registered, time to activate what is needed :-)
-        ServiceMap::Iterator iterator(_services.Services());
-
-        while (iterator.Next() == true) {
+        _activator.Activate(_activators);
 
-            Core::ProxyType<Service> service(*iterator);
+        _sampler.Start();
 
-            if (service->AutoStart() == true) {
-		service->Activate(PluginHost::IShell::STARTUP);
-            } else {
-                SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] blocked"), service->ClassName().c_str(), service->Callsign().c_str()));
-            }
-        }
         Dispatcher().Open(MAX_EXTERNAL_WAITS);
     }
 
     void Server::Close()
     {
         Plugin::Controller* destructor(_controller->ClassType<Plugin::Controller>());
+        _activator.Close();
+        _sampler.Stop();
         _dispatcher.Stop();
         _connections.Close(Core::infinite);
         destructor->Stopped();
@@ -9,6 +9,9 @@
 #include "../processcontainers/ProcessContainer.h"
 #endif
 
+#include <memory>
+#include <unordered_map>
+
 #ifndef HOSTING_COMPROCESS
 #error "Please define the name of the COM process!!!"
 #endif
@@ -185,6 +188,38 @@ namespace PluginHost {
                 Core::JSON::EnumType<PluginHost::InputHandler::type> Type;
             };
 
+            class TelemetryConfig : public Core::JSON::Container {
+            public:
+                TelemetryConfig()
+                    : Interval(0)
+                    , Retention(4)
+                {
+                    Add(_T("interval"), &Interval);
+                    Add(_T("retention"), &Retention);
+                }
+                TelemetryConfig(const TelemetryConfig& copy)
+                    : Interval(copy.Interval)
+                    , Retention(copy.Retention)
+                {
+                    Add(_T("interval"), &Interval);
+                    Add(_T("retention"), &Retention);
+                }
+                ~TelemetryConfig()
+                {
+                }
+                TelemetryConfig& operator=(const TelemetryConfig& RHS)
+                {
+                    Interval = RHS.Interval;
+                    Retention = RHS.Retention;
+                    return (*this);
+                }
+
+                // Seconds between two samples of the plugin host processes, 0 disables the sampling.
+                Core::JSON::DecUInt16 Interval;
+                // Number of recorder blocks (1 KB each) kept per plugin and metric.
+                Core::JSON::DecUInt8 Retention;
+            };
+
 #ifdef PROCESSCONTAINERS_ENABLED
 
             class ProcessContainerConfig : public Core::JSON::Container {
@@ -240,10 +275,14 @@ namespace PluginHost {
                 , Redirect(_T("http://127.0.0.1/Service/Controller/UI"))
                 , Signature(_T("TestSecretKey"))
                 , IdleTime(0)
+                , Backlog(256)
+                , Activators(1)
+                , Zygote(false)
                 , IPV6(false)
                 , DefaultTraceCategories(false)
                 , Process()
                 , Input()
+                , Telemetry()
                 , Configs()
                 , Environments()
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -265,11 +304,15 @@ namespace PluginHost {
                 Add(_T("communicator"), &Communicator);
                 Add(_T("signature"), &Signature);
                 Add(_T("idletime"), &IdleTime);
+                Add(_T("backlog"), &Backlog);
+                Add(_T("activators"), &Activators);
+                Add(_T("zygote"), &Zygote);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("tracing"), &DefaultTraceCategories);
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
                 Add(_T("input"), &Input);
+                Add(_T("telemetry"), &Telemetry);
                 Add(_T("plugins"), &Plugins);
                 Add(_T("configs"), &Configs);
                 Add(_T("environments"), &Environments);
@@ -298,10 +341,14 @@ namespace PluginHost {
             Core::JSON::String Redirect;
             Core::JSON::String Signature;
             Core::JSON::DecUInt16 IdleTime;
+            Core::JSON::DecUInt16 Backlog;
+            Core::JSON::DecUInt8 Activators;
+            Core::JSON::Boolean Zygote;
             Core::JSON::Boolean IPV6;
             Core::JSON::String DefaultTraceCategories;
             ProcessSet Process;
             InputConfig Input;
+            TelemetryConfig Telemetry;
             Core::JSON::String Configs;
             Core::JSON::ArrayType<Plugin::Config> Plugins;
             Core::JSON::ArrayType<Environment::Config> Environments;
@@ -562,10 +609,15 @@ namespace PluginHost {
 
                     return (result);
                 }
-                inline uint32_t Delta(const uint32_t currentSet)
+                inline uint32_t Delta(const uint32_t currentSet) const
                 {
                     return ((currentSet & _events) ^ _value);
                 }
+                // The subsystems this condition is about, 0 if it has none.
+                inline uint32_t Subsystems() const
+                {
+                    return (_value == static_cast<uint32_t>(~0) ? 0 : (_events & ~(1 << PluginHost::ISubSystem::END_LIST)));
+                }
 
             private:
                 uint32_t _events;
@@ -894,6 +946,22 @@ namespace PluginHost {
 
                 PluginHost::Service::GetMetaData(metaData);
             }
+            // The subsystems that still need to change before the preconditions of this plugin are met.
+            inline uint32_t BlockedOn() const
+            {
+                Lock();
+
+                uint32_t result = (_precondition.IsMet() == true ? 0 : _precondition.Delta(_administrator.SubSystemInfo()));
+
+                Unlock();
+
+                return (result);
+            }
+            // The subsystems that deactivate this plugin when they change, these are set or cleared by other plugins.
+            inline uint32_t TerminatesOn() const
+            {
+                return (_termination.Subsystems());
+            }
             inline void Evaluate()
             {
                 Lock();
@@ -931,7 +999,7 @@ namespace PluginHost {
             {
                 return _administrator.EnvironmentConfig().SubstituteVariables(_administrator.Configuration(), input);
             }
-            virtual uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response) override;
+            virtual uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response, const bool notification) override;
             virtual ISubSystem* SubSystems() override;
             virtual void Notify(const string& message) override;
             virtual void* QueryInterface(const uint32_t id) override;
@@ -1102,8 +1170,36 @@ namespace PluginHost {
             static Core::ProxyType<Web::Response> _missingHandler;
         };
         class EXTERNAL ServiceMap : public PluginHost::IShell::ICOMLink {
+        private:
+            // Every request resolves its callsign here, while the set of services only changes when a plugin
+            // is added or removed. So readers take the current Snapshot without locking (an atomic load of the
+            // shared pointer), writers are serialized by the _adminLock and publish a modified copy. A Snapshot
+            // lives as long as the last reader holding it.
+            struct Snapshot {
+                std::map<const string, Core::ProxyType<Service>> Services;
+
+                // Hashed on the exact callsign, the map is only walked for versioned callsigns (<callsign>.<version>).
+                std::unordered_map<string, Core::ProxyType<Service>> Index;
+            };
+
         public:
-            typedef Core::IteratorMapType<std::map<const string, Core::ProxyType<Service>>, Core::ProxyType<Service>, const string&> Iterator;
+            // Walks the Snapshot that was current when it was created, unaffected by services added or removed since.
+            class Iterator : public Core::IteratorMapType<std::map<const string, Core::ProxyType<Service>>, Core::ProxyType<Service>, const string&> {
+            public:
+                Iterator() = delete;
+
+                Iterator(const std::shared_ptr<Snapshot>& snapshot)
+                    : Core::IteratorMapType<std::map<const string, Core::ProxyType<Service>>, Core::ProxyType<Service>, const string&>(snapshot->Services)
+                    , _snapshot(snapshot)
+                {
+                }
+                Iterator(const Iterator&) = default;
+                Iterator& operator=(const Iterator&) = default;
+                ~Iterator() = default;
+
+            private:
+                std::shared_ptr<Snapshot> _snapshot;
+            };
 
         private:
             ServiceMap() = delete;
@@ -1156,6 +1252,10 @@ namespace PluginHost {
                 }
 
             public:
+                uint32_t StartZygote()
+                {
+                    return (RPC::Communicator::StartZygote(_application, _proxyStubPath));
+                }
                 void* Create(uint32_t& connectionId, const RPC::Object& instance, const string& classname, const string& callsign, const uint32_t waitTime)
                 {
                     string persistentPath(_persistentPath);
@@ -1426,7 +1526,7 @@ namespace PluginHost {
                 : _webbridgeConfig(config)
                 , _adminLock()
                 , _notificationLock()
-                , _services()
+                , _services(std::make_shared<Snapshot>())
                 , _notifiers()
                 , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
                 , _processAdministrator(config.Communicator(), config.PersistentPath(), config.SystemPath(), config.DataPath(), config.VolatilePath(), config.AppPath(), config.ProxyStubPath(), _engine)
@@ -1438,10 +1538,14 @@ namespace PluginHost {
             ~ServiceMap()
             {
                 // Make sure all services are deactivated before we are killed (call Destroy on this object);
-                ASSERT(_services.size() == 0);
+                ASSERT(Current()->Services.size() == 0);
             }
 
         public:
+            inline uint32_t StartZygote()
+            {
+                return (_processAdministrator.StartZygote());
+            }
             inline void Security(const bool enabled)
             {
                 _adminLock.Lock();
@@ -1473,9 +1577,9 @@ namespace PluginHost {
                 _adminLock.Unlock();
                 return (result);
             }
-            inline uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response)
+            inline uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response, const bool notification)
             {
-                return (_server.Dispatcher().Submit(id, response));
+                return (_server.Dispatcher().Submit(id, response, notification));
             }
             inline uint32_t SubSystemInfo() const
             {
@@ -1507,10 +1611,11 @@ namespace PluginHost {
                 _notifiers.push_back(sink);
 
                 // Tell this "new" sink all our active/inactive plugins..
-                std::map<const string, Core::ProxyType<Service>>::iterator index(_services.begin());
+                const std::shared_ptr<Snapshot> services(Current());
+                std::map<const string, Core::ProxyType<Service>>::iterator index(services->Services.begin());
 
                 // Notifty all plugins that we have sofar..
-                while (index != _services.end()) {
+                while (index != services->Services.end()) {
                     ASSERT(index->second.IsValid());
 
                     Core::ProxyType<Service> service(index->second);
@@ -1555,10 +1660,7 @@ namespace PluginHost {
                 return (result);
             }
 
-            virtual void* Instantiate(const RPC::Object& object, const uint32_t waitTime, uint32_t& sessionId, const string& className, const string& callsign) override
-            {
-                return (_processAdministrator.Create(sessionId, object, className, callsign, waitTime));
-            }
+            virtual void* Instantiate(const RPC::Object& object, const uint32_t waitTime, uint32_t& sessionId, const string& className, const string& callsign) override;
             virtual void Register(RPC::IRemoteConnection::INotification* sink) override
             {
                 _processAdministrator.Register(sink);
@@ -1591,8 +1693,13 @@ namespace PluginHost {
                 if (newService.IsValid() == true) {
                     _adminLock.Lock();
 
+                    std::shared_ptr<Snapshot> services(std::make_shared<Snapshot>(*Current()));
+
                     // Fire up the interface. Let it handle the messages.
-                    _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
+                    services->Services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
+                    services->Index.insert(std::pair<string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
+
+                    Publish(services);
 
                     _adminLock.Unlock();
                 }
@@ -1603,24 +1710,35 @@ namespace PluginHost {
             {
                 _adminLock.Lock();
 
+                std::shared_ptr<Snapshot> services(std::make_shared<Snapshot>(*Current()));
+
                 // First stop all services running ...
-                std::map<const string, Core::ProxyType<Service>>::iterator index(_services.find(callSign));
+                std::map<const string, Core::ProxyType<Service>>::iterator index(services->Services.find(callSign));
 
-                if (index != _services.end()) {
+                if (index != services->Services.end()) {
                     index->second->Destroy();
-                    _services.erase(index);
+                    services->Services.erase(index);
+                    services->Index.erase(callSign);
+
+                    Publish(services);
                 }
 
                 _adminLock.Unlock();
             }
             inline Iterator Services()
             {
-                return (Iterator(_services));
+                return (Iterator(Current()));
             }
             //inline void Processes(std::list<uint32_t>& listOfPids) const
             //{
             //    return (_processAdministrator.Connections(listOfPids));
             //}
+#ifdef PROCESSCONTAINERS_ENABLED
+            inline void Containers(std::list<RPC::ContainerUsage>& usages) const
+            {
+                _processAdministrator.Containers(usages);
+            }
+#endif
             inline void Notification(const ForwardMessage& message)
             {
                 _server.Notification(message);
@@ -1633,50 +1751,45 @@ namespace PluginHost {
 #endif
             void GetMetaData(Core::JSON::ArrayType<MetaData::Service>& metaData) const
             {
-                _adminLock.Lock();
-
-                std::list<Core::ProxyType<Service>> duplicates;
-                std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
+                const std::shared_ptr<Snapshot> services(Current());
+                std::map<const string, Core::ProxyType<Service>>::const_iterator index(services->Services.begin());
 
-                while (index != _services.end()) {
-                    duplicates.push_back(index->second);
-                    index++;
-                }
-
-                _adminLock.Unlock();
-
-                while (duplicates.size() > 0) {
+                while (index != services->Services.end()) {
                     MetaData::Service newInfo;
-                    duplicates.front()->GetMetaData(newInfo);
+                    index->second->GetMetaData(newInfo);
                     metaData.Add(newInfo);
-                    duplicates.pop_front();
+                    index++;
                 }
             }
             uint32_t FromIdentifier(const string& callSign, Core::ProxyType<Service>& service)
             {
                 uint32_t result = Core::ERROR_UNAVAILABLE;
 
-                _adminLock.Lock();
+                const std::shared_ptr<Snapshot> services(Current());
+                std::unordered_map<string, Core::ProxyType<Service>>::const_iterator exact(services->Index.find(callSign));
 
-                std::map<const string, Core::ProxyType<Service>>::const_iterator index(_services.begin());
+                if (exact != services->Index.end()) {
+                    service = exact->second;
+                    result = Core::ERROR_NONE;
+                } else {
+                    std::map<const string, Core::ProxyType<Service>>::const_iterator index(services->Services.begin());
 
-                while ((index != _services.end()) && (result == Core::ERROR_UNAVAILABLE)) {
-                    const string& source(index->first);
-                    if (callSign.compare(0, source.length(), source) != 0) {
-                        index++;
-                    } else {
-                        result = Core::ERROR_INVALID_SIGNATURE;
-                        uint32_t length = static_cast<uint32_t>(source.length());
+                    while ((index != services->Services.end()) && (result == Core::ERROR_UNAVAILABLE)) {
+                        const string& source(index->first);
+                        if (callSign.compare(0, source.length(), source) != 0) {
+                            index++;
+                        } else {
+                            result = Core::ERROR_INVALID_SIGNATURE;
+                            uint32_t length = static_cast<uint32_t>(source.length());
 
-                        if ((callSign.length() == length) || ((callSign[length] == '.') && (index->second->HasVersionSupport(callSign.substr(length + 1))))) {
-                            service = index->second;
-                            result = Core::ERROR_NONE;
+                            if ((callSign.length() > length) && (callSign[length] == '.') && (index->second->HasVersionSupport(callSign.substr(length + 1)))) {
+                                service = index->second;
+                                result = Core::ERROR_NONE;
+                            }
                         }
                     }
                 }
 
-                _adminLock.Unlock();
-
                 return (result);
             }
             uint32_t FromLocator(const string& identifier, Core::ProxyType<Service>& service, bool& serviceCall);
@@ -1690,26 +1803,26 @@ namespace PluginHost {
                 return _server.Configuration();
             }
         private:
-            void RecursiveNotification(std::map<const string, Core::ProxyType<Service>>::iterator& index)
+            inline std::shared_ptr<Snapshot> Current() const
             {
-                if (index != _services.end()) {
-                    Core::ProxyType<Service> element(index->second);
-                    index++;
-                    RecursiveNotification(index);
-                    element->Evaluate();
-                } else {
-                    _adminLock.Unlock();
-                }
+                return (std::atomic_load(&_services));
+            }
+            inline void Publish(const std::shared_ptr<Snapshot>& services)
+            {
+                // Only to be called with the _adminLock taken, modifications of the snapshot are not merged.
+                std::atomic_store(&_services, services);
             }
             void Evaluate()
             {
+                const std::shared_ptr<Snapshot> services(Current());
 
-                _adminLock.Lock();
-
-                // First stop all services running ...
-                std::map<const string, Core::ProxyType<Service>>::iterator index(_services.begin());
+                // Last one first, as it always has been..
+                std::map<const string, Core::ProxyType<Service>>::reverse_iterator index(services->Services.rbegin());
 
-                RecursiveNotification(index);
+                while (index != services->Services.rend()) {
+                    index->second->Evaluate();
+                    index++;
+                }
             }
             inline Core::WorkerPool& WorkerPool()
             {
@@ -1721,7 +1834,7 @@ namespace PluginHost {
 
             mutable Core::CriticalSection _adminLock;
             Core::CriticalSection _notificationLock;
-            std::map<const string, Core::ProxyType<Service>> _services;
+            std::shared_ptr<Snapshot> _services;
             std::list<IPlugin::INotification*> _notifiers;
             Core::ProxyType<RPC::InvokeServer> _engine;
             CommunicatorServer _processAdministrator;
@@ -1730,6 +1843,308 @@ namespace PluginHost {
             IAuthenticate* _authenticationHandler;
         };
 
+        // At startup, the autostart plugins are activated one by one, in the order of the configuration. If more
+        // activators are configured, the plugins of which the preconditions are met and that do not terminate on
+        // subsystems do not depend on each other, so they are activated concurrently on the WorkerPool (on at most
+        // the configured number of threads, so the pool keeps threads for the work the plugins submit during their
+        // initialization). Plugins that wait for subsystems are handed to the precondition mechanism, which
+        // activates them as soon as their subsystems are set. Plugins that terminate on subsystems are activated
+        // after the concurrent ones, once the subsystems these set are settled. For every plugin, the moments of
+        // activation are kept in a timeline, until all of them are activated (or failed to).
+        class Activator : public IPlugin::INotification {
+        public:
+            class Entry {
+            public:
+                Entry()
+                    : Callsign()
+                    , BlockedOn(0)
+                    , Start(0)
+                    , End(0)
+                    , State(IShell::DEACTIVATED)
+                {
+                }
+                Entry(const string& callsign, const uint32_t blockedOn)
+                    : Callsign(callsign)
+                    , BlockedOn(blockedOn)
+                    , Start(0)
+                    , End(0)
+                    , State(IShell::DEACTIVATED)
+                {
+                }
+                Entry(const Entry& copy)
+                    : Callsign(copy.Callsign)
+                    , BlockedOn(copy.BlockedOn)
+                    , Start(copy.Start)
+                    , End(copy.End)
+                    , State(copy.State)
+                {
+                }
+                ~Entry()
+                {
+                }
+
+                Entry& operator=(const Entry& rhs)
+                {
+                    Callsign = rhs.Callsign;
+                    BlockedOn = rhs.BlockedOn;
+                    Start = rhs.Start;
+                    End = rhs.End;
+                    State = rhs.State;
+
+                    return (*this);
+                }
+
+            public:
+                string Callsign;
+                // Subsystems the plugin was waiting for when the startup began.
+                uint32_t BlockedOn;
+                // Ticks at which the Initialize of the plugin started and returned, 0 if it did not (yet).
+                uint64_t Start;
+                uint64_t End;
+                IShell::state State;
+            };
+
+            typedef std::map<string, Entry> Timeline;
+
+            // Time (ms) the concurrent activations get, before the startup continues without them.
+            static constexpr uint32_t MaxActivationTime = 60000;
+
+        private:
+            Activator() = delete;
+            Activator(const Activator&) = delete;
+            Activator& operator=(const Activator&) = delete;
+
+            class Lane : public Core::IDispatchType<void> {
+            private:
+                Lane() = delete;
+                Lane(const Lane&) = delete;
+                Lane& operator=(const Lane&) = delete;
+
+            public:
+                Lane(Activator* parent)
+                    : _parent(*parent)
+                {
+                    ASSERT(parent != nullptr);
+                }
+                virtual ~Lane()
+                {
+                }
+
+            public:
+                virtual void Dispatch() override
+                {
+                    _parent.Run();
+                }
+
+            private:
+                Activator& _parent;
+            };
+
+        public:
+            Activator(Server* server)
+                : _server(*server)
+                , _adminLock()
+                , _pending()
+                , _timeline()
+                , _lanes(0)
+                , _completed(false, true)
+                , _startTime(0)
+                , _outstanding(0)
+                , _settled(false)
+                , _registered(false)
+            {
+                ASSERT(server != nullptr);
+            }
+            virtual ~Activator()
+            {
+            }
+
+        public:
+            // Returns once all plugins that could be activated, are activated (or failed to), or the concurrent
+            // activations took longer than MaxActivationTime.
+            void Activate(const uint8_t concurrency);
+            void Close();
+
+            inline uint64_t StartTime() const
+            {
+                return (_startTime);
+            }
+            inline void Snapshot(Timeline& timeline) const
+            {
+                _adminLock.Lock();
+                timeline = _timeline;
+                _adminLock.Unlock();
+            }
+
+            virtual void StateChange(PluginHost::IShell* plugin) override;
+
+            BEGIN_INTERFACE_MAP(Activator)
+            INTERFACE_ENTRY(IPlugin::INotification)
+            END_INTERFACE_MAP
+
+        private:
+            void Run();
+            void Settle();
+
+        private:
+            Server& _server;
+            mutable Core::CriticalSection _adminLock;
+            std::list<Core::ProxyType<Service>> _pending;
+            Timeline _timeline;
+            uint8_t _lanes;
+            Core::Event _completed;
+            uint64_t _startTime;
+            // Entries of the timeline that did not complete their activation yet.
+            uint32_t _outstanding;
+            bool _settled;
+            bool _registered;
+        };
+
+        // Samples the CPU and memory usage of the out-of-process plugins at a fixed interval. The /proc files
+        // of the host processes are kept open between the samples, and every metric of a plugin is recorded
+        // in a RecorderType of which only the last blocks are kept, so the history is cheap and bounded.
+        class Sampler {
+        public:
+            enum metric {
+                CPUTIME,
+                RESIDENT,
+                PROPORTIONAL,
+                SHARED,
+                SWAP,
+                THREADS,
+                METRICS
+            };
+
+            typedef Core::RecorderType<uint64_t, 1> Recorder;
+            typedef std::list<std::pair<uint64_t, uint64_t>> History;
+
+        private:
+            Sampler() = delete;
+            Sampler(const Sampler&) = delete;
+            Sampler& operator=(const Sampler&) = delete;
+
+            class Job : public Core::IDispatchType<void> {
+            private:
+                Job() = delete;
+                Job(const Job&) = delete;
+                Job& operator=(const Job&) = delete;
+
+            public:
+                Job(Sampler* parent)
+                    : _parent(*parent)
+                {
+                    ASSERT(parent != nullptr);
+                }
+                virtual ~Job()
+                {
+                }
+
+            public:
+                virtual void Dispatch() override
+                {
+                    _parent.Timed();
+                }
+
+            private:
+                Sampler& _parent;
+            };
+
+            // A sample taken outside the lock. The statistics of the host are handed out to it for the
+            // duration of the measurement and handed back when the result is published.
+            struct Measurement {
+                string Callsign;
+                uint32_t ConnectionId;
+                Core::ProcessStatistics* Statistics;
+                bool Hosted;
+                bool Measured;
+                Core::ProcessStatistics::Sample Sample;
+            };
+
+            class Plugin {
+            private:
+                Plugin() = delete;
+                Plugin(const Plugin&) = delete;
+                Plugin& operator=(const Plugin&) = delete;
+
+            public:
+                Plugin(const string& storage, const uint8_t retention);
+                ~Plugin()
+                {
+                    if (_statistics != nullptr) {
+                        delete _statistics;
+                    }
+                }
+
+            public:
+                inline void Track(const uint32_t connectionId)
+                {
+                    _connectionId = connectionId;
+                }
+                inline const Core::ProxyType<Recorder::Writer>& Recording(const metric index) const
+                {
+                    return (_recorders[index]);
+                }
+                inline void Checkout(Measurement& measurement)
+                {
+                    measurement.ConnectionId = _connectionId;
+                    measurement.Statistics = _statistics;
+                    _statistics = nullptr;
+                }
+                void Publish(Measurement& measurement);
+
+            private:
+                uint32_t _connectionId;
+                Core::ProcessStatistics* _statistics;
+                Core::ProxyType<Recorder::Writer> _recorders[METRICS];
+            };
+
+            typedef std::map<string, Plugin> Plugins;
+
+        public:
+            Sampler(Server* server, const Config::TelemetryConfig& config, const string& storage)
+                : _server(*server)
+                , _adminLock()
+                , _interval(config.Interval.Value() * 1000)
+                , _retention(config.Retention.Value() > 0 ? config.Retention.Value() : 1)
+                , _storage(storage)
+                , _plugins()
+                , _job(Core::ProxyType<Job>::Create(this))
+            {
+                ASSERT(server != nullptr);
+            }
+            ~Sampler()
+            {
+            }
+
+        public:
+            // In milliseconds, 0 if sampling is disabled.
+            inline uint32_t Interval() const
+            {
+                return (_interval);
+            }
+            void Start();
+            void Stop();
+
+            // From now on, the given connection hosts the plugin.
+            void Track(const string& callsign, const uint32_t connectionId);
+
+            // Time (in ticks) and value of all samples of the metric still kept for the plugin.
+            bool Snapshot(const string& callsign, const metric index, History& history) const;
+
+        private:
+            void Timed();
+            static void Measure(ServiceMap& services, Measurement& measurement);
+
+        private:
+            Server& _server;
+            mutable Core::CriticalSection _adminLock;
+            const uint32_t _interval;
+            const uint8_t _retention;
+            const string _storage;
+            Plugins _plugins;
+            Core::ProxyType<Core::IDispatchType<void>> _job;
+        };
+
         // Connection handler is the listening socket and keeps track of all open
         // Links. A Channel is identified by an ID, this way, whenever a link dies
         // (is closed) during the service process, the ChannelMap will
@@ -2007,6 +2422,12 @@ namespace PluginHost {
                 _unauthorizedRequest->ErrorCode = Web::STATUS_UNAUTHORIZED;
                 _unauthorizedRequest->Message = _T("Request needs authorization, but it was not authorized");
             }
+            static void Pools(MetaData::Server& data)
+            {
+                data.AddPool(_T("WebRequestJob"), _webJobs);
+                data.AddPool(_T("JSONElementJob"), _jsonJobs);
+                data.AddPool(_T("TextJob"), _textJobs);
+            }
             void Revoke(PluginHost::ISecurity* baseRights)
             {
                 PluginHost::Channel::Lock();
@@ -2398,10 +2819,11 @@ namespace PluginHost {
 #ifdef __WIN32__
 #pragma warning(disable : 4355)
 #endif
-            ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer)
+            ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint16_t connectionCheckTimer, const uint16_t backlog)
                 : Core::SocketServerType<Channel>(listeningNode)
                 , _parent(parent)
                 , _connectionCheckTimer(connectionCheckTimer * 1000)
+                , _backlog(backlog)
                 , _job(Core::ProxyType<Job>::Create(this))
             {
                 if (connectionCheckTimer != 0) {
@@ -2453,6 +2875,10 @@ namespace PluginHost {
             {
                 return (_parent);
             }
+            inline uint16_t Backlog() const
+            {
+                return (_backlog);
+            }
             inline uint32_t ActiveClients() const
             {
                 return (Core::SocketServerType<Channel>::Count());
@@ -2493,6 +2919,7 @@ namespace PluginHost {
         private:
             Server& _parent;
             const uint32_t _connectionCheckTimer;
+            const uint16_t _backlog;
             Core::ProxyType<Core::IDispatchType<void>> _job;
         };
 
@@ -2509,10 +2936,44 @@ namespace PluginHost {
         {
             return (_services);
         }
+        inline const Activator& Startup() const
+        {
+            return (_activator);
+        }
+        inline Sampler& Telemetry()
+        {
+            return (_sampler);
+        }
         inline Server::WorkerPoolImplementation& WorkerPool()
         {
             return (_dispatcher);
         }
+        inline void Pools(MetaData::Server& data) const
+        {
+            Channel::Pools(data);
+        }
+        inline void Input(MetaData::Server& data) const
+        {
+            const VirtualInput* handler = InputHandler::Handler();
+
+            if (handler != nullptr) {
+                VirtualInput::Statistics statistics;
+
+                handler->Measure(statistics);
+
+                data.Keys.Events = statistics.Events;
+                data.Keys.Dropped = statistics.Dropped;
+
+                for (uint8_t teller = 0; teller < VirtualInput::LatencyBuckets; teller++) {
+                    Core::JSON::DecUInt32 processed;
+                    Core::JSON::DecUInt32 dispatched;
+                    processed = statistics.Processed[teller];
+                    dispatched = statistics.Dispatched[teller];
+                    data.Keys.Processed.Add(processed);
+                    data.Keys.Dispatched.Add(dispatched);
+                }
+            }
+        }
         inline void Submit(const Core::ProxyType<Core::IDispatchType<void>>& job)
         {
             _dispatcher.Submit(job);
@@ -2580,6 +3041,11 @@ namespace PluginHost {
         Core::ProxyType<Service> _controller;
 
         Environment _environment;
+
+        // Activates the autostart plugins and keeps track of how long that took.
+        Core::Sink<Activator> _activator;
+        const uint8_t _activators;
+        Sampler _sampler;
     };
 }
 }
@@ -54,6 +54,61 @@ namespace JsonData {
             Core::JSON::String Data; // Object that was broadcasted as an event by the originator plugin
         }; // class AllParamsData
 
+        class ContainerData : public Core::JSON::Container {
+        public:
+            ContainerData()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+
+            ContainerData(const ContainerData& other)
+                : Core::JSON::Container()
+                , Callsign(other.Callsign)
+                , Pid(other.Pid)
+                , Cputime(other.Cputime)
+                , Throttled(other.Throttled)
+                , Memory(other.Memory)
+                , Resident(other.Resident)
+                , Oomevents(other.Oomevents)
+            {
+                Init();
+            }
+
+            ContainerData& operator=(const ContainerData& rhs)
+            {
+                Callsign = rhs.Callsign;
+                Pid = rhs.Pid;
+                Cputime = rhs.Cputime;
+                Throttled = rhs.Throttled;
+                Memory = rhs.Memory;
+                Resident = rhs.Resident;
+                Oomevents = rhs.Oomevents;
+                return (*this);
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("callsign"), &Callsign);
+                Add(_T("pid"), &Pid);
+                Add(_T("cputime"), &Cputime);
+                Add(_T("throttled"), &Throttled);
+                Add(_T("memory"), &Memory);
+                Add(_T("resident"), &Resident);
+                Add(_T("oomevents"), &Oomevents);
+            }
+
+        public:
+            Core::JSON::String Callsign; // Callsign of the plugin hosted in the container
+            Core::JSON::DecUInt32 Pid; // Process ID of the host process
+            Core::JSON::DecUInt64 Cputime; // CPU time consumed by the container, in microseconds
+            Core::JSON::DecUInt64 Throttled; // Time the container was throttled by its CPU quota, in microseconds
+            Core::JSON::DecUInt64 Memory; // Memory charged to the container, including page cache, in bytes
+            Core::JSON::DecUInt64 Resident; // Anonymous memory of the container processes, in bytes
+            Core::JSON::DecUInt32 Oomevents; // Number of times the memory limit of the container was hit
+        }; // class ContainerData
+
         class DeleteParamsData : public Core::JSON::Container {
         public:
             DeleteParamsData()
@@ -107,6 +162,41 @@ namespace JsonData {
             Core::JSON::String Destination; // Path to the downloaded file in the persistent storage
         }; // class DownloadcompletedParamsData
 
+        class SampleData : public Core::JSON::Container {
+        public:
+            SampleData()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+
+            SampleData(const SampleData& other)
+                : Core::JSON::Container()
+                , Time(other.Time)
+                , Value(other.Value)
+            {
+                Init();
+            }
+
+            SampleData& operator=(const SampleData& rhs)
+            {
+                Time = rhs.Time;
+                Value = rhs.Value;
+                return (*this);
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("time"), &Time);
+                Add(_T("value"), &Value);
+            }
+
+        public:
+            Core::JSON::DecUInt64 Time; // Moment of the sample, in milliseconds since the epoch
+            Core::JSON::DecUInt64 Value; // Value of the sample
+        }; // class SampleData
+
         class StartdiscoveryParamsData : public Core::JSON::Container {
         public:
             StartdiscoveryParamsData()
@@ -122,6 +212,53 @@ namespace JsonData {
             Core::JSON::DecUInt8 Ttl; // TTL (time to live) parameter for SSDP discovery
         }; // class StartdiscoveryParamsData
 
+        class StartupData : public Core::JSON::Container {
+        public:
+            StartupData()
+                : Core::JSON::Container()
+            {
+                Init();
+            }
+
+            StartupData(const StartupData& other)
+                : Core::JSON::Container()
+                , Callsign(other.Callsign)
+                , Blockedon(other.Blockedon)
+                , Start(other.Start)
+                , End(other.End)
+                , State(other.State)
+            {
+                Init();
+            }
+
+            StartupData& operator=(const StartupData& rhs)
+            {
+                Callsign = rhs.Callsign;
+                Blockedon = rhs.Blockedon;
+                Start = rhs.Start;
+                End = rhs.End;
+                State = rhs.State;
+                return (*this);
+            }
+
+        private:
+            void Init()
+            {
+                Add(_T("callsign"), &Callsign);
+                Add(_T("blockedon"), &Blockedon);
+                Add(_T("start"), &Start);
+                Add(_T("end"), &End);
+                Add(_T("state"), &State);
+            }
+
+        public:
+            Core::JSON::String Callsign; // Plugin callsign
+            Core::JSON::ArrayType<Core::JSON::EnumType<PluginHost::ISubSystem::subsystem>> Blockedon; // Subsystems the plugin was waiting for when the startup began
+            Core::JSON::DecUInt32 Start; // Moment the activation started, in milliseconds after the startup began (absent if it did not start)
+            Core::JSON::DecUInt32 End; // Moment the activation completed, in milliseconds after the startup began (absent if it did not complete)
+            Core::JSON::EnumType<PluginHost::MetaData::Service::state> State; // State of the plugin
+        }; // class StartupData
+
         class StatechangeParamsData : public Core::JSON::Container {
         public:
             StatechangeParamsData()
@@ -176,6 +313,33 @@ namespace JsonData {
             Core::JSON::Boolean Active; // Denotes whether the subsystem is active (true)
         }; // class SubsystemsParamsData
 
+        class TelemetryData : public Core::JSON::Container {
+        public:
+            TelemetryData()
+                : Core::JSON::Container()
+            {
+                Add(_T("interval"), &Interval);
+                Add(_T("cputime"), &Cputime);
+                Add(_T("resident"), &Resident);
+                Add(_T("proportional"), &Proportional);
+                Add(_T("shared"), &Shared);
+                Add(_T("swap"), &Swap);
+                Add(_T("threads"), &Threads);
+            }
+
+            TelemetryData(const TelemetryData&) = delete;
+            TelemetryData& operator=(const TelemetryData&) = delete;
+
+        public:
+            Core::JSON::DecUInt32 Interval; // Time between two samples, in milliseconds
+            Core::JSON::ArrayType<SampleData> Cputime; // CPU time consumed by the host process, in milliseconds
+            Core::JSON::ArrayType<SampleData> Resident; // Resident memory of the host process, in bytes
+            Core::JSON::ArrayType<SampleData> Proportional; // Proportional set size (resident memory with shared pages divided over their users) of the host process, in bytes
+            Core::JSON::ArrayType<SampleData> Shared; // Resident memory of the host process backed by files, in bytes
+            Core::JSON::ArrayType<SampleData> Swap; // Memory of the host process swapped out, in bytes
+            Core::JSON::ArrayType<SampleData> Threads; // Number of threads of the host process
+        }; // class TelemetryData
+
     } // namespace Controller
 
 } // namespace JsonData
@@ -243,12 +243,84 @@ namespace Process {
 
         return (result);
     }
+
+#ifdef __LINUX__
+    // In zygote mode (-Z <channel>), the host application loads whatever all hosts share and then waits
+    // for launch requests from the framework. Each request is the argument list of a regular launch, for
+    // which a host is forked. This only returns in such a freshly forked host, with argc/argv replaced by
+    // the arguments of its launch request, or immediately if this is not a zygote.
+    static void Zygote(int& argc, char**& argv)
+    {
+        // The request of the host that continues after the fork, argv points into it.
+        static char request[RPC::ZygoteRequestSize + 1];
+        static std::vector<char*> arguments;
+
+        int channel = -1;
+        const char* proxyStubPath = nullptr;
+
+        for (int index = 1; index < (argc - 1); index++) {
+            if (::strcmp(argv[index], _T("-Z")) == 0) {
+                channel = Core::NumberType<int32_t>(Core::TextFragment(argv[++index])).Value();
+            } else if (::strcmp(argv[index], _T("-m")) == 0) {
+                proxyStubPath = argv[++index];
+            }
+        }
+
+        if (channel != -1) {
+            ssize_t length;
+
+            TRACE_L1("Zygote waiting for launch requests: %d.", Core::ProcessInfo().Id());
+
+            if ((proxyStubPath != nullptr) && (*proxyStubPath != '\0')) {
+                RPC::Administrator::Instance().Load(proxyStubPath);
+            }
+
+            // Nobody waits for the hosts forked here, let the system reap them.
+            ::signal(SIGCHLD, SIG_IGN);
+
+            while ((length = ::recv(channel, request, RPC::ZygoteRequestSize, 0)) > 0) {
+                const pid_t pid = ::fork();
+
+                if (pid == 0) {
+                    ::close(channel);
+                    ::signal(SIGCHLD, SIG_DFL);
+
+                    request[length] = '\0';
+
+                    char* argument = request;
+                    while (argument < &request[length]) {
+                        arguments.push_back(argument);
+                        argument += ::strlen(argument) + 1;
+                    }
+                    arguments.push_back(nullptr);
+
+                    argc = static_cast<int>(arguments.size() - 1);
+                    argv = arguments.data();
+
+                    // The arguments are parsed once more, this time for the host.
+                    optind = 0;
+
+                    return;
+                }
+
+                const int32_t reply = (pid > 0 ? pid : -errno);
+
+                ::send(channel, &reply, sizeof(reply), MSG_NOSIGNAL);
+            }
+
+            // The framework closed the channel, no more hosts to launch.
+            TRACE_L1("Zygote closing down: %d.", Core::ProcessInfo().Id());
+            ::close(channel);
+
+            exit(0);
+        }
+    }
+#endif
 }
 } // Process
 
 using namespace WPEFramework;
 
-static std::list<Core::Library> _proxyStubs;
 static Core::ProxyType<RPC::CommunicatorClient> _server;
 
 //
@@ -266,8 +338,6 @@ void CloseDown()
         // We are done, close the channel and unregister all shit we added...
         _server->Close(2 * RPC::CommunicationTimeOut);
 
-        _proxyStubs.clear();
-
         _server.Release();
     }
 
@@ -294,6 +364,10 @@ int main(int argc, char** argv)
         TRACE_L1("Spawning a new process: %d.", Core::ProcessInfo().Id());
     }
 
+#ifdef __LINUX__
+    Process::Zygote(argc, argv);
+#endif
+
     Process::ConsoleOptions options(argc, argv);
 
     if ((options.RequestUsage() == true) || (options.Locator == nullptr) || (options.ClassName == nullptr) || (options.RemoteChannel == nullptr) || (options.Exchange == 0)) {
@@ -368,15 +442,7 @@ int main(int argc, char** argv)
                 TRACE_L1("Loading ProxyStubs from %s", (options.ProxyStubPath != nullptr ? options.ProxyStubPath : _T("<< No Proxy Stubs Loaded >>")));
 
                 if ((options.ProxyStubPath != nullptr) && (*(options.ProxyStubPath) != '\0')) {
-                    Core::Directory index(options.ProxyStubPath, _T("*.so"));
-
-                    while (index.Next() == true) {
-                        Core::Library library(index.Current().c_str());
-
-                        if (library.IsLoaded() == true) {
-                            _proxyStubs.push_back(library);
-                        }
-                    }
+                    RPC::Administrator::Instance().Load(options.ProxyStubPath);
                 }
                 TRACE_L1("Interface Aquired. %p.", base);
 
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+
+namespace Bluetooth {
+
+    // Rationale:
+    // While scanning, every beacon in range repeats its advertisement many times per second, so
+    // hundreds of reports a second is normal, while hardly any of them carry news. Reports are
+    // kept in a fixed, open addressing table keyed on the advertiser (address, address type and
+    // report type) together with a hash of the payload. A report that was already passed on
+    // within the window is suppressed, a new advertiser or a changed payload marks the entry
+    // for delivery. Marked entries are delivered together, at most once per interval, so the
+    // observers see the latest payload of every advertiser at a bounded rate.
+    class AdvertisementFilter {
+    private:
+        static constexpr uint16_t CAPACITY = 256; // Must be a power of 2
+        static constexpr uint16_t HIGH_WATER = (CAPACITY * 3) / 4;
+        static constexpr uint8_t KEY_SIZE = 8; // evt_type, bdaddr_type, bdaddr
+        static constexpr uint8_t MAX_DATA = 31;
+        static constexpr uint8_t MAX_REPORT = sizeof(le_advertising_info) + MAX_DATA + 1 /* RSSI */;
+
+        class Entry {
+        public:
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            Entry()
+                : _seen(0)
+                , _reported(0)
+                , _hash(0)
+                , _used(false)
+                , _dirty(false)
+            {
+            }
+            ~Entry() = default;
+
+        public:
+            bool IsUsed() const
+            {
+                return (_used);
+            }
+            bool IsDirty() const
+            {
+                return (_dirty);
+            }
+            bool Matches(const uint8_t report[]) const
+            {
+                return ((_used == true) && (::memcmp(_report, report, KEY_SIZE) == 0));
+            }
+            bool IsStale(const uint64_t now, const uint64_t window) const
+            {
+                return ((now - _seen) > window);
+            }
+            uint16_t Home() const
+            {
+                return (Slot(_report));
+            }
+            void Copy(uint8_t report[]) const
+            {
+                ::memcpy(report, _report, sizeof(_report));
+            }
+            // Returns true if the entry needs to be delivered.
+            bool Seen(const uint8_t report[], const uint8_t length, const uint32_t hash, const uint64_t now, const uint64_t window)
+            {
+                bool result = ((_dirty == false) && ((hash != _hash) || ((now - _reported) >= window)));
+
+                // Always keep the latest report, at least the RSSI changes all the time.
+                ::memcpy(_report, report, length);
+                _hash = hash;
+                _seen = now;
+
+                if (result == true) {
+                    _dirty = true;
+                }
+
+                return (result);
+            }
+            void Set(const uint8_t report[], const uint8_t length, const uint32_t hash, const uint64_t now)
+            {
+                ::memcpy(_report, report, length);
+                _hash = hash;
+                _seen = now;
+                _reported = 0;
+                _used = true;
+                _dirty = true;
+            }
+            void Delivered(const uint64_t now)
+            {
+                _reported = now;
+                _dirty = false;
+            }
+            void Move(Entry& from)
+            {
+                ::memcpy(_report, from._report, sizeof(_report));
+                _seen = from._seen;
+                _reported = from._reported;
+                _hash = from._hash;
+                _used = from._used;
+                _dirty = from._dirty;
+                from._used = false;
+                from._dirty = false;
+            }
+            void Clear()
+            {
+                _used = false;
+                _dirty = false;
+            }
+
+        private:
+            uint64_t _seen;
+            uint64_t _reported;
+            uint32_t _hash;
+            bool _used;
+            bool _dirty;
+            uint8_t _report[MAX_REPORT];
+        };
+
+        struct Report {
+            uint8_t Data[MAX_REPORT];
+        };
+
+    public:
+        struct Statistics {
+            uint32_t Received;
+            uint32_t Suppressed;
+            uint32_t Delivered;
+            uint32_t Overflow;
+        };
+
+    public:
+        AdvertisementFilter(const AdvertisementFilter&) = delete;
+        AdvertisementFilter& operator=(const AdvertisementFilter&) = delete;
+
+        // Window and interval in milliseconds. A window of 0 disables the filtering, every report is
+        // delivered as it comes in. Filtering is opt-in, by default nothing is filtered.
+        AdvertisementFilter(const uint32_t window = 0, const uint32_t interval = 250)
+            : _adminLock()
+            , _window(static_cast<uint64_t>(window) * Core::Time::TicksPerMillisecond)
+            , _interval(static_cast<uint64_t>(interval) * Core::Time::TicksPerMillisecond)
+            , _flushed(0)
+            , _count(0)
+            , _dirty(0)
+            , _statistics()
+        {
+            ::memset(&_statistics, 0, sizeof(_statistics));
+        }
+        ~AdvertisementFilter() = default;
+
+    public:
+        void Configure(const uint32_t window, const uint32_t interval)
+        {
+            _adminLock.Lock();
+
+            _window = static_cast<uint64_t>(window) * Core::Time::TicksPerMillisecond;
+            _interval = static_cast<uint64_t>(interval) * Core::Time::TicksPerMillisecond;
+
+            _adminLock.Unlock();
+        }
+        void Clear()
+        {
+            _adminLock.Lock();
+
+            for (uint16_t index = 0; index < CAPACITY; index++) {
+                _entries[index].Clear();
+            }
+            _count = 0;
+            _dirty = 0;
+
+            _adminLock.Unlock();
+        }
+        void Measure(Statistics& statistics) const
+        {
+            _adminLock.Lock();
+            statistics = _statistics;
+            _adminLock.Unlock();
+        }
+        // Milliseconds between two deliveries.
+        uint32_t Interval() const
+        {
+            return (static_cast<uint32_t>(_interval / Core::Time::TicksPerMillisecond));
+        }
+        uint16_t Advertisers() const
+        {
+            return (_count);
+        }
+        bool IsDue(const uint64_t now) const
+        {
+            return ((_dirty != 0) && ((now - _flushed) >= _interval));
+        }
+
+        // Takes in a single report, as it is in a EVT_LE_ADVERTISING_REPORT, followed by its RSSI.
+        // Returns true if the report could not be filtered and should be delivered as is.
+        bool Ingest(const uint8_t report[], const uint16_t length, const uint64_t now)
+        {
+            bool result = true;
+            const le_advertising_info* info = reinterpret_cast<const le_advertising_info*>(report);
+
+            _adminLock.Lock();
+
+            _statistics.Received++;
+
+            if ((_window != 0) && (length >= sizeof(le_advertising_info)) && (info->length <= MAX_DATA) && (length >= (sizeof(le_advertising_info) + info->length + 1))) {
+                const uint8_t size = static_cast<uint8_t>(sizeof(le_advertising_info) + info->length + 1);
+                const uint32_t hash = Hash(&(report[KEY_SIZE]), info->length + 1 /* length */);
+                uint16_t index = Find(report);
+
+                if (_entries[index].IsUsed() == true) {
+                    result = false;
+
+                    if (_entries[index].Seen(report, size, hash, now, _window) == true) {
+                        _dirty++;
+                    } else {
+                        _statistics.Suppressed++;
+                    }
+                } else {
+                    if (_count >= HIGH_WATER) {
+                        Purge(now);
+                        index = Find(report);
+                    }
+                    if (_count < HIGH_WATER) {
+                        result = false;
+                        _entries[index].Set(report, size, hash, now);
+                        _count++;
+                        _dirty++;
+                    } else {
+                        _statistics.Overflow++;
+                    }
+                }
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+        // Delivers all advertisers that changed since the last flush to the handler, a callable taking
+        // a const le_advertising_info&. The reports are collected under the lock, the handler is called
+        // after releasing it, so it is free to call back into the filter. Returns the number of
+        // advertisers delivered.
+        template <typename HANDLER>
+        uint16_t Flush(const uint64_t now, HANDLER&& handler)
+        {
+            std::vector<Report> reports;
+
+            _adminLock.Lock();
+
+            reports.reserve(_dirty);
+
+            for (uint16_t index = 0; (index < CAPACITY) && (_dirty != 0); index++) {
+                Entry& entry(_entries[index]);
+
+                if (entry.IsDirty() == true) {
+                    reports.emplace_back();
+                    entry.Copy(reports.back().Data);
+                    entry.Delivered(now);
+                    _dirty--;
+                }
+            }
+
+            _flushed = now;
+            _statistics.Delivered += static_cast<uint32_t>(reports.size());
+
+            _adminLock.Unlock();
+
+            for (const Report& report : reports) {
+                handler(*reinterpret_cast<const le_advertising_info*>(report.Data));
+            }
+
+            return (static_cast<uint16_t>(reports.size()));
+        }
+
+    private:
+        // FNV-1a
+        static uint32_t Hash(const uint8_t data[], const uint8_t length)
+        {
+            uint32_t result = 2166136261u;
+
+            for (uint8_t index = 0; index < length; index++) {
+                result = (result ^ data[index]) * 16777619u;
+            }
+
+            return (result);
+        }
+        static uint16_t Slot(const uint8_t report[])
+        {
+            return (static_cast<uint16_t>(Hash(report, KEY_SIZE) & (CAPACITY - 1)));
+        }
+        // The slot holding the advertiser, or the free slot where it belongs.
+        uint16_t Find(const uint8_t report[]) const
+        {
+            uint16_t index = Slot(report);
+
+            while ((_entries[index].IsUsed() == true) && (_entries[index].Matches(report) == false)) {
+                index = (index + 1) & (CAPACITY - 1);
+            }
+
+            return (index);
+        }
+        // Forget advertisers that were not seen within the window. Entries are removed by shifting
+        // back the ones that follow, so lookups never have to skip over holes.
+        void Purge(const uint64_t now)
+        {
+            for (uint16_t index = 0; index < CAPACITY; index++) {
+                while ((_entries[index].IsUsed() == true) && (_entries[index].IsDirty() == false) && (_entries[index].IsStale(now, _window) == true)) {
+                    Remove(index);
+                }
+            }
+        }
+        void Remove(uint16_t hole)
+        {
+            uint16_t index = hole;
+
+            _entries[hole].Clear();
+            _count--;
+
+            while (_entries[index = ((index + 1) & (CAPACITY - 1))].IsUsed() == true) {
+                uint16_t home = _entries[index].Home();
+
+                // Move it if its home is not cyclically in (hole, index]
+                if (((index > hole) && ((home <= hole) || (home > index))) || ((index < hole) && ((home <= hole) && (home > index)))) {
+                    _entries[hole].Move(_entries[index]);
+                    hole = index;
+                }
+            }
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        uint64_t _window;
+        uint64_t _interval;
+        uint64_t _flushed;
+        uint16_t _count;
+        uint16_t _dirty;
+        Statistics _statistics;
+        Entry _entries[CAPACITY];
+    };
+
+} // namespace Bluetooth
+
+} // namespace WPEFramework
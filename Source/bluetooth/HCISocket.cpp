@@ -132,16 +132,23 @@ void HCISocket::Scan(const uint16_t scanTime, const bool limited, const bool pas
 
                 _state.SetState(static_cast<state>(_state.GetState() | SCANNING));
 
-                // Now lets wait for the scanning period..
+                // Now lets wait for the scanning period, reporting what was collected in between.
                 _state.Unlock();
 
-                _state.WaitState(ABORT, scanTime * 1000);
+                const uint64_t end = Core::Time::Now().Add(scanTime * 1000).Ticks();
+                uint64_t now;
+
+                while (((now = Core::Time::Now().Ticks()) < end) && (_state.WaitState(ABORT, std::min(std::max(_advertisements.Interval(), 1u), static_cast<uint32_t>((end - now) / Core::Time::TicksPerMillisecond) + 1)) == false)) {
+                    Flush();
+                }
 
                 _state.Lock();
 
                 scanner->enable = 0;
                 Exchange(MAX_ACTION_TIMEOUT, scanner, scanner);
 
+                Flush();
+
                 _state.SetState(static_cast<state>(_state.GetState() & (~(ABORT | SCANNING))));
             }
         }
@@ -176,7 +183,14 @@ void HCISocket::Abort()
 
 /* virtual */ void HCISocket::StateChange() 
 {
-    Core::SynchronousChannelType<Core::SocketPort>::StateChange();
+    _adminLock.Lock();
+
+    // Whatever happened, the controller starts over with room for a single command.
+    _credits = 1;
+    Reevaluate();
+
+    _adminLock.Unlock();
+
     if (IsOpen() == true) {
         hci_filter_clear(&_filter);
 	hci_filter_set_ptype(HCI_EVENT_PKT, &_filter);
@@ -234,41 +248,378 @@ uint8_t HCISocket::Name(const le_advertising_info& info, string& name) const {
     return (type);
 }
 
-/* virtual */ uint16_t HCISocket::Deserialize(const uint8_t* dataFrame, const uint16_t availableData)
+void HCISocket::Send(const uint32_t waitTime, const Core::IOutbound& message, const Core::ProxyType<Core::IOutbound::ICallback>& callback, Core::IInbound* response)
+{
+    ASSERT(callback.IsValid() == true);
+
+    Expire();
+
+    _adminLock.Lock();
+
+    Pending* entry = Allocate(message, response, callback, Core::Time::Now().Add(waitTime).Ticks());
+    bool trigger = ((entry != nullptr) && (_credits > 0));
+
+    _adminLock.Unlock();
+
+    if (entry == nullptr) {
+        TRACE_L1("All %d command slots are in use, command rejected.", MAX_PENDING_COMMANDS);
+        callback->Updated(message, Core::ERROR_UNAVAILABLE);
+    } else if (trigger == true) {
+        Trigger();
+    }
+}
+
+uint32_t HCISocket::Submit(const uint32_t waitTime, const Core::IOutbound& message, Core::IInbound* response)
+{
+    uint32_t result = Core::ERROR_UNAVAILABLE;
+
+    Expire();
+
+    _adminLock.Lock();
+
+    Pending* entry = Allocate(message, response, Core::ProxyType<Core::IOutbound::ICallback>(), 0);
+
+    if (entry != nullptr) {
+        Core::Time now = Core::Time::Now();
+        Core::Time endTime = Core::Time(now).Add(waitTime);
+        bool trigger = (_credits > 0);
+
+        _adminLock.Unlock();
+
+        if (trigger == true) {
+            Trigger();
+        }
+
+        _adminLock.Lock();
+
+        while ((IsOpen() == true) && (entry->State() != Pending::COMPLETED) && (endTime > now)) {
+            uint32_t remainingTime = static_cast<uint32_t>((endTime.Ticks() - now.Ticks()) / Core::Time::TicksPerMillisecond);
+
+            _waitCount++;
+
+            _adminLock.Unlock();
+
+            _reevaluate.Lock(remainingTime);
+
+            _waitCount--;
+
+            _adminLock.Lock();
+
+            now = Core::Time::Now();
+        }
+
+        if (entry->State() == Pending::COMPLETED) {
+            result = entry->Result();
+        } else {
+            result = (IsOpen() == true ? Core::ERROR_TIMEDOUT : Core::ERROR_ASYNC_ABORTED);
+        }
+
+        entry->Clear();
+    } else {
+        TRACE_L1("All %d command slots are in use, command rejected.", MAX_PENDING_COMMANDS);
+    }
+
+    _adminLock.Unlock();
+
+    return (result);
+}
+
+void HCISocket::Revoke(const Core::IOutbound& message)
+{
+    bool found = false;
+
+    _adminLock.Lock();
+
+    for (uint8_t index = 0; (index < MAX_PENDING_COMMANDS) && (found == false); index++) {
+        Pending& entry(_pending[index]);
+
+        if ((entry.State() != Pending::FREE) && (entry.State() != Pending::COMPLETED) && (&(entry.Outbound()) == &message)) {
+            found = true;
+            Report(entry, Core::ERROR_ASYNC_ABORTED);
+        }
+    }
+
+    _adminLock.Unlock();
+}
+
+HCISocket::Pending* HCISocket::Allocate(const Core::IOutbound& message, Core::IInbound* response, const Core::ProxyType<Core::IOutbound::ICallback>& callback, const uint64_t expired)
+{
+    Pending* result = nullptr;
+
+    for (uint8_t index = 0; (index < MAX_PENDING_COMMANDS) && (result == nullptr); index++) {
+        if (_pending[index].State() == Pending::FREE) {
+            result = &(_pending[index]);
+        }
+    }
+
+    if (result != nullptr) {
+        message.Reload();
+        result->Set(message, response, callback, expired, _sequence++);
+    }
+
+    return (result);
+}
+
+// The oldest command in flight with the given opcode.
+HCISocket::Pending* HCISocket::Find(const uint16_t opcode)
+{
+    Pending* result = nullptr;
+
+    for (uint8_t index = 0; index < MAX_PENDING_COMMANDS; index++) {
+        Pending& entry(_pending[index]);
+
+        if ((entry.State() == Pending::SENT) && (entry.Opcode() == opcode) && ((result == nullptr) || (entry.IsOlder(*result) == true))) {
+            result = &entry;
+        }
+    }
+
+    return (result);
+}
+
+bool HCISocket::HasQueued() const
+{
+    uint8_t index = 0;
+
+    while ((index < MAX_PENDING_COMMANDS) && (_pending[index].State() != Pending::QUEUED)) {
+        index++;
+    }
+
+    return (index < MAX_PENDING_COMMANDS);
+}
+
+void HCISocket::Expire()
+{
+    const uint64_t now = Core::Time::Now().Ticks();
+
+    _adminLock.Lock();
+
+    for (uint8_t index = 0; index < MAX_PENDING_COMMANDS; index++) {
+        Pending& entry(_pending[index]);
+
+        if ((entry.State() != Pending::FREE) && (entry.IsExpired(now) == true)) {
+            Report(entry, Core::ERROR_TIMEDOUT);
+        }
+    }
+
+    _adminLock.Unlock();
+}
+
+// Called with the lock taken. A synchronous submitter is woken up to pick up the result, the
+// callback of an asynchronous command is called without holding the lock.
+void HCISocket::Report(Pending& entry, const uint32_t result)
+{
+    if (entry.IsSynchronous() == true) {
+        entry.Completed(result);
+        Reevaluate();
+    } else {
+        Core::ProxyType<Core::IOutbound::ICallback> callback(entry.Callback());
+        const Core::IOutbound& outbound(entry.Outbound());
+
+        entry.Clear();
+
+        _adminLock.Unlock();
+
+        callback->Updated(outbound, result);
+
+        _adminLock.Lock();
+    }
+}
+
+void HCISocket::Reevaluate()
+{
+    _reevaluate.SetEvent();
+
+    while (_waitCount.load() != 0) {
+        SleepMs(0);
+    }
+
+    _reevaluate.ResetEvent();
+}
+
+/* virtual */ uint16_t HCISocket::SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
 {
     uint16_t result = 0;
-    const hci_event_hdr* hdr = reinterpret_cast<const hci_event_hdr*>(&(dataFrame[1]));
 
-    // printf ("GENERAL RECEIVED: ");
-    // for (uint16_t loop = 0; loop < availableData; loop++) { printf("%02X:", dataFrame[loop]); } printf("\n");
+    Expire();
 
-    if ( (availableData > sizeof(hci_event_hdr)) && (availableData > (sizeof(hci_event_hdr) + hdr->plen)) ) {
-        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&(dataFrame[1 + sizeof(hci_event_hdr)]));
+    _adminLock.Lock();
 
-        result = 1 + sizeof(hci_event_hdr) + hdr->plen;
+    if (_credits > 0) {
+        Pending* entry = nullptr;
 
-        if ( (hdr->evt != EVT_LE_META_EVENT) || (reinterpret_cast<const evt_le_meta_event*>(ptr)->subevent != EVT_LE_ADVERTISING_REPORT) ) {
-            Update(*hdr);
+        for (uint8_t index = 0; index < MAX_PENDING_COMMANDS; index++) {
+            if ((_pending[index].State() == Pending::QUEUED) && ((entry == nullptr) || (_pending[index].IsOlder(*entry) == true))) {
+                entry = &(_pending[index]);
+            }
         }
-        else {
-            const uint8_t* segment = reinterpret_cast<const evt_le_meta_event*>(ptr)->data;
-            uint8_t  entries = segment[0];
-            segment++;
-
-            for (uint8_t loop = 0; loop < entries; loop++) {
-                const le_advertising_info* info = reinterpret_cast<const le_advertising_info*>(segment);
-                Update (*info);
-                segment = &(segment[info->length + sizeof(le_advertising_info)]);
+
+        if (entry != nullptr) {
+            // A command always fits in the send buffer, so it goes out in one go.
+            result = entry->Outbound().Serialize(dataFrame, maxSendSize);
+
+            ASSERT(result < maxSendSize);
+
+            _credits--;
+
+            entry->Sent(((result > 3) && (dataFrame[0] == HCI_COMMAND_PKT)) ? static_cast<uint16_t>(dataFrame[1] | (dataFrame[2] << 8)) : 0);
+
+            if (entry->State() == Pending::COMPLETED) {
+                Report(*entry, Core::ERROR_NONE);
             }
         }
     }
-    else {
-        TRACE_L1(_T("EVT_HCI: Message too short => (hci_event_hdr)")); 
+
+    _adminLock.Unlock();
+
+    return (result);
+}
+
+/* virtual */ uint16_t HCISocket::ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+{
+    uint16_t result = 0;
+
+    // printf ("GENERAL RECEIVED: ");
+    // for (uint16_t loop = 0; loop < availableData; loop++) { printf("%02X:", dataFrame[loop]); } printf("\n");
+
+    // Handle all complete packets: [type][event][length][payload]
+    while (((availableData - result) >= (1 + HCI_EVENT_HDR_SIZE)) && ((availableData - result) >= (1 + HCI_EVENT_HDR_SIZE + dataFrame[result + 2]))) {
+        const uint8_t* packet = &(dataFrame[result]);
+        const uint16_t length = 1 + HCI_EVENT_HDR_SIZE + packet[2];
+
+        if (packet[0] == HCI_EVENT_PKT) {
+            (this->*(Dispatcher::Instance().Handler(packet[1])))(packet, length);
+        }
+
+        result += length;
+    }
+
+    if (result == 0) {
+        TRACE_L1(_T("EVT_HCI: Message too short => (hci_event_hdr)"));
     }
 
     return (result);
 }
 
+void HCISocket::OnCommandComplete(const uint8_t packet[], const uint16_t length)
+{
+    if (length >= (1 + HCI_EVENT_HDR_SIZE + EVT_CMD_COMPLETE_SIZE)) {
+        const evt_cmd_complete* cc = reinterpret_cast<const evt_cmd_complete*>(&(packet[1 + HCI_EVENT_HDR_SIZE]));
+
+        Credited(cc->ncmd, btohs(cc->opcode), packet, length);
+    }
+}
+
+void HCISocket::OnCommandStatus(const uint8_t packet[], const uint16_t length)
+{
+    if (length >= (1 + HCI_EVENT_HDR_SIZE + EVT_CMD_STATUS_SIZE)) {
+        const evt_cmd_status* cs = reinterpret_cast<const evt_cmd_status*>(&(packet[1 + HCI_EVENT_HDR_SIZE]));
+
+        Credited(cs->ncmd, btohs(cs->opcode), packet, length);
+    }
+}
+
+void HCISocket::Credited(const uint8_t credits, const uint16_t opcode, const uint8_t packet[], const uint16_t length)
+{
+    bool consumed = false;
+
+    _adminLock.Lock();
+
+    _credits = credits;
+
+    Pending* entry = Find(opcode);
+
+    if (entry != nullptr) {
+        consumed = (entry->Inbound()->Deserialize(packet, length) != 0);
+
+        Core::IInbound::state state = entry->Inbound()->IsCompleted();
+
+        if (state == Core::IInbound::COMPLETED) {
+            Report(*entry, Core::ERROR_NONE);
+        } else if (state == Core::IInbound::RESEND) {
+            entry->Resend();
+        }
+    }
+
+    bool trigger = ((_credits > 0) && (HasQueued() == true));
+
+    _adminLock.Unlock();
+
+    if (consumed == false) {
+        Update(*reinterpret_cast<const hci_event_hdr*>(&(packet[1])));
+    }
+    if (trigger == true) {
+        Trigger();
+    }
+}
+
+void HCISocket::OnMetaEvent(const uint8_t packet[], const uint16_t length)
+{
+    const evt_le_meta_event* meta = reinterpret_cast<const evt_le_meta_event*>(&(packet[1 + HCI_EVENT_HDR_SIZE]));
+
+    if (length <= (1 + HCI_EVENT_HDR_SIZE + EVT_LE_META_EVENT_SIZE)) {
+        TRACE_L1(_T("EVT_LE_META_EVENT: Message too short"));
+    } else if (meta->subevent == EVT_LE_ADVERTISING_REPORT) {
+        // The bulk of the traffic while scanning, these never complete a command.
+        const uint8_t* end = &(packet[length]);
+        const uint8_t* segment = meta->data;
+        uint8_t entries = segment[0];
+        segment++;
+
+        const uint64_t now = Core::Time::Now().Ticks();
+
+        // Every report is followed by its RSSI. Repeated advertisements are filtered out here, the rest
+        // is reported in batches.
+        for (uint8_t loop = 0; (loop < entries) && ((segment + sizeof(le_advertising_info)) <= end); loop++) {
+            const le_advertising_info* info = reinterpret_cast<const le_advertising_info*>(segment);
+            const uint16_t size = sizeof(le_advertising_info) + info->length + 1;
+
+            if (((segment + size) <= end) && (_advertisements.Ingest(segment, size, now) == true)) {
+                Update(*info);
+            }
+            segment = &(segment[size]);
+        }
+
+        if (_advertisements.IsDue(now) == true) {
+            Flush();
+        }
+    } else {
+        bool consumed = false;
+
+        _adminLock.Lock();
+
+        // Subevents completing an LE command carry no opcode, offer them to the LE commands in flight.
+        for (uint8_t index = 0; (index < MAX_PENDING_COMMANDS) && (consumed == false); index++) {
+            Pending& entry(_pending[index]);
+
+            if ((entry.State() == Pending::SENT) && (((entry.Opcode() >> 10) & 0x3F) == OGF_LE_CTL)) {
+                consumed = (entry.Inbound()->Deserialize(packet, length) != 0);
+
+                if ((consumed == true) && (entry.Inbound()->IsCompleted() == Core::IInbound::COMPLETED)) {
+                    Report(entry, Core::ERROR_NONE);
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+
+        if (consumed == false) {
+            Update(*reinterpret_cast<const hci_event_hdr*>(&(packet[1])));
+        }
+    }
+}
+
+void HCISocket::Flush()
+{
+    _advertisements.Flush(Core::Time::Now().Ticks(), [this](const le_advertising_info& info) {
+        Update(info);
+    });
+}
+
+void HCISocket::OnEvent(const uint8_t packet[], const uint16_t)
+{
+    Update(*reinterpret_cast<const hci_event_hdr*>(&(packet[1])));
+}
+
 /* virtual */ void HCISocket::Update(const hci_event_hdr&)
 {
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Module.h"
+#include "AdvertisementFilter.h"
 
 namespace WPEFramework {
 
@@ -421,7 +422,13 @@ namespace Bluetooth {
     typedef KeyListType<SignatureKey> SignatureKeys;
 
 
-    class HCISocket : public Core::SynchronousChannelType<Core::SocketPort> {
+    // Rationale:
+    // The controller accepts as many commands as it has command buffers, it reports the number it
+    // can take (Num_HCI_Command_Packets) with every Command Status and Command Complete event. So
+    // instead of serializing command after command, commands are sent as long as there is credit,
+    // and the events that come back are matched against the commands in flight by opcode. All the
+    // bookkeeping lives in a fixed table, the event path does not allocate.
+    class HCISocket : public Core::SocketPort {
     private:
         static constexpr int      SCAN_TIMEOUT = 1000;
         static constexpr uint8_t  SCAN_TYPE = 0x01;
@@ -431,14 +438,12 @@ namespace Bluetooth {
         static constexpr uint8_t  EIR_NAME_COMPLETE = 0x09;
         static constexpr uint32_t MAX_ACTION_TIMEOUT = 2000; /* 2 Seconds for commands to complete ? */
         static constexpr uint16_t ACTION_MASK = 0x3FFF;
+        static constexpr uint8_t  MAX_PENDING_COMMANDS = 16;
 
     public:
 
         template<const uint16_t OPCODE, typename OUTBOUND, typename INBOUND, const uint8_t RESPONSECODE = ~0>
         class CommandType : public Core::IOutbound, public Core::IInbound {
-        private:
-            CommandType<OPCODE, OUTBOUND, INBOUND, RESPONSECODE>& operator=(const CommandType<OPCODE, OUTBOUND, INBOUND, RESPONSECODE>&) = delete;
-
         public:
             enum : uint16_t { ID = OPCODE };
 
@@ -461,6 +466,15 @@ namespace Bluetooth {
             {
             }
 
+            CommandType<OPCODE, OUTBOUND, INBOUND, RESPONSECODE>& operator=(const CommandType<OPCODE, OUTBOUND, INBOUND, RESPONSECODE>& rhs)
+            {
+                _offset = rhs._offset;
+                _error = ~0;
+                ::memcpy (_buffer, rhs._buffer, sizeof(_buffer));
+
+                return (*this);
+            }
+
         public:
             inline void Clear()
             {
@@ -707,18 +721,223 @@ namespace Bluetooth {
             ABORT       = 0x8000
         };
 
+    private:
+        // A command submitted to the controller, queued until there is credit to send it and, once
+        // sent, waiting for the event(s) that complete it.
+        class Pending {
+        public:
+            Pending(const Pending&) = delete;
+            Pending& operator=(const Pending&) = delete;
+
+            enum state : uint8_t {
+                FREE,
+                QUEUED,
+                SENT,
+                COMPLETED
+            };
+
+        public:
+            Pending()
+                : _outbound(nullptr)
+                , _inbound(nullptr)
+                , _callback()
+                , _expired(0)
+                , _sequence(0)
+                , _result(Core::ERROR_NONE)
+                , _opcode(0)
+                , _state(FREE)
+            {
+            }
+            ~Pending() = default;
+
+        public:
+            // Synchronous commands have no callback and no expiry, the submitter waits for them.
+            void Set(const Core::IOutbound& outbound, Core::IInbound* inbound, const Core::ProxyType<Core::IOutbound::ICallback>& callback, const uint64_t expired, const uint32_t sequence)
+            {
+                ASSERT(_state == FREE);
+
+                _outbound = &outbound;
+                _inbound = inbound;
+                _callback = callback;
+                _expired = expired;
+                _sequence = sequence;
+                _result = Core::ERROR_NONE;
+                _opcode = 0;
+                _state = QUEUED;
+            }
+            void Clear()
+            {
+                _outbound = nullptr;
+                _inbound = nullptr;
+                if (_callback.IsValid() == true) {
+                    _callback.Release();
+                }
+                _state = FREE;
+            }
+            state State() const
+            {
+                return (_state);
+            }
+            bool IsSynchronous() const
+            {
+                return (_expired == 0);
+            }
+            bool IsExpired(const uint64_t now) const
+            {
+                return ((_expired != 0) && (_expired < now));
+            }
+            bool IsOlder(const Pending& other) const
+            {
+                return (static_cast<int32_t>(_sequence - other._sequence) < 0);
+            }
+            const Core::IOutbound& Outbound() const
+            {
+                return (*_outbound);
+            }
+            Core::IInbound* Inbound()
+            {
+                return (_inbound);
+            }
+            uint16_t Opcode() const
+            {
+                return (_opcode);
+            }
+            uint32_t Result() const
+            {
+                return (_result);
+            }
+            Core::ProxyType<Core::IOutbound::ICallback> Callback() const
+            {
+                return (_callback);
+            }
+            void Sent(const uint16_t opcode)
+            {
+                _opcode = opcode;
+                _state = (_inbound == nullptr ? COMPLETED : SENT);
+            }
+            void Resend()
+            {
+                _outbound->Reload();
+                _state = QUEUED;
+            }
+            void Completed(const uint32_t result)
+            {
+                _result = result;
+                _state = COMPLETED;
+            }
+
+        private:
+            const Core::IOutbound* _outbound;
+            Core::IInbound* _inbound;
+            Core::ProxyType<Core::IOutbound::ICallback> _callback;
+            uint64_t _expired;
+            uint32_t _sequence;
+            uint32_t _result;
+            uint16_t _opcode;
+            state _state;
+        };
+
+        // The callback of an Execute, taken from a pool per command type, so a command in flight
+        // does not cost a heap allocation.
+        template <typename COMMAND>
+        class HandlerType : public Core::IOutbound::ICallback {
+        public:
+            HandlerType(const HandlerType<COMMAND>&) = delete;
+            HandlerType<COMMAND>& operator=(const HandlerType<COMMAND>&) = delete;
+
+            HandlerType()
+                : _cmd()
+                , _handler()
+            {
+            }
+            ~HandlerType() override
+            {
+            }
+
+        public:
+            void Set(const COMMAND& cmd, const std::function<void(COMMAND&, const uint32_t error)>& handler)
+            {
+                _cmd = cmd;
+                _handler = handler;
+            }
+            void Clear()
+            {
+                _handler = nullptr;
+            }
+            COMMAND& Cmd()
+            {
+                return (_cmd);
+            }
+            void Updated(const Core::IOutbound& data VARIABLE_IS_NOT_USED, const uint32_t error_code) override
+            {
+                ASSERT(&data == static_cast<const Core::IOutbound*>(&_cmd));
+
+                _handler(_cmd, error_code);
+            }
+
+        private:
+            COMMAND _cmd;
+            std::function<void(COMMAND&, const uint32_t error)> _handler;
+        };
+
+        typedef void (HCISocket::*EventHandler)(const uint8_t packet[], const uint16_t length);
+
+        // Event code indexed dispatch table, built once, shared by all sockets.
+        class Dispatcher {
+        public:
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher()
+            {
+                for (uint16_t index = 0; index < (sizeof(_handlers) / sizeof(EventHandler)); index++) {
+                    _handlers[index] = &HCISocket::OnEvent;
+                }
+                _handlers[EVT_CMD_COMPLETE] = &HCISocket::OnCommandComplete;
+                _handlers[EVT_CMD_STATUS] = &HCISocket::OnCommandStatus;
+                _handlers[EVT_LE_META_EVENT] = &HCISocket::OnMetaEvent;
+            }
+            ~Dispatcher() = default;
+
+        public:
+            static const Dispatcher& Instance()
+            {
+                static const Dispatcher dispatcher;
+                return (dispatcher);
+            }
+            EventHandler Handler(const uint8_t event) const
+            {
+                return (_handlers[event]);
+            }
+
+        private:
+            EventHandler _handlers[256];
+        };
+
     public:
         HCISocket(const HCISocket&) = delete;
         HCISocket& operator=(const HCISocket&) = delete;
 
         HCISocket()
-            : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::RAW, Core::NodeId(), Core::NodeId(), 1024, 1024)
+            : Core::SocketPort(SocketPort::RAW, Core::NodeId(), Core::NodeId(), 1024, 1024)
+            , _adminLock()
+            , _sequence(0)
+            , _credits(1)
+            , _reevaluate(false, true)
+            , _waitCount(0)
             , _state(IDLE)
+            , _advertisements()
         {
         }
         HCISocket(const Core::NodeId& sourceNode)
-            : Core::SynchronousChannelType<Core::SocketPort>(SocketPort::RAW, sourceNode, Core::NodeId(), 1024, 1024)
+            : Core::SocketPort(SocketPort::RAW, sourceNode, Core::NodeId(), 1024, 1024)
+            , _adminLock()
+            , _sequence(0)
+            , _credits(1)
+            , _reevaluate(false, true)
+            , _waitCount(0)
             , _state(IDLE)
+            , _advertisements()
         {
         }
         virtual ~HCISocket()
@@ -736,61 +955,86 @@ namespace Bluetooth {
             return ((_state & ADVERTISING) != 0);
         }
         uint32_t Advertising(const bool enable, const uint8_t mode = 0);
+        // Window in which an unchanged advertisement is reported only once and the minimum interval between
+        // two batches of reports, both in milliseconds. A window of 0, the default, reports every advertisement received.
+        void Filtering(const uint32_t window, const uint32_t interval)
+        {
+            _advertisements.Configure(window, interval);
+            _advertisements.Clear();
+        }
+        void Measure(AdvertisementFilter::Statistics& statistics) const
+        {
+            _advertisements.Measure(statistics);
+        }
         void Scan(const uint16_t scanTime, const uint32_t type, const uint8_t flags);
         void Scan(const uint16_t scanTime, const bool limited, const bool passive);
         void Abort();
         uint8_t Name(const le_advertising_info& info, string& name) const;
         uint32_t ReadStoredLinkKeys(const Address adr, const bool all, LinkKeys& keys);
 
+        uint32_t Exchange(const uint32_t waitTime, const Core::IOutbound& message)
+        {
+            return (Submit(waitTime, message, nullptr));
+        }
+        uint32_t Exchange(const uint32_t waitTime, const Core::IOutbound& message, Core::IInbound& response)
+        {
+            return (Submit(waitTime, message, &response));
+        }
+        void Revoke(const Core::IOutbound& message);
+
         template<typename COMMAND>
         void Execute(const uint32_t waitTime, const COMMAND& cmd, std::function<void(COMMAND&, const uint32_t error)> handler)
         {
-            class Handler : public Core::IOutbound::ICallback {
-            public:
-                Handler() = delete;
-                Handler(const Handler&) = delete;
-                Handler(const COMMAND& cmd, const std::function<void(COMMAND&, const uint32_t error)> handler) 
-                    : _cmd(cmd)
-                    , _handler(handler){
-                }
-                virtual ~Handler() {
-                }
+            static Core::ProxyPoolType< HandlerType<COMMAND> > handlers(2);
 
-            public:
-                COMMAND& Cmd() {
-                    return (_cmd);
-                }
-                void Updated(const Core::IOutbound& data, const uint32_t error_code) override {
-                    //ASSERT(_cmd == data);
-                    fprintf (stderr, "Just before with error: %d\n", error_code); fflush (stderr);
-                    _handler(_cmd, error_code);
-                    fprintf (stderr, "Just before with error: %d\n", error_code); fflush (stderr);
-                    delete this;
-                    fprintf (stderr, "Just before with error: %d\n", error_code); fflush (stderr);
-                }
+            Core::ProxyType< HandlerType<COMMAND> > entry(handlers.Element());
 
-            private:
-                COMMAND _cmd;
-                std::function<void(COMMAND&, const uint32_t error)> _handler;
-            };
-            Handler* entry = new Handler(cmd, handler);
+            entry->Set(cmd, handler);
 
-            Send(waitTime, entry->Cmd(), entry, &(entry->Cmd()));
+            Send(waitTime, entry->Cmd(), Core::ProxyType<Core::IOutbound::ICallback>(entry), &(entry->Cmd()));
         }
 
     protected:
+        void Send(const uint32_t waitTime, const Core::IOutbound& message, const Core::ProxyType<Core::IOutbound::ICallback>& callback, Core::IInbound* response);
+        int Handle() const
+        {
+            return (static_cast<const Core::IResource&>(*this).Descriptor());
+        }
+
         virtual void Update(const le_advertising_info& eventData);
         virtual void Update(const hci_event_hdr& eventData);
         virtual void Discovered(const bool lowEnergy, const Bluetooth::Address& address, const string& name);
 
     private:
         virtual void StateChange() override;
-        virtual uint16_t Deserialize(const uint8_t* dataFrame, const uint16_t availableData) override;
-        void SetOpcode(const uint16_t opcode);
+        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override;
+        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData) override;
+
+        uint32_t Submit(const uint32_t waitTime, const Core::IOutbound& message, Core::IInbound* response);
+        Pending* Allocate(const Core::IOutbound& message, Core::IInbound* response, const Core::ProxyType<Core::IOutbound::ICallback>& callback, const uint64_t expired);
+        Pending* Find(const uint16_t opcode);
+        bool HasQueued() const;
+        void Expire();
+        void Report(Pending& entry, const uint32_t result);
+        void Reevaluate();
+
+        void OnCommandComplete(const uint8_t packet[], const uint16_t length);
+        void OnCommandStatus(const uint8_t packet[], const uint16_t length);
+        void OnMetaEvent(const uint8_t packet[], const uint16_t length);
+        void OnEvent(const uint8_t packet[], const uint16_t length);
+        void Credited(const uint8_t credits, const uint16_t opcode, const uint8_t packet[], const uint16_t length);
+        void Flush();
 
     private:
+        Core::CriticalSection _adminLock;
+        Pending _pending[MAX_PENDING_COMMANDS];
+        uint32_t _sequence;
+        uint8_t _credits;
+        Core::Event _reevaluate;
+        std::atomic<uint32_t> _waitCount;
         Core::StateTrigger<state> _state;
         struct hci_filter _filter;
+        AdvertisementFilter _advertisements;
     };
 
     class ManagementSocket : public Core::SynchronousChannelType<Core::SocketPort> {
@@ -303,5 +303,207 @@ ENUM_CONVERSION_BEGIN(Bluetooth::Profile::Service::type)
 
 ENUM_CONVERSION_END(Bluetooth::Profile::Service::type)
 
+namespace Bluetooth {
+
+    // Stored attribute database, all values little endian:
+    //   "GATT", version, database hash [16], #services
+    //   per service:        uuid, handle, group end, #characteristics
+    //   per characteristic: uuid, value handle, rights, end, #descriptors
+    //   per descriptor:     uuid, handle
+    // where a uuid is its length (2 or 16) followed by its bytes.
+    static constexpr uint8_t CacheVersion = 1;
+    static const uint8_t CacheMagic[] = { 'G', 'A', 'T', 'T' };
+
+    static void Store(std::vector<uint8_t>& buffer, const uint8_t value)
+    {
+        buffer.push_back(value);
+    }
+    static void Store(std::vector<uint8_t>& buffer, const uint16_t value)
+    {
+        buffer.push_back(value & 0xFF);
+        buffer.push_back((value >> 8) & 0xFF);
+    }
+    static void Store(std::vector<uint8_t>& buffer, const UUID& id)
+    {
+        buffer.push_back(id.Length());
+        buffer.insert(buffer.end(), id.Data(), id.Data() + id.Length());
+    }
+
+    class CacheReader {
+    public:
+        CacheReader() = delete;
+        CacheReader(const CacheReader&) = delete;
+        CacheReader& operator=(const CacheReader&) = delete;
+
+        CacheReader(const uint8_t data[], const uint32_t length)
+            : _data(data)
+            , _length(length)
+            , _offset(0)
+        {
+        }
+        ~CacheReader() = default;
+
+    public:
+        bool IsValid() const
+        {
+            return (_offset <= _length);
+        }
+        bool IsComplete() const
+        {
+            return (_offset == _length);
+        }
+        const uint8_t* Bytes(const uint8_t count)
+        {
+            const uint8_t* result = ((_offset + count) <= _length ? &(_data[_offset]) : nullptr);
+            _offset += count;
+            return (result);
+        }
+        uint8_t Byte()
+        {
+            const uint8_t* data = Bytes(1);
+            return (data != nullptr ? data[0] : 0);
+        }
+        uint16_t Word()
+        {
+            const uint8_t* data = Bytes(2);
+            return (data != nullptr ? (data[0] | (data[1] << 8)) : 0);
+        }
+        UUID Id()
+        {
+            const uint8_t length = Byte();
+            const uint8_t* data = (((length == 2) || (length == 16)) ? Bytes(length) : nullptr);
+
+            if (data == nullptr) {
+                // Invalidate the rest of the read.
+                _offset = _length + 1;
+            }
+
+            return (data == nullptr ? UUID() : (length == 2 ? UUID(static_cast<uint16_t>(data[0] | (data[1] << 8))) : UUID(data)));
+        }
+
+    private:
+        const uint8_t* _data;
+        uint32_t _length;
+        uint32_t _offset;
+    };
+
+    uint32_t Profile::Save(const string& fileName) const
+    {
+        uint32_t result = Core::ERROR_WRITE_ERROR;
+        std::vector<uint8_t> buffer;
+
+        buffer.reserve(1024);
+        buffer.insert(buffer.end(), CacheMagic, CacheMagic + sizeof(CacheMagic));
+        Store(buffer, CacheVersion);
+        buffer.insert(buffer.end(), _hash, _hash + sizeof(_hash));
+        Store(buffer, static_cast<uint16_t>(_services.size()));
+
+        for (const Service& service : _services) {
+            Store(buffer, service.Type());
+            Store(buffer, service.Handle());
+            Store(buffer, service.Max());
+            Store(buffer, static_cast<uint16_t>(service._characteristics.size()));
+
+            for (const Service::Characteristic& characteristic : service._characteristics) {
+                Store(buffer, characteristic.Type());
+                Store(buffer, characteristic.Handle());
+                Store(buffer, characteristic.Rights());
+                Store(buffer, characteristic.Max());
+                Store(buffer, static_cast<uint16_t>(characteristic._descriptors.size()));
+
+                for (const Service::Characteristic::Descriptor& descriptor : characteristic._descriptors) {
+                    Store(buffer, descriptor.Type());
+                    Store(buffer, descriptor.Handle());
+                }
+            }
+        }
+
+        Core::File file(fileName);
+
+        if (file.Create() == true) {
+            if (file.Write(buffer.data(), static_cast<uint32_t>(buffer.size())) == buffer.size()) {
+                result = Core::ERROR_NONE;
+            }
+            file.Close();
+        }
+
+        if (result != Core::ERROR_NONE) {
+            TRACE_L1("Could not store the GATT database in %s", fileName.c_str());
+            file.Destroy();
+        }
+
+        return (result);
+    }
+
+    uint32_t Profile::Restore(const string& fileName)
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+        Core::File file(fileName);
+
+        _services.clear();
+
+        if ((file.Exists() == true) && (file.Open(true) == true)) {
+            std::vector<uint8_t> buffer(static_cast<size_t>(file.Size()));
+
+            if (file.Read(buffer.data(), static_cast<uint32_t>(buffer.size())) != buffer.size()) {
+                result = Core::ERROR_READ_ERROR;
+            }
+            else {
+                CacheReader reader(buffer.data(), static_cast<uint32_t>(buffer.size()));
+                const uint8_t* magic = reader.Bytes(sizeof(CacheMagic));
+
+                if ((magic == nullptr) || (::memcmp(magic, CacheMagic, sizeof(CacheMagic)) != 0) || (reader.Byte() != CacheVersion)) {
+                    result = Core::ERROR_INVALID_SIGNATURE;
+                }
+                else {
+                    const uint8_t* hash = reader.Bytes(sizeof(_hash));
+                    uint16_t services = reader.Word();
+
+                    while ((services-- != 0) && (reader.IsValid() == true)) {
+                        const UUID id(reader.Id());
+                        const uint16_t handle = reader.Word();
+                        const uint16_t group = reader.Word();
+                        uint16_t characteristics = reader.Word();
+
+                        _services.emplace_back(id, handle, group);
+                        Service& service(_services.back());
+
+                        while ((characteristics-- != 0) && (reader.IsValid() == true)) {
+                            const UUID type(reader.Id());
+                            const uint16_t value = reader.Word();
+                            const uint8_t rights = reader.Byte();
+                            const uint16_t end = reader.Word();
+                            uint16_t descriptors = reader.Word();
+
+                            service._characteristics.emplace_back(end, rights, value, type);
+                            Service::Characteristic& characteristic(service._characteristics.back());
+
+                            while ((descriptors-- != 0) && (reader.IsValid() == true)) {
+                                const UUID kind(reader.Id());
+                                characteristic._descriptors.emplace_back(reader.Word(), kind);
+                            }
+                        }
+                    }
+
+                    if ((reader.IsComplete() == false) || (hash == nullptr) || (_services.empty() == true)) {
+                        result = Core::ERROR_INVALID_INPUT_LENGTH;
+                    }
+                    else {
+                        ::memcpy(_hash, hash, sizeof(_hash));
+                        result = Core::ERROR_NONE;
+                    }
+                }
+            }
+        }
+
+        if (result != Core::ERROR_NONE) {
+            _services.clear();
+        }
+
+        return (result);
+    }
+
+} // namespace Bluetooth
+
 } // namespace WPEFramework
 
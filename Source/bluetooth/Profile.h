@@ -11,6 +11,7 @@ namespace Bluetooth {
     private:
         static constexpr uint16_t PRIMARY_SERVICE_UUID = 0x2800;
         static constexpr uint16_t CHARACTERISTICS_UUID = 0x2803;
+        static constexpr uint16_t DATABASE_HASH_UUID = 0x2B2A;
 
     public:
         class Service {
@@ -568,24 +569,48 @@ namespace Bluetooth {
             , _socket(nullptr)
             , _command()
             , _handler()
-            , _expired(0) {
+            , _expired(0)
+            , _storage()
+            , _cached(false)
+            , _hashed(false)
+            , _started(0) {
+            ::memset(_hash, 0, sizeof(_hash));
         }
         ~Profile() {
         }
 
     public:
         uint32_t Discover(const uint32_t waitTime, GATTSocket& socket, const Handler& handler) {
+            return (Discover(waitTime, socket, string(), handler));
+        }
+        // Discovery with the attribute database of the remote kept in the given file, typically stored per
+        // device next to its keys. If the database hash of the remote (GATT Caching) matches the stored one,
+        // services, characteristics and descriptors are taken from the file and only the values are read.
+        // Otherwise the database is discovered and stored again. Remotes without a database hash are never
+        // stored, as there is no way to tell whether their database changed.
+        uint32_t Discover(const uint32_t waitTime, GATTSocket& socket, const string& storage, const Handler& handler) {
             uint32_t result = Core::ERROR_INPROGRESS;
 
             _adminLock.Lock();
             if (_socket == nullptr) {
                 result = Core::ERROR_NONE;
                 _socket = &socket;
+                _started = Core::Time::Now().Ticks();
                 _expired = Core::Time::Now().Add(waitTime).Ticks();
                 _handler = handler;
                 _services.clear();
-                _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
-                _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                _storage = storage;
+                _cached = false;
+                _hashed = false;
+
+                if (_storage.empty() == true) {
+                    _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
+                    _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                }
+                else {
+                    _command.ReadByType(0x0001, 0xFFFF, UUID(DATABASE_HASH_UUID));
+                    _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnHash(cmd); });
+                }
             }
             _adminLock.Unlock();
 
@@ -597,6 +622,23 @@ namespace Bluetooth {
         bool IsValid() const {
             return ((_services.size() > 0) && (_expired == Core::ERROR_NONE));
         }
+        bool IsCached() const {
+            return (_cached);
+        }
+        // The stored attribute database, without the values of the characteristics.
+        uint32_t Load(const string& fileName) {
+            uint32_t result = Core::ERROR_INPROGRESS;
+
+            _adminLock.Lock();
+            if (_socket == nullptr) {
+                result = Restore(fileName);
+                _expired = (result == Core::ERROR_NONE ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+            }
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint32_t Save(const string& fileName) const;
         Iterator Services() const {
             return (Iterator(_services));
         }
@@ -639,7 +681,7 @@ namespace Bluetooth {
             _adminLock.Unlock();
 
             if (_socket != nullptr) {
-                if ((begin + 1) < end){
+                if ((_cached == false) && ((begin + 1) < end)) {
                     _command.FindInformation(begin+1, end);
                     _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnDescriptors(cmd); });
                 }
@@ -650,6 +692,56 @@ namespace Bluetooth {
             }
             _adminLock.Unlock();
         }
+        void LoadValues(uint32_t waitTime) {
+            // Time to start reading the attributes on the services!!
+            _index = _services.begin();
+
+            // If we get here, there must be services, otherwise we would have bailed out on OnServices!! 
+            ASSERT (_index != _services.end());
+
+            _characteristics = _index->Filler();
+
+            if (NextCharacteristic() == false) {
+                Report(Core::ERROR_NONE);
+            }
+            else {
+                LoadCharacteristics(waitTime);
+            }
+        }
+        void OnHash(const GATTSocket::Command& cmd) {
+            ASSERT (&cmd == &_command);
+
+            uint32_t waitTime = AvailableTime();
+
+            if (waitTime > 0) {
+                GATTSocket::Command::Response& response(_command.Result());
+
+                if ((cmd.Error() == Core::ERROR_NONE) && (response.Next() == true) && (response.Length() == sizeof(_hash))) {
+                    uint8_t hash[sizeof(_hash)];
+
+                    ::memcpy(hash, response.Data(), sizeof(hash));
+
+                    _cached = ((Restore(_storage) == Core::ERROR_NONE) && (::memcmp(hash, _hash, sizeof(_hash)) == 0));
+                    _hashed = true;
+
+                    ::memcpy(_hash, hash, sizeof(_hash));
+                }
+
+                if (_cached == true) {
+                    LoadValues(waitTime);
+                }
+                else {
+                    _services.clear();
+
+                    _adminLock.Lock();
+                    if (_socket != nullptr) {
+                        _command.ReadByGroupType(0x0001, 0xFFFF, UUID(PRIMARY_SERVICE_UUID));
+                        _socket->Execute(waitTime, _command, [&](const GATTSocket::Command& cmd) { OnServices(cmd); });
+                    }
+                    _adminLock.Unlock();
+                }
+            }
+        }
         void OnServices(const GATTSocket::Command& cmd) {
             ASSERT (&cmd == &_command);
 
@@ -719,21 +811,7 @@ namespace Bluetooth {
                         _adminLock.Unlock();
                     }
                     else {
-
-                        // Time to start reading the attributes on the services!!
-                        _index = _services.begin();
-
-                        // If we get here, there must be services, otherwise we would have bailed out on OnServices!! 
-                        ASSERT (_index != _services.end());
-
-                        _characteristics = _index->Filler();
-
-                        if (NextCharacteristic() == false) {
-                            Report(Core::ERROR_NONE);
-                        }
-                        else {
-                            LoadCharacteristics(waitTime);
-                       }
+                        LoadValues(waitTime);
                     }
                 }
             }
@@ -795,6 +873,12 @@ namespace Bluetooth {
                 _handler = nullptr;
                 _expired = result;
 
+                TRACE_L1("GATT database %s in %d ms", (_cached ? "restored" : "discovered"), static_cast<uint32_t>((Core::Time::Now().Ticks() - _started) / Core::Time::TicksPerMillisecond));
+
+                if ((result == Core::ERROR_NONE) && (_hashed == true) && (_cached == false)) {
+                    Save(_storage);
+                }
+
                 caller(result);
             }
             _adminLock.Unlock();
@@ -809,6 +893,8 @@ namespace Bluetooth {
             return (result);
         }
 
+        uint32_t Restore(const string& fileName);
+
     private:
         Core::CriticalSection _adminLock;
         std::list<Service> _services;
@@ -819,6 +905,11 @@ namespace Bluetooth {
         GATTSocket::Command _command;
         Handler _handler;
         uint64_t _expired;
+        string _storage;
+        bool _cached;
+        bool _hashed;
+        uint64_t _started;
+        uint8_t _hash[16];
     };
 
 } // namespace Bluetooth
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IDriver.h"
+#include "AdvertisementFilter.h"
 #include "HCISocket.h"
 #include "GATTSocket.h"
 #include "Profile.h"
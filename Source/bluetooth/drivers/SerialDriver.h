@@ -25,6 +25,112 @@ namespace Bluetooth {
 #define HCI_UART_NOKIA 10
 #define HCI_UART_MRVL 11
 
+    // H4 UART transport: a packet indicator followed by the HCI packet, which holds its own length.
+    class EXTERNAL H4Framing : public Core::SerialPort::IFraming {
+    private:
+        H4Framing(const H4Framing&) = delete;
+        H4Framing& operator=(const H4Framing&) = delete;
+
+    public:
+        enum indicator : uint8_t {
+            COMMAND = 0x01,
+            ACL = 0x02,
+            SCO = 0x03,
+            EVENT = 0x04,
+            ISO = 0x05
+        };
+
+    public:
+        H4Framing()
+        {
+        }
+        ~H4Framing() override
+        {
+        }
+
+    public:
+        uint16_t Frame(const uint8_t stream[], const uint16_t length, uint16_t& skip) const override
+        {
+            uint16_t header = 0;
+            uint16_t payload = 0;
+
+            skip = 0;
+
+            if (length > 0) {
+                switch (stream[0]) {
+                case COMMAND: // opcode (2), length (1)
+                case SCO: // handle (2), length (1)
+                    header = 4;
+                    payload = (length >= header ? stream[3] : 0);
+                    break;
+                case EVENT: // event code (1), length (1)
+                    header = 3;
+                    payload = (length >= header ? stream[2] : 0);
+                    break;
+                case ACL: // handle (2), length (2)
+                    header = 5;
+                    payload = (length >= header ? (stream[3] | (stream[4] << 8)) : 0);
+                    break;
+                case ISO: // handle (2), length (14 bits)
+                    header = 5;
+                    payload = (length >= header ? ((stream[3] | (stream[4] << 8)) & 0x3FFF) : 0);
+                    break;
+                default:
+                    // Not a packet indicator, we are out of sync. Drop it and try the next byte.
+                    skip = 1;
+                    break;
+                }
+            }
+
+            return ((header != 0) && (length >= header) && ((header + payload) <= length) ? (header + payload) : 0);
+        }
+    };
+
+    // H5 (three wire) UART transport: SLIP encoded packets between 0xC0 delimiters. The frames are handed
+    // over including both delimiters and still SLIP encoded.
+    class EXTERNAL H5Framing : public Core::SerialPort::IFraming {
+    private:
+        H5Framing(const H5Framing&) = delete;
+        H5Framing& operator=(const H5Framing&) = delete;
+
+    public:
+        static constexpr uint8_t Delimiter = 0xC0;
+
+    public:
+        H5Framing()
+        {
+        }
+        ~H5Framing() override
+        {
+        }
+
+    public:
+        uint16_t Frame(const uint8_t stream[], const uint16_t length, uint16_t& skip) const override
+        {
+            uint16_t result = 0;
+
+            skip = 0;
+
+            if (length > 0) {
+                if (stream[0] != Delimiter) {
+                    // Whatever comes before the first delimiter is the tail of a packet we missed.
+                    const uint8_t* start = static_cast<const uint8_t*>(::memchr(stream, Delimiter, length));
+                    skip = (start != nullptr ? static_cast<uint16_t>(start - stream) : length);
+                } else if (length > 1) {
+                    if (stream[1] == Delimiter) {
+                        // Back to back delimiters, the first one closed a packet we missed.
+                        skip = 1;
+                    } else {
+                        const uint8_t* end = static_cast<const uint8_t*>(::memchr(&(stream[1]), Delimiter, length - 1));
+                        result = (end != nullptr ? static_cast<uint16_t>(end - stream + 1) : 0);
+                    }
+                }
+            }
+
+            return (result);
+        }
+    };
+
     class EXTERNAL SerialDriver {
     private:
         SerialDriver() = delete;
@@ -328,6 +434,10 @@ namespace Bluetooth {
         };
 
     private:
+        static constexpr uint16_t SendBufferSize = 64;
+        // Large enough for a few maximum sized events (3 + 255 bytes) in one read.
+        static constexpr uint16_t ReceiveBufferSize = 1024;
+
         class Channel : public Core::MessageExchangeType<Core::SerialPort, Exchange> {
         private:
             Channel() = delete;
@@ -360,11 +470,16 @@ namespace Bluetooth {
         SerialDriver(const string& port, const uint32_t baudRate, const Core::SerialPort::FlowControl flowControl, const bool sendBreak)
             : _port(*this, port)
             , _flowControl(flowControl)
+            , _framing()
         {
+            // Hand over complete HCI packets only, and have them handed over as soon as they are in.
+            _port.Link().Framing(&_framing);
+            _port.Link().SetLowLatency(true);
+
             if (_port.Open(100) == Core::ERROR_NONE) {
 
                 ToTerminal();
-                _port.Link().Configuration(Convert(baudRate), flowControl, 64, 64);
+                _port.Link().Configuration(Convert(baudRate), flowControl, SendBufferSize, ReceiveBufferSize);
                 _port.Flush();
 
                 if (sendBreak == true) {
@@ -384,6 +499,7 @@ namespace Bluetooth {
                 ToTerminal();
                 _port.Close(Core::infinite);
             }
+            _port.Link().Framing(nullptr);
         }
 
     public:
@@ -417,7 +533,7 @@ namespace Bluetooth {
             if (_port.Open(100) == Core::ERROR_NONE) {
 
                 ToTerminal();
-                _port.Link().Configuration(Convert(baudRate), _flowControl, 64, 64);
+                _port.Link().Configuration(Convert(baudRate), _flowControl, SendBufferSize, ReceiveBufferSize);
                 _port.Flush();
             }
             else {
@@ -506,6 +622,7 @@ namespace Bluetooth {
     private:
         Channel _port;
         Core::SerialPort::FlowControl _flowControl;
+        H4Framing _framing;
     };
 }
 } // namespace WPEFramework::Bluetooth
@@ -102,6 +102,110 @@ namespace Broadcast {
         typename std::list<LISTOBJECT> _list;
     };
 
+    // Result store for the (P)SI parsers. Tables of different tuners are parsed in parallel, to avoid
+    // these parsers to serialize on a single lock, the store is split up in shards, each with its own
+    // lock. The shard is selected on the key of the object.
+    template <typename LISTOBJECT, const uint8_t SHARDS = 8>
+    class StoreType {
+    private:
+        StoreType(const StoreType<LISTOBJECT, SHARDS>&) = delete;
+        StoreType<LISTOBJECT, SHARDS>& operator=(const StoreType<LISTOBJECT, SHARDS>&) = delete;
+
+        typedef std::map<uint16_t, LISTOBJECT> Container;
+
+        class Shard {
+        private:
+            Shard(const Shard&) = delete;
+            Shard& operator=(const Shard&) = delete;
+
+        public:
+            Shard()
+                : _adminLock()
+                , _container()
+            {
+            }
+            ~Shard()
+            {
+            }
+
+        public:
+            void Set(const uint16_t key, const LISTOBJECT& object)
+            {
+                _adminLock.Lock();
+                _container[key] = object;
+                _adminLock.Unlock();
+            }
+            bool Get(const uint16_t key, LISTOBJECT& object) const
+            {
+                _adminLock.Lock();
+
+                typename Container::const_iterator index(_container.find(key));
+                bool found = (index != _container.end());
+
+                if (found == true) {
+                    object = index->second;
+                }
+
+                _adminLock.Unlock();
+
+                return (found);
+            }
+            void Collect(Container& container) const
+            {
+                _adminLock.Lock();
+                container.insert(_container.begin(), _container.end());
+                _adminLock.Unlock();
+            }
+            void Clear()
+            {
+                _adminLock.Lock();
+                _container.clear();
+                _adminLock.Unlock();
+            }
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            Container _container;
+        };
+
+    public:
+        StoreType()
+        {
+        }
+        ~StoreType()
+        {
+        }
+
+    public:
+        inline void Set(const uint16_t key, const LISTOBJECT& object)
+        {
+            _shards[key % SHARDS].Set(key, object);
+        }
+        inline bool Get(const uint16_t key, LISTOBJECT& object) const
+        {
+            return (_shards[key % SHARDS].Get(key, object));
+        }
+        void Clear()
+        {
+            for (uint8_t index = 0; index < SHARDS; index++) {
+                _shards[index].Clear();
+            }
+        }
+        IteratorType<LISTOBJECT> List() const
+        {
+            Container container;
+
+            for (uint8_t index = 0; index < SHARDS; index++) {
+                _shards[index].Collect(container);
+            }
+
+            return (IteratorType<LISTOBJECT>(container));
+        }
+
+    private:
+        Shard _shards[SHARDS];
+    };
+
     template <typename TYPE>
     TYPE ConvertBCD(const uint8_t buffer[], const uint8_t digits, const bool evenStart)
     {
@@ -76,6 +76,10 @@ namespace Broadcast {
             {
                 return (Core::DataElement(_section, Offset(), DataLength()));
             }
+            inline const uint8_t* Buffer() const
+            {
+                return (_section.Buffer());
+            }
             template <typename TYPE>
             TYPE GetNumber(const uint16_t offset) const
             {
@@ -167,17 +171,15 @@ namespace Broadcast {
 
                         addSection = (_tableId == section.TableId());
 
-                        if ((addSection == true) && (section.Version() != _version)) {
+                        // A table is identified by its TableId and its extension, a section of another
+                        // extension (or version) starts a new table.
+                        if ((addSection == true) && ((section.Version() != _version) || (section.Extension() != _extension))) {
                             // Give back all the elemts we do not use..
                             _sections.clear();
                             _data.Size(0);
                             _lastSectionNumber = section.LastSectionNumber();
                             _version = section.Version();
-
-                            if (_extension != section.Extension()) {
-                                printf("%s, %d -> Interesting the extensions differ\n",
-                                    __FUNCTION__, __LINE__);
-                            }
+                            _extension = section.Extension();
                         }
                     } else {
                         _tableId = section.TableId();
@@ -189,7 +191,9 @@ namespace Broadcast {
 
                     if (addSection == true) {
                         uint32_t offset = 0;
-                        uint32_t slotValue = (section.SectionNumber() << 16) | section.Length();
+                        const Core::DataElement data(section.Data());
+                        // The slots hold the length of the data, as that is what is stored.
+                        uint32_t slotValue = (section.SectionNumber() << 16) | static_cast<uint16_t>(data.Size());
 
                         std::list<uint32_t>::iterator index(_sections.begin());
 
@@ -198,23 +202,23 @@ namespace Broadcast {
                             uint8_t thisSection((*index >> 16) & 0xFF);
 
                             if (section.SectionNumber() == thisSection) {
-                                // Replace it..
-                                Insert(section.Data(), thisLength, offset);
-                                *index = slotValue;
+                                // The version did not change, so this is a repetition of a section
+                                // we already have, no need to copy it again..
                                 break;
                             } else if (section.SectionNumber() < thisSection) {
                                 // We need to extend the last part
-                                Insert(section.Data(), 0, offset);
+                                Insert(data, 0, offset);
                                 index = _sections.insert(index, slotValue);
                                 break;
                             }
                             offset += thisLength;
+                            index++;
                         }
 
                         if (index == _sections.end()) {
                             ASSERT(offset == _data.Size());
 
-                            Insert(section.Data(), 0, offset);
+                            Insert(data, 0, offset);
                             _sections.push_back(slotValue);
                         }
                     }
@@ -53,12 +53,14 @@ namespace Broadcast {
             Parser(const Parser&) = delete;
             Parser& operator=(const Parser&) = delete;
 
+            typedef std::map<uint16_t, MPEG::Table> Tables;
+
         public:
             Parser(Networks& parent, ITuner* source, const bool scan, const uint16_t pid)
                 : _parent(parent)
                 , _source(source)
                 , _actual(Core::ProxyType<Core::DataStore>::Create(512))
-                , _others(Core::ProxyType<Core::DataStore>::Create(512))
+                , _others()
                 , _pid(pid)
             {
                 if (scan == true) {
@@ -103,18 +105,34 @@ namespace Broadcast {
                         _parent.Load(DVB::NIT(_actual));
                     }
                 } else if (section.TableId() == DVB::NIT::OTHER) {
-                    _others.AddSection(section);
-                    if (_others.IsValid() == true) {
-                        _parent.Load(DVB::NIT(_others));
+                    MPEG::Table& table(Other(section.Extension()));
+
+                    table.AddSection(section);
+                    if (table.IsValid() == true) {
+                        _parent.Load(DVB::NIT(table));
                     }
                 }
             }
+            // The sections of the other tables are interleaved, each extension is a table of its own.
+            MPEG::Table& Other(const uint16_t extension)
+            {
+                Tables::iterator index(_others.find(extension));
+
+                if (index == _others.end()) {
+                    index = _others.emplace(std::piecewise_construct,
+                                       std::forward_as_tuple(extension),
+                                       std::forward_as_tuple(Core::ProxyType<Core::DataStore>::Create(512)))
+                                .first;
+                }
+
+                return (index->second);
+            }
 
         private:
             Networks& _parent;
             ITuner* _source;
             MPEG::Table _actual;
-            MPEG::Table _others;
+            Tables _others;
             uint16_t _pid;
         };
 
@@ -230,7 +248,7 @@ namespace Broadcast {
         typedef IteratorType<Network> Iterator;
 
     private:
-        typedef std::map<uint16_t, Network> NetworkMap;
+        typedef StoreType<Network> NetworkMap;
 
     public:
         Networks()
@@ -266,23 +284,13 @@ namespace Broadcast {
         {
             Network result;
 
-            _adminLock.Lock();
-            NetworkMap::const_iterator index(_networks.find(id));
-            if (index != _networks.end()) {
-                result = index->second;
-            }
-            _adminLock.Unlock();
+            _networks.Get(id, result);
 
             return (result);
         }
         Iterator List() const
         {
-
-            _adminLock.Lock();
-            Iterator value(_networks);
-            _adminLock.Unlock();
-
-            return (value);
+            return (_networks.List());
         }
 
     private:
@@ -322,15 +330,12 @@ namespace Broadcast {
         }
         void Load(const DVB::NIT& table)
         {
-            _adminLock.Lock();
-
+            // The store has its own locking, no need to hold the lock of the scanners while loading.
             DVB::NIT::NetworkIterator index = table.Networks();
 
             while (index.Next() == true) {
-                _networks[index.TransportStreamId()] = Network(index);
+                _networks.Set(index.TransportStreamId(), Network(index));
             }
-
-            _adminLock.Unlock();
         }
 
     private:
@@ -0,0 +1,353 @@
+#ifndef SCAN_SCHEDULER_H
+#define SCAN_SCHEDULER_H
+
+#include "Definitions.h"
+
+namespace WPEFramework {
+
+namespace Broadcast {
+
+    // The ScanScheduler distributes a band scan (a list of transponders) over all the tuners it is
+    // handed, that are IDLE at the start of the scan. Each tuner is tuned to the next transponder
+    // that has not been scanned yet and stays there for the dwell time, allowing the (P)SI parsers
+    // to collect the tables of that multiplex. If the tables are complete before that, the owner
+    // can move the tuner on through Collected(). The transponders are scanned in parallel, one per
+    // tuner, a transponder that can not be tuned to is reported and skipped.
+    class ScanScheduler {
+    public:
+        struct ICallback {
+            virtual ~ICallback() {}
+
+            // The tuner has been on the given frequency for the dwell time, or less if it was Collected().
+            virtual void Scanned(ITuner* tuner, const uint16_t frequency) = 0;
+
+            // The tuner could not be tuned to the given frequency, it is skipped.
+            virtual void Failed(ITuner* tuner, const uint16_t frequency) = 0;
+
+            // All transponders have been visited.
+            virtual void Completed() = 0;
+        };
+
+        class Transponder {
+        public:
+            Transponder()
+                : Frequency(0)
+                , Modulation(MODULATION_UNKNOWN)
+                , SymbolRate(0)
+                , FEC(FEC_INNER_UNKNOWN)
+                , Inversion(Auto)
+            {
+            }
+            Transponder(const uint16_t frequency, const Broadcast::Modulation modulation, const uint32_t symbolRate, const uint16_t fec, const SpectralInversion inversion)
+                : Frequency(frequency)
+                , Modulation(modulation)
+                , SymbolRate(symbolRate)
+                , FEC(fec)
+                , Inversion(inversion)
+            {
+            }
+            Transponder(const Transponder& copy)
+                : Frequency(copy.Frequency)
+                , Modulation(copy.Modulation)
+                , SymbolRate(copy.SymbolRate)
+                , FEC(copy.FEC)
+                , Inversion(copy.Inversion)
+            {
+            }
+            ~Transponder()
+            {
+            }
+
+            Transponder& operator=(const Transponder& rhs)
+            {
+                Frequency = rhs.Frequency;
+                Modulation = rhs.Modulation;
+                SymbolRate = rhs.SymbolRate;
+                FEC = rhs.FEC;
+                Inversion = rhs.Inversion;
+
+                return (*this);
+            }
+
+        public:
+            uint16_t Frequency;
+            Broadcast::Modulation Modulation;
+            uint32_t SymbolRate;
+            uint16_t FEC;
+            SpectralInversion Inversion;
+        };
+
+    private:
+        ScanScheduler() = delete;
+        ScanScheduler(const ScanScheduler&) = delete;
+        ScanScheduler& operator=(const ScanScheduler&) = delete;
+
+        class Dwell {
+        private:
+            Dwell() = delete;
+            Dwell& operator=(const Dwell&) = delete;
+
+        public:
+            Dwell(ScanScheduler* parent, ITuner* tuner, const uint16_t frequency)
+                : _parent(*parent)
+                , _tuner(tuner)
+                , _frequency(frequency)
+            {
+            }
+            Dwell(const Dwell& copy)
+                : _parent(copy._parent)
+                , _tuner(copy._tuner)
+                , _frequency(copy._frequency)
+            {
+            }
+            ~Dwell()
+            {
+            }
+
+            bool operator==(const Dwell& rhs) const
+            {
+                return (rhs._tuner == _tuner);
+            }
+            bool operator!=(const Dwell& rhs) const
+            {
+                return (!operator==(rhs));
+            }
+
+        public:
+            uint64_t Timed(const uint64_t /* scheduledTime */)
+            {
+                _parent.Next(_tuner, _frequency);
+
+                // The next dwell, if any, is scheduled by the parent.
+                return (0);
+            }
+
+        private:
+            ScanScheduler& _parent;
+            ITuner* _tuner;
+            uint16_t _frequency;
+        };
+
+        // Tuner with the frequency it is currently scanning, 0 if it has nothing to do anymore.
+        typedef std::map<ITuner*, uint16_t> Tuners;
+        typedef std::list<Transponder> Transponders;
+
+    public:
+        ScanScheduler(const uint32_t dwellTime, ICallback* callback)
+            : _adminLock()
+            , _dwellTime(dwellTime)
+            , _callback(callback)
+            , _tuners()
+            , _pending()
+            , _starting(false)
+            , _timer(Core::Thread::DefaultStackSize(), _T("ScanScheduler"))
+        {
+        }
+        ~ScanScheduler()
+        {
+            Stop();
+        }
+
+    public:
+        void Add(const Transponder& transponder)
+        {
+            _adminLock.Lock();
+            _pending.push_back(transponder);
+            _adminLock.Unlock();
+        }
+        bool IsScanning() const
+        {
+            _adminLock.Lock();
+            bool result = (_tuners.empty() == false);
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        // Start scanning on all tuners from the list that are currently IDLE.
+        uint32_t Start(const std::list<ITuner*>& tuners)
+        {
+            uint32_t result = Core::ERROR_INPROGRESS;
+
+            _adminLock.Lock();
+
+            if (_tuners.empty() == true) {
+
+                std::list<ITuner*>::const_iterator index(tuners.begin());
+
+                while (index != tuners.end()) {
+                    if ((*index)->State() == ITuner::IDLE) {
+                        _tuners.emplace(*index, 0);
+                    }
+                    index++;
+                }
+
+                result = (_tuners.empty() == true ? Core::ERROR_UNAVAILABLE : Core::ERROR_NONE);
+
+                // A tuner that is done, before all tuners got their first transponder, does not complete the scan.
+                _starting = (result == Core::ERROR_NONE);
+            }
+
+            _adminLock.Unlock();
+
+            if (result == Core::ERROR_NONE) {
+                std::list<ITuner*>::const_iterator index(tuners.begin());
+
+                while (index != tuners.end()) {
+                    _adminLock.Lock();
+                    bool ours = (_tuners.find(*index) != _tuners.end());
+                    _adminLock.Unlock();
+
+                    if (ours == true) {
+                        Tune(*index);
+                    }
+                    index++;
+                }
+
+                _adminLock.Lock();
+                _starting = false;
+                _adminLock.Unlock();
+
+                // Nothing to scan, or all transponders failed, this completes the scan already.
+                Evaluate();
+            }
+
+            return (result);
+        }
+        // The tables of the multiplex the tuner is on are complete, no need to wait for the rest of the dwell time.
+        void Collected(ITuner* tuner)
+        {
+            _adminLock.Lock();
+
+            Tuners::const_iterator index(_tuners.find(tuner));
+
+            if ((index != _tuners.end()) && (index->second != 0)) {
+                _timer.Trigger(Core::Time::Now().Ticks(), Dwell(this, tuner, index->second));
+            }
+
+            _adminLock.Unlock();
+        }
+        void Stop()
+        {
+            _adminLock.Lock();
+
+            Tuners::iterator index(_tuners.begin());
+
+            while (index != _tuners.end()) {
+                _timer.Revoke(Dwell(this, index->first, 0));
+                index++;
+            }
+
+            _tuners.clear();
+            _pending.clear();
+
+            _adminLock.Unlock();
+        }
+
+    private:
+        // Tune to the next transponder that can be tuned to, the tuner is done if there is none left.
+        void Tune(ITuner* tuner)
+        {
+            bool tune = true;
+
+            while (tune == true) {
+                Transponder transponder;
+
+                _adminLock.Lock();
+
+                Tuners::iterator index(_tuners.find(tuner));
+                tune = ((index != _tuners.end()) && (_pending.empty() == false));
+
+                if (tune == true) {
+                    transponder = _pending.front();
+                    _pending.pop_front();
+                    index->second = transponder.Frequency;
+                } else if (index != _tuners.end()) {
+                    index->second = 0;
+                }
+
+                _adminLock.Unlock();
+
+                if (tune == true) {
+                    if (tuner->Tune(transponder.Frequency, transponder.Modulation, transponder.SymbolRate, transponder.FEC, transponder.Inversion) == Core::ERROR_NONE) {
+
+                        _adminLock.Lock();
+
+                        // Unless the scan was stopped in the mean time, give it the dwell time to collect the tables.
+                        index = _tuners.find(tuner);
+
+                        if ((index != _tuners.end()) && (index->second == transponder.Frequency)) {
+                            _timer.Schedule(Core::Time::Now().Add(_dwellTime), Dwell(this, tuner, transponder.Frequency));
+                        }
+
+                        _adminLock.Unlock();
+
+                        tune = false;
+                    } else {
+                        TRACE_L1("Could not tune to %d MHz, skipping it.", transponder.Frequency);
+
+                        if (_callback != nullptr) {
+                            _callback->Failed(tuner, transponder.Frequency);
+                        }
+                    }
+                }
+            }
+        }
+        void Next(ITuner* tuner, const uint16_t frequency)
+        {
+            _adminLock.Lock();
+
+            Tuners::const_iterator index(_tuners.find(tuner));
+
+            // The dwell might have been ended early, on a frequency the tuner already left.
+            bool scanned = ((index != _tuners.end()) && (index->second == frequency));
+
+            _adminLock.Unlock();
+
+            if (scanned == true) {
+                if (_callback != nullptr) {
+                    _callback->Scanned(tuner, frequency);
+                }
+
+                Tune(tuner);
+
+                Evaluate();
+            }
+        }
+        // If none of the tuners is scanning anymore, we are done.
+        void Evaluate()
+        {
+            _adminLock.Lock();
+
+            bool completed = ((_tuners.empty() == false) && (_starting == false));
+            Tuners::const_iterator loop(_tuners.begin());
+
+            while ((completed == true) && (loop != _tuners.end())) {
+                completed = (loop->second == 0);
+                loop++;
+            }
+
+            if (completed == true) {
+                _tuners.clear();
+            }
+
+            _adminLock.Unlock();
+
+            if ((completed == true) && (_callback != nullptr)) {
+                _callback->Completed();
+            }
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        const uint32_t _dwellTime;
+        ICallback* _callback;
+        Tuners _tuners;
+        Transponders _pending;
+        bool _starting;
+        Core::TimerType<Dwell> _timer;
+    };
+
+} // namespace Broadcast
+} // namespace WPEFramework
+
+#endif // SCAN_SCHEDULER_H
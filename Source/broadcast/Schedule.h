@@ -181,9 +181,7 @@ namespace Broadcast {
         }
         void Load(const DVB::EIT& table)
         {
-            _adminLock.Lock();
-
-            _adminLock.Unlock();
+            // Called from the parse queue of the tuner, do not take the lock of the scanners here.
         }
 
     private:
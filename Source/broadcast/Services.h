@@ -52,12 +52,14 @@ namespace Broadcast {
             Parser(const Parser&) = delete;
             Parser& operator=(const Parser&) = delete;
 
+            typedef std::map<uint16_t, MPEG::Table> Tables;
+
         public:
             Parser(Services& parent, ITuner* source, const bool scan)
                 : _parent(parent)
                 , _source(source)
                 , _actual(Core::ProxyType<Core::DataStore>::Create(512))
-                , _others(Core::ProxyType<Core::DataStore>::Create(512))
+                , _others()
             {
                 if (scan == true) {
                     Scan(true);
@@ -101,18 +103,34 @@ namespace Broadcast {
                         _parent.Load(DVB::SDT(_actual));
                     }
                 } else if (section.TableId() == DVB::SDT::OTHER) {
-                    _others.AddSection(section);
-                    if (_others.IsValid() == true) {
-                        _parent.Load(DVB::SDT(_others));
+                    MPEG::Table& table(Other(section.Extension()));
+
+                    table.AddSection(section);
+                    if (table.IsValid() == true) {
+                        _parent.Load(DVB::SDT(table));
                     }
                 }
             }
+            // The sections of the other tables are interleaved, each extension is a table of its own.
+            MPEG::Table& Other(const uint16_t extension)
+            {
+                Tables::iterator index(_others.find(extension));
+
+                if (index == _others.end()) {
+                    index = _others.emplace(std::piecewise_construct,
+                                       std::forward_as_tuple(extension),
+                                       std::forward_as_tuple(Core::ProxyType<Core::DataStore>::Create(512)))
+                                .first;
+                }
+
+                return (index->second);
+            }
 
         private:
             Services& _parent;
             ITuner* _source;
             MPEG::Table _actual;
-            MPEG::Table _others;
+            Tables _others;
         };
 
         typedef std::list<Parser> Scanners;
@@ -196,7 +214,7 @@ namespace Broadcast {
         typedef IteratorType<Service> Iterator;
 
     private:
-        typedef std::map<uint16_t, Service> ServiceMap;
+        typedef StoreType<Service> ServiceMap;
 
     public:
         Services()
@@ -232,23 +250,13 @@ namespace Broadcast {
         {
             Service result;
 
-            _adminLock.Lock();
-            ServiceMap::const_iterator index(_services.find(id));
-            if (index != _services.end()) {
-                result = index->second;
-            }
-            _adminLock.Unlock();
+            _services.Get(id, result);
 
             return (result);
         }
         Iterator List() const
         {
-
-            _adminLock.Lock();
-            Iterator value(_services);
-            _adminLock.Unlock();
-
-            return (value);
+            return (_services.List());
         }
 
     private:
@@ -285,15 +293,12 @@ namespace Broadcast {
         }
         void Load(const DVB::SDT& table)
         {
-            _adminLock.Lock();
-
+            // The store has its own locking, no need to hold the lock of the scanners while loading.
             DVB::SDT::ServiceIterator index = table.Services();
 
             while (index.Next() == true) {
-                _services[index.ServiceId()] = Service(index);
+                _services.Set(index.ServiceId(), Service(index));
             }
-
-            _adminLock.Unlock();
         }
 
     private:
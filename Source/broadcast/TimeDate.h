@@ -113,6 +113,7 @@ namespace Broadcast {
             , _scanners()
             , _sink(*this)
             , _scan(true)
+            , _timeLock()
             , _time()
         {
             ITuner::Register(&_sink);
@@ -172,26 +173,21 @@ namespace Broadcast {
         }
         void Load(const DVB::TOT& table)
         {
-
-            _adminLock.Lock();
-
+            // Called from the parse queue of the tuner, do not take the lock of the scanners here.
             MPEG::DescriptorIterator index = table.Descriptors();
 
             while (index.Next() == true) {
             }
 
+            _timeLock.Lock();
             _time = table.Time();
-
-            _adminLock.Unlock();
+            _timeLock.Unlock();
         }
         void Load(const DVB::TDT& table)
         {
-
-            _adminLock.Lock();
-
+            _timeLock.Lock();
             _time = table.Time();
-
-            _adminLock.Unlock();
+            _timeLock.Unlock();
         }
 
     private:
@@ -199,6 +195,7 @@ namespace Broadcast {
         Scanners _scanners;
         Sink _sink;
         bool _scan;
+        mutable Core::CriticalSection _timeLock;
         Core::Time _time;
     };
 
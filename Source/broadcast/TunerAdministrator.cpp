@@ -4,6 +4,8 @@ namespace WPEFramework {
 
 namespace Broadcast {
 
+    /* static */ Core::ProxyPoolType<Core::DataStore> TunerAdministrator::ParseQueue::_storeFactory(16);
+
     /* static */ TunerAdministrator& TunerAdministrator::Instance()
     {
         static TunerAdministrator _instance;
@@ -24,6 +24,362 @@ namespace Broadcast {
             virtual void StateChange(ITuner* tuner) = 0;
         };
 
+        // Sections that passed the filter are copied in to a queue, one per tuner, and parsed on the WorkerPool.
+        // Sections of one tuner are parsed in the order they arrived, sections of different tuners are parsed
+        // in parallel. Without a WorkerPool (e.g. test applications) the sections are parsed on the thread that
+        // delivered them.
+        class ParseQueue : public Core::IDispatch {
+        private:
+            ParseQueue(const ParseQueue&) = delete;
+            ParseQueue& operator=(const ParseQueue&) = delete;
+
+            class Entry {
+            public:
+                Entry() = delete;
+                Entry& operator=(const Entry&) = delete;
+
+                Entry(ISection* callback, const Core::ProxyType<Core::DataStore>& data, const uint16_t length)
+                    : _callback(callback)
+                    , _data(data)
+                    , _length(length)
+                {
+                }
+                Entry(const Entry& copy)
+                    : _callback(copy._callback)
+                    , _data(copy._data)
+                    , _length(copy._length)
+                {
+                }
+                ~Entry()
+                {
+                }
+
+            public:
+                inline ISection* Callback() const
+                {
+                    return (_callback);
+                }
+                inline MPEG::Section Section() const
+                {
+                    return (MPEG::Section(Core::DataElement(_data, 0, _length)));
+                }
+
+            private:
+                ISection* _callback;
+                Core::ProxyType<Core::DataStore> _data;
+                uint16_t _length;
+            };
+
+            typedef std::list<Entry> Entries;
+
+        public:
+            ParseQueue()
+                : _adminLock()
+                , _entries()
+                , _submitted(false)
+                , _enabled(true)
+                , _current(nullptr)
+                , _revoking(nullptr)
+                , _handler(0)
+                , _revoked(false, true)
+            {
+            }
+            virtual ~ParseQueue()
+            {
+                ASSERT(_entries.empty() == true);
+            }
+
+        public:
+            void Post(ISection* callback, const MPEG::Section& section)
+            {
+                Core::ProxyType<Core::DataStore> data(_storeFactory.Element());
+
+                data->Size(section.Length());
+                data->Copy(section.Buffer(), section.Length());
+
+                _adminLock.Lock();
+
+                bool submit = false;
+
+                if (_enabled == true) {
+                    _entries.emplace_back(callback, data, section.Length());
+
+                    if (_submitted == false) {
+                        _submitted = true;
+                        submit = true;
+                    }
+                }
+
+                _adminLock.Unlock();
+
+                if (submit == true) {
+                    Core::WorkerPool::Instance().Submit(Core::ProxyType<Core::IDispatch>(*this));
+                }
+            }
+            // Drop all pending sections for this callback. If the callback is currently handling a section
+            // (on another thread), wait for it to complete, after this call the callback can be destructed.
+            void Revoke(ISection* callback)
+            {
+                _adminLock.Lock();
+
+                Entries::iterator index(_entries.begin());
+                while (index != _entries.end()) {
+                    if (index->Callback() == callback) {
+                        index = _entries.erase(index);
+                    } else {
+                        index++;
+                    }
+                }
+
+                if ((_current == callback) && (_handler != Core::Thread::ThreadId())) {
+                    _revoking = callback;
+                    _revoked.ResetEvent();
+                    _adminLock.Unlock();
+
+                    _revoked.Lock(Core::infinite);
+                } else {
+                    _adminLock.Unlock();
+                }
+            }
+            // The tuner is gone, no more sections will be accepted.
+            void Flush()
+            {
+                _adminLock.Lock();
+
+                _enabled = false;
+                _entries.clear();
+
+                if (_submitted == true) {
+                    _adminLock.Unlock();
+                    if (Core::WorkerPool::Instance().Revoke(Core::ProxyType<Core::IDispatch>(*this)) == Core::ERROR_NONE) {
+                        _adminLock.Lock();
+                        _submitted = false;
+                        _adminLock.Unlock();
+                    }
+                } else {
+                    _adminLock.Unlock();
+                }
+            }
+            uint32_t Pending() const
+            {
+                _adminLock.Lock();
+                uint32_t result = static_cast<uint32_t>(_entries.size());
+                _adminLock.Unlock();
+
+                return (result);
+            }
+
+            virtual void Dispatch() override
+            {
+                _adminLock.Lock();
+
+                _handler = Core::Thread::ThreadId();
+
+                while (_entries.empty() == false) {
+                    Entry entry(_entries.front());
+                    _entries.pop_front();
+                    _current = entry.Callback();
+
+                    _adminLock.Unlock();
+
+                    entry.Callback()->Handle(entry.Section());
+
+                    _adminLock.Lock();
+
+                    if (_revoking == _current) {
+                        _revoking = nullptr;
+                        _revoked.SetEvent();
+                    }
+                    _current = nullptr;
+                }
+
+                _handler = 0;
+                _submitted = false;
+
+                _adminLock.Unlock();
+            }
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            Entries _entries;
+            bool _submitted;
+            bool _enabled;
+            ISection* _current;
+            ISection* _revoking;
+            ::ThreadId _handler;
+            Core::Event _revoked;
+
+            static Core::ProxyPoolType<Core::DataStore> _storeFactory;
+        };
+
+        // Per PID section filter. A tuner implementation puts this in front of the ISection callback it has
+        // been handed for a PID. Sections are repeated continuously in a transport stream, so once a section
+        // for a (TableId, Extension, Version, SectionNumber) has been offered to the callback, the same
+        // section is dropped until the version (or current/next indicator) of that table changes. This keeps
+        // the table reassembly and parsing out of the loop as long as the multiplex does not change.
+        // Every section is offered only once, so a callback should keep a table per extension, the sections
+        // of different extensions (e.g. the SDT of other transport streams) are interleaved.
+        // The extension alone does not identify a table of another multiplex: the EIT is keyed on the
+        // service_id, the SDT on the transport_stream_id, which are only unique within an original network.
+        // For these the transport_stream_id and original_network_id at the start of the payload are part
+        // of the key as well.
+        class SectionFilter : public ISection {
+        private:
+            SectionFilter(const SectionFilter&) = delete;
+            SectionFilter& operator=(const SectionFilter&) = delete;
+
+            class Entry {
+            public:
+                Entry()
+                    : _version(~0)
+                {
+                    ::memset(_received, 0, sizeof(_received));
+                }
+                ~Entry()
+                {
+                }
+
+            public:
+                // Returns true if this section was not yet seen for the current version of the table.
+                bool Update(const uint8_t version, const uint8_t sectionNumber)
+                {
+                    if (version != _version) {
+                        _version = version;
+                        ::memset(_received, 0, sizeof(_received));
+                    }
+
+                    uint32_t& slot(_received[sectionNumber >> 5]);
+                    const uint32_t mask(1u << (sectionNumber & 0x1F));
+
+                    bool result = ((slot & mask) == 0);
+
+                    slot |= mask;
+
+                    return (result);
+                }
+
+            private:
+                uint16_t _version;
+                uint32_t _received[256 / 32];
+            };
+
+            typedef std::map<uint64_t, Entry> Entries;
+
+        public:
+            SectionFilter(ITuner* tuner = nullptr)
+                : _adminLock()
+                , _tuner(tuner)
+                , _callback(nullptr)
+                , _entries()
+                , _queue()
+                , _dropped(0)
+            {
+            }
+            virtual ~SectionFilter()
+            {
+                Callback(nullptr);
+            }
+
+        public:
+            // Install a (new) callback. All the knowledge on already seen sections is dropped, so the new
+            // callback will receive a full table again.
+            void Callback(ISection* callback)
+            {
+                _adminLock.Lock();
+
+                ISection* previous = _callback;
+
+                _callback = callback;
+                _entries.clear();
+                _dropped = 0;
+
+                if ((callback != nullptr) && (_tuner != nullptr) && (_queue.IsValid() == false)) {
+                    _queue = TunerAdministrator::Instance().Queue(_tuner);
+                }
+
+                Core::ProxyType<ParseQueue> queue(_queue);
+
+                _adminLock.Unlock();
+
+                // Make sure the previous callback does not receive any queued sections anymore.
+                if ((previous != nullptr) && (previous != callback) && (queue.IsValid() == true)) {
+                    queue->Revoke(previous);
+                }
+            }
+            ISection* Callback() const
+            {
+                return (_callback);
+            }
+            void Reset()
+            {
+                _adminLock.Lock();
+                _entries.clear();
+                _adminLock.Unlock();
+            }
+            uint32_t Dropped() const
+            {
+                return (_dropped);
+            }
+
+            virtual void Handle(const MPEG::Section& section) override
+            {
+                _adminLock.Lock();
+
+                if (_callback != nullptr) {
+                    // Sections without section syntax (TDT/TOT) carry no version, they are always new...
+                    bool changed = (section.HasSectionSyntax() == false);
+
+                    if (changed == false) {
+                        // The current/next indicator is folded into the version.
+                        const uint8_t version((section.Version() << 1) | (section.IsCurrent() ? 0x01 : 0x00));
+
+                        changed = _entries[Key(section)].Update(version, section.SectionNumber());
+                    }
+
+                    if (changed == false) {
+                        _dropped++;
+                    } else if (_queue.IsValid() == true) {
+                        _queue->Post(_callback, section);
+                    } else {
+                        _callback->Handle(section);
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+
+        private:
+            // Key: TableId(8)/Extension(16)/TransportStreamId(16)/OriginalNetworkId(16)
+            static uint64_t Key(const MPEG::Section& section)
+            {
+                const uint8_t tableId(section.TableId());
+                const uint32_t length(section.Data().Size());
+                uint64_t result((static_cast<uint64_t>(tableId) << 48) | (static_cast<uint64_t>(section.Extension()) << 32));
+
+                if ((tableId >= 0x4E) && (tableId <= 0x6F)) {
+                    // EIT, Extension: service_id, followed by transport_stream_id and original_network_id.
+                    if (length >= 4) {
+                        result |= (static_cast<uint64_t>(section.GetNumber<uint16_t>(8)) << 16) | section.GetNumber<uint16_t>(10);
+                    }
+                } else if ((tableId == 0x42) || (tableId == 0x46)) {
+                    // SDT, Extension: transport_stream_id already, followed by original_network_id.
+                    if (length >= 2) {
+                        result |= section.GetNumber<uint16_t>(8);
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            ITuner* _tuner;
+            ISection* _callback;
+            Entries _entries;
+            Core::ProxyType<ParseQueue> _queue;
+            uint32_t _dropped;
+        };
+
     private:
         TunerAdministrator(const TunerAdministrator&) = delete;
         TunerAdministrator& operator=(const TunerAdministrator&) = delete;
@@ -58,11 +414,13 @@ namespace Broadcast {
             , _sink(*this)
             , _observers()
             , _tuners()
+            , _queues()
         {
         }
 
         typedef std::list<ITuner::INotification*> Observers;
         typedef std::list<ITuner*> Tuners;
+        typedef std::map<const ITuner*, Core::ProxyType<ParseQueue>> Queues;
 
     public:
         static TunerAdministrator& Instance();
@@ -113,10 +471,34 @@ namespace Broadcast {
 
             _tuners.push_back(tuner);
 
+            if (Core::WorkerPool::IsAvailable() == true) {
+                _queues.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(tuner),
+                    std::forward_as_tuple(Core::ProxyType<ParseQueue>::Create()));
+            }
+
             _adminLock.Unlock();
 
             return (&_sink);
         }
+        // Get the parse queue associated with this tuner. If there is no WorkerPool to parse on, the
+        // returned queue is not valid and the sections should be parsed on the calling thread.
+        Core::ProxyType<ParseQueue> Queue(const ITuner* tuner) const
+        {
+            Core::ProxyType<ParseQueue> result;
+
+            _adminLock.Lock();
+
+            Queues::const_iterator index(_queues.find(tuner));
+
+            if (index != _queues.end()) {
+                result = index->second;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
         void Revoke(ITuner* tuner)
         {
             _adminLock.Lock();
@@ -135,6 +517,13 @@ namespace Broadcast {
                     (*index)->Deactivated(tuner);
                     index++;
                 }
+
+                Queues::iterator queue(_queues.find(tuner));
+
+                if (queue != _queues.end()) {
+                    queue->second->Flush();
+                    _queues.erase(queue);
+                }
             }
 
             _adminLock.Unlock();
@@ -161,10 +550,11 @@ namespace Broadcast {
         }
 
     private:
-        Core::CriticalSection _adminLock;
+        mutable Core::CriticalSection _adminLock;
         Sink _sink;
         Observers _observers;
         Tuners _tuners;
+        Queues _queues;
     };
 
 } // namespace Broadcast
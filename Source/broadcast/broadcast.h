@@ -12,6 +12,7 @@
 #include "Networks.h"
 #include "ProgramTable.h"
 #include "SDT.h"
+#include "ScanScheduler.h"
 #include "Services.h"
 #include "TDT.h"
 #include "TimeDate.h"
@@ -0,0 +1,901 @@
+#include "Definitions.h"
+#include "ProgramTable.h"
+#include "TunerAdministrator.h"
+
+// --------------------------------------------------------------------
+// Stub tuner, no hardware required. Tuning to a frequency "locks" on a
+// recorded transport stream, <path>/<frequency>.ts, which is replayed
+// (optionally in a loop, memory mapped and/or at the recorded pace) and
+// demultiplexed in software. Intended to benchmark the SI/PSI parsing
+// and to run the broadcast stack on boxes without a frontend, e.g.:
+//   { "frontends":2, "path":"/captures", "mapped":true, "realtime":false }
+// --------------------------------------------------------------------
+namespace WPEFramework {
+namespace Broadcast {
+
+    static constexpr uint8_t TS_SYNC_BYTE = 0x47;
+    static constexpr uint8_t TS_PACKET_SIZE = 188;
+    static constexpr uint16_t MAX_SECTION_SIZE = 4096;
+    static constexpr uint16_t NO_PID = 0xFFFF;
+
+    class __attribute__((visibility("hidden"))) Tuner : public ITuner {
+    private:
+        Tuner() = delete;
+        Tuner(const Tuner&) = delete;
+        Tuner& operator=(const Tuner&) = delete;
+
+    public:
+        class Information {
+        private:
+            Information(const Information&) = delete;
+            Information& operator=(const Information&) = delete;
+
+        private:
+            class Config : public Core::JSON::Container {
+            private:
+                Config(const Config&);
+                Config& operator=(const Config&);
+
+            public:
+                Config()
+                    : Core::JSON::Container()
+                    , Frontends(1)
+                    , Standard(ITuner::DVB)
+                    , Annex(ITuner::A)
+                    , Modus(ITuner::Terrestrial)
+                    , Path(_T("/tmp"))
+                    , Mapped(false)
+                    , RealTime(false)
+                    , Loop(true)
+                {
+                    Add(_T("frontends"), &Frontends);
+                    Add(_T("standard"), &Standard);
+                    Add(_T("annex"), &Annex);
+                    Add(_T("modus"), &Modus);
+                    Add(_T("path"), &Path);
+                    Add(_T("mapped"), &Mapped);
+                    Add(_T("realtime"), &RealTime);
+                    Add(_T("loop"), &Loop);
+                }
+                ~Config()
+                {
+                }
+
+            public:
+                Core::JSON::DecUInt8 Frontends;
+                Core::JSON::EnumType<ITuner::DTVStandard> Standard;
+                Core::JSON::EnumType<ITuner::annex> Annex;
+                Core::JSON::EnumType<ITuner::modus> Modus;
+                Core::JSON::String Path;
+                Core::JSON::Boolean Mapped;
+                Core::JSON::Boolean RealTime;
+                Core::JSON::Boolean Loop;
+            };
+
+            Information()
+                : _frontends(0)
+                , _standard(ITuner::DVB)
+                , _annex(ITuner::A)
+                , _modus(ITuner::Terrestrial)
+                , _path()
+                , _mapped(false)
+                , _realtime(false)
+                , _loop(true)
+            {
+            }
+
+        public:
+            static Information& Instance()
+            {
+                return (_instance);
+            }
+            ~Information()
+            {
+            }
+            void Initialize(const string& configuration)
+            {
+                Config config;
+                config.FromString(configuration);
+
+                _frontends = config.Frontends.Value();
+                _standard = config.Standard.Value();
+                _annex = config.Annex.Value();
+                _modus = config.Modus.Value();
+                _path = Core::Directory::Normalize(config.Path.Value());
+                _mapped = config.Mapped.Value();
+                _realtime = config.RealTime.Value();
+                _loop = config.Loop.Value();
+            }
+            void Deinitialize()
+            {
+            }
+
+        public:
+            inline uint8_t Frontends() const
+            {
+                return (_frontends);
+            }
+            inline ITuner::DTVStandard Standard() const
+            {
+                return (_standard);
+            }
+            inline ITuner::annex Annex() const
+            {
+                return (_annex);
+            }
+            inline ITuner::modus Modus() const
+            {
+                return (_modus);
+            }
+            // Memory map the capture, instead of reading it in chunks.
+            inline bool Mapped() const
+            {
+                return (_mapped);
+            }
+            // Offer the packets at the pace they were recorded at (PCR), instead of as fast as possible.
+            inline bool RealTime() const
+            {
+                return (_realtime);
+            }
+            // Start again at the beginning of the capture once the end is reached.
+            inline bool Loop() const
+            {
+                return (_loop);
+            }
+            inline string Capture(const uint16_t frequency) const
+            {
+                return (_path + Core::NumberType<uint16_t>(frequency).Text() + _T(".ts"));
+            }
+
+        private:
+            uint8_t _frontends;
+            ITuner::DTVStandard _standard;
+            ITuner::annex _annex;
+            ITuner::modus _modus;
+            string _path;
+            bool _mapped;
+            bool _realtime;
+            bool _loop;
+
+            static Information _instance;
+        };
+
+    private:
+        // Reassembles the sections of one PID from the transport stream packets.
+        class Assembler {
+        private:
+            Assembler(const Assembler&) = delete;
+            Assembler& operator=(const Assembler&) = delete;
+
+        public:
+            Assembler()
+                : _size(0)
+                , _synced(false)
+            {
+            }
+            ~Assembler()
+            {
+            }
+
+        public:
+            void Payload(Tuner& parent, const uint16_t pid, const uint8_t data[], const uint8_t length, const bool start)
+            {
+                if (start == true) {
+                    uint8_t pointer = data[0];
+
+                    if ((pointer + 1) < length) {
+                        if (_synced == true) {
+                            // Finish the section that was still in progress..
+                            Append(data + 1, pointer);
+                            Sections(parent, pid);
+                        }
+                        _size = 0;
+                        _synced = true;
+                        Append(data + 1 + pointer, length - 1 - pointer);
+                        Sections(parent, pid);
+                    } else {
+                        _size = 0;
+                        _synced = false;
+                    }
+                } else if (_synced == true) {
+                    Append(data, length);
+                    Sections(parent, pid);
+                }
+            }
+
+        private:
+            inline void Append(const uint8_t data[], const uint8_t length)
+            {
+                if ((_size + length) <= sizeof(_buffer)) {
+                    ::memcpy(&(_buffer[_size]), data, length);
+                    _size += length;
+                } else {
+                    // Can not be a valid section, wait for the next start..
+                    _size = 0;
+                    _synced = false;
+                }
+            }
+            void Sections(Tuner& parent, const uint16_t pid)
+            {
+                uint16_t offset = 0;
+
+                while (((_size - offset) >= 3) && (_buffer[offset] != 0xFF)) {
+                    uint16_t length = ((((_buffer[offset + 1] & 0x0F) << 8) | _buffer[offset + 2]) + 3);
+
+                    if (length > MAX_SECTION_SIZE) {
+                        offset = _size;
+                        _synced = false;
+                    } else if ((_size - offset) < length) {
+                        break;
+                    } else {
+                        parent.Deliver(pid, MPEG::Section(Core::DataElement(length, &(_buffer[offset]))));
+                        offset += length;
+                    }
+                }
+
+                if ((_size - offset) >= 1) {
+                    if (_buffer[offset] == 0xFF) {
+                        // Stuffing, nothing of interest until the next start of a section.
+                        offset = _size;
+                        _synced = false;
+                    } else if (offset > 0) {
+                        ::memmove(_buffer, &(_buffer[offset]), _size - offset);
+                    }
+                }
+                _size -= offset;
+            }
+
+        private:
+            uint16_t _size;
+            bool _synced;
+            uint8_t _buffer[MAX_SECTION_SIZE + TS_PACKET_SIZE];
+        };
+
+        // Feeds the packets of a capture to the tuner. The capture is either read in chunks, or memory mapped
+        // as a whole. Without pacing, the packets are offered as fast as the tuner can process them (benchmarking),
+        // with pacing the Program Clock Reference of the first PCR PID encountered is followed, so the packets
+        // are offered at the rate they were recorded at.
+        class Demultiplexer : public Core::Thread {
+        private:
+            Demultiplexer() = delete;
+            Demultiplexer(const Demultiplexer&) = delete;
+            Demultiplexer& operator=(const Demultiplexer&) = delete;
+
+            static constexpr uint32_t CHUNK_SIZE = (TS_PACKET_SIZE * 128);
+            static constexpr uint32_t MAX_PACE_DELAY = 20; // ms
+            static constexpr uint64_t PCR_CLOCK = 27; // ticks per us
+            static constexpr uint64_t PCR_DISCONTINUITY = (PCR_CLOCK * 1000 * 1000); // 1 second
+
+        public:
+            Demultiplexer(Tuner& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("FileTuner"))
+                , _parent(parent)
+                , _file(-1)
+                , _mapped(nullptr)
+                , _realtime(false)
+                , _loop(true)
+                , _offset(0)
+                , _size(0)
+                , _pcrPid(NO_PID)
+                , _pcrReference(0)
+                , _pcrLast(0)
+                , _clockReference(0)
+                , _packets(0)
+                , _start(0)
+            {
+            }
+            virtual ~Demultiplexer()
+            {
+                Close();
+            }
+
+        public:
+            uint32_t Open(const string& fileName)
+            {
+                const Information& info(Information::Instance());
+
+                Close();
+
+                _realtime = info.RealTime();
+                _loop = info.Loop();
+
+                if (info.Mapped() == true) {
+                    _mapped = new Core::DataElementFile(fileName, Core::File::USER_READ);
+
+                    if ((_mapped->IsValid() == false) || (_mapped->Size() < TS_PACKET_SIZE)) {
+                        TRACE_L1("Could not map capture %s, error: %d", fileName.c_str(), _mapped->ErrorCode());
+                        delete _mapped;
+                        _mapped = nullptr;
+                    }
+                } else {
+                    _file = ::open(fileName.c_str(), O_RDONLY);
+
+                    if (_file == -1) {
+                        TRACE_L1("Could not open capture %s, error: %d", fileName.c_str(), errno);
+                    }
+                }
+
+                uint32_t result = ((_file != -1) || (_mapped != nullptr) ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+
+                if (result == Core::ERROR_NONE) {
+                    Rewind();
+                    _packets = 0;
+                    _start = Core::Time::Now().Ticks();
+                    Run();
+                }
+
+                return (result);
+            }
+            void Close()
+            {
+                ASSERT(Core::Thread::ThreadId() != Id());
+
+                Block();
+                Wait(Core::Thread::BLOCKED | Core::Thread::STOPPED, Core::infinite);
+
+                if (_packets != 0) {
+                    Report();
+                }
+                if (_file != -1) {
+                    ::close(_file);
+                    _file = -1;
+                }
+                if (_mapped != nullptr) {
+                    delete _mapped;
+                    _mapped = nullptr;
+                }
+            }
+
+        private:
+            virtual uint32_t Worker() override
+            {
+                bool completed;
+
+                if (_mapped != nullptr) {
+                    // The whole capture is available, hand it out in chunks so we can be blocked in between.
+                    const uint64_t available(_mapped->Size() - _offset);
+                    const uint32_t length(available > CHUNK_SIZE ? CHUNK_SIZE : static_cast<uint32_t>(available));
+
+                    _offset += Process(&(_mapped->Buffer()[_offset]), length);
+                    completed = ((_mapped->Size() - _offset) < TS_PACKET_SIZE);
+                } else {
+                    ssize_t loaded = (_size < sizeof(_buffer) ? ::read(_file, &(_buffer[_size]), sizeof(_buffer) - _size) : 0);
+
+                    if (loaded > 0) {
+                        _size += static_cast<uint32_t>(loaded);
+                    }
+
+                    uint32_t offset = Process(_buffer, _size);
+
+                    if (offset < _size) {
+                        ::memmove(_buffer, &(_buffer[offset]), _size - offset);
+                    }
+                    _size -= offset;
+
+                    completed = ((loaded <= 0) && (_size < TS_PACKET_SIZE));
+                }
+
+                if (completed == true) {
+                    if (_loop == true) {
+                        // Loop around, sections repeat anyway..
+                        Rewind();
+                    } else {
+                        Report();
+                        Block();
+                    }
+                }
+
+                // Keep on reading as long as we are running, once blocked, wait till we are started again.
+                return (Core::infinite);
+            }
+            // Returns the number of bytes consumed. If the packets are ahead of the recorded clock, processing stops
+            // at the packet that is too early, after waiting a bit (at most MAX_PACE_DELAY).
+            uint32_t Process(const uint8_t data[], const uint32_t length)
+            {
+                uint32_t offset = 0;
+                uint32_t delay = 0;
+
+                while (((length - offset) >= TS_PACKET_SIZE) && (delay == 0)) {
+                    if (data[offset] != TS_SYNC_BYTE) {
+                        // Lost sync, search for the next sync byte..
+                        offset++;
+                    } else if ((_realtime == false) || ((delay = Pace(&(data[offset]))) == 0)) {
+                        _parent.Packet(&(data[offset]));
+                        offset += TS_PACKET_SIZE;
+                        _packets++;
+                    }
+                }
+
+                if (delay != 0) {
+                    SleepMs(delay > MAX_PACE_DELAY ? MAX_PACE_DELAY : delay);
+                }
+
+                return (offset);
+            }
+            // Returns the time (in ms) this packet is ahead of the recorded clock.
+            uint32_t Pace(const uint8_t packet[])
+            {
+                uint32_t result = 0;
+
+                // Only packets with an adaptation field, that carries a PCR, are of interest.
+                if (((packet[3] & 0x20) != 0) && (packet[4] >= 7) && ((packet[5] & 0x10) != 0)) {
+                    const uint16_t pid(((packet[1] & 0x1F) << 8) | packet[2]);
+
+                    if ((_pcrPid == NO_PID) || (_pcrPid == pid)) {
+                        const uint64_t base((static_cast<uint64_t>(packet[6]) << 25) | (packet[7] << 17) | (packet[8] << 9) | (packet[9] << 1) | (packet[10] >> 7));
+                        const uint64_t pcr((base * 300) + (((packet[10] & 0x01) << 8) | packet[11]));
+                        const uint64_t now(Core::Time::Now().Ticks());
+
+                        if ((_pcrPid == NO_PID) || (pcr < _pcrLast) || ((pcr - _pcrLast) > PCR_DISCONTINUITY)) {
+                            // First PCR, a wrap around or a discontinuity, (re)start following the clock from here.
+                            _pcrPid = pid;
+                            _pcrReference = pcr;
+                            _clockReference = now;
+                        } else {
+                            const uint64_t due(_clockReference + ((pcr - _pcrReference) / PCR_CLOCK));
+
+                            if (due > now) {
+                                result = static_cast<uint32_t>(((due - now) + 999) / 1000);
+                            }
+                        }
+
+                        if (result == 0) {
+                            _pcrLast = pcr;
+                        }
+                    }
+                }
+
+                return (result);
+            }
+            void Rewind()
+            {
+                if (_file != -1) {
+                    ::lseek(_file, 0, SEEK_SET);
+                }
+                _offset = 0;
+                _size = 0;
+                _pcrPid = NO_PID;
+            }
+            void Report()
+            {
+                const uint64_t elapsed(Core::Time::Now().Ticks() - _start);
+                const uint64_t bits(static_cast<uint64_t>(_packets) * TS_PACKET_SIZE * 8);
+
+                TRACE_L1("Replayed %d packets in %d ms, %d kbit/s", _packets, static_cast<uint32_t>(elapsed / 1000), static_cast<uint32_t>(elapsed > 0 ? ((bits * 1000) / elapsed) : 0));
+
+                _packets = 0;
+                _start = Core::Time::Now().Ticks();
+            }
+
+        private:
+            Tuner& _parent;
+            int _file;
+            Core::DataElementFile* _mapped;
+            bool _realtime;
+            bool _loop;
+            uint64_t _offset;
+            uint32_t _size;
+            uint16_t _pcrPid;
+            uint64_t _pcrReference;
+            uint64_t _pcrLast;
+            uint64_t _clockReference;
+            uint32_t _packets;
+            uint64_t _start;
+            uint8_t _buffer[CHUNK_SIZE];
+        };
+
+        class Collector : public IMonitor, public ISection {
+        private:
+            Collector() = delete;
+            Collector(const Collector&) = delete;
+            Collector& operator=(const Collector&) = delete;
+
+        public:
+            Collector(Tuner& parent)
+                : _parent(parent)
+                , _filter(&parent)
+                , _callback(nullptr)
+                , _pid(NO_PID)
+                , _tableId(0)
+            {
+            }
+            ~Collector()
+            {
+                Close();
+            }
+
+        public:
+            inline uint16_t Pid() const
+            {
+                return (_pid);
+            }
+            uint32_t Open(const uint16_t frequency)
+            {
+                Close();
+
+                // Lets start collecting information (PAT/PMT)
+                _callback = ProgramTable::Instance().Register(this, frequency);
+
+                if (_callback != nullptr) {
+                    Listen(0, MPEG::PAT::ID);
+                }
+
+                return (_callback != nullptr ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+            }
+            void Close()
+            {
+                Listen(NO_PID, 0);
+
+                if (_callback != nullptr) {
+                    ProgramTable::Instance().Unregister(this);
+                    _callback = nullptr;
+                }
+            }
+            void Deliver(const MPEG::Section& section)
+            {
+                if (section.TableId() == _tableId) {
+                    _filter.Handle(section);
+                }
+            }
+
+        private:
+            void Listen(const uint16_t pid, const uint8_t tableId)
+            {
+                _filter.Callback(nullptr);
+
+                _parent._adminLock.Lock();
+                _pid = pid;
+                _tableId = tableId;
+                _parent._adminLock.Unlock();
+
+                if (pid != NO_PID) {
+                    _filter.Callback(this);
+                }
+            }
+            virtual void ChangePid(const uint16_t newpid, ISection* observer) override
+            {
+                ASSERT(observer == _callback);
+
+                if (newpid != NO_PID) {
+                    Listen(newpid, MPEG::PMT::ID);
+                } else {
+                    Listen(NO_PID, 0);
+                    ProgramTable::Instance().Unregister(this);
+                    _callback = nullptr;
+                }
+            }
+            virtual void Handle(const MPEG::Section& section) override
+            {
+                if (_callback != nullptr) {
+                    _callback->Handle(section);
+                }
+                _parent.EvaluateProgramId();
+            }
+
+        private:
+            Tuner& _parent;
+            TunerAdministrator::SectionFilter _filter;
+            ISection* _callback;
+            uint16_t _pid;
+            uint8_t _tableId;
+        };
+
+        typedef std::map<uint32_t, TunerAdministrator::SectionFilter*> Sections;
+        typedef std::list<TunerAdministrator::SectionFilter*> Filters;
+        typedef std::map<uint16_t, Assembler> Assemblers;
+
+        Tuner(const uint8_t index)
+            : _adminLock()
+            , _index(index)
+            , _state(IDLE)
+            , _frequency(0)
+            , _programId(~0)
+            , _program()
+            , _sections()
+            , _assemblers()
+            , _dispatching(false)
+            , _released()
+            , _collector(*this)
+            , _demux(*this)
+            , _callback(nullptr)
+        {
+            _callback = TunerAdministrator::Instance().Announce(this);
+        }
+
+    public:
+        ~Tuner()
+        {
+            _demux.Close();
+            _collector.Close();
+
+            TunerAdministrator::Instance().Revoke(this);
+
+            for (std::pair<const uint32_t, TunerAdministrator::SectionFilter*>& entry : _sections) {
+                delete entry.second;
+            }
+            _sections.clear();
+
+            _callback = nullptr;
+        }
+
+        static ITuner* Create(const string& info)
+        {
+            Tuner* result = nullptr;
+
+            uint8_t index = Core::NumberType<uint8_t>(Core::TextFragment(info)).Value();
+
+            if (index < Information::Instance().Frontends()) {
+                result = new Tuner(index);
+            }
+
+            return (result);
+        }
+
+    public:
+        virtual uint32_t Properties() const override
+        {
+            Information& instance = Information::Instance();
+            return (instance.Annex() | instance.Standard() | instance.Modus());
+        }
+
+        // Currently locked on ID
+        // This method return a unique number that will identify the locked on Transport stream. The ID will always
+        // identify the uniquely locked on to Tune request. ID => 0 is reserved and means not locked on to anything.
+        virtual uint16_t Id() const override
+        {
+            return (_state == IDLE ? 0 : _frequency);
+        }
+
+        // Using these methods the state of the tuner can be viewed.
+        virtual state State() const override
+        {
+            return (_state);
+        }
+
+        // Locking on a frequency means opening the capture recorded for that frequency.
+        virtual uint32_t Tune(const uint16_t frequency, const Modulation, const uint32_t, const uint16_t, const SpectralInversion) override
+        {
+            uint32_t result = Core::ERROR_UNAVAILABLE;
+
+            _demux.Close();
+            _collector.Close();
+
+            if (_state != IDLE) {
+                _state = IDLE;
+                _callback->StateChange(this);
+            }
+
+            _adminLock.Lock();
+            _assemblers.clear();
+            _frequency = frequency;
+            _adminLock.Unlock();
+
+            if (_collector.Open(frequency) == Core::ERROR_NONE) {
+                result = _demux.Open(Information::Instance().Capture(frequency));
+
+                if (result == Core::ERROR_NONE) {
+                    _state = LOCKED;
+                    _callback->StateChange(this);
+                } else {
+                    _collector.Close();
+                }
+            }
+
+            return (result);
+        }
+
+        // In case the tuner needs to be tuned to s apecific programId, please list it here. Once the PID's associated to this
+        // programId have been found, and set, the Tuner will reach its PREPARED state.
+        virtual uint32_t Prepare(const uint16_t programId) override
+        {
+            _state.Lock();
+
+            if (_state != STREAMING) {
+                _programId = programId;
+            }
+
+            _state.Unlock();
+
+            EvaluateProgramId();
+
+            return (_programId == programId ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
+        }
+
+        // A Tuner can be used to filter PSI/SI. Using the next call a callback can be installed to receive sections associated
+        // with a table. Each valid section received will be offered as a single section on the ISection interface for the user
+        // to process.
+        virtual uint32_t Filter(const uint16_t pid, const uint8_t tableId, ISection* callback) override
+        {
+            uint32_t id = (pid << 16) | tableId;
+            TunerAdministrator::SectionFilter* released = nullptr;
+
+            _adminLock.Lock();
+
+            Sections::iterator index(_sections.find(id));
+
+            // Replacing or removing the callback of a filter revokes the sections queued for the previous
+            // one, which waits for the one being handled. That might need this lock, so the filter is taken
+            // out under the lock and released without it. A replaced callback gets a fresh filter.
+            if ((index != _sections.end()) && (index->second->Callback() != callback)) {
+                released = index->second;
+                _sections.erase(index);
+                index = _sections.end();
+            }
+
+            if (callback != nullptr) {
+                if (index != _sections.end()) {
+                    // The same callback again, it will receive a full table again.
+                    index->second->Reset();
+                } else {
+                    TunerAdministrator::SectionFilter* filter = new TunerAdministrator::SectionFilter(this);
+                    filter->Callback(callback);
+                    _sections.emplace(id, filter);
+                }
+            }
+
+            // If we are delivering a section (on this thread), the filter might still be in use, it is
+            // released once the delivery is done.
+            if ((released != nullptr) && (_dispatching == true)) {
+                _released.push_back(released);
+                released = nullptr;
+            }
+
+            _adminLock.Unlock();
+
+            if (released != nullptr) {
+                delete released;
+            }
+
+            return (Core::ERROR_NONE);
+        }
+
+        // There are no decoders, the capture is always "streaming" to nowhere..
+        virtual uint32_t Attach(const uint8_t) override
+        {
+            uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+            if (_state == PREPARED) {
+                _state = STREAMING;
+                _callback->StateChange(this);
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+        virtual uint32_t Detach(const uint8_t) override
+        {
+            uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+            if (_state == STREAMING) {
+                _state = PREPARED;
+                _callback->StateChange(this);
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+
+    private:
+        void Packet(const uint8_t packet[])
+        {
+            const uint16_t pid(((packet[1] & 0x1F) << 8) | packet[2]);
+            const bool start((packet[1] & 0x40) != 0);
+            const uint8_t control((packet[3] >> 4) & 0x03);
+
+            // Packets without payload or with an transport error are of no interest.
+            if (((control & 0x01) != 0) && ((packet[1] & 0x80) == 0)) {
+                uint8_t offset = 4;
+
+                if ((control & 0x02) != 0) {
+                    offset += (packet[4] + 1);
+                }
+
+                if (offset < TS_PACKET_SIZE) {
+                    _adminLock.Lock();
+
+                    if (IsFiltered(pid) == true) {
+                        _dispatching = true;
+                        _assemblers[pid].Payload(*this, pid, &(packet[offset]), TS_PACKET_SIZE - offset, start);
+                        _dispatching = false;
+                    }
+
+                    Filters released;
+                    released.swap(_released);
+
+                    _adminLock.Unlock();
+
+                    for (TunerAdministrator::SectionFilter* filter : released) {
+                        delete filter;
+                    }
+                }
+            }
+        }
+        inline bool IsFiltered(const uint16_t pid) const
+        {
+            Sections::const_iterator index(_sections.lower_bound(pid << 16));
+
+            return ((pid == _collector.Pid()) || ((index != _sections.end()) && ((index->first >> 16) == pid)));
+        }
+        void Deliver(const uint16_t pid, const MPEG::Section& section)
+        {
+            if (section.IsValid() == true) {
+                if (pid == _collector.Pid()) {
+                    _collector.Deliver(section);
+                }
+
+                Sections::iterator index(_sections.find((pid << 16) | section.TableId()));
+
+                if (index == _sections.end()) {
+                    // Maybe someone is interested in all tables on this PID..
+                    index = _sections.find(pid << 16);
+                }
+                if (index != _sections.end()) {
+                    index->second->Handle(section);
+                }
+            }
+        }
+        void EvaluateProgramId()
+        {
+            _state.Lock();
+
+            if ((_state == LOCKED) || (_state == PREPARED)) {
+                bool updated = false;
+
+                if (ProgramTable::Instance().Program(_frequency, _programId, _program) == true) {
+                    if ((_program.IsValid() == true) && (_state == LOCKED)) {
+                        _state = PREPARED;
+                        updated = true;
+                    } else if ((_program.IsValid() == false) && (_state == PREPARED)) {
+                        _state = LOCKED;
+                        updated = true;
+                    }
+                }
+
+                if (updated == true) {
+                    _callback->StateChange(this);
+                }
+            }
+
+            _state.Unlock();
+        }
+
+    private:
+        mutable Core::CriticalSection _adminLock;
+        uint8_t _index;
+        Core::StateTrigger<state> _state;
+        uint16_t _frequency;
+        uint16_t _programId;
+        MPEG::PMT _program;
+        Sections _sections;
+        Assemblers _assemblers;
+        bool _dispatching;
+        Filters _released;
+        Collector _collector;
+        Demultiplexer _demux;
+        TunerAdministrator::ICallback* _callback;
+    };
+
+    /* static */ Tuner::Information Tuner::Information::_instance;
+
+    // The following methods will be called before any create is called. It allows for an initialization,
+    // if requires, and a deinitialization, if the Tuners will no longer be used.
+    /* static */ uint32_t ITuner::Initialize(const string& configuration)
+    {
+        Tuner::Information::Instance().Initialize(configuration);
+        return (Core::ERROR_NONE);
+    }
+
+    /* static */ uint32_t ITuner::Deinitialize()
+    {
+        Tuner::Information::Instance().Deinitialize();
+        return (Core::ERROR_NONE);
+    }
+
+    // Accessor to create a tuner.
+    /* static */ ITuner* ITuner::Create(const string& configuration)
+    {
+        return (Tuner::Create(configuration));
+    }
+
+} // namespace Broadcast
+} // namespace WPEFramework
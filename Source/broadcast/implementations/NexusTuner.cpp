@@ -422,15 +422,15 @@ namespace Broadcast {
 
         class Section {
         private:
+            Section() = delete;
             Section(const Section&) = delete;
             Section& operator=(const Section&) = delete;
 
         public:
-            Section()
-                : _adminLock()
-                , _pidChannel(nullptr)
+            Section(ITuner* tuner)
+                : _pidChannel(nullptr)
                 , _messages(nullptr)
-                , _callback(nullptr)
+                , _filter(tuner)
             {
                 NEXUS_MessageSettings openSettings;
 
@@ -459,7 +459,7 @@ namespace Broadcast {
 
                 if (_messages != nullptr) {
 
-                    ASSERT((callback != nullptr) && (_callback == nullptr));
+                    ASSERT((callback != nullptr) && (_pidChannel == nullptr));
 
                     _pidChannel = NEXUS_PidChannel_Open(parser, pid, nullptr);
 
@@ -472,12 +472,12 @@ namespace Broadcast {
                             startSettings.filter.mask[0] = 0x0;
                             // startSettings.filter.exclusion[0] = 0x0;
                         }
-                        _callback = callback;
+                        _filter.Callback(callback);
                         NEXUS_Error rc = NEXUS_Message_Start(_messages, &startSettings);
                         if (rc != 0) {
                             NEXUS_PidChannel_Close(_pidChannel);
                             _pidChannel = nullptr;
-                            _callback = nullptr;
+                            _filter.Callback(nullptr);
                         } else {
                             result = Core::ERROR_NONE;
                         }
@@ -495,9 +495,7 @@ namespace Broadcast {
                     NEXUS_PidChannel_Close(_pidChannel);
                     _pidChannel = nullptr;
                 }
-                _adminLock.Lock();
-                _callback = nullptr;
-                _adminLock.Unlock();
+                _filter.Callback(nullptr);
             }
 
         private:
@@ -524,11 +522,8 @@ namespace Broadcast {
                         size_t sectionLength = ((newSection.Length() + 3) & (static_cast<size_t>(~0) ^ 0x03));
 
                         if (newSection.IsValid() == true) {
-                            _adminLock.Lock();
-                            if (_callback != nullptr) {
-                                _callback->Handle(newSection);
-                            }
-                            _adminLock.Unlock();
+                            // Only sections that changed since the last time are passed on.
+                            _filter.Handle(newSection);
                         } else {
                             TRACE_L1("Invalid frame (%d - %d)!!!!\n", (sectionSize - handled), sectionLength);
                             DumpData(&(data[handled]), sectionSize - handled);
@@ -542,10 +537,9 @@ namespace Broadcast {
             }
 
         private:
-            Core::CriticalSection _adminLock;
             NEXUS_PidChannelHandle _pidChannel;
             NEXUS_MessageHandle _messages;
-            ISection* _callback;
+            TunerAdministrator::SectionFilter _filter;
         };
 
         class Collector : public IMonitor, public ISection {
@@ -557,7 +551,7 @@ namespace Broadcast {
         public:
             Collector(Tuner& parent)
                 : _parent(parent)
-                , _handler()
+                , _handler(&parent)
                 , _callback(nullptr)
             {
             }
@@ -910,7 +904,7 @@ namespace Broadcast {
 
             if (callback != nullptr) {
                 auto entry = _sections.emplace(std::piecewise_construct, std::forward_as_tuple(id),
-                    std::forward_as_tuple());
+                    std::forward_as_tuple(this));
                 result = entry.first->second.Open(ParserBand(), pid, tableId, callback);
 
                 if (result != Core::ERROR_NONE) {
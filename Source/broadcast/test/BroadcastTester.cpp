@@ -10,20 +10,48 @@ void printHelp(){
     printf("c -> Request a tuner\n");
     printf("t -> Tune\n");
     printf("s -> Switch stream\n");
+    printf("b -> Band scan all streams on all tuners\n");
+    printf("n -> Number of services and networks found\n");
+    printf("w -> Wait a second\n");
     printf("? -> This message\n");
     printf("q -> Quit\n");
 }
 
+class ScanReport : public Broadcast::ScanScheduler::ICallback {
+public:
+    ScanReport(const ScanReport&) = delete;
+    ScanReport& operator=(const ScanReport&) = delete;
+
+    ScanReport() = default;
+    ~ScanReport() override = default;
+
+public:
+    void Scanned(Broadcast::ITuner* tuner, const uint16_t frequency) override
+    {
+        printf("Scanned %d MHz on tuner %p\n", frequency, tuner);
+    }
+    void Failed(Broadcast::ITuner* tuner, const uint16_t frequency) override
+    {
+        printf("Could not tune to %d MHz on tuner %p\n", frequency, tuner);
+    }
+    void Completed() override
+    {
+        printf("Band scan completed\n");
+    }
+};
+
 int main(int argc, const char* argv[])
 {
-    const string configuration = "{ \
+    // The tuner configuration can be passed as the first argument, e.g. to replay captures with the file tuner:
+    // BroadcastTester '{ "frontends":1, "path":"/captures", "mapped":true }'
+    const string configuration = (argc > 1 ? string(argv[1]) : "{ \
         frontends:1, \
         decoders:1, \
         standard: \"DVB\" \
         annex: \"A\"\
         scan:true \
         modus: \"Terrestrial\" \
-    }";
+    }");
 
     const string information = "0";
 
@@ -57,6 +85,13 @@ int main(int argc, const char* argv[])
 
     std::list<streamInfo>::iterator stream = streams.begin();
 
+    Broadcast::Services services;
+    Broadcast::Networks networks;
+
+    // All tuners that are not in use scan in parallel, 2 seconds on each transponder.
+    ScanReport report;
+    Broadcast::ScanScheduler scanner(2000, &report);
+
     char keyPress;
 
     printf("Ready to start processing events, start with 0 to connect.\n");
@@ -114,6 +149,37 @@ int main(int argc, const char* argv[])
             }
         } break;
 
+        case 'B': {
+            if (scanner.IsScanning() == true) {
+                printf("A band scan is already in progress.\n");
+            } else {
+                for (const streamInfo& entry : streams) {
+                    scanner.Add(Broadcast::ScanScheduler::Transponder(entry.frequency, entry.modulation, entry.symbolRate, entry.fec, entry.si));
+                }
+                uint32_t result = scanner.Start(tuners);
+                printf("Band scan started on %d tuners: %d\n", static_cast<uint32_t>(tuners.size()), result);
+            }
+        } break;
+
+        case 'N': {
+            uint32_t serviceCount = 0;
+            uint32_t networkCount = 0;
+            Broadcast::Services::Iterator serviceList(services.List());
+            Broadcast::Networks::Iterator networkList(networks.List());
+
+            while (serviceList.Next() == true) {
+                serviceCount++;
+            }
+            while (networkList.Next() == true) {
+                networkCount++;
+            }
+            printf("Services: %d, Networks: %d\n", serviceCount, networkCount);
+        } break;
+
+        case 'W': {
+            SleepMs(1000);
+        } break;
+
         case 'Q':
             break;
 
@@ -127,6 +193,8 @@ int main(int argc, const char* argv[])
         }
     } while (keyPress != 'Q');
 
+    scanner.Stop();
+
     // Clear the factory we created..
     WPEFramework::Core::Singleton::Dispose();
 
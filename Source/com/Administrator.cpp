@@ -4,10 +4,40 @@
 namespace WPEFramework {
 namespace RPC {
 
+    namespace {
+
+        // Written by the ProxyStubGenerator (--index) next to the library it describes.
+        class ProxyStubIndex : public Core::JSON::Container {
+        public:
+            ProxyStubIndex(const ProxyStubIndex&) = delete;
+            ProxyStubIndex& operator=(const ProxyStubIndex&) = delete;
+
+            ProxyStubIndex()
+                : Core::JSON::Container()
+                , Library()
+                , Interfaces()
+            {
+                Add(_T("library"), &Library);
+                Add(_T("interfaces"), &Interfaces);
+            }
+            ~ProxyStubIndex()
+            {
+            }
+
+        public:
+            Core::JSON::String Library;
+            Core::JSON::ArrayType<Core::JSON::DecUInt32> Interfaces;
+        };
+    }
+
     Administrator::Administrator()
         : _adminLock()
+        , _loaderLock()
         , _stubs()
+        , _stubTable()
         , _proxy()
+        , _index()
+        , _libraries()
         , _factory(8)
         , _channelProxyMap()
     {
@@ -15,6 +45,32 @@ namespace RPC {
 
     /* virtual */ Administrator::~Administrator()
     {
+        _adminLock.Lock();
+
+        // The stubs and proxies live in the code of the libraries, release them before these are unloaded.
+        _stubTable.Clear();
+
+        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator stub(_stubs.begin());
+
+        while (stub != _stubs.end()) {
+            delete stub->second;
+            stub++;
+        }
+
+        std::map<uint32_t, IMetadata*>::iterator proxy(_proxy.begin());
+
+        while (proxy != _proxy.end()) {
+            delete proxy->second;
+            proxy++;
+        }
+
+        _stubs.clear();
+        _proxy.clear();
+        _index.clear();
+
+        _adminLock.Unlock();
+
+        _libraries.clear();
     }
 
     /* static */ Administrator& Administrator::Instance()
@@ -24,13 +80,165 @@ namespace RPC {
         return (systemAdministrator);
     }
 
+    void Administrator::Load(const string& pathName)
+    {
+        const string path(Core::Directory::Normalize(pathName));
+        std::list<string> indexed;
+        uint16_t loaded = 0;
+
+        _loaderLock.Lock();
+
+        Core::Directory indexes(path.c_str(), _T("*.json"));
+
+        while (indexes.Next() == true) {
+            Core::File file(indexes.Current());
+            ProxyStubIndex info;
+
+            if ((file.Open(true) == true) && (info.IElement::FromFile(file) == true) && (info.Library.Value().empty() == false)) {
+                const string library(path + info.Library.Value());
+
+                indexed.push_back(library);
+
+                if (IsLoaded(library) == false) {
+                    Core::JSON::ArrayType<Core::JSON::DecUInt32>::Iterator ids(info.Interfaces.Elements());
+
+                    _adminLock.Lock();
+
+                    while (ids.Next() == true) {
+                        // Interfaces already announced (or indexed) by another library keep their origin.
+                        if (_stubs.find(ids.Current().Value()) == _stubs.end()) {
+                            _index.emplace(ids.Current().Value(), library);
+                        }
+                    }
+
+                    _adminLock.Unlock();
+                }
+            }
+        }
+
+        Core::Directory index(path.c_str(), _T("*.so"));
+
+        while (index.Next() == true) {
+            const string library(index.Current());
+
+            if ((std::find(indexed.begin(), indexed.end(), library) == indexed.end()) && (IsLoaded(library) == false)) {
+                Core::Library proxyStub(library.c_str());
+
+                if (proxyStub.IsLoaded() == true) {
+                    _adminLock.Lock();
+                    _libraries.push_back(proxyStub);
+                    _adminLock.Unlock();
+                    loaded++;
+                }
+            }
+        }
+
+        _loaderLock.Unlock();
+
+        TRACE_L1("ProxyStubs from %s: %d libraries loaded, %d on demand.", path.c_str(), loaded, static_cast<uint32_t>(indexed.size()));
+    }
+
+    bool Administrator::IsLoaded(const string& libraryName) const
+    {
+        _adminLock.Lock();
+
+        std::list<Core::Library>::const_iterator loop(_libraries.begin());
+        while ((loop != _libraries.end()) && (loop->Name() != libraryName)) {
+            loop++;
+        }
+
+        bool result = (loop != _libraries.end());
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void Administrator::Resolve(const uint32_t interfaceId)
+    {
+        // Loading the library announces its proxies and stubs, which takes the _adminLock, from within
+        // the dynamic loader. So never load a library while holding the _adminLock, the _loaderLock just
+        // makes sure a library that is being loaded is not picked up half way by another thread.
+        _loaderLock.Lock();
+
+        string library;
+
+        _adminLock.Lock();
+
+        LibraryIndex::iterator index(_index.find(interfaceId));
+
+        if (index != _index.end()) {
+            library = index->second;
+
+            // Whatever happens, this library will not be tried again.
+            index = _index.begin();
+            while (index != _index.end()) {
+                if (index->second == library) {
+                    index = _index.erase(index);
+                } else {
+                    index++;
+                }
+            }
+        }
+
+        _adminLock.Unlock();
+
+        if (library.empty() == false) {
+            Core::Library proxyStub(library.c_str());
+
+            if (proxyStub.IsLoaded() == true) {
+                TRACE_L1("Loaded ProxyStubs %s on demand for interface 0x%X.", library.c_str(), interfaceId);
+
+                _adminLock.Lock();
+                _libraries.push_back(proxyStub);
+                _adminLock.Unlock();
+            }
+        }
+
+        _loaderLock.Unlock();
+    }
+
+    ProxyStub::UnknownStub* Administrator::Stub(const uint32_t interfaceId)
+    {
+        // Stubs are never removed once announced, so a stub that is found, can be used without the lock.
+        ProxyStub::UnknownStub* result = _stubTable.Find(interfaceId);
+
+        if (result == nullptr) {
+            // Not (yet) announced, or it did not fit the table, the libraries can be loaded on demand.
+            _adminLock.Lock();
+
+            std::map<uint32_t, ProxyStub::UnknownStub*>::const_iterator index(_stubs.find(interfaceId));
+
+            if (index != _stubs.end()) {
+                result = index->second;
+            }
+
+            _adminLock.Unlock();
+
+            if (result == nullptr) {
+                Resolve(interfaceId);
+
+                _adminLock.Lock();
+
+                index = _stubs.find(interfaceId);
+
+                if (index != _stubs.end()) {
+                    result = index->second;
+                }
+
+                _adminLock.Unlock();
+            }
+        }
+
+        return (result);
+    }
+
     void Administrator::AddRef(void* impl, const uint32_t interfaceId)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -45,11 +253,10 @@ namespace RPC {
 
     void Administrator::Release(void* impl, const uint32_t interfaceId)
     {
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        if (index != _stubs.end()) {
-            Core::IUnknown* implementation(index->second->Convert(impl));
+        if (stub != nullptr) {
+            Core::IUnknown* implementation(stub->Convert(impl));
 
             ASSERT(implementation != nullptr);
 
@@ -77,13 +284,11 @@ namespace RPC {
     void Administrator::Invoke(Core::ProxyType<Core::IPCChannel>& channel, Core::ProxyType<InvokeMessage>& message)
     {
         uint32_t interfaceId(message->Parameters().InterfaceId());
+        ProxyStub::UnknownStub* stub(Stub(interfaceId));
 
-        // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
-        std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
-
-        if (index != _stubs.end()) {
+        if (stub != nullptr) {
             uint32_t methodId(message->Parameters().MethodId());
-            index->second->Handle(methodId, channel, message);
+            stub->Handle(methodId, channel, message);
         } else {
             // Oops this is an unknown interface, Do not think this could happen.
             TRACE_L1("Unknown interface. %d", interfaceId);
@@ -169,6 +374,15 @@ namespace RPC {
 
         if (impl != nullptr) {
 
+            _adminLock.Lock();
+            const bool load = ((_proxy.find(id) == _proxy.end()) && (_index.find(id) != _index.end()));
+            _adminLock.Unlock();
+
+            if (load == true) {
+                // The proxy lives in a library that is not loaded yet, that can not be done under the lock.
+                Resolve(id);
+            }
+
             _adminLock.Lock();
 
             ChannelMap::iterator index(_channelProxyMap.find(channel.operator->()));
@@ -261,8 +475,8 @@ namespace RPC {
 
     Core::IUnknown* Administrator::Convert(void* rawImplementation, const uint32_t id) 
     {
-        std::map<uint32_t, ProxyStub::UnknownStub*>::const_iterator index (_stubs.find(id));
-        return(index != _stubs.end() ? index->second->Convert(rawImplementation) : nullptr);
+        ProxyStub::UnknownStub* stub(Stub(id));
+        return(stub != nullptr ? stub->Convert(rawImplementation) : nullptr);
     }
 
     /* static */ Administrator& Job::_administrator= Administrator::Instance();
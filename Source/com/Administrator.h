@@ -83,9 +83,96 @@ namespace RPC {
             std::atomic<uint32_t> _refCount;
         };
 
+        // Every invoke looks up its stub. Stubs are only added, never removed, so they are also published
+        // in this fixed size, open addressed table, that can be looked up without taking a lock. Adding is
+        // done under the administrator lock. A stub that does not fit is only in the map.
+        class StubTable {
+        public:
+            StubTable(const StubTable&) = delete;
+            StubTable& operator=(const StubTable&) = delete;
+
+            StubTable()
+            {
+                for (Slot& slot : _slots) {
+                    slot.Id.store(0, std::memory_order_relaxed);
+                    slot.Stub.store(nullptr, std::memory_order_relaxed);
+                }
+            }
+            ~StubTable()
+            {
+            }
+
+        public:
+            bool Add(const uint32_t id, ProxyStub::UnknownStub* stub)
+            {
+                uint16_t index = Hash(id);
+                uint16_t count = 0;
+
+                while ((count < Slots) && (_slots[index].Stub.load(std::memory_order_relaxed) != nullptr)) {
+                    index = (index + 1) & (Slots - 1);
+                    count++;
+                }
+
+                if (count < Slots) {
+                    // The id must be visible before the stub is, the stub marks the slot as taken.
+                    _slots[index].Id.store(id, std::memory_order_relaxed);
+                    _slots[index].Stub.store(stub, std::memory_order_release);
+                }
+
+                return (count < Slots);
+            }
+            ProxyStub::UnknownStub* Find(const uint32_t id) const
+            {
+                ProxyStub::UnknownStub* result = nullptr;
+                uint16_t index = Hash(id);
+                uint16_t count = 0;
+
+                while (count < Slots) {
+                    ProxyStub::UnknownStub* stub = _slots[index].Stub.load(std::memory_order_acquire);
+
+                    if (stub == nullptr) {
+                        count = Slots;
+                    } else if (_slots[index].Id.load(std::memory_order_relaxed) == id) {
+                        result = stub;
+                        count = Slots;
+                    } else {
+                        index = (index + 1) & (Slots - 1);
+                        count++;
+                    }
+                }
+
+                return (result);
+            }
+            // Only when no lookups can be done anymore, the stubs it holds are about to be deleted.
+            void Clear()
+            {
+                for (Slot& slot : _slots) {
+                    slot.Stub.store(nullptr, std::memory_order_relaxed);
+                    slot.Id.store(0, std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            static constexpr uint16_t Slots = 512;
+
+            struct Slot {
+                std::atomic<uint32_t> Id;
+                std::atomic<ProxyStub::UnknownStub*> Stub;
+            };
+
+            static uint16_t Hash(const uint32_t id)
+            {
+                return (static_cast<uint16_t>((id * 2654435761u) >> 23) & (Slots - 1));
+            }
+
+        private:
+            Slot _slots[Slots];
+        };
+
         typedef std::list<ProxyStub::UnknownProxy*> ProxyList;
         typedef std::map<const Core::IPCChannel*, ProxyList> ChannelMap;
         typedef std::map<const Core::IPCChannel*, std::list<ExternalReference>> ReferenceMap;
+        typedef std::map<uint32_t, string> LibraryIndex;
 
         struct EXTERNAL IMetadata {
             virtual ~IMetadata(){};
@@ -125,12 +212,26 @@ namespace RPC {
         {
             _adminLock.Lock();
 
-            _stubs.insert(std::pair<uint32_t, ProxyStub::UnknownStub*>(ACTUALINTERFACE::ID, new STUB()));
-            _proxy.insert(std::pair<uint32_t, IMetadata*>(ACTUALINTERFACE::ID, new ProxyType<PROXY>()));
+            // The first announcement of an interface is the one used, the administrator owns what it creates.
+            if (_stubs.find(ACTUALINTERFACE::ID) == _stubs.end()) {
+                ProxyStub::UnknownStub* stub = new STUB();
+
+                _stubs.insert(std::pair<uint32_t, ProxyStub::UnknownStub*>(ACTUALINTERFACE::ID, stub));
+                _stubTable.Add(ACTUALINTERFACE::ID, stub);
+            }
+
+            if (_proxy.find(ACTUALINTERFACE::ID) == _proxy.end()) {
+                _proxy.insert(std::pair<uint32_t, IMetadata*>(ACTUALINTERFACE::ID, new ProxyType<PROXY>()));
+            }
 
             _adminLock.Unlock();
         }
 
+        // Make the proxy/stub libraries in the given directory available. Libraries that come with an
+        // index (a <library>.json file, generated by the ProxyStubGenerator, listing its interfaces) are
+        // only loaded once one of these interfaces is used, the others are loaded right away.
+        void Load(const string& pathName);
+
         Core::ProxyType<InvokeMessage> Message()
         {
             return (_factory.Element());
@@ -222,6 +323,9 @@ namespace RPC {
         }
 
     private:
+        bool IsLoaded(const string& libraryName) const;
+        void Resolve(const uint32_t interfaceId);
+        ProxyStub::UnknownStub* Stub(const uint32_t interfaceId);
         Core::IUnknown* Convert(void* rawImplementation, const uint32_t id);
         void* ProxyFind(const Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t id, const uint32_t interfaceId);
         void* ProxyInstanceQuery(const Core::ProxyType<Core::IPCChannel>& channel, void* impl, const uint32_t id, const bool refCounted, const uint32_t interfaceId, const bool piggyBack);
@@ -229,9 +333,13 @@ namespace RPC {
 
     private:
         // Seems like we have enough information, open up the Process communcication Channel.
-        Core::CriticalSection _adminLock;
+        mutable Core::CriticalSection _adminLock;
+        Core::CriticalSection _loaderLock;
         std::map<uint32_t, ProxyStub::UnknownStub*> _stubs;
+        StubTable _stubTable;
         std::map<uint32_t, IMetadata*> _proxy;
+        LibraryIndex _index;
+        std::list<Core::Library> _libraries;
         Core::ProxyPoolType<InvokeMessage> _factory;
         ChannelMap _channelProxyMap;
         ReferenceMap _channelReferenceMap;
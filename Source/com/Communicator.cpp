@@ -10,7 +10,15 @@ namespace RPC {
 
     static constexpr uint32_t DestructionStackSize = 64 * 1024;
     static Core::ProxyPoolType<RPC::AnnounceMessage> AnnounceMessageFactory(2);
-    static Core::TimerType<ProcessShutdown>& _destructor = Core::SingletonType<Core::TimerType<ProcessShutdown>>::Instance(DestructionStackSize, "ProcessDestructor");
+
+    // Created on first use, a static initializer would start the timer thread in every process that
+    // loads this library and the zygote host needs to be single threaded when it forks.
+    static Core::TimerType<ProcessShutdown>& Destructor()
+    {
+        static Core::TimerType<ProcessShutdown>& destructor = Core::SingletonType<Core::TimerType<ProcessShutdown>>::Instance(DestructionStackSize, "ProcessDestructor");
+
+        return (destructor);
+    }
 
     class ClosingInfo {
     public:
@@ -37,9 +45,18 @@ namespace RPC {
             uint32_t nextinterval = handler->AttemptClose(0);
 
             if (nextinterval != 0) {
-                _destructor.Schedule(Core::Time::Now().Add(nextinterval), ProcessShutdown(std::move(handler)));
+                Destructor().Schedule(Core::Time::Now().Add(nextinterval), ProcessShutdown(std::move(handler)));
             }
         }
+        // Same as Start, but the first attempt is made on the destructor thread as well. For callers that
+        // hold locks the handler can not take, e.g. the ResourceMonitor when it observes the process.
+        template <class IMPLEMENTATION, typename... Args>
+        static void Dispatch(Args... args)
+        {
+            std::unique_ptr<ClosingInfo> handler(new IMPLEMENTATION(args...));
+
+            Destructor().Schedule(Core::Time::Now(), ProcessShutdown(std::move(handler), 0));
+        }
 
     public:
         ProcessShutdown& operator=(const ProcessShutdown& RHS) = delete;
@@ -51,9 +68,9 @@ namespace RPC {
         {
         }
 
-        explicit ProcessShutdown(std::unique_ptr<ClosingInfo>&& handler)
+        explicit ProcessShutdown(std::unique_ptr<ClosingInfo>&& handler, const uint8_t cycle = 1)
             : _handler(std::move(handler))
-            , _cycle(1)
+            , _cycle(cycle)
         {
         }
 
@@ -80,7 +97,46 @@ namespace RPC {
         uint8_t _cycle;
     };
 
-    class LocalClosingInfo : public ClosingInfo {
+    // The exit of a host, as reported by its ProcessObserver on the ResourceMonitor thread, handled on the
+    // destructor thread where the administration of the connections can be locked. It holds on to the link
+    // to the connections, not to the connections themselves, those might be gone by the time it runs.
+    template <typename LINK>
+    class ExitedInfo : public ClosingInfo {
+    public:
+        ExitedInfo& operator=(const ExitedInfo& RHS) = delete;
+        ExitedInfo(const ExitedInfo& copy) = delete;
+
+        virtual ~ExitedInfo() = default;
+
+    private:
+        friend class ProcessShutdown;
+
+        ExitedInfo(const uint32_t pid, const Core::ProxyType<LINK>& link, const uint32_t id)
+            : ClosingInfo()
+            , _process(pid)
+            , _link(link)
+            , _id(id)
+        {
+        }
+
+    protected:
+        uint32_t AttemptClose(const uint8_t /* iteration */) override
+        {
+            // If it is our child, collect the exit code so it does not linger as a zombie.
+            _process.IsActive();
+
+            _link->Exited(_id);
+
+            return (0);
+        }
+
+    private:
+        Core::Process _process;
+        Core::ProxyType<LINK> _link;
+        const uint32_t _id;
+    };
+
+    class LocalClosingInfo : public ClosingInfo, private Core::ProcessObserver::ICallback {
     public:
         LocalClosingInfo& operator=(const LocalClosingInfo& RHS) = delete;
         LocalClosingInfo(const LocalClosingInfo& copy) = delete;
@@ -93,6 +149,7 @@ namespace RPC {
         explicit LocalClosingInfo(const uint32_t pid)
             : ClosingInfo()
             , _process(pid)
+            , _observer(this)
         {
         }
 
@@ -100,9 +157,13 @@ namespace RPC {
         uint32_t AttemptClose(const uint8_t iteration) override
         {
             uint32_t nextinterval = 0;
-            if (_process.IsActive() != false) {
+
+            // Once the observer saw it go, the pid might already be in use by another process, do not signal it.
+            if ((_observer.HasExited() == false) && (_process.IsActive() != false)) {
                 switch (iteration) {
                 case 0:
+                    // Without a pidfd the process is only checked for at the end of each interval.
+                    _observer.Open(_process.Id());
                     _process.Kill(false);
                     nextinterval = 10000;
                     break;
@@ -119,8 +180,16 @@ namespace RPC {
             return nextinterval;
         }
 
+    private:
+        void Exited(const uint32_t pid) override
+        {
+            // Reap it right away, the scheduled attempt finds it gone and does not signal the pid anymore.
+            Core::Process(pid).IsActive();
+        }
+
     private:
         Core::Process _process;
+        Core::ProcessObserver _observer;
     };
 
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -192,27 +261,15 @@ namespace RPC {
 
     /* static */ std::atomic<uint32_t> Communicator::RemoteConnection::_sequenceId(1);
 
-    static void LoadProxyStubs(const string& pathName)
+    void Communicator::ExitLink::Exited(const uint32_t id)
     {
-        static std::list<Core::Library> processProxyStubs;
-
-        Core::Directory index(pathName.c_str(), _T("*.so"));
-
-        while (index.Next() == true) {
-            // Check if this ProxySTub file is already loaded in this process space..
-            std::list<Core::Library>::const_iterator loop(processProxyStubs.begin());
-            while ((loop != processProxyStubs.end()) && (loop->Name() != index.Current())) {
-                loop++;
-            }
-
-            if (loop == processProxyStubs.end()) {
-                Core::Library library(index.Current().c_str());
+        _adminLock.Lock();
 
-                if (library.IsLoaded() == true) {
-                    processProxyStubs.push_back(library);
-                }
-            }
+        if (_connections != nullptr) {
+            _connections->Exited(id);
         }
+
+        _adminLock.Unlock();
     }
 
     /* virtual */ uint32_t Communicator::RemoteConnection::Parent() const
@@ -280,12 +337,21 @@ namespace RPC {
         // Just submit our selves for destruction !!!!
 
         // Time to shoot the application, it will trigger a close by definition of the channel, if it is still standing..
-        if (_id != 0) {
-            ProcessShutdown::Start<LocalClosingInfo>(_id);
+        // Dispatched, as we are called with the connection administration locked, and the observer of the
+        // shutdown registers with the ResourceMonitor that might be waiting for that lock.
+        if ((_id != 0) && (_observer.HasExited() == false)) {
+            ProcessShutdown::Dispatch<LocalClosingInfo>(_id);
             _id = 0;
         }
     }
 
+    /* virtual */ void Communicator::LocalRemoteProcess::Exited(const uint32_t pid)
+    {
+        TRACE_L1("Host process %d of connection %d exited", pid, Id());
+
+        ProcessShutdown::Dispatch<ExitedInfo<ExitLink>>(pid, _exits, Id());
+    }
+
     uint32_t Communicator::LocalRemoteProcess::RemoteId() const
     {
         return (_id);
@@ -308,12 +374,145 @@ namespace RPC {
     {
     }
 
+    Communicator::Zygote::Zygote()
+        : _adminLock()
+        , _process(false)
+        , _channel(-1)
+    {
+    }
+
+    Communicator::Zygote::~Zygote()
+    {
+        Stop();
+    }
+
+    uint32_t Communicator::Zygote::Start(const string& hostApplication, const string& proxyStubPath)
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+#ifdef __LINUX__
+        int channels[2];
+
+        _adminLock.Lock();
+
+        if (_channel != -1) {
+            result = Core::ERROR_ILLEGAL_STATE;
+        } else if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, channels) == 0) {
+            Core::Process::Options options(hostApplication);
+            uint32_t id;
+
+            options[_T("-Z")] = Core::NumberType<int32_t>(channels[1]).Text();
+
+            if (proxyStubPath.empty() == false) {
+                options[_T("-m")] = proxyStubPath;
+            }
+
+            // Only the zygote end of the channel should survive the exec of the host application.
+            ::fcntl(channels[1], F_SETFD, 0);
+
+            result = _process.Launch(options, &id);
+
+            ::close(channels[1]);
+
+            if (result == Core::ERROR_NONE) {
+                TRACE_L1("Zygote host started: %d.", id);
+                _channel = channels[0];
+            } else {
+                ::close(channels[0]);
+            }
+        }
+
+        _adminLock.Unlock();
+#else
+        DEBUG_VARIABLE(hostApplication);
+        DEBUG_VARIABLE(proxyStubPath);
+#endif
+
+        return (result);
+    }
+
+    void Communicator::Zygote::Stop()
+    {
+        _adminLock.Lock();
+
+        if (_channel != -1) {
+            // Closing the channel is what makes the zygote quit, the hosts it forked keep on running.
+            ::close(_channel);
+            _channel = -1;
+
+            // Give it a moment to do so, before it is left as a zombie.
+            _process.WaitProcessCompleted(1000);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    uint32_t Communicator::Zygote::Launch(const Core::Process::Options& options, uint32_t* pid)
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+#ifdef __LINUX__
+        // The request is the argument list of the host application, each argument zero terminated.
+        std::string request(Core::ToString(options.Command()));
+        Core::Process::Options::Iterator index(options.Get());
+
+        request.push_back('\0');
+
+        while (index.Next() == true) {
+            request += Core::ToString(string(index.Key()));
+            request.push_back('\0');
+
+            if (index.Current().empty() == false) {
+                request += Core::ToString(index.Current());
+                request.push_back('\0');
+            }
+        }
+
+        if (request.length() <= ZygoteRequestSize) {
+            _adminLock.Lock();
+
+            if (_channel != -1) {
+                struct pollfd slot;
+                int32_t reply = 0;
+
+                slot.fd = _channel;
+                slot.events = POLLIN;
+                slot.revents = 0;
+
+                if ((::send(_channel, request.c_str(), request.length(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.length())) && (::poll(&slot, 1, CommunicationTimeOut) == 1) && (::recv(_channel, &reply, sizeof(reply), 0) == sizeof(reply))) {
+
+                    if (reply > 0) {
+                        *pid = static_cast<uint32_t>(reply);
+                        result = Core::ERROR_NONE;
+                    } else {
+                        TRACE_L1("Zygote could not fork a host: %d.", -reply);
+                        result = Core::ERROR_GENERAL;
+                    }
+                } else {
+                    // The zygote is gone or does not respond, launch the regular way from now on.
+                    TRACE_L1("Zygote host is not responding, falling back to regular launches.");
+                    ::close(_channel);
+                    _channel = -1;
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+#else
+        DEBUG_VARIABLE(options);
+        DEBUG_VARIABLE(pid);
+#endif
+
+        return (result);
+    }
+
     Communicator::Communicator(const Core::NodeId& node, const string& proxyStubPath)
-        : _connectionMap(*this)
+        : _zygote()
+        , _connectionMap(*this)
         , _ipcServer(node, _connectionMap, proxyStubPath)
     {
         if (proxyStubPath.empty() == false) {
-            RPC::LoadProxyStubs(proxyStubPath);
+            RPC::Administrator::Instance().Load(proxyStubPath);
         }
         // These are the elements we are expecting to receive over the IPC channels.
         _ipcServer.CreateFactory<AnnounceMessage>(1);
@@ -324,11 +523,12 @@ namespace RPC {
         const Core::NodeId& node,
         const string& proxyStubPath,
         const Core::ProxyType<Core::IIPCServer>& handler)
-        : _connectionMap(*this)
+        : _zygote()
+        , _connectionMap(*this)
         , _ipcServer(node, _connectionMap, proxyStubPath, handler)
     {
         if (proxyStubPath.empty() == false) {
-            RPC::LoadProxyStubs(proxyStubPath);
+            RPC::Administrator::Instance().Load(proxyStubPath);
         }
         // These are the elements we are expecting to receive over the IPC channels.
         _ipcServer.CreateFactory<AnnounceMessage>(1);
@@ -486,7 +686,7 @@ namespace RPC {
             string proxyStubPath(announceMessage->Response().ProxyStubPath());
             if (proxyStubPath.empty() == false) {
                 // Also load the ProxyStubs before we do anything else
-                RPC::LoadProxyStubs(proxyStubPath);
+                RPC::Administrator::Instance().Load(proxyStubPath);
             }
         }
 
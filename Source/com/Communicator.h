@@ -274,9 +274,80 @@ namespace RPC {
         }
     };
 
+    // Maximum size of a launch request (the arguments of the host application) sent to a zygote host.
+    enum { ZygoteRequestSize = 8192 };
+
+#ifdef PROCESSCONTAINERS_ENABLED
+    struct ContainerUsage {
+        string Callsign;
+        uint32_t Pid;
+        ProcessContainers::IContainerAdministrator::IContainer::Usage Usage;
+    };
+#endif
+
     class EXTERNAL Communicator {
     private:
         class ChannelLink;
+        class RemoteConnectionMap;
+
+        // The exit of a host is handled on the destructor thread, that might run after the connection map
+        // is gone. It reaches the map through this (counted) link, which the map cuts when it is destroyed.
+        class ExitLink {
+        public:
+            ExitLink() = delete;
+            ExitLink(const ExitLink&) = delete;
+            ExitLink& operator=(const ExitLink&) = delete;
+
+            ExitLink(RemoteConnectionMap* connections)
+                : _adminLock()
+                , _connections(connections)
+            {
+            }
+            ~ExitLink()
+            {
+            }
+
+        public:
+            void Exited(const uint32_t id);
+            // Once cut, no exit reaches the map anymore, also waits for the one being handled (if any).
+            void Cut()
+            {
+                _adminLock.Lock();
+                _connections = nullptr;
+                _adminLock.Unlock();
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            RemoteConnectionMap* _connections;
+        };
+
+        // A pre-initialized host process (the host application started with -Z <channel>), that forks a new
+        // host for every launch request it receives. Core, tracing and the proxy stubs are already loaded in
+        // it, so an out-of-process plugin started this way skips the exec, the dynamic linking and the
+        // initialization of all these libraries.
+        class EXTERNAL Zygote {
+        public:
+            Zygote(const Zygote&) = delete;
+            Zygote& operator=(const Zygote&) = delete;
+
+            Zygote();
+            ~Zygote();
+
+        public:
+            inline bool IsRunning() const
+            {
+                return (_channel != -1);
+            }
+            uint32_t Start(const string& hostApplication, const string& proxyStubPath);
+            void Stop();
+            uint32_t Launch(const Core::Process::Options& options, uint32_t* pid);
+
+        private:
+            Core::CriticalSection _adminLock;
+            Core::Process _process;
+            int _channel;
+        };
 
         class EXTERNAL RemoteConnection : public IRemoteConnection {
         private:
@@ -420,7 +491,7 @@ namespace RPC {
                 LaunchProcess(options);
             }
         };
-        class EXTERNAL LocalRemoteProcess : public RemoteProcess {
+        class EXTERNAL LocalRemoteProcess : public RemoteProcess, private Core::ProcessObserver::ICallback {
         public:
             friend class Core::Service<LocalRemoteProcess>;
 
@@ -428,23 +499,44 @@ namespace RPC {
             LocalRemoteProcess& operator=(const LocalRemoteProcess&) = delete;
 
         private:
-            LocalRemoteProcess() = default;
+            LocalRemoteProcess(Zygote* zygote, const Core::ProxyType<ExitLink>& exits)
+                : _zygote(zygote)
+                , _exits(exits)
+                , _observer(this)
+                , _id(0)
+            {
+            }
 
-            ~LocalRemoteProcess() = default;
+            ~LocalRemoteProcess()
+            {
+                _observer.Close();
+            }
 
         private:
             void LaunchProcess(const Core::Process::Options& options) override
             {
-                // Start the external process launch..
-                Core::Process fork(false);
+                if ((_zygote == nullptr) || (_zygote->IsRunning() == false) || (_zygote->Launch(options, &_id) != Core::ERROR_NONE)) {
+                    // Start the external process launch..
+                    Core::Process fork(false);
+
+                    fork.Launch(options, &_id);
+                }
 
-                fork.Launch(options, &_id);
+                // Learn about a crash of the host the moment it happens, without a pidfd it is only noticed
+                // once its channel closes, or not at all if it dies before it announced itself.
+                if ((_id != 0) && (_observer.Open(_id) == Core::ERROR_PROCESS_TERMINATED)) {
+                    Exited(_id);
+                }
             }
 
+            void Exited(const uint32_t pid) override;
             void Terminate() override;
             uint32_t RemoteId() const override;
 
         private:
+            Zygote* _zygote;
+            Core::ProxyType<ExitLink> _exits;
+            Core::ProcessObserver _observer;
             uint32_t _id;
         };
 #ifdef PROCESSCONTAINERS_ENABLED
@@ -485,6 +577,7 @@ namespace RPC {
                 const string& datapath,
                 const string& volatilepath,
                 const string& configuration)
+                : _callsign(callsign)
             {
 
                 static constexpr TCHAR ContainerName[] = _T("Container");
@@ -549,8 +642,17 @@ namespace RPC {
             {
                 return _container->Pid();
             }
+            const string& Callsign() const
+            {
+                return (_callsign);
+            }
+            bool Measure(ProcessContainers::IContainerAdministrator::IContainer::Usage& usage) const
+            {
+                return ((_container != nullptr) && (_container->Measure(usage) == true));
+            }
 
         private:
+            const string _callsign;
             ProcessContainers::IContainerAdministrator::IContainer* _container;
         };
 
@@ -580,13 +682,13 @@ namespace RPC {
             Core::ProxyType<Core::IPCChannelType<Core::SocketPort, ChannelLink>> _hostChannel;
         };
 
-        static RemoteProcess* CreateProcess(const Object& instance, const Config& config)
+        static RemoteProcess* CreateProcess(const Object& instance, const Config& config, Zygote* zygote, RemoteConnectionMap& connections)
         {
             RemoteProcess* result = nullptr;
 
             switch (instance.Type()) {
             case Object::HostType::LOCAL:
-                result = Core::Service<LocalRemoteProcess>::Create<RemoteProcess>();
+                result = Core::Service<LocalRemoteProcess>::Create<RemoteProcess>(zygote, connections.Exits());
                 break;
             case Object::HostType::DISTRIBUTED:
                 result = Core::Service<RemoteHost>::Create<RemoteProcess>(Core::NodeId(_T("127.0.0.1:9120")));
@@ -618,10 +720,14 @@ namespace RPC {
                 , _announcements()
                 , _connections()
                 , _parent(parent)
+                , _exits(Core::ProxyType<ExitLink>::Create(this))
             {
             }
             virtual ~RemoteConnectionMap()
             {
+                // Exits reported from here on, have nothing left to report to.
+                _exits->Cut();
+
                 // All observers should have unregistered before this map get's destroyed !!!
                 ASSERT(_observers.size() == 0);
 
@@ -637,6 +743,10 @@ namespace RPC {
             }
 
         public:
+            inline const Core::ProxyType<ExitLink>& Exits() const
+            {
+                return (_exits);
+            }
             inline void Register(RPC::IRemoteConnection::INotification* sink)
             {
                 ASSERT(sink != nullptr);
@@ -691,7 +801,7 @@ namespace RPC {
 
                 _adminLock.Lock();
 
-                Communicator::RemoteProcess* result = CreateProcess(instance, config);
+                Communicator::RemoteProcess* result = CreateProcess(instance, config, &(_parent._zygote), *this);
 
                 ASSERT(result != nullptr);
 
@@ -713,8 +823,8 @@ namespace RPC {
                     // Start the process, and....
                     result->Launch(instance, config);
 
-                    // wait for the announce message to be exchanged
-                    if (trigger.Lock(waitTime) == Core::ERROR_NONE) {
+                    // wait for the announce message to be exchanged, or for the process to give up before it did.
+                    if ((trigger.Lock(waitTime) == Core::ERROR_NONE) && (result->IsOperational() == true)) {
 
                         uint32_t interfaceId = instance.Interface();
 
@@ -780,6 +890,29 @@ namespace RPC {
                     _parent.Closed(destructed);
                 }
             }
+            inline void Exited(const uint32_t id)
+            {
+                _adminLock.Lock();
+
+                std::map<uint32_t, Communicator::RemoteConnection*>::iterator index(_connections.find(id));
+
+                if (index != _connections.end()) {
+                    if (index->second->IsOperational() == true) {
+                        // The channel might outlive the process (inherited by a child), do not wait for it
+                        // to break, closing it runs the regular Closed() path.
+                        index->second->Close();
+                    } else {
+                        // Died before it announced itself, no use to wait for the announce any longer.
+                        auto processConnection = _announcements.find(id);
+
+                        if (processConnection != _announcements.end()) {
+                            processConnection->second.first.SetEvent();
+                        }
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
             inline Communicator::RemoteConnection* Connection(const uint32_t id)
             {
                 Communicator::RemoteConnection* result = nullptr;
@@ -797,6 +930,43 @@ namespace RPC {
 
                 return (result);
             }
+#ifdef PROCESSCONTAINERS_ENABLED
+            inline void Containers(std::list<ContainerUsage>& usages) const
+            {
+                std::list<const ContainerRemoteProcess*> containers;
+
+                _adminLock.Lock();
+
+                std::map<uint32_t, Communicator::RemoteConnection*>::const_iterator index(_connections.begin());
+
+                while (index != _connections.end()) {
+                    const ContainerRemoteProcess* container = dynamic_cast<const ContainerRemoteProcess*>(index->second);
+
+                    if (container != nullptr) {
+                        container->AddRef();
+                        containers.push_back(container);
+                    }
+                    index++;
+                }
+
+                _adminLock.Unlock();
+
+                // Reading the cgroup files is file I/O, keep it out of the lock every connection change takes.
+                std::list<const ContainerRemoteProcess*>::const_iterator loop(containers.begin());
+
+                while (loop != containers.end()) {
+                    ContainerUsage entry;
+
+                    if ((*loop)->Measure(entry.Usage) == true) {
+                        entry.Callsign = (*loop)->Callsign();
+                        entry.Pid = (*loop)->RemoteId();
+                        usages.push_back(entry);
+                    }
+                    (*loop)->Release();
+                    loop++;
+                }
+            }
+#endif
             inline void Destroy()
             {
                 // First do an activity check on all processes registered.
@@ -934,6 +1104,7 @@ namespace RPC {
             std::map<uint32_t, Communicator::RemoteConnection*> _connections;
             std::list<RPC::IRemoteConnection::INotification*> _observers;
             Communicator& _parent;
+            Core::ProxyType<ExitLink> _exits;
         };
         class EXTERNAL ChannelLink {
         private:
@@ -1160,6 +1331,18 @@ namespace RPC {
         {
             return (_connectionMap.Create(pid, instance, config, waitTime));
         }
+#ifdef PROCESSCONTAINERS_ENABLED
+        // Resource usage of all plugins hosted in a container.
+        inline void Containers(std::list<ContainerUsage>& usages) const
+        {
+            _connectionMap.Containers(usages);
+        }
+#endif
+        // From now on, launch local hosts by forking them from a pre-initialized host application.
+        inline uint32_t StartZygote(const string& hostApplication, const string& proxyStubPath)
+        {
+            return (_zygote.Start(hostApplication, proxyStubPath));
+        }
         void Destroy()
         {
             _connectionMap.Destroy();
@@ -1212,6 +1395,7 @@ namespace RPC {
         }
 
     private:
+        Zygote _zygote;
         RemoteConnectionMap _connectionMap;
         ChannelServer _ipcServer;
     };
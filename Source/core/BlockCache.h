@@ -0,0 +1,201 @@
+#ifndef __BLOCKCACHE_H
+#define __BLOCKCACHE_H
+
+#include "Module.h"
+#include "Portability.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    // Rationale:
+    // Objects that are built and destroyed per request (JSON containers, their labels list and
+    // their string values) allocate the same small blocks over and over again. Instead of going
+    // back to the heap, the blocks are kept per thread in a few size classes, so in steady state
+    // a request is served from memory the previous request on that thread released. The number
+    // of blocks kept per class is bounded, whatever is released beyond that goes back to the heap,
+    // so is everything left when the thread ends.
+    // Blocks are not owned by a thread, a block allocated on one thread can be released on another.
+    class BlockCache {
+    private:
+        static constexpr uint8_t Classes = 4;
+        static constexpr uint16_t MinBlockSize = 32;
+        static constexpr uint16_t MaxBlocks = 64;
+
+    public:
+        // Per thread counters, to verify the blocks are recycled.
+        struct Statistics {
+            uint32_t Cached; // allocations served from a block released earlier
+            uint32_t Heap; // allocations that went to the heap
+            uint32_t Kept; // released blocks kept for reuse
+        };
+
+    private:
+        class Cache {
+        public:
+            Cache(const Cache&) = delete;
+            Cache& operator=(const Cache&) = delete;
+
+            Cache()
+            {
+                ::memset(_count, 0, sizeof(_count));
+                ::memset(&_statistics, 0, sizeof(_statistics));
+            }
+            ~Cache()
+            {
+                Gone() = true;
+
+                for (uint8_t index = 0; index < Classes; index++) {
+                    while (_count[index] != 0) {
+                        ::free(_blocks[index][--_count[index]]);
+                    }
+                }
+            }
+
+        public:
+            inline void* Take(const uint8_t sizeClass)
+            {
+                void* result = nullptr;
+
+                if ((sizeClass < Classes) && (_count[sizeClass] != 0)) {
+                    result = _blocks[sizeClass][--_count[sizeClass]];
+                    _statistics.Cached++;
+                } else {
+                    _statistics.Heap++;
+                }
+
+                return (result);
+            }
+            inline bool Keep(const uint8_t sizeClass, void* block)
+            {
+                bool result = ((sizeClass < Classes) && (_count[sizeClass] < MaxBlocks));
+
+                if (result == true) {
+                    _blocks[sizeClass][_count[sizeClass]++] = block;
+                    _statistics.Kept++;
+                }
+
+                return (result);
+            }
+            inline const Statistics& Measure() const
+            {
+                return (_statistics);
+            }
+
+        private:
+            uint16_t _count[Classes];
+            void* _blocks[Classes][MaxBlocks];
+            Statistics _statistics;
+        };
+
+    public:
+        BlockCache() = delete;
+        BlockCache(const BlockCache&) = delete;
+        BlockCache& operator=(const BlockCache&) = delete;
+
+    public:
+        static void* Allocate(const size_t size)
+        {
+            const uint8_t sizeClass = SizeClass(size);
+            void* result = nullptr;
+
+            if (Gone() == false) {
+                result = Local().Take(sizeClass);
+            }
+            if (result == nullptr) {
+                result = ::malloc(sizeClass < Classes ? (MinBlockSize << sizeClass) : size);
+            }
+
+            return (result);
+        }
+        static void Free(void* block, const size_t size)
+        {
+            const uint8_t sizeClass = SizeClass(size);
+
+            if ((Gone() == true) || (Local().Keep(sizeClass, block) == false)) {
+                ::free(block);
+            }
+        }
+        // The counters of the calling thread.
+        static void Measure(Statistics& statistics)
+        {
+            if (Gone() == false) {
+                statistics = Local().Measure();
+            } else {
+                ::memset(&statistics, 0, sizeof(statistics));
+            }
+        }
+
+    private:
+        static uint8_t SizeClass(const size_t size)
+        {
+            uint8_t result = 0;
+
+            while ((result < Classes) && (size > static_cast<size_t>(MinBlockSize << result))) {
+                result++;
+            }
+
+            return (result);
+        }
+        // A plain flag, so it can still be checked when the cache of the thread is already destructed,
+        // e.g. by objects released from other thread_local or static destructors.
+        static bool& Gone()
+        {
+            static thread_local bool gone = false;
+            return (gone);
+        }
+        static Cache& Local()
+        {
+            static thread_local Cache cache;
+            return (cache);
+        }
+    };
+
+    // Standard allocator on top of the BlockCache, for the containers and strings of short lived objects.
+    template <typename TYPE>
+    class BlockCacheAllocator {
+    public:
+        typedef TYPE value_type;
+
+        template <typename OTHER>
+        struct rebind {
+            typedef BlockCacheAllocator<OTHER> other;
+        };
+
+    public:
+        BlockCacheAllocator() = default;
+        template <typename OTHER>
+        BlockCacheAllocator(const BlockCacheAllocator<OTHER>&)
+        {
+        }
+        ~BlockCacheAllocator() = default;
+
+    public:
+        TYPE* allocate(const size_t count)
+        {
+            TYPE* result = static_cast<TYPE*>(BlockCache::Allocate(count * sizeof(TYPE)));
+
+            if (result == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return (result);
+        }
+        void deallocate(TYPE* block, const size_t count)
+        {
+            BlockCache::Free(block, count * sizeof(TYPE));
+        }
+        template <typename OTHER>
+        inline bool operator==(const BlockCacheAllocator<OTHER>&) const
+        {
+            return (true);
+        }
+        template <typename OTHER>
+        inline bool operator!=(const BlockCacheAllocator<OTHER>&) const
+        {
+            return (false);
+        }
+    };
+}
+} // namespace Core
+
+#endif // __BLOCKCACHE_H
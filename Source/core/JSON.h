@@ -3,6 +3,7 @@
 
 #include <map>
 
+#include "BlockCache.h"
 #include "Enumerate.h"
 #include "FileSystem.h"
 #include "Number.h"
@@ -988,6 +989,11 @@ namespace Core {
 
         class EXTERNAL String : public IElement, public IMessagePack {
         private:
+            // Strings of per request objects come and go, their buffers are recycled per thread.
+            typedef std::basic_string<char, std::char_traits<char>, BlockCacheAllocator<char>> Buffer;
+
+            friend class Container;
+
             static constexpr uint32_t None = 0x00000000;
             static constexpr uint32_t ScopeMask = 0x007FFFFF;
             static constexpr uint32_t DepthCountMask = 0x0F800000;
@@ -1049,7 +1055,7 @@ namespace Core {
 
             String& operator=(const string& RHS)
             {
-                Core::ToString(RHS.c_str(), _value);
+                Assign(RHS.c_str());
                 _scopeCount |= SetBit;
 
                 return (*this);
@@ -1057,7 +1063,7 @@ namespace Core {
 
             String& operator=(const char RHS[])
             {
-                Core::ToString(RHS, _value);
+                Assign(RHS);
                 _scopeCount |= SetBit;
 
                 return (*this);
@@ -1066,7 +1072,7 @@ namespace Core {
 #ifndef __NO_WCHAR_SUPPORT__
             String& operator=(const wchar_t RHS[])
             {
-                Core::ToString(RHS, _value);
+                Assign(RHS);
                 _scopeCount |= SetBit;
 
                 return (*this);
@@ -1188,7 +1194,7 @@ namespace Core {
             }
 
         protected:
-            inline bool MatchLastCharacter(const string& str, char ch) const
+            inline bool MatchLastCharacter(const Buffer& str, char ch) const
             {
                 return (str.length() > 0) && (str[str.length() - 1] == ch);
             }
@@ -1202,8 +1208,14 @@ namespace Core {
                 ASSERT(maxLength > 0);
 
                 if ((quoted == false) || ((_scopeCount & NullBit) != 0)) {
-                    std::string source((_value.empty() || (_scopeCount & NullBit)) ? NullTag : _value);
-                    result = static_cast<uint16_t>(source.copy(stream, maxLength - result, offset));
+                    const bool null = (_value.empty() || ((_scopeCount & NullBit) != 0));
+                    const char* source = (null ? NullTag : _value.c_str());
+                    const uint16_t length = static_cast<uint16_t>(null ? strlen(NullTag) : _value.length());
+
+                    ASSERT(offset <= length);
+
+                    result = std::min(static_cast<uint16_t>(maxLength - result), static_cast<uint16_t>(length - offset));
+                    ::memcpy(stream, &(source[offset]), result);
                     offset = (result < maxLength ? 0 : offset + result);
                 } else {
                     if (offset == 0) {
@@ -1442,6 +1454,18 @@ namespace Core {
             }
 
         private:
+            inline void Assign(const char source[])
+            {
+                _value.assign(source);
+            }
+#ifndef __NO_WCHAR_SUPPORT__
+            inline void Assign(const wchar_t source[])
+            {
+                std::string converted;
+                Core::ToString(source, converted);
+                _value.assign(converted.c_str(), converted.length());
+            }
+#endif // __NO_WCHAR_SUPPORT__
             bool IsValidEscapeSequence(char current) const
             {
                 ASSERT(MatchLastCharacter(_value, '\\') == true);
@@ -1511,7 +1535,7 @@ namespace Core {
             // This constrains the maximal depth of the opaque object to be 23.
             uint32_t _scopeCount;
             mutable uint32_t _unaccountedCount;
-            std::string _value;
+            Buffer _value;
         };
 
         class EXTERNAL Buffer : public IElement, public IMessagePack {
@@ -2565,7 +2589,7 @@ namespace Core {
             static constexpr uint16_t PARSE = 11;
 
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
-            typedef std::list<JSONLabelValue> JSONElementList;
+            typedef std::list<JSONLabelValue, BlockCacheAllocator<JSONLabelValue>> JSONElementList;
 
             class Iterator {
             private:
@@ -2722,7 +2746,7 @@ namespace Core {
 
                     offset = (_iterator == _data.end() ? ~0 : ((_iterator->second->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
                     if (offset == BEGIN_MARKER) {
-                        _fieldName = string(_iterator->first);
+                        _fieldName = _iterator->first;
                         _current.json = &_fieldName;
                         offset = PARSE;
                     }
@@ -2740,7 +2764,7 @@ namespace Core {
                         } else {
                             if (FindNext() != false) {
                                 stream[loaded++] = ',';
-                                _fieldName = string(_iterator->first);
+                                _fieldName = _iterator->first;
                                 _current.json = &_fieldName;
                                 offset = PARSE;
                             } else {
@@ -2855,7 +2879,7 @@ namespace Core {
                                         ++loaded;
                                         break;
                                     }
-                                    _current.json = Find(_fieldName.Value().c_str());
+                                    _current.json = Find(_fieldName._value.c_str());
 
                                     _fieldName.Clear();
 
@@ -2925,7 +2949,7 @@ namespace Core {
                         offset = 1;
                     }
                     if (offset != 0) {
-                        _fieldName = string(_iterator->first);
+                        _fieldName = _iterator->first;
                     }
                 }
                 while ((loaded < maxLength) && (offset > 0) && (offset < PARSE)) {
@@ -2958,7 +2982,7 @@ namespace Core {
                             if (_iterator == _data.end()) {
                                 offset = 0;
                             } else {
-                                _fieldName = string(_iterator->first);
+                                _fieldName = _iterator->first;
                             }
                         }
                     }
@@ -3000,7 +3024,7 @@ namespace Core {
                         loaded += static_cast<IMessagePack&>(_fieldName).Deserialize(stream, maxLength, offset);
                         offset += PARSE;
                     } else if (_fieldName.IsSet() == true) {
-                        _current.pack = dynamic_cast<IMessagePack*>(Find(_fieldName.Value().c_str()));
+                        _current.pack = dynamic_cast<IMessagePack*>(Find(_fieldName._value.c_str()));
                         if (_current.pack == nullptr) {
                             _current.pack = &(static_cast<IMessagePack&>(_fieldName));
                         }
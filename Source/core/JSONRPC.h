@@ -4,6 +4,7 @@
 #include "Module.h"
 #include "TypeTraits.h"
 
+#include <algorithm>
 #include <cctype>
 #include <functional>
 #include <vector>
@@ -114,6 +115,11 @@ namespace Core {
 
         public:
             static string Callsign(const string& designator)
+            {
+                return (designator.substr(0, CallsignLength(designator)));
+            }
+            // The parsers below return the positions of the part in the designator, they do not copy it.
+            static size_t CallsignLength(const string& designator)
             {
                 size_t pos = designator.find_last_of('.', designator.find_last_of('@'));
                 if ((pos != string::npos) && (pos > 0)) {
@@ -127,7 +133,17 @@ namespace Core {
                         pos = string::npos;
                     }
                 }
-                return (pos == string::npos ? EMPTY_STRING : designator.substr(0, pos));
+                return (pos == string::npos ? 0 : pos);
+            }
+            static size_t MethodOffset(const string& designator, size_t& length)
+            {
+                size_t end = designator.find_last_of('@');
+                size_t begin = designator.find_last_of('.', end);
+
+                begin = (begin == string::npos ? 0 : begin + 1);
+                length = (end == string::npos ? designator.length() : end) - begin;
+
+                return (begin);
             }
             static string FullCallsign(const string& designator)
             {
@@ -136,10 +152,10 @@ namespace Core {
             }
             static string Method(const string& designator)
             {
-                size_t end = designator.find_last_of('@');
-                size_t begin = designator.find_last_of('.', end);
+                size_t length;
+                size_t begin = MethodOffset(designator, length);
 
-                return (designator.substr((begin == string::npos) ? 0 : begin + 1, (end == string::npos ? string::npos : (begin == string::npos) ? end : end - begin - 1)));
+                return (designator.substr(begin, length));
             }
             static string FullMethod(const string& designator)
             {
@@ -179,7 +195,13 @@ namespace Core {
                     }
 
                     if (index < pos) {
-                        result = static_cast<uint8_t>(atoi(designator.substr(index, pos - index).c_str()));
+                        uint32_t value = 0;
+
+                        // Like atoi, the number ends at the first non digit, no digits at all is version 0.
+                        while ((index < pos) && (isdigit(designator[index]))) {
+                            value = (value * 10) + (designator[index++] - '0');
+                        }
+                        result = static_cast<uint8_t>(value);
                     }
                 }
                 return (result);
@@ -235,6 +257,80 @@ namespace Core {
             Info Error;
         };
 
+        // A notification, formatted once, to be streamed as is to all channels that subscribed to it through
+        // the same designator. Serializing does not change it, the position is kept in the offset of the caller,
+        // so all these channels can share the one instance. That offset also limits it to 64KB, see IsStreamable.
+        class EXTERNAL Notification : public Core::JSON::IElement {
+        public:
+            Notification() = delete;
+            Notification(const Notification&) = delete;
+            Notification& operator=(const Notification&) = delete;
+
+            Notification(const string& designator, const string& parameters)
+                : _text()
+            {
+                Message message;
+
+                message.JSONRPC = Message::DefaultVersion;
+                message.Designator = designator;
+
+                if (parameters.empty() == false) {
+                    message.Parameters = parameters;
+                }
+
+                message.ToString(_text);
+            }
+            ~Notification() override
+            {
+            }
+
+        public:
+            inline bool IsStreamable() const
+            {
+                return (_text.length() < static_cast<uint16_t>(~0));
+            }
+            inline const string& Text() const
+            {
+                return (_text);
+            }
+
+            void Clear() override
+            {
+            }
+            bool IsSet() const override
+            {
+                return (true);
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint16_t& offset) const override
+            {
+                ASSERT(IsStreamable() == true);
+
+                const uint32_t left = static_cast<uint32_t>(_text.length()) - offset;
+                const uint16_t loaded = static_cast<uint16_t>(left > maxLength ? maxLength : left);
+
+                ::memcpy(stream, &(_text.c_str()[offset]), loaded);
+
+                offset = (loaded == left ? 0 : offset + loaded);
+
+                return (loaded);
+            }
+            uint16_t Deserialize(const char[], const uint16_t, uint16_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                // Only meant to be sent.
+                error = Core::JSON::Error{ "A notification can not be deserialized" };
+                offset = 0;
+
+                return (0);
+            }
+
+        private:
+            string _text;
+        };
+
         class EXTERNAL Connection {
         private:
             Connection() = delete;
@@ -283,121 +379,95 @@ namespace Core {
             typedef std::function<uint32_t(const string& method, const string& parameters, string& result)> InvokeFunction;
 
             class Entry {
-            private:
+            public:
                 Entry() = delete;
-                Entry& operator=(const Entry&) = delete;
-
-                union Functions {
-                    Functions(const Functions& function, const bool async)
-                    {
-                        if (async == true) {
-                            new (&_callback) auto(function._callback);
-                        } else {
-                            new (&_invoke) auto(function._invoke);
-                        }
-                    }
-                    Functions(const CallbackFunction& function)
-                        : _callback(function)
-                    {
-                    }
-                    Functions(const InvokeFunction& function)
-                        : _invoke(function)
-                    {
-                    }
-                    ~Functions()
-                    {
-                    }
-
-                    CallbackFunction _callback;
-                    InvokeFunction _invoke;
-                };
 
-            public:
-                Entry(const CallbackFunction& callback)
-                    : _asynchronous(true)
-                    , _info(callback)
-                {
-                }
-                Entry(const InvokeFunction& callback)
-                    : _asynchronous(false)
-                    , _info(callback)
+                Entry(const string& name, const CallbackFunction& callback)
+                    : _name(name)
+                    , _hash(Hash(name.c_str(), name.length()))
+                    , _asynchronous(true)
+                    , _callback(callback)
+                    , _invoke()
                 {
                 }
-                Entry(const Entry& copy)
-                    : _asynchronous(copy._asynchronous)
-                    , _info(copy._info, copy._asynchronous)
+                Entry(const string& name, const InvokeFunction& callback)
+                    : _name(name)
+                    , _hash(Hash(name.c_str(), name.length()))
+                    , _asynchronous(false)
+                    , _callback()
+                    , _invoke(callback)
                 {
                 }
+                Entry(const Entry& copy) = default;
+                Entry& operator=(const Entry& rhs) = default;
                 ~Entry()
                 {
-                    if (_asynchronous == true) {
-                        _info._callback.~CallbackFunction();
-                    } else {
-                        _info._invoke.~InvokeFunction();
-                    }
                 }
 
             public:
-                uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response)
+                // FNV-1a, good enough to tell method names apart and cheap to calculate.
+                static uint32_t Hash(const TCHAR name[], const size_t length)
                 {
-                    uint32_t result = ~0;
-                    if (_asynchronous == true) {
-                        _info._callback(connection, parameters);
-                    } else {
-                        result = _info._invoke(method, parameters, response);
-                    }
-                    return (result);
-                }
+                    uint32_t result = 2166136261u;
 
-            private:
-                bool _asynchronous;
-                Functions _info;
-            };
-
-            class Observer {
-            private:
-                Observer(const Observer&) = delete;
-                Observer& operator=(const Observer&) = delete;
+                    for (size_t index = 0; index < length; index++) {
+                        result = (result ^ static_cast<uint8_t>(name[index])) * 16777619u;
+                    }
 
-            public:
-                Observer(const uint32_t id, const string& designator)
-                    : _id(id)
-                    , _designator(designator)
-                {
+                    return (result);
                 }
-                ~Observer()
+                inline const string& Name() const
                 {
+                    return (_name);
                 }
-
-                bool operator==(const Observer& rhs) const
+                inline uint32_t HashValue() const
                 {
-                    return ((rhs._id == _id) && (rhs._designator == _designator));
+                    return (_hash);
                 }
-                bool operator!=(const Observer& rhs) const
+                inline bool IsAsynchronous() const
                 {
-                    return (!operator==(rhs));
+                    return (_asynchronous);
                 }
-
-                uint32_t Id() const
+                inline bool IsEqual(const TCHAR name[], const size_t length) const
                 {
-                    return (_id);
+                    return ((_name.length() == length) && (::memcmp(_name.c_str(), name, length * sizeof(TCHAR)) == 0));
                 }
-                const string& Designator() const
+                uint32_t Invoke(const Connection connection, const string& method, const string& parameters, string& response) const
                 {
-                    return (_designator);
+                    uint32_t result = ~0;
+                    if (_asynchronous == true) {
+                        _callback(connection, parameters);
+                    } else {
+                        result = _invoke(method, parameters, response);
+                    }
+                    return (result);
                 }
 
             private:
-                uint32_t _id;
-                string _designator;
+                string _name;
+                uint32_t _hash;
+                bool _asynchronous;
+                CallbackFunction _callback;
+                InvokeFunction _invoke;
             };
 
-            typedef std::map<const string, Entry> HandlerMap;
-            typedef std::list<Observer> ObserverList;
-            typedef std::map<string, ObserverList> ObserverMap;
+            // The methods, sorted on the hash of their name. They are registered once, but looked up on every
+            // call. The name is taken in place from the designator, hashed, and a binary search on the hash
+            // over this flat table leaves a single name to compare.
+            typedef std::vector<Entry> HandlerMap;
 
+            // Per event, the channels subscribed to it, grouped by the designator (callsign) they subscribed with.
+            // All channels of a group receive the very same message, so it is only formatted once per group.
+            typedef std::vector<uint32_t> ChannelList;
+            typedef std::map<string, ChannelList> DesignatorMap;
+            typedef std::map<string, DesignatorMap> ObserverMap;
+
+        public:
             typedef std::function<void(const uint32_t id, const string& designator, const string& data)> NotificationFunction;
 
+            // Called once per group of channels that subscribed with the same designator, outside of any lock.
+            typedef std::function<void(const ChannelList& ids, const string& designator, const string& data)> BatchNotificationFunction;
+
         public:
             Handler() = delete;
             Handler(const Handler&) = delete;
@@ -408,6 +478,7 @@ namespace Core {
                 , _handlers()
                 , _observers()
                 , _notificationFunction(notificationFunction)
+                , _batchFunction()
                 , _versions(versions)
             {
             }
@@ -416,6 +487,25 @@ namespace Core {
                 , _handlers(copy._handlers)
                 , _observers()
                 , _notificationFunction(notificationFunction)
+                , _batchFunction()
+                , _versions(versions)
+            {
+            }
+            Handler(const BatchNotificationFunction& batchFunction, const std::vector<uint8_t>& versions)
+                : _adminLock()
+                , _handlers()
+                , _observers()
+                , _notificationFunction()
+                , _batchFunction(batchFunction)
+                , _versions(versions)
+            {
+            }
+            Handler(const BatchNotificationFunction& batchFunction, const std::vector<uint8_t>& versions, const Handler& copy)
+                : _adminLock()
+                , _handlers(copy._handlers)
+                , _observers()
+                , _notificationFunction()
+                , _batchFunction(batchFunction)
                 , _versions(versions)
             {
             }
@@ -428,15 +518,11 @@ namespace Core {
             {
                 bool copied = false;
 
-                HandlerMap::const_iterator index = copy._handlers.find(method);
+                HandlerMap::const_iterator index = copy.Find(method.c_str(), method.length());
 
                 if (index != copy._handlers.end()) {
                     copied = true;
-                    const Entry& info(index->second);
-
-                    _handlers.emplace(std::piecewise_construct,
-                        std::forward_as_tuple(method),
-                        std::forward_as_tuple(info));
+                    Insert(*index);
                 }
 
                 return (copied);
@@ -445,7 +531,20 @@ namespace Core {
             // The interface is prepared.
             inline uint32_t Exists(const string& methodName) const
             {
-                return ((_handlers.find(methodName) != _handlers.end()) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+                return (Exists(methodName.c_str(), methodName.length()));
+            }
+            inline uint32_t Exists(const TCHAR methodName[], const size_t length) const
+            {
+                return ((Find(methodName, length) != _handlers.end()) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
+            }
+            // Methods registered with a Connection answer a-synchronously, the response is send later, if at all.
+            inline uint32_t Exists(const TCHAR methodName[], const size_t length, bool& asynchronous) const
+            {
+                HandlerMap::const_iterator index = Find(methodName, length);
+
+                asynchronous = ((index != _handlers.end()) && (index->IsAsynchronous() == true));
+
+                return ((index != _handlers.end()) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY);
             }
             bool HasVersionSupport(const uint8_t number) const
             {
@@ -525,22 +624,18 @@ namespace Core {
                 // Due to versioning, we do allow to overwrite methods that have been registsred.
                 // These are typically methods that are different from the preferred interface..
 
-                _handlers.emplace(std::piecewise_construct,
-                    std::make_tuple(methodName),
-                    std::make_tuple(lambda));
+                Insert(Entry(methodName, lambda));
             }
             void Register(const string& methodName, const CallbackFunction& lambda)
             {
                 // Due to versioning, we do allow to overwrite methods that have been registsred.
                 // These are typically methods that are different from the preferred interface..
 
-                _handlers.emplace(std::piecewise_construct,
-                    std::make_tuple(methodName),
-                    std::make_tuple(lambda));
+                Insert(Entry(methodName, lambda));
             }
             void Unregister(const string& methodName)
             {
-                HandlerMap::iterator index = _handlers.find(methodName);
+                HandlerMap::const_iterator index = Find(methodName.c_str(), methodName.length());
 
                 ASSERT((index != _handlers.end()) && _T("Do not unregister methods that are not registered!!!"));
 
@@ -554,9 +649,12 @@ namespace Core {
 
                 response.clear();
 
-                HandlerMap::iterator index = _handlers.find(Message::Method(method));
+                size_t length;
+                size_t offset = Message::MethodOffset(method, length);
+
+                HandlerMap::const_iterator index = Find(&(method.c_str()[offset]), length);
                 if (index != _handlers.end()) {
-                    result = index->second.Invoke(connection, method, parameters, response);
+                    result = index->Invoke(connection, method, parameters, response);
                 }
                 return (result);
             }
@@ -564,13 +662,10 @@ namespace Core {
             {
                 _adminLock.Lock();
 
-                ObserverMap::iterator index = _observers.find(eventId);
+                ChannelList& channels(_observers[eventId][callsign]);
 
-                if (index == _observers.end()) {
-                    _observers[eventId].emplace_back(id, callsign);
-                    response.Result = _T("0");
-                } else if (std::find(index->second.begin(), index->second.end(), Observer(id, callsign)) == index->second.end()) {
-                    index->second.emplace_back(id, callsign);
+                if (std::find(channels.begin(), channels.end(), id) == channels.end()) {
+                    channels.push_back(id);
                     response.Result = _T("0");
                 } else {
                     response.Error.SetError(Core::ERROR_DUPLICATE_KEY);
@@ -586,20 +681,22 @@ namespace Core {
                 ObserverMap::iterator index = _observers.find(eventId);
 
                 if (index != _observers.end()) {
-                    ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
-                    Observer key(id, callsign);
-
-                    while ((loop != clients.end()) && (*loop != key)) {
-                        loop++;
-                    }
-
-                    if (loop != clients.end()) {
-                        clients.erase(loop);
-                        if (clients.empty() == true) {
-                            _observers.erase(index);
+                    DesignatorMap::iterator group = index->second.find(callsign);
+
+                    if (group != index->second.end()) {
+                        ChannelList& channels = group->second;
+                        ChannelList::iterator loop = std::find(channels.begin(), channels.end(), id);
+
+                        if (loop != channels.end()) {
+                            channels.erase(loop);
+                            if (channels.empty() == true) {
+                                index->second.erase(group);
+                                if (index->second.empty() == true) {
+                                    _observers.erase(index);
+                                }
+                            }
+                            response.Result = _T("0");
                         }
-                        response.Result = _T("0");
                     }
                 }
 
@@ -635,17 +732,20 @@ namespace Core {
                 ObserverMap::iterator index = _observers.begin();
 
                 while (index != _observers.end()) {
-                    ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
+                    DesignatorMap::iterator group = index->second.begin();
+
+                    while (group != index->second.end()) {
+                        ChannelList& channels = group->second;
 
-                    while (loop != clients.end()) {
-                        if (loop->Id() != id) {
-                            loop++;
+                        channels.erase(std::remove(channels.begin(), channels.end(), id), channels.end());
+
+                        if (channels.empty() == true) {
+                            group = index->second.erase(group);
                         } else {
-                            loop = clients.erase(loop);
+                            group++;
                         }
                     }
-                    if (clients.empty() == true) {
+                    if (index->second.empty() == true) {
                         index = _observers.erase(index);
                     } else {
                         index++;
@@ -664,6 +764,30 @@ namespace Core {
             }
 
         private:
+            static bool Before(const Entry& entry, const uint32_t hash)
+            {
+                return (entry.HashValue() < hash);
+            }
+            HandlerMap::const_iterator Find(const TCHAR name[], const size_t length) const
+            {
+                const uint32_t hash = Entry::Hash(name, length);
+                HandlerMap::const_iterator index = std::lower_bound(_handlers.begin(), _handlers.end(), hash, Before);
+
+                while ((index != _handlers.end()) && (index->HashValue() == hash) && (index->IsEqual(name, length) == false)) {
+                    index++;
+                }
+
+                return (((index != _handlers.end()) && (index->HashValue() == hash)) ? index : _handlers.end());
+            }
+            void Insert(const Entry& entry)
+            {
+                // As before, the first registration of a name sticks.
+                if (Find(entry.Name().c_str(), entry.Name().length()) == _handlers.end()) {
+                    _handlers.insert(std::upper_bound(_handlers.begin(), _handlers.end(), entry,
+                                         [](const Entry& lhs, const Entry& rhs) -> bool { return (lhs.HashValue() < rhs.HashValue()); }),
+                        entry);
+                }
+            }
             template <typename PARAMETER, typename GET_METHOD, typename REALOBJECT>
             void InternalProperty(const ::TemplateIntToType<1>&, const string& methodName, const GET_METHOD& getMethod, REALOBJECT* objectPtr)
             {
@@ -782,30 +906,27 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD>
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method)
             {
-                std::function<uint32_t()> actualMethod = method;
-                InvokeFunction implementation = [actualMethod](const string&, const string&, string&) -> uint32_t {
-                    return (actualMethod());
+                InvokeFunction implementation = [method](const string&, const string&, string&) mutable -> uint32_t {
+                    return (method());
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD>
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method)
             {
-                std::function<uint32_t(const INBOUND&)> actualMethod = method;
-                InvokeFunction implementation = [actualMethod](const string&, const string& parameters, string&) -> uint32_t {
+                InvokeFunction implementation = [method](const string&, const string& parameters, string&) mutable -> uint32_t {
                     INBOUND inbound;
                     inbound.FromString(parameters);
-                    return (actualMethod(inbound));
+                    return (method(inbound));
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD>
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                std::function<uint32_t(OUTBOUND&)> actualMethod = method;
-                InvokeFunction implementation = [actualMethod](const string&, const string&, string& result) -> uint32_t {
+                InvokeFunction implementation = [method](const string&, const string&, string& result) mutable -> uint32_t {
                     OUTBOUND outbound;
-                    uint32_t code = actualMethod(outbound);
+                    uint32_t code = method(outbound);
                     if (code == Core::ERROR_NONE) {
                         outbound.ToString(result);
                     } else {
@@ -818,12 +939,11 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD>
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                std::function<uint32_t(const INBOUND&, OUTBOUND&)> actualMethod = method;
-                InvokeFunction implementation = [actualMethod](const string&, const string& parameters, string& result) -> uint32_t {
+                InvokeFunction implementation = [method](const string&, const string& parameters, string& result) mutable -> uint32_t {
                     INBOUND inbound;
                     OUTBOUND outbound;
                     inbound.FromString(parameters);
-                    uint32_t code = actualMethod(inbound, outbound);
+                    uint32_t code = method(inbound, outbound);
                     if (code == Core::ERROR_NONE) {
                         outbound.ToString(result);
                     } else {
@@ -836,30 +956,30 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT>
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<uint32_t()> actualMethod = std::bind(method, objectPtr);
-                InvokeFunction implementation = [actualMethod](const string&, const string&, string&) -> uint32_t {
-                    return (actualMethod());
+                ASSERT(objectPtr != nullptr);
+                InvokeFunction implementation = [objectPtr, method](const string&, const string&, string&) -> uint32_t {
+                    return ((objectPtr->*method)());
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT>
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<uint32_t(const INBOUND&)> actualMethod = std::bind(method, objectPtr, std::placeholders::_1);
-                InvokeFunction implementation = [actualMethod](const string&, const string& parameters, string&) -> uint32_t {
+                ASSERT(objectPtr != nullptr);
+                InvokeFunction implementation = [objectPtr, method](const string&, const string& parameters, string&) -> uint32_t {
                     INBOUND inbound;
                     inbound.FromString(parameters);
-                    return (actualMethod(inbound));
+                    return ((objectPtr->*method)(inbound));
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT>
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<uint32_t(OUTBOUND&)> actualMethod = std::bind(method, objectPtr, std::placeholders::_1);
-                InvokeFunction implementation = [actualMethod](const string&, const string&, string& result) -> uint32_t {
+                ASSERT(objectPtr != nullptr);
+                InvokeFunction implementation = [objectPtr, method](const string&, const string&, string& result) -> uint32_t {
                     OUTBOUND outbound;
-                    uint32_t code = actualMethod(outbound);
+                    uint32_t code = (objectPtr->*method)(outbound);
                     if (code == Core::ERROR_NONE) {
                         outbound.ToString(result);
                     } else {
@@ -872,12 +992,12 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT>
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<uint32_t(const INBOUND&, OUTBOUND&)> actualMethod = std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2);
-                InvokeFunction implementation = [actualMethod](const string&, const string& parameters, string& result) -> uint32_t {
+                ASSERT(objectPtr != nullptr);
+                InvokeFunction implementation = [objectPtr, method](const string&, const string& parameters, string& result) -> uint32_t {
                     INBOUND inbound;
                     OUTBOUND outbound;
                     inbound.FromString(parameters);
-                    uint32_t code = actualMethod(inbound, outbound);
+                    uint32_t code = (objectPtr->*method)(inbound, outbound);
                     if (code == Core::ERROR_NONE) {
                         outbound.ToString(result);
                     } else {
@@ -890,70 +1010,78 @@ namespace Core {
             template <typename INBOUND, typename METHOD>
             void InternalAnnounce(const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method)
             {
-                std::function<void(const Core::JSONRPC::Connection&)> actualMethod = method;
-                CallbackFunction implementation = [actualMethod](const Connection& connection, const string&) -> void {
-                    actualMethod(connection);
+                CallbackFunction implementation = [method](const Connection& connection, const string&) mutable -> void {
+                    method(connection);
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename METHOD>
             void InternalAnnounce(const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                std::function<void(const Core::JSONRPC::Connection&, const INBOUND&)> actualMethod = method;
-                CallbackFunction implementation = [actualMethod](const Connection& connection, const string& parameters) -> void {
+                CallbackFunction implementation = [method](const Connection& connection, const string& parameters) mutable -> void {
                     INBOUND inbound;
                     inbound.FromString(parameters);
-                    actualMethod(connection, inbound);
+                    method(connection, inbound);
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename METHOD, typename REALOBJECT>
             void InternalAnnounce(const ::TemplateIntToType<1>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<void(const Core::JSONRPC::Connection&)> actualMethod = std::bind(method, objectPtr, std::placeholders::_1);
-                CallbackFunction implementation = [actualMethod](const Connection& connection, const string&) -> void {
-                    actualMethod(connection);
+                ASSERT(objectPtr != nullptr);
+                CallbackFunction implementation = [objectPtr, method](const Connection& connection, const string&) -> void {
+                    (objectPtr->*method)(connection);
                 };
                 Register(methodName, implementation);
             }
             template <typename INBOUND, typename METHOD, typename REALOBJECT>
             void InternalAnnounce(const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                std::function<void(const Core::JSONRPC::Connection&, const INBOUND&)> actualMethod = std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2);
-                CallbackFunction implementation = [actualMethod](const Connection& connection, const string& parameters) -> void {
+                ASSERT(objectPtr != nullptr);
+                CallbackFunction implementation = [objectPtr, method](const Connection& connection, const string& parameters) -> void {
                     INBOUND inbound;
                     inbound.FromString(parameters);
-                    actualMethod(connection, inbound);
+                    (objectPtr->*method)(connection, inbound);
                 };
                 Register(methodName, implementation);
             }
             uint32_t InternalNotify(const string& event, const string& parameters, std::function<bool(const string&)>&& sendifmethod = std::function<bool(const string&)>())
             {
                 uint32_t result = Core::ERROR_UNKNOWN_KEY;
+                DesignatorMap recipients;
 
+                // Only hold the lock for taking a copy of the subscribers, the channels of a subscriber that
+                // does not keep up should not block the notifier or any (un)subscribe.
                 _adminLock.Lock();
 
-                ObserverMap::iterator index = _observers.find(event);
+                ObserverMap::const_iterator index = _observers.find(event);
 
                 if (index != _observers.end()) {
-                    ObserverList& clients = index->second;
-                    ObserverList::iterator loop = clients.begin();
-
+                    recipients = index->second;
                     result = Core::ERROR_NONE;
+                }
 
-                    while (loop != clients.end()) {
-                        const string& designator(loop->Designator());
+                _adminLock.Unlock();
 
-                        if (!sendifmethod || sendifmethod(designator)) {
+                DesignatorMap::const_iterator group = recipients.begin();
 
-                            _notificationFunction(loop->Id(), (designator.empty() == false ? designator + '.' + event : event), parameters);
-                        }
+                while (group != recipients.end()) {
+                    const string& designator(group->first);
 
-                        loop++;
+                    if (!sendifmethod || sendifmethod(designator)) {
+                        const string method(designator.empty() == false ? designator + '.' + event : event);
+
+                        if (_batchFunction) {
+                            _batchFunction(group->second, method, parameters);
+                        } else {
+                            for (const uint32_t id : group->second) {
+                                _notificationFunction(id, method, parameters);
+                            }
+                        }
                     }
-                }
 
-                _adminLock.Unlock();
+                    group++;
+                }
 
                 return (result);
             }
@@ -963,6 +1091,7 @@ namespace Core {
             HandlerMap _handlers;
             ObserverMap _observers;
             NotificationFunction _notificationFunction;
+            BatchNotificationFunction _batchFunction;
             const std::vector<uint8_t> _versions;
         };
 
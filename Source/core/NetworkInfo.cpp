@@ -58,6 +58,7 @@ namespace Core {
 #define FREE(x) HeapFree(GetProcessHeap(), 0, (x))
 
     static uint16_t AdapterCount = 0;
+    static uint32_t AdapterVersion = 0;
     static PIP_ADAPTER_ADDRESSES _interfaceInfo = nullptr;
 
     static PIP_ADAPTER_ADDRESSES LoadAdapterInfo(const uint16_t adapterIndex)
@@ -413,6 +414,12 @@ namespace Core {
         FREE(_interfaceInfo);
 
         _interfaceInfo = nullptr;
+        AdapterVersion++;
+    }
+
+    /* static */ uint32_t AdapterIterator::Version()
+    {
+        return (AdapterVersion);
     }
 
     uint32_t AdapterIterator::Up(const bool)
@@ -967,9 +974,9 @@ namespace Core {
             void Update(const struct rtattr* rtatp, const uint16_t length)
             {
 
-                uint16_t rtattrlen = length;
+                int rtattrlen = length;
 
-                for (; RTA_OK(rtatp, length); rtatp = RTA_NEXT(rtatp, rtattrlen)) {
+                for (; RTA_OK(rtatp, rtattrlen); rtatp = RTA_NEXT(rtatp, rtattrlen)) {
 
                     /* Here we hit the fist chunk of the message. Time to validate the    *
              * the type. For more info on the different types see man(7) rtnetlink*
@@ -1047,12 +1054,12 @@ namespace Core {
                     }
                 }
             }
-            void Update(const struct rtattr* rtatp, const uint16_t length, const uint8_t prefixlen)
+            void Update(const struct rtattr* rtatp, const uint16_t length, const uint8_t prefixlen, const bool add = true)
             {
 
-                uint16_t rtattrlen = length;
+                int rtattrlen = length;
 
-                for (; RTA_OK(rtatp, length); rtatp = RTA_NEXT(rtatp, rtattrlen)) {
+                for (; RTA_OK(rtatp, rtattrlen); rtatp = RTA_NEXT(rtatp, rtattrlen)) {
 
                     /* Here we hit the fist chunk of the message. Time to validate the    *
              * the type. For more info on the different types see man(7) rtnetlink*
@@ -1082,31 +1089,31 @@ namespace Core {
                      _ipv4Nodes.push_back(IPNode(*reinterpret_cast<const struct in_addr *>(RTA_DATA(rtatp)), prefixlen));
                  else */
                         if (RTA_PAYLOAD(rtatp) == 16)
-                            _ipv6Nodes.push_back(IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv6Nodes, IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         break;
                     case IFA_LOCAL:
                         if (RTA_PAYLOAD(rtatp) == 4)
-                            _ipv4Nodes.push_back(IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv4Nodes, IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         else if (RTA_PAYLOAD(rtatp) == 16)
-                            _ipv6Nodes.push_back(IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv6Nodes, IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         break;
                     case IFA_BROADCAST:
                         if (RTA_PAYLOAD(rtatp) == 4)
-                            _ipv4Nodes.push_back(IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv4Nodes, IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         else if (RTA_PAYLOAD(rtatp) == 16)
-                            _ipv6Nodes.push_back(IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv6Nodes, IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         break;
                     case IFA_ANYCAST:
                         if (RTA_PAYLOAD(rtatp) == 4)
-                            _ipv4Nodes.push_back(IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv4Nodes, IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         else if (RTA_PAYLOAD(rtatp) == 16)
-                            _ipv6Nodes.push_back(IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv6Nodes, IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         break;
                     case IFA_MULTICAST:
                         if (RTA_PAYLOAD(rtatp) == 4)
-                            _ipv4Nodes.push_back(IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv4Nodes, IPNode(*reinterpret_cast<const struct in_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         else if (RTA_PAYLOAD(rtatp) == 16)
-                            _ipv6Nodes.push_back(IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen));
+                            Store(_ipv6Nodes, IPNode(*reinterpret_cast<const struct in6_addr*>(RTA_DATA(rtatp)), prefixlen), add);
                         break;
                     case IFA_LABEL:
                         //   _name = string(reinterpret_cast<const char*>(RTA_DATA(rtatp)), (RTA_PAYLOAD(rtatp) - 1));
@@ -1129,6 +1136,21 @@ namespace Core {
             {
                 _channel = channel;
             }
+            // The kernel reports an address again when it changes, e.g. its lifetime, keep it only once.
+            static void Store(std::list<IPNode>& nodes, const IPNode& node, const bool add)
+            {
+                std::list<IPNode>::iterator index(nodes.begin());
+
+                while ((index != nodes.end()) && ((*index != node) || (index->Mask() != node.Mask()))) {
+                    index++;
+                }
+
+                if ((add == true) && (index == nodes.end())) {
+                    nodes.push_back(node);
+                } else if ((add == false) && (index != nodes.end())) {
+                    nodes.erase(index);
+                }
+            }
 
         private:
             uint8_t _MAC[6];
@@ -1139,12 +1161,49 @@ namespace Core {
             ProxyType<Channel> _channel;
         };
 
+    private:
+        class ChangesType : public Netlink {
+        private:
+            ChangesType() = delete;
+            ChangesType(const ChangesType&) = delete;
+            ChangesType& operator=(const ChangesType&) = delete;
+
+        public:
+            ChangesType(IPNetworks& parent)
+                : _parent(parent)
+            {
+            }
+            virtual ~ChangesType()
+            {
+            }
+
+        private:
+            virtual uint16_t Write(uint8_t[], const uint16_t) const override
+            {
+                return (0);
+            }
+            virtual uint16_t Read(const uint8_t stream[], const uint16_t length) override
+            {
+                string name;
+
+                _parent.Apply(Type(), stream, length, name);
+
+                // Keep on going, a single datagram can hold many changes.
+                return (length);
+            }
+
+        private:
+            IPNetworks& _parent;
+        };
+
     public:
         typedef IteratorMapType<std::map<uint32_t, Network>, Network&, uint32_t> Iterator;
 
     public:
         IPNetworks()
-            : _channel(ProxyType<Channel>::Create())
+            : _adminLock()
+            , _version(0)
+            , _channel(ProxyType<Channel>::Create())
             , _networks()
         {
 
@@ -1165,6 +1224,18 @@ namespace Core {
         {
             return ((_channel.IsValid()) && (_channel->IsValid() == true));
         }
+        inline void Lock() const
+        {
+            _adminLock.Lock();
+        }
+        inline void Unlock() const
+        {
+            _adminLock.Unlock();
+        }
+        inline uint32_t Version() const
+        {
+            return (_version);
+        }
         Network& operator[](const uint32_t networkId)
         {
             std::map<uint32_t, Network>::iterator index(_networks.find(networkId));
@@ -1187,6 +1258,8 @@ namespace Core {
 
             if (IsValid() == true) {
 
+                _adminLock.Lock();
+
                 _networks.clear();
 
                 InterfacesFetchType ifInfo(_networks);
@@ -1211,10 +1284,63 @@ namespace Core {
                         }
                     }
                 }
+
+                _version++;
+
+                _adminLock.Unlock();
             }
         }
+        void Ingest(const uint8_t stream[], const uint16_t length)
+        {
+            ChangesType changes(*this);
+
+            changes.Deserialize(stream, length);
+        }
+        // Applies a single change as reported by the kernel, name is set to the adapter it applies to.
+        void Apply(const uint32_t type, const uint8_t stream[], const uint16_t length, string& name)
+        {
+            _adminLock.Lock();
+
+            if (((type == RTM_NEWLINK) || (type == RTM_DELLINK)) && (length >= sizeof(struct ifinfomsg))) {
+                const struct ifinfomsg* iface = reinterpret_cast<const struct ifinfomsg*>(stream);
+                std::map<uint32_t, Network>::iterator index(_networks.find(iface->ifi_index));
+
+                if (type == RTM_DELLINK) {
+                    if (index != _networks.end()) {
+                        name = index->second.Name();
+                        _networks.erase(index);
+                        _version++;
+                    }
+                } else if (index == _networks.end()) {
+                    index = _networks.emplace(std::piecewise_construct,
+                                         std::forward_as_tuple(iface->ifi_index),
+                                         std::forward_as_tuple(iface->ifi_index, reinterpret_cast<const struct rtattr*>(IFLA_RTA(iface)), length - sizeof(struct ifinfomsg)))
+                                .first;
+                    index->second.Info(_channel);
+                    name = index->second.Name();
+                    _version++;
+                } else {
+                    index->second.Update(reinterpret_cast<const struct rtattr*>(IFLA_RTA(iface)), length - sizeof(struct ifinfomsg));
+                    name = index->second.Name();
+                    _version++;
+                }
+            } else if (((type == RTM_NEWADDR) || (type == RTM_DELADDR)) && (length >= sizeof(struct ifaddrmsg))) {
+                const struct ifaddrmsg* rtmp = reinterpret_cast<const struct ifaddrmsg*>(stream);
+                std::map<uint32_t, Network>::iterator index(_networks.find(rtmp->ifa_index));
+
+                if (index != _networks.end()) {
+                    index->second.Update(reinterpret_cast<const struct rtattr*>(IFA_RTA(rtmp)), length - sizeof(struct ifaddrmsg), static_cast<uint8_t>(rtmp->ifa_prefixlen), (type == RTM_NEWADDR));
+                    name = index->second.Name();
+                    _version++;
+                }
+            }
+
+            _adminLock.Unlock();
+        }
 
     private:
+        mutable CriticalSection _adminLock;
+        std::atomic<uint32_t> _version;
         ProxyType<Channel> _channel;
         std::map<uint32_t, Network> _networks;
         Network _invalidNetwork;
@@ -1248,7 +1374,8 @@ namespace Core {
         , _index(static_cast<uint16_t>(~0))
         , _count(0)
     {
-        // Just a dummy load so we have the info
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(adapter));
 
         if (network.IsValid() == true) {
@@ -1258,11 +1385,15 @@ namespace Core {
             // Best case, linux attaches 1 IPV4 to 1 adapter.
             _count = network.IPv4Nodes().Count();
         }
+
+        networkController.Unlock();
     }
     IPNode IPV4AddressIterator::Address() const
     {
         IPNode result;
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController[_adapter]);
 
         if (network.IsValid() == true) {
@@ -1274,11 +1405,14 @@ namespace Core {
                 count--;
             }
 
-            ASSERT(index.IsValid());
-
-            result = (*index);
+            // The address might have been removed since this iterator was created.
+            if (index.IsValid() == true) {
+                result = (*index);
+            }
         }
 
+        networkController.Unlock();
+
         return (result);
     }
 
@@ -1287,6 +1421,8 @@ namespace Core {
         , _index(static_cast<uint16_t>(~0))
         , _count(0)
     {
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(adapter));
 
         if (network.IsValid() == true) {
@@ -1296,12 +1432,16 @@ namespace Core {
             // Best case, linux attaches 1 IPV4 to 1 adapter.
             _count = network.IPv6Nodes().Count();
         }
+
+        networkController.Unlock();
     }
 
     IPNode IPV6AddressIterator::Address() const
     {
         IPNode result;
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController[_adapter]);
 
         if (network.IsValid() == true) {
@@ -1313,11 +1453,14 @@ namespace Core {
                 count--;
             }
 
-            ASSERT(index.IsValid());
-
-            result = (*index);
+            // The address might have been removed since this iterator was created.
+            if (index.IsValid() == true) {
+                result = (*index);
+            }
         }
 
+        networkController.Unlock();
+
         return (result);
     }
 
@@ -1326,21 +1469,44 @@ namespace Core {
         networkController.Reload();
     }
 
+    /* static */ uint32_t AdapterIterator::Version()
+    {
+        return (networkController.Version());
+    }
+
+    /* static */ void AdapterIterator::Ingest(const uint8_t stream[], const uint16_t length)
+    {
+        networkController.Ingest(stream, length);
+    }
+
     uint16_t AdapterIterator::Count() const
     {
-        // Just a dummy load so we have the info
-        return (networkController.Count());
+        networkController.Lock();
+
+        uint16_t result = networkController.Count();
+
+        networkController.Unlock();
+
+        return (result);
     }
 
     string AdapterIterator::Name() const
     {
+        string result;
+
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(_index));
 
         ASSERT(network.IsValid());
 
-        return (network.Name());
+        result = network.Name();
+
+        networkController.Unlock();
+
+        return (result);
     }
 
     string AdapterIterator::MACAddress(const char delimiter) const
@@ -1350,12 +1516,16 @@ namespace Core {
 
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(_index));
 
         ASSERT(network.IsValid());
 
         network.MAC(MAC, sizeof(MAC));
 
+        networkController.Unlock();
+
         ConvertMACToString(MAC, sizeof(MAC), delimiter, result);
 
         return (result);
@@ -1365,11 +1535,15 @@ namespace Core {
     {
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(_index));
 
         ASSERT(network.IsValid());
 
         network.MAC(buffer, length);
+
+        networkController.Unlock();
     }
 
     bool AdapterIterator::IsUp() const
@@ -1491,11 +1665,17 @@ namespace Core {
 
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(_index));
 
         ASSERT(network.IsValid());
 
-        return (network.Add(address));
+        uint32_t result = network.Add(address);
+
+        networkController.Unlock();
+
+        return (result);
     }
 
     uint32_t AdapterIterator::Delete(const IPNode& address)
@@ -1503,11 +1683,17 @@ namespace Core {
 
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& network(networkController.Index(_index));
 
         ASSERT(network.IsValid());
 
-        return (network.Delete(address));
+        uint32_t result = network.Delete(address);
+
+        networkController.Unlock();
+
+        return (result);
     }
 
     uint32_t AdapterIterator::Gateway(const IPNode& network, const NodeId& gateway)
@@ -1515,11 +1701,17 @@ namespace Core {
 
         ASSERT(IsValid());
 
+        networkController.Lock();
+
         IPNetworks::Network& adapter(networkController.Index(_index));
 
         ASSERT(adapter.IsValid());
 
-        return (adapter.Gateway(network, gateway));
+        uint32_t result = adapter.Gateway(network, gateway);
+
+        networkController.Unlock();
+
+        return (result);
     }
 
 #endif
@@ -1531,42 +1723,23 @@ namespace Core {
     }
     /* virtual */ uint16_t AdapterObserver::Observer::Message::Read(const uint8_t stream[], const uint16_t length)
     {
-        uint16_t result = 0;
-        const struct ifinfomsg* ifi = reinterpret_cast<const struct ifinfomsg*>(stream);
         string interfaceName;
 
-        if (Type() == RTM_NEWLINK) {
-            const IPNetworks::Network& network(networkController[ifi->ifi_index]);
-            if (network.IsValid() == false) {
-                AdapterIterator::Flush();
-                const IPNetworks::Network& network(networkController[ifi->ifi_index]);
-                if (network.IsValid() == true) {
-                    interfaceName = network.Name();
-                }
-            } else {
-                interfaceName = network.Name();
-            }
-        } else if (Type() == RTM_DELLINK) {
-            const IPNetworks::Network& network(networkController[ifi->ifi_index]);
+        // Keep the adapters in memory up to date with the change itself, no need to reload them all.
+        networkController.Apply(Type(), stream, length, interfaceName);
 
-            if (network.IsValid() == true) {
-
-                interfaceName = network.Name();
-                AdapterIterator::Flush();
-            }
-        }
-
-        if (interfaceName.empty() == false) {
+        // Address changes only update the adapter information, observers are told about the adapters.
+        if ((interfaceName.empty() == false) && ((Type() == RTM_NEWLINK) || (Type() == RTM_DELLINK))) {
             _callback->Event(interfaceName.c_str());
-            result = length;
         }
-        return (result);
+
+        return (length);
     }
 
     AdapterObserver::Observer::Observer(INotification* callback)
         : SocketDatagram(
               true,
-              NodeId(NETLINK_ROUTE, 0, RTMGRP_LINK),
+              NodeId(NETLINK_ROUTE, 0, RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR),
               NodeId(),
               64,
               4000)
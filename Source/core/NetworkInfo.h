@@ -248,7 +248,17 @@ namespace Core {
         bool IsRunning() const;
         uint32_t Up(const bool enabled);
 
+        // The adapters and their addresses are kept in memory, loaded once and kept up to date from the
+        // changes the kernel reports to an open AdapterObserver. Flush reloads them all.
         static void Flush();
+        // Changes whenever an adapter or one of its addresses changes, a cheap way to see whether
+        // iterators created earlier are still current.
+        static uint32_t Version();
+#ifndef __WIN32__
+        // Applies rtnetlink messages (RTM_NEWLINK, RTM_DELLINK, RTM_NEWADDR, RTM_DELADDR), as received from
+        // the kernel, to the adapters kept in memory.
+        static void Ingest(const uint8_t stream[], const uint16_t length);
+#endif
         uint16_t Count() const;
         string Name() const;
 
@@ -6,6 +6,10 @@
 #include "Module.h"
 #include "Portability.h"
 
+#ifdef __LINUX__
+#include <sys/syscall.h>
+#endif
+
 namespace WPEFramework {
 namespace Core {
 
@@ -594,7 +598,37 @@ namespace Core {
             }
             return (Core::ERROR_TIMEDOUT);
 #else
+            uint32_t result = Core::ERROR_NONE;
             uint32_t timeLeft(waitTime);
+            int descriptor = (IsActive() == true ? Descriptor(_PID) : -1);
+
+            if (descriptor != -1) {
+                // No need to poll, the descriptor turns readable the moment the process is gone.
+                const uint64_t end = (waitTime == Core::infinite ? 0 : Core::Time::Now().Add(waitTime).Ticks());
+                struct pollfd entry;
+                int outcome;
+
+                entry.fd = descriptor;
+                entry.events = POLLIN;
+
+                do {
+                    const uint64_t now = Core::Time::Now().Ticks();
+
+                    entry.revents = 0;
+                    outcome = ::poll(&entry, 1, (end == 0 ? -1 : (now >= end ? 0 : static_cast<int>((end - now) / Core::Time::TicksPerMillisecond) + 1)));
+
+                    // A signal delivered to this thread only interrupts the wait, it does not end it.
+                } while ((outcome < 0) && (errno == EINTR));
+
+                if (outcome < 0) {
+                    TRACE_L1("Waiting for process %d failed, error: %d", _PID, errno);
+                    result = Core::ERROR_GENERAL;
+                }
+
+                ::close(descriptor);
+                timeLeft = 0;
+            }
+
             while ((IsActive() == true) && (timeLeft > 0)) {
                 if (timeLeft == Core::infinite) {
                     SleepMs(500);
@@ -607,7 +641,11 @@ namespace Core {
                 }
             }
 
-            return ((IsActive() == false) ? Core::ERROR_NONE : Core::ERROR_TIMEDOUT);
+            if (result == Core::ERROR_NONE) {
+                result = ((IsActive() == false) ? Core::ERROR_NONE : Core::ERROR_TIMEDOUT);
+            }
+
+            return (result);
 #endif
         }
 
@@ -616,6 +654,21 @@ namespace Core {
             return (_exitCode);
         }
 
+#ifdef __LINUX__
+        // A pidfd (Linux 5.3 and up): a file descriptor that becomes readable once the process terminated,
+        // so its exit can be awaited with poll or a ResourceMonitor. It works for any process, not only for
+        // children. Returns -1 if the kernel does not offer it (errno ENOSYS) or the process is gone (ESRCH).
+        static int Descriptor(const uint32_t pid)
+        {
+#ifdef __NR_pidfd_open
+            return (static_cast<int>(::syscall(__NR_pidfd_open, static_cast<pid_t>(pid), 0)));
+#else
+            errno = ENOSYS;
+            return (-1);
+#endif
+        }
+#endif
+
         Process(uint32_t pid)
             : _argc(0)
             , _parameters(nullptr)
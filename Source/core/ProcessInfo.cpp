@@ -362,6 +362,96 @@ namespace Core {
 
         return (result);
     }
+    ProcessStatistics::ProcessStatistics(const uint32_t id)
+        : _pid(id)
+#ifndef __WIN32__
+        , _stat(-1)
+        , _statm(-1)
+        , _smaps(-1)
+#endif
+    {
+#ifndef __WIN32__
+        TCHAR buffer[64];
+
+        snprintf(buffer, sizeof(buffer), "/proc/%d/stat", _pid);
+        _stat = open(buffer, O_RDONLY | O_CLOEXEC);
+        snprintf(buffer, sizeof(buffer), "/proc/%d/statm", _pid);
+        _statm = open(buffer, O_RDONLY | O_CLOEXEC);
+        // Since Linux 4.14, before that the PSS can only be had by summing all of smaps, which is too expensive.
+        snprintf(buffer, sizeof(buffer), "/proc/%d/smaps_rollup", _pid);
+        _smaps = open(buffer, O_RDONLY | O_CLOEXEC);
+#endif
+    }
+    ProcessStatistics::~ProcessStatistics()
+    {
+#ifndef __WIN32__
+        if (_stat != -1) {
+            close(_stat);
+        }
+        if (_statm != -1) {
+            close(_statm);
+        }
+        if (_smaps != -1) {
+            close(_smaps);
+        }
+#endif
+    }
+    bool ProcessStatistics::Measure(Sample& sample) const
+    {
+        bool result = false;
+
+        ::memset(&sample, 0, sizeof(sample));
+
+#ifndef __WIN32__
+        static const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+
+        char buffer[1024];
+        ssize_t length;
+
+        // The descriptors stay bound to the process they were opened for, once it is gone reading them fails.
+        if ((_stat != -1) && ((length = pread(_stat, buffer, sizeof(buffer) - 1, 0)) > 0)) {
+            buffer[length] = '\0';
+
+            // The name of the process is between parentheses and may contain anything, skip past it.
+            const char* fields = strrchr(buffer, ')');
+            unsigned long long utime, stime;
+            long threads;
+
+            if ((fields != nullptr) && (sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %*d %*d %*d %*d %ld", &utime, &stime, &threads) == 3)) {
+                sample.CPUTime = ((utime + stime) * 1000) / ticksPerSecond;
+                sample.Threads = static_cast<uint32_t>(threads);
+                result = true;
+            }
+        }
+
+        if ((result == true) && ((length = pread(_statm, buffer, sizeof(buffer) - 1, 0)) > 0)) {
+            buffer[length] = '\0';
+
+            unsigned long long size, resident, shared;
+
+            if (sscanf(buffer, "%llu %llu %llu", &size, &resident, &shared) == 3) {
+                sample.Allocated = size * PageSize;
+                sample.Resident = resident * PageSize;
+                sample.Shared = shared * PageSize;
+            }
+        }
+
+        if ((result == true) && (_smaps != -1) && ((length = pread(_smaps, buffer, sizeof(buffer) - 1, 0)) > 0)) {
+            buffer[length] = '\0';
+
+            const char* line = strstr(buffer, "\nPss:");
+            if (line != nullptr) {
+                sample.Proportional = strtoull(line + 5, nullptr, 10) * 1024;
+            }
+            line = strstr(buffer, "\nSwap:");
+            if (line != nullptr) {
+                sample.Swap = strtoull(line + 6, nullptr, 10) * 1024;
+            }
+        }
+#endif
+
+        return (result);
+    }
     string ProcessInfo::Name() const
     {
 #ifdef __WIN32__
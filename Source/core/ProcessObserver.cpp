@@ -0,0 +1,86 @@
+#include "ProcessObserver.h"
+#include "IIterator.h"
+#include "Process.h"
+
+namespace WPEFramework {
+
+namespace Core {
+
+    ProcessObserver::ProcessObserver(ICallback* callback)
+        : _callback(callback)
+        , _pid(0)
+        , _descriptor(-1)
+        , _exited(false)
+    {
+        ASSERT(callback != nullptr);
+    }
+    /* virtual */ ProcessObserver::~ProcessObserver()
+    {
+        Close();
+    }
+
+    uint32_t ProcessObserver::Open(const uint32_t pid)
+    {
+        uint32_t result = ERROR_ILLEGAL_STATE;
+
+        ASSERT(pid != 0);
+
+        if (_descriptor == -1) {
+#ifdef __LINUX__
+            _descriptor = Process::Descriptor(pid);
+
+            if (_descriptor != -1) {
+                _pid = pid;
+                _exited = false;
+                result = ERROR_NONE;
+
+                ResourceMonitor::Instance().Register(*this);
+            } else if (errno == ESRCH) {
+                // Too late, there is nothing to observe anymore.
+                result = ERROR_PROCESS_TERMINATED;
+            } else {
+                TRACE_L1("No pidfd available for process %d, error: %d", pid, errno);
+                result = ERROR_UNAVAILABLE;
+            }
+#else
+            result = ERROR_UNAVAILABLE;
+#endif
+        }
+
+        return (result);
+    }
+
+    void ProcessObserver::Close()
+    {
+        if (_descriptor != -1) {
+            // Waits for a running Handle() to complete, after this the callback will not be called anymore.
+            ResourceMonitor::Instance().Unregister(*this);
+
+#ifdef __LINUX__
+            ::close(_descriptor);
+#endif
+            _descriptor = -1;
+        }
+    }
+
+    /* virtual */ IResource::handle ProcessObserver::Descriptor() const
+    {
+        return (static_cast<IResource::handle>(_descriptor));
+    }
+
+    /* virtual */ uint16_t ProcessObserver::Events()
+    {
+        // Once reported, the descriptor stays readable, time to leave the monitor.
+        return (_exited == true ? 0 : POLLIN);
+    }
+
+    /* virtual */ void ProcessObserver::Handle(const uint16_t events)
+    {
+        if (((events & POLLIN) != 0) && (_exited == false)) {
+            _exited = true;
+
+            _callback->Exited(_pid);
+        }
+    }
+}
+} // namespace WPEFramework::Core
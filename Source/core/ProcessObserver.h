@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Module.h"
+#include "ResourceMonitor.h"
+
+#include <atomic>
+
+namespace WPEFramework {
+namespace Core {
+
+    // Reports the exit of a process as an event of the ResourceMonitor, instead of finding out by
+    // polling the process. It is based on a pidfd, so it needs Linux 5.3 or up, Open() returns
+    // ERROR_UNAVAILABLE on kernels without it and the owner has to fall back to polling.
+    // The callback is invoked exactly once, on the ResourceMonitor thread, while the monitor is
+    // locked: it should not block on locks held by threads that Open() or Close() observers.
+    class EXTERNAL ProcessObserver : public IResource {
+    public:
+        struct ICallback {
+            virtual ~ICallback() = default;
+
+            virtual void Exited(const uint32_t pid) = 0;
+        };
+
+    public:
+        ProcessObserver() = delete;
+        ProcessObserver(const ProcessObserver&) = delete;
+        ProcessObserver& operator=(const ProcessObserver&) = delete;
+
+        ProcessObserver(ICallback* callback);
+        virtual ~ProcessObserver();
+
+    public:
+        inline uint32_t Id() const
+        {
+            return (_pid);
+        }
+        inline bool IsOpen() const
+        {
+            return (_descriptor != -1);
+        }
+        inline bool HasExited() const
+        {
+            return (_exited);
+        }
+        uint32_t Open(const uint32_t pid);
+        void Close();
+
+    private:
+        virtual IResource::handle Descriptor() const override;
+        virtual uint16_t Events() override;
+        virtual void Handle(const uint16_t events) override;
+
+    private:
+        ICallback* _callback;
+        uint32_t _pid;
+        int _descriptor;
+        std::atomic<bool> _exited;
+    };
+}
+} // namespace Core
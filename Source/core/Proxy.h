@@ -18,7 +18,10 @@
 #define __PROXY_H
 
 // ---- Include system wide include files ----
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <vector>
 
 // ---- Include local include files ----
 #include "StateTrigger.h"
@@ -971,9 +974,8 @@ namespace Core {
 
                     baseElement->__Clear<PROXYPOOLELEMENT>();
 
-                    Core::ProxyType<ThisClass> returnObject(static_cast<IReferenceCounted*>(baseElement), baseElement);
-
-                    _queue.Return(returnObject);
+                    // Parked in the pool without any reference, the next Element() hands out the first one.
+                    _queue.Return(baseElement);
 
                     return (Core::ERROR_DESTRUCTION_SUCCEEDED);
                 }
@@ -1049,15 +1051,50 @@ namespace Core {
     private:
         typedef ProxyObjectType<PROXYPOOLELEMENT> ProxyPoolElement;
 
+        // Every thread takes and returns elements through a small cache of its own (a magazine), so
+        // only when a magazine runs empty or full, half of it is exchanged with the shared queue under
+        // the lock. A magazine is guarded by a flag, if it is in use (more threads than magazines
+        // share it), the shared queue is used directly. Nobody ever waits for a magazine.
+        struct Magazine {
+            std::atomic_flag Busy;
+            uint8_t Count;
+            uint32_t Hits;
+            ProxyPoolElement* Elements[16];
+            uint8_t Padding[64];
+        };
+
+        static constexpr uint8_t Magazines = 8;
+        static constexpr uint8_t MaxMagazineSize = sizeof(Magazine::Elements) / sizeof(ProxyPoolElement*);
+
+    public:
+        static constexpr uint8_t DefaultMagazineSize = 8;
+
+        struct Statistics {
+            uint32_t Created; // Misses, elements that had to be allocated.
+            uint32_t Cached; // Hits on the magazine of the requesting thread.
+            uint32_t Pooled; // Hits on the shared queue.
+            uint32_t Idle; // Elements in the magazines and the shared queue.
+        };
+
     public:
         ProxyPoolType(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
         ProxyPoolType<PROXYPOOLELEMENT>& operator=(const ProxyPoolType<PROXYPOOLELEMENT>&) = delete;
 
-        ProxyPoolType(const uint32_t initialQueueSize)
+        // A magazineSize of 0 disables the per thread caches, every request goes to the shared queue.
+        ProxyPoolType(const uint32_t initialQueueSize, const uint8_t magazineSize = DefaultMagazineSize)
             : _createdElements(0)
-            , _queue(initialQueueSize)
+            , _pooledElements(0)
+            , _magazineSize(magazineSize > MaxMagazineSize ? static_cast<uint8_t>(MaxMagazineSize) : magazineSize)
+            , _queue()
             , _lock()
         {
+            _queue.reserve(initialQueueSize);
+
+            for (Magazine& magazine : _magazines) {
+                magazine.Busy.clear();
+                magazine.Count = 0;
+                magazine.Hits = 0;
+            }
         }
         ~ProxyPoolType()
         {
@@ -1067,26 +1104,14 @@ namespace Core {
         Core::ProxyType<PROXYPOOLELEMENT> Element()
         {
             Core::ProxyType<PROXYPOOLELEMENT> result;
+            ProxyPoolElement* element = Take();
 
-            _lock.Lock();
-
-            if (_queue.Count() == 0) {
-
-                _createdElements++;
-
-                _lock.Unlock();
-
+            if (element == nullptr) {
                 result = ProxyPoolElement::Create(*this);
 
                 // TRACE_L1("Created a new element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
             } else {
-                Core::ProxyType<ProxyPoolElement> listLoad;
-
-                _queue.Remove(0, listLoad);
-
-                _lock.Unlock();
-
-                result = Core::proxy_cast<PROXYPOOLELEMENT>(listLoad);
+                result = Core::ProxyType<PROXYPOOLELEMENT>(static_cast<IReferenceCounted*>(element), element);
 
                 // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
             }
@@ -1097,37 +1122,92 @@ namespace Core {
         Core::ProxyType<PROXYPOOLELEMENT> Element(Arg1 argument1)
         {
             Core::ProxyType<PROXYPOOLELEMENT> result;
+            ProxyPoolElement* element = Take();
 
-            _lock.Lock();
+            if (element == nullptr) {
+                result = ProxyPoolElement::Create(*this, argument1);
 
-            if (_queue.Count() == 0) {
+                // TRACE_L1("Created a new element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+            } else {
+                result = Core::ProxyType<PROXYPOOLELEMENT>(static_cast<IReferenceCounted*>(element), element);
 
-                _createdElements++;
+                // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+            }
 
-                _lock.Unlock();
+            return (result);
+        }
+        void Return(ProxyPoolElement* element) const
+        {
+            ASSERT(element != nullptr);
 
-                result = ProxyPoolElement::Create(*this, argument1);
+            Magazine& magazine(_magazines[Slot() % Magazines]);
 
-                // TRACE_L1("Created a new element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+            if ((_magazineSize == 0) || (magazine.Busy.test_and_set(std::memory_order_acquire) == true)) {
+                _lock.Lock();
+                _queue.push_back(element);
+                _lock.Unlock();
             } else {
-                Core::ProxyType<ProxyPoolElement> listLoad;
+                if (magazine.Count == _magazineSize) {
+                    // Full, move the oldest half to the shared queue, the most recent ones are still warm.
+                    const uint8_t moving = (_magazineSize + 1) / 2;
 
-                _queue.Remove(0, listLoad);
+                    _lock.Lock();
+                    _queue.insert(_queue.end(), &(magazine.Elements[0]), &(magazine.Elements[moving]));
+                    _lock.Unlock();
 
-                _lock.Unlock();
+                    magazine.Count -= moving;
+                    ::memmove(&(magazine.Elements[0]), &(magazine.Elements[moving]), magazine.Count * sizeof(ProxyPoolElement*));
+                }
+
+                magazine.Elements[magazine.Count++] = element;
+                magazine.Busy.clear(std::memory_order_release);
+            }
+        }
+        // Frees idle elements, all elements in the magazines and all but the given number of elements
+        // in the shared queue. Returns the number of elements freed.
+        uint32_t Trim(const uint32_t keep = 0)
+        {
+            std::vector<ProxyPoolElement*> freeing;
 
-                result = Core::proxy_cast<PROXYPOOLELEMENT>(listLoad);
+            _lock.Lock();
 
-                // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
+            for (Magazine& magazine : _magazines) {
+                // A magazine in use right now, is skipped.
+                if (magazine.Busy.test_and_set(std::memory_order_acquire) == false) {
+                    _queue.insert(_queue.end(), &(magazine.Elements[0]), &(magazine.Elements[magazine.Count]));
+                    magazine.Count = 0;
+                    magazine.Busy.clear(std::memory_order_release);
+                }
             }
 
-            return (result);
+            if (_queue.size() > keep) {
+                freeing.assign(_queue.begin() + keep, _queue.end());
+                _queue.resize(keep);
+                _queue.shrink_to_fit();
+            }
+
+            _lock.Unlock();
+
+            for (ProxyPoolElement* element : freeing) {
+                delete element;
+            }
+
+            return (static_cast<uint32_t>(freeing.size()));
         }
-        void Return(Core::ProxyType<ProxyPoolElement>& element) const
+        void Measure(Statistics& statistics) const
         {
+            statistics.Cached = 0;
+            statistics.Idle = 0;
+
+            for (const Magazine& magazine : _magazines) {
+                statistics.Cached += magazine.Hits;
+                statistics.Idle += magazine.Count;
+            }
+
             _lock.Lock();
-            // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
-            _queue.Add(element);
+            statistics.Created = _createdElements;
+            statistics.Pooled = _pooledElements;
+            statistics.Idle += static_cast<uint32_t>(_queue.size());
             _lock.Unlock();
         }
         inline uint32_t CreatedElements() const
@@ -1136,16 +1216,79 @@ namespace Core {
         }
         inline uint32_t QueuedElements() const
         {
-            return (_queue.Count());
+            Statistics statistics;
+            Measure(statistics);
+            return (statistics.Idle);
         }
         inline uint32_t CurrentQueueSize() const
         {
-            return (_queue.CurrentQueueSize());
+            return (static_cast<uint32_t>(_queue.capacity()));
+        }
+
+    private:
+        // Stable per thread, so a thread keeps on using the same magazine.
+        static uint32_t Slot()
+        {
+            static std::atomic<uint32_t> threads(0);
+            static thread_local uint32_t slot = threads.fetch_add(1, std::memory_order_relaxed);
+
+            return (slot);
+        }
+        ProxyPoolElement* Take()
+        {
+            ProxyPoolElement* result = nullptr;
+            Magazine& magazine(_magazines[Slot() % Magazines]);
+
+            if ((_magazineSize == 0) || (magazine.Busy.test_and_set(std::memory_order_acquire) == true)) {
+                _lock.Lock();
+
+                if (_queue.empty() == true) {
+                    _createdElements++;
+                } else {
+                    result = _queue.back();
+                    _queue.pop_back();
+                    _pooledElements++;
+                }
+
+                _lock.Unlock();
+            } else {
+                if (magazine.Count == 0) {
+                    // Empty, refill half of it from the shared queue in one go.
+                    _lock.Lock();
+
+                    const uint8_t moving = static_cast<uint8_t>(std::min(_queue.size(), static_cast<size_t>((_magazineSize + 1) / 2)));
+
+                    if (moving == 0) {
+                        _createdElements++;
+                    } else {
+                        ::memcpy(&(magazine.Elements[0]), &(_queue[_queue.size() - moving]), moving * sizeof(ProxyPoolElement*));
+                        _queue.resize(_queue.size() - moving);
+                        magazine.Count = moving;
+                        _pooledElements++;
+                    }
+
+                    _lock.Unlock();
+
+                    if (moving != 0) {
+                        result = magazine.Elements[--magazine.Count];
+                    }
+                } else {
+                    result = magazine.Elements[--magazine.Count];
+                    magazine.Hits++;
+                }
+
+                magazine.Busy.clear(std::memory_order_release);
+            }
+
+            return (result);
         }
 
     private:
         uint32_t _createdElements;
-        mutable Core::ProxyList<ProxyPoolElement> _queue;
+        uint32_t _pooledElements;
+        const uint8_t _magazineSize;
+        mutable Magazine _magazines[Magazines];
+        mutable std::vector<ProxyPoolElement*> _queue;
         mutable Core::CriticalSection _lock;
     };
 
@@ -19,6 +19,9 @@
 #endif
 
 #include <sys/ioctl.h>
+#ifdef __LINUX__
+#include <linux/serial.h>
+#endif
 #define ERRORRESULT errno
 #define ERROR_WOULDBLOCK EWOULDBLOCK
 #define ERROR_AGAIN EAGAIN
@@ -257,6 +260,8 @@ namespace Core {
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
         , m_ReadBytes(0)
+        , m_ReceiveOffset(0)
+        , m_Framing(nullptr)
         , m_SendOffset(0)
         , m_SendBytes(0)
         ,
@@ -267,6 +272,9 @@ namespace Core {
 
 #ifdef __LINUX__
             m_Descriptor(-1)
+            , m_ReadMinimum(1)
+            , m_ReadTime(0)
+            , m_LowLatency(false)
 #endif
     {
 #ifdef __WIN32__
@@ -285,6 +293,8 @@ namespace Core {
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
         , m_ReadBytes(0)
+        , m_ReceiveOffset(0)
+        , m_Framing(nullptr)
         , m_SendOffset(0)
         , m_SendBytes(0)
         ,
@@ -295,6 +305,9 @@ namespace Core {
 
 #ifdef __LINUX__
             m_Descriptor(-1)
+            , m_ReadMinimum(1)
+            , m_ReadTime(0)
+            , m_LowLatency(false)
 #endif
     {
 #ifdef __WIN32__
@@ -321,6 +334,8 @@ namespace Core {
         , m_SendBuffer(nullptr)
         , m_ReceiveBuffer(nullptr)
         , m_ReadBytes(0)
+        , m_ReceiveOffset(0)
+        , m_Framing(nullptr)
         , m_SendOffset(0)
         , m_SendBytes(0)
         ,
@@ -331,6 +346,9 @@ namespace Core {
 
 #ifdef __LINUX__
             m_Descriptor(-1)
+            , m_ReadMinimum(1)
+            , m_ReadTime(0)
+            , m_LowLatency(false)
 #endif
     {
 #ifdef __WIN32__
@@ -382,6 +400,9 @@ namespace Core {
 #ifdef __LINUX__
         cfmakeraw(&m_PortSettings);
 
+        m_PortSettings.c_cc[VMIN] = m_ReadMinimum;
+        m_PortSettings.c_cc[VTIME] = m_ReadTime;
+
         cfsetispeed(&m_PortSettings, baudRate); // set baud rates for in
         cfsetospeed(&m_PortSettings, baudRate); // and out
         m_PortSettings.c_cflag |= CLOCAL;
@@ -487,6 +508,8 @@ namespace Core {
                 m_PortSettings.c_cflag &= ~(PARENB | PARODD | CSTOPB | CS5 | CS6 | CS7 | CS8); // Clear all relevant bits
                 m_PortSettings.c_cflag |= parity | stopBits | dataBits; // Set the requested bits
                 m_PortSettings.c_cflag |= CLOCAL;
+                m_PortSettings.c_cc[VMIN] = m_ReadMinimum;
+                m_PortSettings.c_cc[VTIME] = m_ReadTime;
 
                 if (flowControl == OFF) {
                     m_PortSettings.c_cflag &= ~CRTSCTS;
@@ -582,6 +605,12 @@ namespace Core {
 
                     tcflush(m_Descriptor, TCIOFLUSH);
 
+                    if (m_LowLatency == true) {
+                        LowLatency();
+                    }
+
+                    m_ReadBytes = 0;
+                    m_ReceiveOffset = 0;
                     m_State = SerialPort::OPEN;
                     ResourceMonitor::Instance().Register(*this);
 
@@ -619,6 +648,7 @@ namespace Core {
                         ::SetCommState(m_Descriptor, &currentSettings);
                     }
                     m_ReadBytes = 0;
+                    m_ReceiveOffset = 0;
                     m_State = SerialPort::OPEN;
 
                     g_SerialPortMonitor.Monitor(*this);
@@ -817,7 +847,7 @@ void SerialPort::Read(const uint16_t readBytes)
         ASSERT(m_ReadBytes <= m_ReceiveBufferSize);
 
         if (m_ReadBytes == m_ReceiveBufferSize) {
-            m_ReadBytes = 0;
+            Compact();
         }
 
         // Read the actual data from the port.
@@ -839,24 +869,70 @@ void SerialPort::Read(const uint16_t readBytes)
             m_ReadBytes++;
         }
 
-        if (m_ReadBytes != 0) {
-            uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
+        Deliver();
+    }
+
+    m_syncAdmin.Unlock();
+}
+#endif
+
+    // The received data is consumed from the front of the buffer, bytes are only moved when the end
+    // of the buffer is reached, and then only the (partial) frame that is still pending.
+    void SerialPort::Compact()
+    {
+        if (m_ReceiveOffset == 0) {
+            // Nothing handled from a full buffer, e.g. a frame that does not fit, drop it all.
+            TRACE_L1("Receive buffer of %s overflowed, dropping %d bytes", m_PortName.c_str(), m_ReadBytes);
+            m_ReadBytes = 0;
+        } else {
+            m_ReadBytes -= m_ReceiveOffset;
+            ::memmove(m_ReceiveBuffer, &m_ReceiveBuffer[m_ReceiveOffset], m_ReadBytes);
+            m_ReceiveOffset = 0;
+        }
+    }
+
+    void SerialPort::Deliver()
+    {
+        bool available = (m_ReceiveOffset < m_ReadBytes);
+
+        while (available == true) {
+            uint8_t* data = &(m_ReceiveBuffer[m_ReceiveOffset]);
+            uint16_t length = m_ReadBytes - m_ReceiveOffset;
+            uint16_t handled = 0;
 
-            ASSERT(m_ReadBytes >= handledBytes);
+            if (m_Framing == nullptr) {
+                handled = ReceiveData(data, length);
+                available = false;
+            } else {
+                uint16_t skip = 0;
+                uint16_t size = m_Framing->Frame(data, length, skip);
 
-            m_ReadBytes -= handledBytes;
+                ASSERT((skip <= length) && (size <= (length - skip)));
 
-            if ((m_ReadBytes != 0) && (handledBytes != 0)) {
-                // Oops not all data was consumed, Lets remove the read data
-                ::memcpy(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
+                if (skip != 0) {
+                    TRACE_L1("Dropping %d bytes of %s that do not start a frame", skip, m_PortName.c_str());
+                    handled = skip;
+                } else if (size != 0) {
+                    ReceiveData(data, size);
+                    handled = size;
+                } else {
+                    available = false;
+                }
+            }
+
+            ASSERT(handled <= length);
+
+            m_ReceiveOffset += handled;
+
+            if (m_ReceiveOffset == m_ReadBytes) {
+                // All handled, start at the front again, for free.
+                m_ReceiveOffset = 0;
+                m_ReadBytes = 0;
+                available = false;
             }
         }
     }
 
-    m_syncAdmin.Unlock();
-}
-#endif
-
 #ifdef __POSIX__
         void SerialPort::Write()
         {
@@ -907,32 +983,26 @@ void SerialPort::Read(const uint16_t readBytes)
                 ASSERT(m_ReadBytes <= m_ReceiveBufferSize);
 
                 if (m_ReadBytes == m_ReceiveBufferSize) {
-                    m_ReadBytes = 0;
+                    Compact();
                 }
 
-                // Read the actual data from the port.
+                // Read the actual data from the port, as much as fits, till the port has nothing left.
                 l_Size = ::read(m_Descriptor, reinterpret_cast<char*>(&m_ReceiveBuffer[m_ReadBytes]), m_ReceiveBufferSize - m_ReadBytes);
 
                 if ((l_Size != static_cast<uint32_t>(~0)) && (l_Size != 0)) {
                     m_ReadBytes += l_Size;
 
-                    if (m_ReadBytes != 0) {
-                        uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
-
-                        ASSERT(m_ReadBytes >= handledBytes);
-
-                        m_ReadBytes -= handledBytes;
-
-                        if ((m_ReadBytes != 0) && (handledBytes != 0)) {
-                            // Oops not all data was consumed, Lets remove the read data
-                            ::memcpy(m_ReceiveBuffer, &m_ReceiveBuffer[handledBytes], m_ReadBytes);
-                        }
+                    if (m_ReadBytes == m_ReceiveBufferSize) {
+                        Deliver();
                     }
                 } else {
                     uint32_t l_Result = ERRORRESULT;
 
                     m_State |= SerialPort::READ;
 
+                    // All that is available is read, hand it over in one go.
+                    Deliver();
+
                     if ((l_Result != ERROR_WOULDBLOCK) && (l_Result != ERROR_INPROGRESS) && (l_Result != 0)) {
                         m_State |= SerialPort::EXCEPTION;
                         StateChange();
@@ -942,6 +1012,24 @@ void SerialPort::Read(const uint16_t readBytes)
 
             m_syncAdmin.Unlock();
         }
+
+        void SerialPort::LowLatency()
+        {
+            struct serial_struct info;
+
+            if (::ioctl(m_Descriptor, TIOCGSERIAL, &info) < 0) {
+                TRACE_L1("Low latency not supported on %s: %d", m_PortName.c_str(), errno);
+            } else {
+                if (m_LowLatency == true) {
+                    info.flags |= ASYNC_LOW_LATENCY;
+                } else {
+                    info.flags &= ~ASYNC_LOW_LATENCY;
+                }
+                if (::ioctl(m_Descriptor, TIOCSSERIAL, &info) < 0) {
+                    TRACE_L1("Error setting low latency on %s: %d", m_PortName.c_str(), errno);
+                }
+            }
+        }
 #endif
     }
 } // namespace Solution::Core
@@ -109,6 +109,95 @@ namespace Core {
             OPEN = 0x0400
         } enumState;
 #endif
+
+        // Splits the received byte stream in frames. With a framing set, ReceiveData is called once for
+        // every complete frame, and never with a partial one.
+        struct IFraming {
+            virtual ~IFraming() {}
+
+            // Returns the size of the complete frame the stream starts with, 0 if more data is needed.
+            // Leading bytes that can not start a frame are reported in skip, these are dropped.
+            virtual uint16_t Frame(const uint8_t stream[], const uint16_t length, uint16_t& skip) const = 0;
+        };
+
+        // Frames with a fixed size header that holds the length of the payload that follows it.
+        class EXTERNAL LengthFraming : public IFraming {
+        private:
+            LengthFraming() = delete;
+            LengthFraming(const LengthFraming&) = delete;
+            LengthFraming& operator=(const LengthFraming&) = delete;
+
+        public:
+            LengthFraming(const uint8_t header, const uint8_t offset, const uint8_t size, const bool bigEndian = false)
+                : _header(header)
+                , _offset(offset)
+                , _size(size)
+                , _bigEndian(bigEndian)
+            {
+                ASSERT((size >= 1) && (size <= 2) && ((offset + size) <= header));
+            }
+            ~LengthFraming() override
+            {
+            }
+
+        public:
+            uint16_t Frame(const uint8_t stream[], const uint16_t length, uint16_t& skip) const override
+            {
+                uint16_t result = 0;
+
+                skip = 0;
+
+                if (length >= _header) {
+                    uint32_t payload = stream[_offset];
+
+                    if (_size == 2) {
+                        payload = (_bigEndian == true ? ((payload << 8) | stream[_offset + 1]) : (payload | (stream[_offset + 1] << 8)));
+                    }
+                    if ((_header + payload) <= length) {
+                        result = static_cast<uint16_t>(_header + payload);
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            const uint8_t _header;
+            const uint8_t _offset;
+            const uint8_t _size;
+            const bool _bigEndian;
+        };
+
+        // Frames that end with a delimiter, the delimiter is part of the frame.
+        class EXTERNAL DelimiterFraming : public IFraming {
+        private:
+            DelimiterFraming() = delete;
+            DelimiterFraming(const DelimiterFraming&) = delete;
+            DelimiterFraming& operator=(const DelimiterFraming&) = delete;
+
+        public:
+            DelimiterFraming(const uint8_t delimiter)
+                : _delimiter(delimiter)
+            {
+            }
+            ~DelimiterFraming() override
+            {
+            }
+
+        public:
+            uint16_t Frame(const uint8_t stream[], const uint16_t length, uint16_t& skip) const override
+            {
+                const uint8_t* end = static_cast<const uint8_t*>(::memchr(stream, _delimiter, length));
+
+                skip = 0;
+
+                return (end != nullptr ? static_cast<uint16_t>(end - stream + 1) : 0);
+            }
+
+        private:
+            const uint8_t _delimiter;
+        };
+
         // -------------------------------------------------------------------------
         // This object should not be copied, assigned or created with a default
         // constructor. Prevent them from being used, generatoed by the compiler.
@@ -158,6 +247,7 @@ namespace Core {
         {
             m_syncAdmin.Lock();
             m_ReadBytes = 0;
+            m_ReceiveOffset = 0;
             m_SendOffset = 0;
             m_SendBytes = 0;
 #ifndef __WIN32__
@@ -220,6 +310,48 @@ namespace Core {
                     ::tcflush(m_Descriptor, TCIOFLUSH);
                 }
             }
+#endif
+        }
+        // The framing is not owned by the port, it should outlive it (or be reset first).
+        void Framing(const IFraming* framing)
+        {
+            m_syncAdmin.Lock();
+            m_Framing = framing;
+            m_syncAdmin.Unlock();
+        }
+        // VMIN/VTIME of the tty. With time 0, the port is only reported readable once at least minimum
+        // bytes arrived, so a burst is read in one go instead of a wake up per byte or two. With a
+        // time set, the port is reported readable at the first byte, as usual.
+        void SetReadBatch(const uint8_t minimum, const uint8_t time)
+        {
+#ifdef __WIN32__
+            // TODO: Implement a windows variant..
+            ASSERT(false);
+#else
+            m_ReadMinimum = minimum;
+            m_ReadTime = time;
+            m_PortSettings.c_cc[VMIN] = minimum;
+            m_PortSettings.c_cc[VTIME] = time;
+            if (m_Descriptor != -1) {
+
+                if (tcsetattr(m_Descriptor, TCSANOW, &m_PortSettings) < 0) {
+                    TRACE_L1("Error setting the read batch: %d", -errno);
+                }
+            }
+#endif
+        }
+        // Lets the driver push received bytes to the tty right away instead of on its next tick. Not
+        // all UART drivers support it.
+        void SetLowLatency(const bool enabled)
+        {
+#ifdef __WIN32__
+            // TODO: Implement a windows variant..
+            ASSERT(false);
+#else
+            m_LowLatency = enabled;
+            if (m_Descriptor != -1) {
+                LowLatency();
+            }
 #endif
         }
         void SendBreak()
@@ -261,9 +393,12 @@ namespace Core {
         void Write(const uint16_t writtenBytes);
         void Read(const uint16_t readBytes);
 #endif
+        void Compact();
+        void Deliver();
 #ifdef __LINUX__
         void Write();
         void Read();
+        void LowLatency();
         virtual IResource::handle Descriptor() const override
         {
             return (static_cast<IResource::handle>(m_Descriptor));
@@ -293,6 +428,8 @@ namespace Core {
         uint8_t* m_SendBuffer;
         uint8_t* m_ReceiveBuffer;
         uint16_t m_ReadBytes;
+        uint16_t m_ReceiveOffset;
+        const IFraming* m_Framing;
         uint16_t m_WriteBytes;
         uint16_t m_SendOffset;
         uint16_t m_SendBytes;
@@ -308,6 +445,9 @@ namespace Core {
 #ifdef __LINUX__
         int m_Descriptor;
         struct termios m_PortSettings;
+        uint8_t m_ReadMinimum;
+        uint8_t m_ReadTime;
+        bool m_LowLatency;
 #endif
     };
 }
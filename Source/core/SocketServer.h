@@ -170,6 +170,24 @@ namespace Core {
 
                 return (result);
             }
+            template <typename PACKAGE, typename ARGUMENT>
+            uint32_t Submit(const uint32_t ID, PACKAGE package, const ARGUMENT argument)
+            {
+                uint32_t result = Core::ERROR_UNAVAILABLE;
+                _lock.Lock();
+
+                typename ClientMap::iterator index = _clients.find(ID);
+
+                if (index != _clients.end()) {
+                    // Oke connection still exists, send the message..
+                    index->second->Submit(package, argument);
+                    result = Core::ERROR_NONE;
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
             inline Iterator Clients() const
             {
                 _lock.Lock();
@@ -335,6 +353,11 @@ namespace Core {
         {
             return (_handler.Submit(ID, package));
         }
+        template <typename PACKAGE, typename ARGUMENT>
+        inline uint32_t Submit(const uint32_t ID, PACKAGE package, const ARGUMENT argument)
+        {
+            return (_handler.Submit(ID, package, argument));
+        }
         inline Iterator Clients() const
         {
             return (_handler.Clients());
@@ -476,10 +476,13 @@ namespace Core {
             Writer& operator=(const Writer& copy);
 
         protected:
-            Writer(const string fileName)
+            // With a retention, only the last "retention" saved files are kept, so the recordings on disk form
+            // a ring. Numbering only continues from earlier files as long as the first one (.0) still exists.
+            Writer(const string fileName, const uint32_t retention)
                 : BaseRecorder()
                 , _lock()
                 , _fileId(static_cast<uint32_t>(~0))
+                , _retention(retention)
                 , _storageName(fileName)
             {
                 uint32_t startPoint = 0;
@@ -521,9 +524,9 @@ namespace Core {
             {
                 Save();
             }
-            static ProxyType<Writer> Create(const string& filename)
+            static ProxyType<Writer> Create(const string& filename, const uint32_t retention = 0)
             {
-                ProxyType<Writer> result = ProxyType<Writer>::Create(filename);
+                ProxyType<Writer> result = ProxyType<Writer>::Create(filename, retention);
 
                 result->SetBuffer(result->_buffer);
 
@@ -535,6 +538,15 @@ namespace Core {
             {
                 return (_storageName);
             }
+            // The first file that still holds recordings.
+            inline uint32_t Oldest() const
+            {
+                _lock.Lock();
+                uint32_t result = ((_retention == 0) || (_fileId <= _retention) ? 0 : _fileId - _retention);
+                _lock.Unlock();
+
+                return (result);
+            }
             void Record(const STOREVALUE value)
             {
                 // First do the time tracking so it is as close as possible to the "log time"
@@ -574,6 +586,11 @@ namespace Core {
                     file.Close();
 
                     _fileId++;
+
+                    if ((_retention != 0) && (_fileId > _retention)) {
+                        number = (_fileId - _retention - 1);
+                        Core::File(_storageName + "." + number.Text()).Destroy();
+                    }
                 }
 
                 _lock.Unlock();
@@ -582,6 +599,7 @@ namespace Core {
         private:
             mutable Core::CriticalSection _lock;
             uint32_t _fileId;
+            const uint32_t _retention;
             string _storageName;
             uint8_t _buffer[BaseRecorder::CaptureSize];
         };
@@ -631,12 +649,12 @@ namespace Core {
             }
             void Reset(const uint32_t id)
             {
-                _fileId = static_cast<uint32_t>(~0);
-
                 bool correctFile = false;
 
-                // Now create the storage space.
-                NumberType<uint32_t> number(0);
+                // Now create the storage space, starting at the oldest file the writer did not drop yet.
+                NumberType<uint32_t> number(_currentSet.IsValid() == true ? _currentSet->Oldest() : 0);
+
+                _fileId = number.Value() - 1;
 
                 Core::File file(_storageName + '.' + number.Text());
 
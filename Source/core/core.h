@@ -21,6 +21,7 @@
 #include "IObserver.h"
 
 #include "ASN1.h"
+#include "BlockCache.h"
 #include "DoorBell.h"
 #include "CyclicBuffer.h"
 #include "DataBuffer.h"
@@ -48,6 +49,7 @@
 #include "Parser.h"
 #include "Process.h"
 #include "ProcessInfo.h"
+#include "ProcessObserver.h"
 #include "Proxy.h"
 #include "Queue.h"
 #include "Range.h"
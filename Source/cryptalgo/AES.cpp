@@ -5,8 +5,10 @@ namespace Crypto {
 
     AESEncryption::AESEncryption(const aesType type)
         : _type(type)
+        , _offset(0)
     {
         ::memset(_iv, 0, sizeof(_iv));
+        ::memset(_stream, 0, sizeof(_stream));
     }
 
     AESEncryption::~AESEncryption()
@@ -27,13 +29,11 @@ namespace Crypto {
 
         switch (Type()) {
         case AES_ECB: {
-            uint32_t offset = 0;
             uint32_t blockSize = ((length / 16) * 16);
 
-            while (offset < blockSize) {
+            if (blockSize > 0) {
                 // First encrypt the whole blocks. No padding needed, yet
-                result = mbedtls_aes_crypt_ecb(&_context, MBEDTLS_AES_ENCRYPT, &(input[offset]), &(output[offset]));
-                offset += 16;
+                result = mbedtls_aes_crypt_ecb_blocks(&_context, MBEDTLS_AES_ENCRYPT, (blockSize / 16), input, output);
             }
 
             if (blockSize < length) {
@@ -151,6 +151,15 @@ namespace Crypto {
         }
             result = mbedtls_aes_crypt_ofb(&_context, length, &_offset, _iv, input, output);
             break;
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+        case AES_CTR: {
+            // A stream cipher, no padding needed: a partial block continues in the next call.
+            uint32_t offset = static_cast<uint32_t>(_offset);
+            result = mbedtls_aes_crypt_ctr(&_context, length, &offset, _iv, _stream, input, output);
+            _offset = offset;
+            break;
+        }
 #endif
         default:
             ASSERT(false);
@@ -165,6 +174,7 @@ namespace Crypto {
         , _offset(0)
     {
         ::memset(_iv, 0, sizeof(_iv));
+        ::memset(_stream, 0, sizeof(_stream));
     }
 
     AESDecryption::~AESDecryption()
@@ -191,13 +201,11 @@ namespace Crypto {
 
         switch (Type()) {
         case AES_ECB: {
-            uint32_t offset = 0;
             uint32_t blockSize = ((length / 16) * 16);
 
-            while (offset < blockSize) {
+            if (blockSize > 0) {
                 // First encrypt the whole blocks. No padding needed, yet
-                result = mbedtls_aes_crypt_ecb(&_context, MBEDTLS_AES_DECRYPT, &(input[offset]), &(output[offset]));
-                offset += 16;
+                result = mbedtls_aes_crypt_ecb_blocks(&_context, MBEDTLS_AES_DECRYPT, (blockSize / 16), input, output);
             }
 
             if (blockSize < length) {
@@ -313,6 +321,15 @@ namespace Crypto {
             }
             break;
         }
+#endif
+#if defined(MBEDTLS_CIPHER_MODE_CTR)
+        case AES_CTR: {
+            // A stream cipher, no padding needed: a partial block continues in the next call.
+            uint32_t offset = static_cast<uint32_t>(_offset);
+            result = mbedtls_aes_crypt_ctr(&_context, length, &offset, _iv, _stream, input, output);
+            _offset = offset;
+            break;
+        }
 #endif
         default:
             ASSERT(false);
@@ -321,5 +338,270 @@ namespace Crypto {
 
         return (result);
     }
+
+    // GCM limits the payload to 2^39 - 256 bits.
+    static constexpr uint64_t GCMMaximumPayload = ((1ULL << 36) - 32);
+
+    // Process this much at a time, so the second pass (CTR after GHASH or vice versa) finds the
+    // data still in the cache.
+    static constexpr uint32_t GCMSliceSize = 4096;
+
+    AESGCM::AESGCM()
+        : _keyed(false)
+        , _started(false)
+        , _offset(0)
+        , _pendingLength(0)
+        , _aadLength(0)
+        , _payloadLength(0)
+    {
+        mbedtls_aes_init(&_context);
+        ::memset(&_ghash, 0, sizeof(_ghash));
+        ::memset(_preCounter, 0, sizeof(_preCounter));
+        ::memset(_counter, 0, sizeof(_counter));
+        ::memset(_stream, 0, sizeof(_stream));
+        ::memset(_hash, 0, sizeof(_hash));
+        ::memset(_pending, 0, sizeof(_pending));
+    }
+
+    AESGCM::~AESGCM()
+    {
+        mbedtls_aes_free(&_context);
+        ::memset(&_ghash, 0, sizeof(_ghash));
+    }
+
+    uint32_t AESGCM::Key(const uint8_t length, const uint8_t key[])
+    {
+        ASSERT((length == 16 /* 128 bits */) || (length == 24 /* 192 bits */) || (length == 32 /* 256 bits */));
+
+        uint32_t result = Core::ERROR_INVALID_INPUT_LENGTH;
+
+        mbedtls_aes_init(&_context);
+        _started = false;
+
+        if (mbedtls_aes_setkey_enc(&_context, key, (length << 3)) == 0) {
+            uint8_t subKey[16];
+
+            // The hash subkey is the encryption of the zero block.
+            ::memset(subKey, 0, sizeof(subKey));
+            mbedtls_aes_crypt_ecb(&_context, MBEDTLS_AES_ENCRYPT, subKey, subKey);
+            mbedtls_ghash_setkey(&_ghash, subKey);
+
+            _keyed = true;
+            result = Core::ERROR_NONE;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESGCM::Start(const uint8_t ivLength, const uint8_t iv[], const uint32_t aadLength, const uint8_t aad[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_keyed == false) {
+            result = Core::ERROR_ILLEGAL_STATE;
+        } else if ((ivLength == 0) || ((aadLength > 0) && (aad == nullptr))) {
+            result = Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            ::memset(_hash, 0, sizeof(_hash));
+            _pendingLength = 0;
+            _payloadLength = 0;
+            _offset = 0;
+
+            if (ivLength == 12) {
+                ::memcpy(_preCounter, iv, 12);
+                _preCounter[12] = 0;
+                _preCounter[13] = 0;
+                _preCounter[14] = 0;
+                _preCounter[15] = 1;
+            } else {
+                uint8_t lengths[16];
+                const uint64_t bits = (static_cast<uint64_t>(ivLength) << 3);
+
+                ::memset(lengths, 0, sizeof(lengths));
+                for (uint8_t index = 0; index < 8; index++) {
+                    lengths[15 - index] = static_cast<uint8_t>(bits >> (index * 8));
+                }
+
+                Hash(ivLength, iv);
+                Pad();
+                Hash(sizeof(lengths), lengths);
+
+                ::memcpy(_preCounter, _hash, sizeof(_preCounter));
+                ::memset(_hash, 0, sizeof(_hash));
+            }
+
+            ::memcpy(_counter, _preCounter, sizeof(_counter));
+            for (uint8_t index = 15; (index >= 12) && (++_counter[index] == 0); index--) /* inc32 */;
+
+            Hash(aadLength, aad);
+            Pad();
+
+            _aadLength = aadLength;
+            _started = true;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESGCM::Encrypt(const uint32_t length, const uint8_t input[], uint8_t output[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_started == false) {
+            result = Core::ERROR_ILLEGAL_STATE;
+        } else if ((_payloadLength + length) > GCMMaximumPayload) {
+            result = Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            uint32_t offset = 0;
+
+            while (offset < length) {
+                const uint32_t slice = std::min(length - offset, GCMSliceSize);
+
+                Crypt(slice, &input[offset], &output[offset]);
+                Hash(slice, &output[offset]);
+                offset += slice;
+            }
+
+            _payloadLength += length;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESGCM::Decrypt(const uint32_t length, const uint8_t input[], uint8_t output[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_started == false) {
+            result = Core::ERROR_ILLEGAL_STATE;
+        } else if ((_payloadLength + length) > GCMMaximumPayload) {
+            result = Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            uint32_t offset = 0;
+
+            while (offset < length) {
+                const uint32_t slice = std::min(length - offset, GCMSliceSize);
+
+                // Hash the ciphertext before it is overwritten (in place decryption).
+                Hash(slice, &input[offset]);
+                Crypt(slice, &input[offset], &output[offset]);
+                offset += slice;
+            }
+
+            _payloadLength += length;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESGCM::Tag(const uint8_t length, uint8_t tag[])
+    {
+        uint32_t result = Core::ERROR_NONE;
+
+        if (_started == false) {
+            result = Core::ERROR_ILLEGAL_STATE;
+        } else if ((length < 4) || (length > 16)) {
+            result = Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            uint8_t lengths[16];
+            const uint64_t aadBits = (_aadLength << 3);
+            const uint64_t payloadBits = (_payloadLength << 3);
+
+            for (uint8_t index = 0; index < 8; index++) {
+                lengths[7 - index] = static_cast<uint8_t>(aadBits >> (index * 8));
+                lengths[15 - index] = static_cast<uint8_t>(payloadBits >> (index * 8));
+            }
+
+            Pad();
+            Hash(sizeof(lengths), lengths);
+
+            uint8_t mask[16];
+            mbedtls_aes_crypt_ecb(&_context, MBEDTLS_AES_ENCRYPT, _preCounter, mask);
+
+            for (uint8_t index = 0; index < length; index++) {
+                tag[index] = (mask[index] ^ _hash[index]);
+            }
+
+            _started = false;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESGCM::Verify(const uint8_t length, const uint8_t tag[])
+    {
+        uint8_t calculated[16];
+        uint32_t result = Tag(length, calculated);
+
+        if (result == Core::ERROR_NONE) {
+            uint8_t difference = 0;
+
+            // Compare all bytes, the time taken should not tell how many bytes matched.
+            for (uint8_t index = 0; index < length; index++) {
+                difference |= (calculated[index] ^ tag[index]);
+            }
+
+            result = (difference == 0 ? Core::ERROR_NONE : Core::ERROR_INVALID_SIGNATURE);
+        }
+
+        return (result);
+    }
+
+    void AESGCM::Hash(const uint32_t length, const uint8_t data[])
+    {
+        uint32_t offset = 0;
+
+        if (_pendingLength > 0) {
+            offset = std::min(length, static_cast<uint32_t>(sizeof(_pending) - _pendingLength));
+            ::memcpy(&_pending[_pendingLength], data, offset);
+            _pendingLength += static_cast<uint8_t>(offset);
+
+            if (_pendingLength == sizeof(_pending)) {
+                mbedtls_ghash_update(&_ghash, _hash, 1, _pending);
+                _pendingLength = 0;
+            }
+        }
+
+        const uint32_t blocks = ((length - offset) / 16);
+
+        if (blocks > 0) {
+            mbedtls_ghash_update(&_ghash, _hash, blocks, &data[offset]);
+            offset += (blocks * 16);
+        }
+
+        if (offset < length) {
+            _pendingLength = static_cast<uint8_t>(length - offset);
+            ::memcpy(_pending, &data[offset], _pendingLength);
+        }
+    }
+
+    void AESGCM::Pad()
+    {
+        if (_pendingLength > 0) {
+            ::memset(&_pending[_pendingLength], 0, sizeof(_pending) - _pendingLength);
+            mbedtls_ghash_update(&_ghash, _hash, 1, _pending);
+            _pendingLength = 0;
+        }
+    }
+
+    void AESGCM::Crypt(const uint32_t length, const uint8_t input[], uint8_t output[])
+    {
+        uint32_t offset = 0;
+
+        while (offset < length) {
+            // The CTR mode below counts on 128 bits, GCM only on the lower 32 bits. Stop at the
+            // wrap around of the lower 32 bits and undo the carry into the upper bits.
+            const uint32_t low = (_counter[12] << 24) | (_counter[13] << 16) | (_counter[14] << 8) | _counter[15];
+            const uint64_t available = ((_offset != 0 ? (16 - _offset) : 0) + (((1ULL << 32) - low) * 16));
+            const uint32_t slice = static_cast<uint32_t>(std::min(static_cast<uint64_t>(length - offset), available));
+
+            mbedtls_aes_crypt_ctr(&_context, slice, &_offset, _counter, _stream, &input[offset], &output[offset]);
+            offset += slice;
+
+            if ((_counter[12] | _counter[13] | _counter[14] | _counter[15]) == 0) {
+                ::memcpy(_counter, _preCounter, 12);
+            }
+        }
+    }
 }
 } // namespace WPEFramework::Crypto
@@ -12,7 +12,8 @@ namespace Crypto {
         AES_CBC,
         AES_CFB8,
         AES_CFB128,
-        AES_OFB
+        AES_OFB,
+        AES_CTR
     };
 
     enum bitLength {
@@ -53,6 +54,7 @@ namespace Crypto {
         aesType _type;
         mbedtls_aes_context _context;
         uint8_t _iv[16];
+        uint8_t _stream[16];
         size_t _offset;
     };
 
@@ -90,8 +92,58 @@ namespace Crypto {
         aesType _type;
         mbedtls_aes_context _context;
         uint8_t _iv[16];
+        uint8_t _stream[16];
         size_t _offset;
     };
+
+    // AES in Galois/Counter Mode (NIST SP 800-38D): authenticated encryption. A message is started
+    // with its IV and additional authenticated data, after which the payload can be passed in any
+    // number of Encrypt/Decrypt calls of any length (input and output may be the same buffer), and
+    // the authentication tag is produced or checked at the end.
+    class EXTERNAL AESGCM {
+    private:
+        AESGCM(const AESGCM&) = delete;
+        AESGCM& operator=(const AESGCM&) = delete;
+
+    public:
+        AESGCM();
+        ~AESGCM();
+
+    public:
+        uint32_t Key(const uint8_t length, const uint8_t key[]);
+
+        // A 12 bytes IV is the recommended (and fastest) length, other lengths are hashed.
+        uint32_t Start(const uint8_t ivLength, const uint8_t iv[], const uint32_t aadLength = 0, const uint8_t aad[] = nullptr);
+
+        uint32_t Encrypt(const uint32_t length, const uint8_t input[], uint8_t output[]);
+        uint32_t Decrypt(const uint32_t length, const uint8_t input[], uint8_t output[]);
+
+        // Completes the message, the tag is 4 up to 16 bytes.
+        uint32_t Tag(const uint8_t length, uint8_t tag[]);
+
+        // Completes the message, ERROR_INVALID_SIGNATURE if the tag does not match.
+        uint32_t Verify(const uint8_t length, const uint8_t tag[]);
+
+    private:
+        void Hash(const uint32_t length, const uint8_t data[]);
+        void Crypt(const uint32_t length, const uint8_t input[], uint8_t output[]);
+        void Pad();
+
+    private:
+        mbedtls_aes_context _context;
+        mbedtls_ghash_context _ghash;
+        bool _keyed;
+        bool _started;
+        uint8_t _preCounter[16];
+        uint8_t _counter[16];
+        uint8_t _stream[16];
+        uint32_t _offset;
+        uint8_t _hash[16];
+        uint8_t _pending[16];
+        uint8_t _pendingLength;
+        uint64_t _aadLength;
+        uint64_t _payloadLength;
+    };
 }
 } // namespace Crypto
 
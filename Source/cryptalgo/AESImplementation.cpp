@@ -28,6 +28,17 @@
 #include "AESImplementation.h"
 #include <stdio.h>
 #include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AES_HW_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define AES_HW_ARMV8
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
 extern "C" {
 #define mbedtls_printf printf
 
@@ -443,6 +454,387 @@ static void aes_gen_tables(void)
 
 #endif /* MBEDTLS_AES_ROM_TABLES */
 
+/*
+* Hardware accelerated AES rounds and GHASH (AES-NI and PCLMULQDQ on x86, Cryptography Extensions
+* on ARMv8). The instructions are not available on every CPU the code is compiled for, so these
+* functions are compiled for the extension only and used if the CPU reports it at runtime. They
+* run on the (standard byte order) round keys set up by mbedtls_aes_setkey_enc/dec: the decryption
+* key schedule already is the "equivalent inverse cipher" schedule AESDEC/AESD expect.
+*/
+#define AES_HW_ROUNDS 0x01
+#define AES_HW_CLMUL 0x02
+
+static int aes_hw_enabled = 1;
+
+#if defined(AES_HW_X86)
+
+static int aes_hw_detect(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    int result = 0;
+
+    // AES (ECX bit 25) and PCLMULQDQ (ECX bit 1), the functions below also use SSSE3 and SSE4.1 (ECX bit 9 and 19)
+    if ((__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0) && ((ecx & (1 << 9)) != 0) && ((ecx & (1 << 19)) != 0)) {
+        result = ((ecx & (1 << 25)) != 0 ? AES_HW_ROUNDS : 0) | ((ecx & (1 << 1)) != 0 ? AES_HW_CLMUL : 0);
+    }
+
+    return (result);
+}
+
+#define AES_HW_TARGET __attribute__((target("aes,pclmul,sse4.1")))
+
+AES_HW_TARGET static inline void aes_hw_load_keys(const mbedtls_aes_context* ctx, __m128i key[15])
+{
+    for (int i = 0; i <= ctx->nr; i++) {
+        key[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctx->rk[i * 4]));
+    }
+}
+
+AES_HW_TARGET static inline __m128i aes_hw_encrypt(const __m128i key[15], const int nr, __m128i block)
+{
+    block = _mm_xor_si128(block, key[0]);
+    for (int i = 1; i < nr; i++) {
+        block = _mm_aesenc_si128(block, key[i]);
+    }
+    return (_mm_aesenclast_si128(block, key[nr]));
+}
+
+AES_HW_TARGET static inline __m128i aes_hw_decrypt(const __m128i key[15], const int nr, __m128i block)
+{
+    block = _mm_xor_si128(block, key[0]);
+    for (int i = 1; i < nr; i++) {
+        block = _mm_aesdec_si128(block, key[i]);
+    }
+    return (_mm_aesdeclast_si128(block, key[nr]));
+}
+
+// Four independent blocks at a time keep the AES unit busy, a single block is latency bound.
+AES_HW_TARGET static inline void aes_hw_encrypt4(const __m128i key[15], const int nr, __m128i block[4])
+{
+    block[0] = _mm_xor_si128(block[0], key[0]);
+    block[1] = _mm_xor_si128(block[1], key[0]);
+    block[2] = _mm_xor_si128(block[2], key[0]);
+    block[3] = _mm_xor_si128(block[3], key[0]);
+    for (int i = 1; i < nr; i++) {
+        block[0] = _mm_aesenc_si128(block[0], key[i]);
+        block[1] = _mm_aesenc_si128(block[1], key[i]);
+        block[2] = _mm_aesenc_si128(block[2], key[i]);
+        block[3] = _mm_aesenc_si128(block[3], key[i]);
+    }
+    block[0] = _mm_aesenclast_si128(block[0], key[nr]);
+    block[1] = _mm_aesenclast_si128(block[1], key[nr]);
+    block[2] = _mm_aesenclast_si128(block[2], key[nr]);
+    block[3] = _mm_aesenclast_si128(block[3], key[nr]);
+}
+
+AES_HW_TARGET static inline void aes_hw_decrypt4(const __m128i key[15], const int nr, __m128i block[4])
+{
+    block[0] = _mm_xor_si128(block[0], key[0]);
+    block[1] = _mm_xor_si128(block[1], key[0]);
+    block[2] = _mm_xor_si128(block[2], key[0]);
+    block[3] = _mm_xor_si128(block[3], key[0]);
+    for (int i = 1; i < nr; i++) {
+        block[0] = _mm_aesdec_si128(block[0], key[i]);
+        block[1] = _mm_aesdec_si128(block[1], key[i]);
+        block[2] = _mm_aesdec_si128(block[2], key[i]);
+        block[3] = _mm_aesdec_si128(block[3], key[i]);
+    }
+    block[0] = _mm_aesdeclast_si128(block[0], key[nr]);
+    block[1] = _mm_aesdeclast_si128(block[1], key[nr]);
+    block[2] = _mm_aesdeclast_si128(block[2], key[nr]);
+    block[3] = _mm_aesdeclast_si128(block[3], key[nr]);
+}
+
+#define AES_HW_BLOCK __m128i
+#define AES_HW_LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+#define AES_HW_STORE(p, v) _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v)
+#define AES_HW_XOR(a, b) _mm_xor_si128(a, b)
+#define AES_HW_COUNTER(high, low) _mm_set_epi64x(__builtin_bswap64(low), __builtin_bswap64(high))
+
+// GF(2^128) multiplication of byte reflected operands, as GHASH defines it (Intel carry-less
+// multiplication white paper, algorithm 5).
+AES_HW_TARGET static inline __m128i ghash_hw_mult(const __m128i a, const __m128i b)
+{
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // Shift the 256 bit product left by one bit, the operands are bit reflected.
+    __m128i carryLo = _mm_srli_epi32(lo, 31);
+    __m128i carryHi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    hi = _mm_or_si128(hi, _mm_srli_si128(carryLo, 12));
+    hi = _mm_or_si128(hi, _mm_slli_si128(carryHi, 4));
+    lo = _mm_or_si128(lo, _mm_slli_si128(carryLo, 4));
+
+    // Reduce modulo x^128 + x^7 + x^2 + x + 1
+    __m128i a1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)), _mm_slli_epi32(lo, 25));
+    __m128i a2 = _mm_srli_si128(a1, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(a1, 12));
+
+    __m128i b1 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)), _mm_srli_epi32(lo, 7));
+    b1 = _mm_xor_si128(b1, a2);
+    lo = _mm_xor_si128(lo, b1);
+
+    return (_mm_xor_si128(hi, lo));
+}
+
+AES_HW_TARGET static void ghash_hw_update(unsigned char state[16], const unsigned char h[16], uint32_t blocks, const unsigned char* input)
+{
+    const __m128i reflect = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i key = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)), reflect);
+    __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), reflect);
+
+    if (blocks >= 4) {
+        // ((((x + b0)H + b1)H + b2)H + b3)H = (x + b0)H^4 + b1.H^3 + b2.H^2 + b3.H, four independent
+        // multiplications instead of a chain of four.
+        const __m128i key2 = ghash_hw_mult(key, key);
+        const __m128i key3 = ghash_hw_mult(key2, key);
+        const __m128i key4 = ghash_hw_mult(key3, key);
+
+        for (; blocks >= 4; blocks -= 4, input += 64) {
+            __m128i b0 = _mm_xor_si128(x, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[0])), reflect));
+            __m128i b1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[16])), reflect);
+            __m128i b2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[32])), reflect);
+            __m128i b3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[48])), reflect);
+
+            x = _mm_xor_si128(_mm_xor_si128(ghash_hw_mult(b0, key4), ghash_hw_mult(b1, key3)), _mm_xor_si128(ghash_hw_mult(b2, key2), ghash_hw_mult(b3, key)));
+        }
+    }
+
+    while (blocks-- > 0) {
+        x = _mm_xor_si128(x, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), reflect));
+        x = ghash_hw_mult(x, key);
+        input += 16;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi8(x, reflect));
+}
+
+#elif defined(AES_HW_ARMV8)
+
+static int aes_hw_detect(void)
+{
+    // GHASH stays on the tables, only the AES rounds use the extension.
+    return ((::getauxval(AT_HWCAP) & HWCAP_AES) != 0 ? AES_HW_ROUNDS : 0);
+}
+
+#define AES_HW_TARGET __attribute__((target("+crypto")))
+
+AES_HW_TARGET static inline void aes_hw_load_keys(const mbedtls_aes_context* ctx, uint8x16_t key[15])
+{
+    for (int i = 0; i <= ctx->nr; i++) {
+        key[i] = vld1q_u8(reinterpret_cast<const uint8_t*>(&ctx->rk[i * 4]));
+    }
+}
+
+// AESE/AESD include the AddRoundKey of the round, so the last round key is added separately.
+AES_HW_TARGET static inline uint8x16_t aes_hw_encrypt(const uint8x16_t key[15], const int nr, uint8x16_t block)
+{
+    for (int i = 0; i < (nr - 1); i++) {
+        block = vaesmcq_u8(vaeseq_u8(block, key[i]));
+    }
+    return (veorq_u8(vaeseq_u8(block, key[nr - 1]), key[nr]));
+}
+
+AES_HW_TARGET static inline uint8x16_t aes_hw_decrypt(const uint8x16_t key[15], const int nr, uint8x16_t block)
+{
+    for (int i = 0; i < (nr - 1); i++) {
+        block = vaesimcq_u8(vaesdq_u8(block, key[i]));
+    }
+    return (veorq_u8(vaesdq_u8(block, key[nr - 1]), key[nr]));
+}
+
+AES_HW_TARGET static inline void aes_hw_encrypt4(const uint8x16_t key[15], const int nr, uint8x16_t block[4])
+{
+    for (int i = 0; i < (nr - 1); i++) {
+        block[0] = vaesmcq_u8(vaeseq_u8(block[0], key[i]));
+        block[1] = vaesmcq_u8(vaeseq_u8(block[1], key[i]));
+        block[2] = vaesmcq_u8(vaeseq_u8(block[2], key[i]));
+        block[3] = vaesmcq_u8(vaeseq_u8(block[3], key[i]));
+    }
+    block[0] = veorq_u8(vaeseq_u8(block[0], key[nr - 1]), key[nr]);
+    block[1] = veorq_u8(vaeseq_u8(block[1], key[nr - 1]), key[nr]);
+    block[2] = veorq_u8(vaeseq_u8(block[2], key[nr - 1]), key[nr]);
+    block[3] = veorq_u8(vaeseq_u8(block[3], key[nr - 1]), key[nr]);
+}
+
+AES_HW_TARGET static inline void aes_hw_decrypt4(const uint8x16_t key[15], const int nr, uint8x16_t block[4])
+{
+    for (int i = 0; i < (nr - 1); i++) {
+        block[0] = vaesimcq_u8(vaesdq_u8(block[0], key[i]));
+        block[1] = vaesimcq_u8(vaesdq_u8(block[1], key[i]));
+        block[2] = vaesimcq_u8(vaesdq_u8(block[2], key[i]));
+        block[3] = vaesimcq_u8(vaesdq_u8(block[3], key[i]));
+    }
+    block[0] = veorq_u8(vaesdq_u8(block[0], key[nr - 1]), key[nr]);
+    block[1] = veorq_u8(vaesdq_u8(block[1], key[nr - 1]), key[nr]);
+    block[2] = veorq_u8(vaesdq_u8(block[2], key[nr - 1]), key[nr]);
+    block[3] = veorq_u8(vaesdq_u8(block[3], key[nr - 1]), key[nr]);
+}
+
+#define AES_HW_BLOCK uint8x16_t
+#define AES_HW_LOAD(p) vld1q_u8(p)
+#define AES_HW_STORE(p, v) vst1q_u8(p, v)
+#define AES_HW_XOR(a, b) veorq_u8(a, b)
+#define AES_HW_COUNTER(high, low) vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(__builtin_bswap64(high)), vcreate_u64(__builtin_bswap64(low))))
+
+#endif
+
+#if defined(AES_HW_BLOCK)
+
+static int aes_hw_support(void)
+{
+    static const int support = aes_hw_detect();
+
+    return (aes_hw_enabled != 0 ? support : 0);
+}
+
+// Big endian 128 bit counter block, as mbedtls_aes_crypt_ctr increments it.
+static inline void aes_hw_counter_load(uint64_t& high, uint64_t& low, const unsigned char counter[16])
+{
+    high = 0;
+    low = 0;
+    for (int i = 0; i < 8; i++) {
+        high = (high << 8) | counter[i];
+        low = (low << 8) | counter[i + 8];
+    }
+}
+
+static inline void aes_hw_counter_store(unsigned char counter[16], const uint64_t high, const uint64_t low)
+{
+    for (int i = 7; i >= 0; i--) {
+        counter[i] = static_cast<unsigned char>(high >> ((7 - i) * 8));
+        counter[i + 8] = static_cast<unsigned char>(low >> ((7 - i) * 8));
+    }
+}
+
+// The counter block, built in a register, after which the counter moves on to the next one.
+AES_HW_TARGET static inline AES_HW_BLOCK aes_hw_counter_next(uint64_t& high, uint64_t& low)
+{
+    AES_HW_BLOCK result = AES_HW_COUNTER(high, low);
+
+    if (++low == 0) {
+        high++;
+    }
+
+    return (result);
+}
+
+AES_HW_TARGET static void aes_hw_crypt_ecb(const mbedtls_aes_context* ctx, int mode, uint32_t blocks, const unsigned char* input, unsigned char* output)
+{
+    AES_HW_BLOCK key[15];
+    AES_HW_BLOCK block[4];
+
+    aes_hw_load_keys(ctx, key);
+
+    for (; blocks >= 4; blocks -= 4, input += 64, output += 64) {
+        for (int i = 0; i < 4; i++) {
+            block[i] = AES_HW_LOAD(&input[i * 16]);
+        }
+        if (mode == MBEDTLS_AES_ENCRYPT) {
+            aes_hw_encrypt4(key, ctx->nr, block);
+        } else {
+            aes_hw_decrypt4(key, ctx->nr, block);
+        }
+        for (int i = 0; i < 4; i++) {
+            AES_HW_STORE(&output[i * 16], block[i]);
+        }
+    }
+    for (; blocks > 0; blocks--, input += 16, output += 16) {
+        if (mode == MBEDTLS_AES_ENCRYPT) {
+            AES_HW_STORE(output, aes_hw_encrypt(key, ctx->nr, AES_HW_LOAD(input)));
+        } else {
+            AES_HW_STORE(output, aes_hw_decrypt(key, ctx->nr, AES_HW_LOAD(input)));
+        }
+    }
+}
+
+AES_HW_TARGET static void aes_hw_crypt_cbc(const mbedtls_aes_context* ctx, int mode, uint32_t blocks, unsigned char iv[16], const unsigned char* input, unsigned char* output)
+{
+    AES_HW_BLOCK key[15];
+    AES_HW_BLOCK chain = AES_HW_LOAD(iv);
+
+    aes_hw_load_keys(ctx, key);
+
+    if (mode == MBEDTLS_AES_ENCRYPT) {
+        // Each block depends on the previous one, no parallelism possible.
+        for (; blocks > 0; blocks--, input += 16, output += 16) {
+            chain = aes_hw_encrypt(key, ctx->nr, AES_HW_XOR(AES_HW_LOAD(input), chain));
+            AES_HW_STORE(output, chain);
+        }
+    } else {
+        AES_HW_BLOCK block[4];
+        AES_HW_BLOCK cipher[4];
+
+        // Input and output may be the same buffer, keep the ciphertext for the chaining.
+        for (; blocks >= 4; blocks -= 4, input += 64, output += 64) {
+            for (int i = 0; i < 4; i++) {
+                block[i] = cipher[i] = AES_HW_LOAD(&input[i * 16]);
+            }
+            aes_hw_decrypt4(key, ctx->nr, block);
+            AES_HW_STORE(&output[0], AES_HW_XOR(block[0], chain));
+            AES_HW_STORE(&output[16], AES_HW_XOR(block[1], cipher[0]));
+            AES_HW_STORE(&output[32], AES_HW_XOR(block[2], cipher[1]));
+            AES_HW_STORE(&output[48], AES_HW_XOR(block[3], cipher[2]));
+            chain = cipher[3];
+        }
+        for (; blocks > 0; blocks--, input += 16, output += 16) {
+            cipher[0] = AES_HW_LOAD(input);
+            AES_HW_STORE(output, AES_HW_XOR(aes_hw_decrypt(key, ctx->nr, cipher[0]), chain));
+            chain = cipher[0];
+        }
+    }
+
+    AES_HW_STORE(iv, chain);
+}
+
+AES_HW_TARGET static void aes_hw_crypt_ctr(const mbedtls_aes_context* ctx, uint32_t blocks, unsigned char nonce_counter[16], const unsigned char* input, unsigned char* output)
+{
+    AES_HW_BLOCK key[15];
+    AES_HW_BLOCK block[4];
+    uint64_t high, low;
+
+    aes_hw_load_keys(ctx, key);
+    aes_hw_counter_load(high, low, nonce_counter);
+
+    for (; blocks >= 4; blocks -= 4, input += 64, output += 64) {
+        for (int i = 0; i < 4; i++) {
+            block[i] = aes_hw_counter_next(high, low);
+        }
+        aes_hw_encrypt4(key, ctx->nr, block);
+        for (int i = 0; i < 4; i++) {
+            AES_HW_STORE(&output[i * 16], AES_HW_XOR(block[i], AES_HW_LOAD(&input[i * 16])));
+        }
+    }
+    for (; blocks > 0; blocks--, input += 16, output += 16) {
+        AES_HW_STORE(output, AES_HW_XOR(aes_hw_encrypt(key, ctx->nr, aes_hw_counter_next(high, low)), AES_HW_LOAD(input)));
+    }
+
+    // Hand back the first counter that was not used.
+    aes_hw_counter_store(nonce_counter, high, low);
+}
+
+#else
+
+static int aes_hw_support(void)
+{
+    return (0);
+}
+
+#endif
+
+int mbedtls_aes_hw_acceleration(int enable)
+{
+    aes_hw_enabled = enable;
+
+    return (aes_hw_support() & AES_HW_ROUNDS);
+}
+
 void mbedtls_aes_init(mbedtls_aes_context* ctx)
 {
     memset(ctx, 0, sizeof(mbedtls_aes_context));
@@ -750,6 +1142,13 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context* ctx,
     }
 #endif
 
+#if defined(AES_HW_BLOCK)
+    if ((aes_hw_support() & AES_HW_ROUNDS) != 0) {
+        aes_hw_crypt_ecb(ctx, mode, 1, input, output);
+        return (0);
+    }
+#endif
+
     if (mode == MBEDTLS_AES_ENCRYPT)
         mbedtls_aes_encrypt(ctx, input, output);
     else
@@ -758,6 +1157,32 @@ int mbedtls_aes_crypt_ecb(mbedtls_aes_context* ctx,
     return (0);
 }
 
+/*
+* AES-ECB encryption/decryption of consecutive blocks
+*/
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context* ctx,
+    int mode,
+    uint32_t blocks,
+    const unsigned char* input,
+    unsigned char* output)
+{
+#if defined(AES_HW_BLOCK)
+    if ((aes_hw_support() & AES_HW_ROUNDS) != 0) {
+        aes_hw_crypt_ecb(ctx, mode, blocks, input, output);
+        return (0);
+    }
+#endif
+
+    while (blocks-- > 0) {
+        mbedtls_aes_crypt_ecb(ctx, mode, input, output);
+
+        input += 16;
+        output += 16;
+    }
+
+    return (0);
+}
+
 #if defined(MBEDTLS_CIPHER_MODE_CBC)
 /*
 * AES-CBC buffer encryption/decryption
@@ -786,6 +1211,13 @@ int mbedtls_aes_crypt_cbc(mbedtls_aes_context* ctx,
     }
 #endif
 
+#if defined(AES_HW_BLOCK)
+    if ((aes_hw_support() & AES_HW_ROUNDS) != 0) {
+        aes_hw_crypt_cbc(ctx, mode, length / 16, iv, input, output);
+        return (0);
+    }
+#endif
+
     if (mode == MBEDTLS_AES_DECRYPT) {
         while (length > 0) {
             memcpy(temp, input, 16);
@@ -907,6 +1339,24 @@ int mbedtls_aes_crypt_ctr(mbedtls_aes_context* ctx,
     int c, i;
     uint32_t n = *nc_off;
 
+#if defined(AES_HW_BLOCK)
+    if ((aes_hw_support() & AES_HW_ROUNDS) != 0) {
+        // Use up the key stream left over from the previous call, the whole blocks go in one run.
+        while ((n != 0) && (length > 0)) {
+            *output++ = (unsigned char)(*input++ ^ stream_block[n]);
+            n = (n + 1) & 0x0F;
+            length--;
+        }
+
+        if (length >= 16) {
+            aes_hw_crypt_ctr(ctx, length / 16, nonce_counter, input, output);
+            input += (length & ~0x0F);
+            output += (length & ~0x0F);
+            length &= 0x0F;
+        }
+    }
+#endif
+
     while (length--) {
         if (n == 0) {
             mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, nonce_counter, stream_block);
@@ -954,7 +1404,7 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
     }
 
     while ((cnt + 16) <= length) {
-        mbedtls_aes_encrypt(ctx, iv, iv);
+        mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, iv, iv);
 
         for (unsigned char teller = 0; teller < 16; teller++) {
 
@@ -964,7 +1414,7 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
     }
 
     if (cnt < length) {
-        mbedtls_aes_encrypt(ctx, iv, iv);
+        mbedtls_aes_crypt_ecb(ctx, MBEDTLS_AES_ENCRYPT, iv, iv);
 
         while (cnt < length) {
             *output++ = iv[b_pos++] ^ *input++;
@@ -979,6 +1429,118 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
 
 #endif /* MBEDTLS_CIPHER_MODE_OFB */
 
+/*
+* GHASH, the GCM authentication function (NIST SP 800-38D), with 4 bit tables (Shoup's method)
+* or the carry-less multiply instruction if the CPU has it.
+*/
+static const uint64_t ghash_last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460,
+    0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560,
+    0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+void mbedtls_ghash_setkey(mbedtls_ghash_context* ctx, const unsigned char h[16])
+{
+    int i, j;
+    uint64_t vh = 0, vl = 0;
+
+    memcpy(ctx->H, h, 16);
+
+    for (i = 0; i < 8; i++) {
+        vh = (vh << 8) | h[i];
+        vl = (vl << 8) | h[i + 8];
+    }
+
+    /* 8 = 1000 corresponds to 1 in GF(2^128) */
+    ctx->HL[8] = vl;
+    ctx->HH[8] = vh;
+
+    /* 0 corresponds to 0 in GF(2^128) */
+    ctx->HH[0] = 0;
+    ctx->HL[0] = 0;
+
+    for (i = 4; i > 0; i >>= 1) {
+        uint32_t T = (vl & 1) * 0xe1000000U;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ ((uint64_t)T << 32);
+
+        ctx->HL[i] = vl;
+        ctx->HH[i] = vh;
+    }
+
+    for (i = 2; i <= 8; i *= 2) {
+        uint64_t *HiL = ctx->HL + i, *HiH = ctx->HH + i;
+        vh = *HiH;
+        vl = *HiL;
+        for (j = 1; j < i; j++) {
+            HiH[j] = vh ^ ctx->HH[j];
+            HiL[j] = vl ^ ctx->HL[j];
+        }
+    }
+}
+
+static void ghash_mult(const mbedtls_ghash_context* ctx, unsigned char x[16])
+{
+    int i;
+    unsigned char lo, hi, rem;
+    uint64_t zh, zl;
+
+    lo = x[15] & 0xf;
+
+    zh = ctx->HH[lo];
+    zl = ctx->HL[lo];
+
+    for (i = 15; i >= 0; i--) {
+        lo = x[i] & 0xf;
+        hi = (x[i] >> 4) & 0xf;
+
+        if (i != 15) {
+            rem = (unsigned char)zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4);
+            zh ^= (uint64_t)ghash_last4[rem] << 48;
+            zh ^= ctx->HH[lo];
+            zl ^= ctx->HL[lo];
+        }
+
+        rem = (unsigned char)zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4);
+        zh ^= (uint64_t)ghash_last4[rem] << 48;
+        zh ^= ctx->HH[hi];
+        zl ^= ctx->HL[hi];
+    }
+
+    for (i = 0; i < 8; i++) {
+        x[i] = (unsigned char)(zh >> (56 - (i * 8)));
+        x[i + 8] = (unsigned char)(zl >> (56 - (i * 8)));
+    }
+}
+
+void mbedtls_ghash_update(const mbedtls_ghash_context* ctx,
+    unsigned char state[16],
+    uint32_t blocks,
+    const unsigned char* input)
+{
+#if defined(AES_HW_X86)
+    if ((aes_hw_support() & AES_HW_CLMUL) != 0) {
+        ghash_hw_update(state, ctx->H, blocks, input);
+        return;
+    }
+#endif
+
+    while (blocks-- > 0) {
+        for (int i = 0; i < 16; i++) {
+            state[i] ^= input[i];
+        }
+
+        ghash_mult(ctx, state);
+
+        input += 16;
+    }
+}
+
 #endif /* !MBEDTLS_AES_ALT */
 
 #if defined(MBEDTLS_SELF_TEST)
@@ -29,7 +29,7 @@
 #define MBEDTLS_CIPHER_MODE_CFB
 #define MBEDTLS_CIPHER_MODE_OFB
 #undef MBEDTLS_SELF_TEST
-#undef MBEDTLS_CIPHER_MODE_CTR
+#define MBEDTLS_CIPHER_MODE_CTR
 
 #include <stddef.h>
 #include <stdint.h>
@@ -272,6 +272,70 @@ int mbedtls_aes_crypt_ofb(mbedtls_aes_context* ctx,
 
 #endif /* MBEDTLS_CIPHER_MODE_OFB */
 
+/**
+	* \brief          AES-ECB encryption/decryption of consecutive blocks.
+	*                 With hardware acceleration, several blocks are processed
+	*                 in parallel, which is a lot faster than block by block.
+	*
+	* \param ctx      AES context
+	* \param mode     MBEDTLS_AES_ENCRYPT or MBEDTLS_AES_DECRYPT
+	* \param blocks   number of 16-byte blocks
+	* \param input    buffer holding the input data
+	* \param output   buffer holding the output data (may be the input)
+	*
+	* \return         0 if successful
+	*/
+int mbedtls_aes_crypt_ecb_blocks(mbedtls_aes_context* ctx,
+    int mode,
+    uint32_t blocks,
+    const unsigned char* input,
+    unsigned char* output);
+
+/**
+	* \brief          Hardware acceleration (AES-NI and PCLMULQDQ on x86, Cryptography
+	*                 Extensions on ARMv8) of the AES rounds and of GHASH. It is
+	*                 detected on first use and used by all functions in here.
+	*
+	* \param enable   0 forces the table implementation (e.g. to compare them),
+	*                 1 uses the hardware if the CPU supports it (default).
+	*
+	* \return         non-zero if the AES rounds run on the hardware from now on.
+	*/
+int mbedtls_aes_hw_acceleration(int enable);
+
+/**
+	* \brief          GHASH context, the hash subkey H of GCM, expanded for the
+	*                 table implementation.
+	*/
+typedef struct
+{
+    uint64_t HL[16]; /*!< precalculated H table, low part */
+    uint64_t HH[16]; /*!< precalculated H table, high part */
+    unsigned char H[16]; /*!< hash subkey */
+} mbedtls_ghash_context;
+
+/**
+	* \brief          GHASH key setup
+	*
+	* \param ctx      GHASH context to be initialized
+	* \param h        hash subkey (the encryption of the zero block)
+	*/
+void mbedtls_ghash_setkey(mbedtls_ghash_context* ctx, const unsigned char h[16]);
+
+/**
+	* \brief          GHASH of whole blocks: state = (state ^ block) * H for
+	*                 each block of the input.
+	*
+	* \param ctx      GHASH context
+	* \param state    running hash value (updated)
+	* \param blocks   number of 16-byte blocks
+	* \param input    buffer holding the data
+	*/
+void mbedtls_ghash_update(const mbedtls_ghash_context* ctx,
+    unsigned char state[16],
+    uint32_t blocks,
+    const unsigned char* input);
+
 /**
 	* \brief           Internal AES block encryption function
 	*                  (Only exposed to allow overriding it,
@@ -45,6 +45,17 @@
 #include "Winsock2.h"
 #endif // __WIN32__
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__LINUX__)
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
 // --------------------------------------------------------------------------------------------
 // MD5 functionality
 // --------------------------------------------------------------------------------------------
@@ -196,6 +207,13 @@
 
 namespace WPEFramework {
 namespace Crypto {
+    // Hardware accelerated block functions, nullptr if the CPU does not support them (see below).
+    typedef void (*sha1_transform)(uint32_t state[5], const uint8_t data[], uint64_t blocks);
+    typedef void (*sha256_transform)(uint32_t state[8], const uint8_t data[], uint64_t blocks);
+
+    static sha1_transform sha1_accelerated();
+    static sha256_transform sha256_accelerated();
+
     // --------------------------------------------------------------------------------------------
     // SHA1 functionality
     // --------------------------------------------------------------------------------------------
@@ -217,31 +235,50 @@ namespace Crypto {
  *  Comments:
  *
  */
-    void SHA1::Input(const uint8_t message_array[], const uint16_t length)
+    void SHA1::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t counter = length;
+        uint64_t counter = length;
         const uint8_t* current = &(message_array[0]);
 
         ASSERT((_computed == false) || (_corrupted == false));
 
-        while (counter-- && !_corrupted) {
-            _messageBlock[_messageIndex++] = *current;
+        if (_corrupted == false) {
+            _length += length;
 
-            _lengthLow++;
-            if (_lengthLow == 0x20000000) {
-                _lengthLow = 0;
-                _lengthHigh++;
-                if (_lengthHigh == 0) {
-                    _corrupted = true; // Message is too long
+            if (_length >= (static_cast<uint64_t>(1) << 61)) {
+                _corrupted = true; // Message is too long
+            } else {
+                // First complete the block that is partially filled..
+                if (_messageIndex > 0) {
+                    uint32_t size = (64 - _messageIndex);
+
+                    if (counter < size) {
+                        size = static_cast<uint32_t>(counter);
+                    }
+
+                    ::memcpy(&(_messageBlock[_messageIndex]), current, size);
+                    _messageIndex += size;
+                    current += size;
+                    counter -= size;
+
+                    if (_messageIndex == 64) {
+                        ProcessMessageBlocks(_messageBlock, 1);
+                        _messageIndex = 0;
+                    }
                 }
-            }
 
-            if (_messageIndex == 64) {
-                ProcessMessageBlock();
-                _messageIndex = 0;
-            }
+                // All complete blocks can be processed straight from the input..
+                if (counter >= 64) {
+                    ProcessMessageBlocks(current, counter >> 6);
+                    current += (counter & ~static_cast<uint64_t>(0x3F));
+                    counter &= 0x3F;
+                }
 
-            current++;
+                if (counter > 0) {
+                    ::memcpy(_messageBlock, current, static_cast<size_t>(counter));
+                    _messageIndex = static_cast<uint32_t>(counter);
+                }
+            }
         }
     }
 
@@ -265,13 +302,14 @@ namespace Crypto {
  */
     SHA1& SHA1::operator<<(const uint8_t message_array[])
     {
-        const uint8_t* p = &(message_array[0]);
+        uint32_t length = 0;
 
-        while (*p != 0) {
-            Input(p, 1);
-            p++;
+        while (message_array[length] != '\0') {
+            length++;
         }
 
+        Input(message_array, length);
+
         return *this;
     }
 
@@ -299,15 +337,45 @@ namespace Crypto {
         return *this;
     }
 
+    /*
+ *  ProcessMessageBlocks
+ *
+ *  Description:
+ *      This function will process the next blocks of 512 bits of the
+ *      message. If the CPU has SHA instructions, they are used.
+ *
+ *  Parameters:
+ *      blocks: [in]
+ *          The message blocks, 64 bytes each.
+ *      count: [in]
+ *          The number of message blocks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ */
+    void SHA1::ProcessMessageBlocks(const uint8_t blocks[], const uint64_t count)
+    {
+        static const sha1_transform accelerated = sha1_accelerated();
+
+        if (accelerated != nullptr) {
+            accelerated(H, blocks, count);
+        } else {
+            for (uint64_t index = 0; index < count; index++) {
+                ProcessMessageBlock(&(blocks[index << 6]));
+            }
+        }
+    }
+
     /*
  *  ProcessMessageBlock
  *
  *  Description:
- *      This function will process the next 512 bits of the message
- *      stored in the _messageBlock array.
+ *      This function will process the next 512 bits of the message.
  *
  *  Parameters:
- *      None.
+ *      block: [in]
+ *          The 64 bytes of the message to process.
  *
  *  Returns:
  *      Nothing.
@@ -318,7 +386,7 @@ namespace Crypto {
  *      in the publication.
  *
  */
-    void SHA1::ProcessMessageBlock()
+    void SHA1::ProcessMessageBlock(const uint8_t block[])
     {
         const unsigned K[] = { // Constants defined for SHA-1
             0x5A827999,
@@ -335,10 +403,10 @@ namespace Crypto {
      *  Initialize the first 16 words in the array W
      */
         for (t = 0; t < 16; t++) {
-            W[t] = ((unsigned)_messageBlock[t * 4]) << 24;
-            W[t] |= ((unsigned)_messageBlock[t * 4 + 1]) << 16;
-            W[t] |= ((unsigned)_messageBlock[t * 4 + 2]) << 8;
-            W[t] |= ((unsigned)_messageBlock[t * 4 + 3]);
+            W[t] = ((unsigned)block[t * 4]) << 24;
+            W[t] |= ((unsigned)block[t * 4 + 1]) << 16;
+            W[t] |= ((unsigned)block[t * 4 + 2]) << 8;
+            W[t] |= ((unsigned)block[t * 4 + 3]);
         }
 
         for (t = 16; t < 80; t++) {
@@ -431,7 +499,7 @@ namespace Crypto {
 
             ::memset(&(_messageBlock[_messageIndex]), 0, (64 - _messageIndex));
 
-            ProcessMessageBlock();
+            ProcessMessageBlocks(_messageBlock, 1);
 
             _messageIndex = 0;
         } else {
@@ -442,16 +510,11 @@ namespace Crypto {
         /*
      *  Store the message length as the last 8 octets
      */
-        _messageBlock[56] = (_lengthHigh >> 24) & 0xFF;
-        _messageBlock[57] = (_lengthHigh >> 16) & 0xFF;
-        _messageBlock[58] = (_lengthHigh >> 8) & 0xFF;
-        _messageBlock[59] = (_lengthHigh)&0xFF;
-        _messageBlock[60] = (_lengthLow >> 21) & 0xFF;
-        _messageBlock[61] = (_lengthLow >> 13) & 0xFF;
-        _messageBlock[62] = (_lengthLow >> 5) & 0xFF;
-        _messageBlock[63] = (_lengthLow << 3) & 0xFF;
+        const uint64_t bits = (_length << 3);
+
+        UNPACK64(bits, &(_messageBlock[56]));
 
-        ProcessMessageBlock();
+        ProcessMessageBlocks(_messageBlock, 1);
 
         uint32_t* writer = reinterpret_cast<uint32_t*>(&_messageBlock[0]);
 
@@ -660,20 +723,18 @@ namespace Crypto {
         _context.buffer[15] = _context.d >> 24;
     }
 
-    void MD5::Input(const uint8_t message_array[], const uint16_t length)
+    void MD5::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t sizeToHandle = length;
+        uint64_t sizeToHandle = length;
         const uint8_t* source = &message_array[0];
 
+        // The update takes an unsigned long, which might be 32 bits..
         while (sizeToHandle > 0) {
-            if (sizeToHandle > 512) {
-                MD5_Update(&_context, source, 512);
-                source += 512;
-                sizeToHandle -= 512;
-            } else {
-                MD5_Update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
+            const unsigned long size = (sizeToHandle > 0x40000000 ? 0x40000000 : static_cast<unsigned long>(sizeToHandle));
+
+            MD5_Update(&_context, source, size);
+            source += size;
+            sizeToHandle -= size;
         }
     }
 
@@ -697,7 +758,7 @@ namespace Crypto {
  */
     MD5& MD5::operator<<(const uint8_t message_array[])
     {
-        uint16_t length = 0;
+        uint32_t length = 0;
 
         while (message_array[length] != '\0') {
             length++;
@@ -820,22 +881,283 @@ namespace Crypto {
         0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
     };
 
+    // --------------------------------------------------------------------------------------------
+    // Hardware accelerated block functions (SHA-NI on x86, Cryptography Extensions on ARMv8)
+    // --------------------------------------------------------------------------------------------
+    // The instructions are not available on every CPU the code is compiled for, so the accelerated
+    // functions are compiled for the extension only, and selected at runtime if the CPU supports it.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+    static bool sha_extensions()
+    {
+        uint32_t eax, ebx, ecx, edx;
+        bool result = false;
+
+        // SHA-NI (leaf 7, EBX bit 29), the functions below also use SSSE3 and SSE4.1 (leaf 1, ECX bit 9 and 19)
+        if ((__get_cpuid_max(0, nullptr) >= 7) && (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0)) {
+            const bool sse = ((ecx & (1 << 9)) != 0) && ((ecx & (1 << 19)) != 0);
+
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+            result = (sse == true) && ((ebx & (1 << 29)) != 0);
+        }
+
+        return (result);
+    }
+
+    __attribute__((target("sha,sse4.1"))) static void sha1_transf_accelerated(uint32_t state[5], const uint8_t data[], uint64_t blocks)
+    {
+        const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+        __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+        __m128i e[2] = { _mm_set_epi32(state[4], 0, 0, 0), _mm_setzero_si128() };
+        __m128i msg[4];
+
+        while (blocks-- > 0) {
+            const __m128i abcdSaved = abcd;
+            const __m128i eSaved = e[0];
+
+            for (uint8_t index = 0; index < 4; index++) {
+                msg[index] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index << 4])), mask);
+            }
+
+            // 20 groups of 4 rounds, the message schedule is calculated for the groups ahead. Once unrolled,
+            // the switch on the round function below disappears and all values stay in registers.
+#if (__GNUC__ >= 8)
+#pragma GCC unroll 20
+#endif
+            for (uint8_t group = 0; group < 20; group++) {
+                __m128i& current(e[group & 0x01]);
+
+                current = (group == 0 ? _mm_add_epi32(current, msg[0]) : _mm_sha1nexte_epu32(current, msg[group & 0x03]));
+                e[(group & 0x01) ^ 0x01] = abcd;
+
+                if ((group >= 3) && (group <= 18)) {
+                    msg[(group + 1) & 0x03] = _mm_sha1msg2_epu32(msg[(group + 1) & 0x03], msg[group & 0x03]);
+                }
+
+                // The round function is an immediate operand...
+                switch (group / 5) {
+                case 0:
+                    abcd = _mm_sha1rnds4_epu32(abcd, current, 0);
+                    break;
+                case 1:
+                    abcd = _mm_sha1rnds4_epu32(abcd, current, 1);
+                    break;
+                case 2:
+                    abcd = _mm_sha1rnds4_epu32(abcd, current, 2);
+                    break;
+                default:
+                    abcd = _mm_sha1rnds4_epu32(abcd, current, 3);
+                    break;
+                }
+
+                if ((group >= 1) && (group <= 16)) {
+                    msg[(group + 3) & 0x03] = _mm_sha1msg1_epu32(msg[(group + 3) & 0x03], msg[group & 0x03]);
+                }
+                if ((group >= 2) && (group <= 17)) {
+                    msg[(group + 2) & 0x03] = _mm_xor_si128(msg[(group + 2) & 0x03], msg[group & 0x03]);
+                }
+            }
+
+            e[0] = _mm_sha1nexte_epu32(e[0], eSaved);
+            abcd = _mm_add_epi32(abcd, abcdSaved);
+
+            data += 64;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+        state[4] = _mm_extract_epi32(e[0], 3);
+    }
+
+    __attribute__((target("sha,sse4.1"))) static void sha256_transf_accelerated(uint32_t state[8], const uint8_t data[], uint64_t blocks)
+    {
+        const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // The instructions work on ABEF and CDGH
+        __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+        __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+        __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+        __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+        __m128i msg[4];
+
+        while (blocks-- > 0) {
+            const __m128i abefSaved = abef;
+            const __m128i cdghSaved = cdgh;
+
+            // 16 groups of 4 rounds, the message schedule is calculated for the group at hand.
+            for (uint8_t group = 0; group < 16; group++) {
+                __m128i& w(msg[group & 0x03]);
+
+                if (group < 4) {
+                    w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[group << 4])), mask);
+                } else {
+                    const __m128i& previous(msg[(group - 1) & 0x03]);
+
+                    w = _mm_sha256msg1_epu32(w, msg[(group - 3) & 0x03]);
+                    w = _mm_add_epi32(w, _mm_alignr_epi8(previous, msg[(group - 2) & 0x03], 4));
+                    w = _mm_sha256msg2_epu32(w, previous);
+                }
+
+                __m128i value = _mm_add_epi32(w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&sha256_k[group << 2])));
+
+                cdgh = _mm_sha256rnds2_epu32(cdgh, abef, value);
+                value = _mm_shuffle_epi32(value, 0x0E);
+                abef = _mm_sha256rnds2_epu32(abef, cdgh, value);
+            }
+
+            abef = _mm_add_epi32(abef, abefSaved);
+            cdgh = _mm_add_epi32(cdgh, cdghSaved);
+
+            data += 64;
+        }
+
+        // Back to ABCD and EFGH
+        const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+        const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+    }
+
+    static sha1_transform sha1_accelerated()
+    {
+        return (sha_extensions() == true ? sha1_transf_accelerated : nullptr);
+    }
+
+    static sha256_transform sha256_accelerated()
+    {
+        return (sha_extensions() == true ? sha256_transf_accelerated : nullptr);
+    }
+
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__LINUX__)
+
+    static const uint32_t sha1_k[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+    __attribute__((target("+crypto"))) static void sha1_transf_accelerated(uint32_t state[5], const uint8_t data[], uint64_t blocks)
+    {
+        uint32x4_t abcd = vld1q_u32(&state[0]);
+        uint32_t e = state[4];
+        uint32x4_t msg[4];
+
+        while (blocks-- > 0) {
+            const uint32x4_t abcdSaved = abcd;
+            const uint32_t eSaved = e;
+
+            for (uint8_t index = 0; index < 4; index++) {
+                msg[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index << 4])));
+            }
+
+            // 20 groups of 4 rounds, the message schedule is calculated for the groups ahead.
+            for (uint8_t group = 0; group < 20; group++) {
+                const uint32x4_t value = vaddq_u32(msg[group & 0x03], vdupq_n_u32(sha1_k[group / 5]));
+                const uint32_t next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+                if (group < 5) {
+                    abcd = vsha1cq_u32(abcd, e, value);
+                } else if ((group < 10) || (group >= 15)) {
+                    abcd = vsha1pq_u32(abcd, e, value);
+                } else {
+                    abcd = vsha1mq_u32(abcd, e, value);
+                }
+                e = next;
+
+                if (group < 16) {
+                    uint32x4_t& w(msg[group & 0x03]);
+                    w = vsha1su0q_u32(w, msg[(group + 1) & 0x03], msg[(group + 2) & 0x03]);
+                    w = vsha1su1q_u32(w, msg[(group + 3) & 0x03]);
+                }
+            }
+
+            abcd = vaddq_u32(abcd, abcdSaved);
+            e += eSaved;
+
+            data += 64;
+        }
+
+        vst1q_u32(&state[0], abcd);
+        state[4] = e;
+    }
+
+    __attribute__((target("+crypto"))) static void sha256_transf_accelerated(uint32_t state[8], const uint8_t data[], uint64_t blocks)
+    {
+        uint32x4_t abcd = vld1q_u32(&state[0]);
+        uint32x4_t efgh = vld1q_u32(&state[4]);
+        uint32x4_t msg[4];
+
+        while (blocks-- > 0) {
+            const uint32x4_t abcdSaved = abcd;
+            const uint32x4_t efghSaved = efgh;
+
+            for (uint8_t index = 0; index < 4; index++) {
+                msg[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index << 4])));
+            }
+
+            // 16 groups of 4 rounds, the message schedule is calculated for the groups ahead.
+            for (uint8_t group = 0; group < 16; group++) {
+                const uint32x4_t value = vaddq_u32(msg[group & 0x03], vld1q_u32(&sha256_k[group << 2]));
+                const uint32x4_t previous = abcd;
+
+                abcd = vsha256hq_u32(abcd, efgh, value);
+                efgh = vsha256h2q_u32(efgh, previous, value);
+
+                if (group < 12) {
+                    uint32x4_t& w(msg[group & 0x03]);
+                    w = vsha256su0q_u32(w, msg[(group + 1) & 0x03]);
+                    w = vsha256su1q_u32(w, msg[(group + 2) & 0x03], msg[(group + 3) & 0x03]);
+                }
+            }
+
+            abcd = vaddq_u32(abcd, abcdSaved);
+            efgh = vaddq_u32(efgh, efghSaved);
+
+            data += 64;
+        }
+
+        vst1q_u32(&state[0], abcd);
+        vst1q_u32(&state[4], efgh);
+    }
+
+    static sha1_transform sha1_accelerated()
+    {
+        return ((::getauxval(AT_HWCAP) & HWCAP_SHA1) != 0 ? sha1_transf_accelerated : nullptr);
+    }
+
+    static sha256_transform sha256_accelerated()
+    {
+        return ((::getauxval(AT_HWCAP) & HWCAP_SHA2) != 0 ? sha256_transf_accelerated : nullptr);
+    }
+
+#else
+
+    static sha1_transform sha1_accelerated()
+    {
+        return (nullptr);
+    }
+
+    static sha256_transform sha256_accelerated()
+    {
+        return (nullptr);
+    }
+
+#endif
+
     // --------------------------------------------------------------------------------------------
     // SHA256 functionality
     // --------------------------------------------------------------------------------------------
-    static void sha256_transf(SHA256::Context* ctx, const unsigned char* message, unsigned int block_nb)
+    static void sha256_transf_generic(SHA256::Context* ctx, const unsigned char* message, uint64_t block_nb)
     {
         uint32_t w[64];
         uint32_t wv[8];
         uint32_t t1, t2;
         const unsigned char* sub_block;
-        int i;
+        uint64_t i;
 
 #ifndef UNROLL_LOOPS
         int j;
 #endif
 
-        for (i = 0; i < (int)block_nb; i++) {
+        for (i = 0; i < block_nb; i++) {
             sub_block = message + (i << 6);
 
 #ifndef UNROLL_LOOPS
@@ -1021,6 +1343,19 @@ namespace Crypto {
         }
     }
 
+    static void sha256_transf(SHA256::Context* ctx, const unsigned char* message, uint64_t block_nb)
+    {
+        static const sha256_transform accelerated = sha256_accelerated();
+
+        if (block_nb > 0) {
+            if (accelerated != nullptr) {
+                accelerated(ctx->h, message, block_nb);
+            } else {
+                sha256_transf_generic(ctx, message, block_nb);
+            }
+        }
+    }
+
     void SHA256::Reset()
     {
 #ifndef UNROLL_LOOPS
@@ -1044,10 +1379,10 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha256_update(SHA256::Context* ctx, const unsigned char* message, unsigned int len)
+    static void sha256_update(SHA256::Context* ctx, const unsigned char* message, uint64_t len)
     {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
+        uint64_t block_nb;
+        uint64_t new_len, rem_len, tmp_len;
         const unsigned char* shifted_message;
 
         tmp_len = SHA256_BLOCK_SIZE - ctx->len;
@@ -1056,7 +1391,7 @@ namespace Crypto {
         memcpy(&ctx->block[ctx->len], message, rem_len);
 
         if (ctx->len + len < SHA256_BLOCK_SIZE) {
-            ctx->len += len;
+            ctx->len += static_cast<uint32_t>(len);
             return;
         }
 
@@ -1073,7 +1408,7 @@ namespace Crypto {
         memcpy(ctx->block, &shifted_message[block_nb << 6],
             rem_len);
 
-        ctx->len = rem_len;
+        ctx->len = static_cast<uint32_t>(rem_len);
         ctx->tot_len += (block_nb + 1) << 6;
     }
 
@@ -1081,7 +1416,7 @@ namespace Crypto {
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64_t len_b;
 
 #ifndef UNROLL_LOOPS
         int i;
@@ -1094,7 +1429,7 @@ namespace Crypto {
 
         memset(_context.block + _context.len, 0, pm_len - _context.len);
         _context.block[_context.len] = 0x80;
-        UNPACK32(len_b, _context.block + pm_len - 4);
+        UNPACK64(len_b, _context.block + pm_len - 8);
 
         sha256_transf(&_context, _context.block, block_nb);
 
@@ -1114,20 +1449,10 @@ namespace Crypto {
 #endif /* !UNROLL_LOOPS */
     }
 
-    void SHA256::Input(const uint8_t message_array[], const uint16_t length)
+    void SHA256::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA256_BLOCK_SIZE) {
-                sha256_update(&_context, source, SHA256_BLOCK_SIZE);
-                source += SHA256_BLOCK_SIZE;
-                sizeToHandle -= SHA256_BLOCK_SIZE;
-            } else {
-                sha256_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
+        if (length > 0) {
+            sha256_update(&_context, message_array, length);
         }
     }
 
@@ -1151,7 +1476,7 @@ namespace Crypto {
  */
     SHA256& SHA256::operator<<(const uint8_t message_array[])
     {
-        uint16_t length = 0;
+        uint32_t length = 0;
 
         while (message_array[length] != '\0') {
             length++;
@@ -1212,10 +1537,10 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha224_update(SHA256::Context* ctx, const unsigned char* message, unsigned int len)
+    static void sha224_update(SHA256::Context* ctx, const unsigned char* message, uint64_t len)
     {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
+        uint64_t block_nb;
+        uint64_t new_len, rem_len, tmp_len;
         const unsigned char* shifted_message;
 
         tmp_len = SHA224_BLOCK_SIZE - ctx->len;
@@ -1224,7 +1549,7 @@ namespace Crypto {
         memcpy(&ctx->block[ctx->len], message, rem_len);
 
         if (ctx->len + len < SHA224_BLOCK_SIZE) {
-            ctx->len += len;
+            ctx->len += static_cast<uint32_t>(len);
             return;
         }
 
@@ -1241,7 +1566,7 @@ namespace Crypto {
         memcpy(ctx->block, &shifted_message[block_nb << 6],
             rem_len);
 
-        ctx->len = rem_len;
+        ctx->len = static_cast<uint32_t>(rem_len);
         ctx->tot_len += (block_nb + 1) << 6;
     }
 
@@ -1249,7 +1574,7 @@ namespace Crypto {
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64_t len_b;
 
 #ifndef UNROLL_LOOPS
         int i;
@@ -1262,7 +1587,7 @@ namespace Crypto {
 
         memset(_context.block + _context.len, 0, pm_len - _context.len);
         _context.block[_context.len] = 0x80;
-        UNPACK32(len_b, _context.block + pm_len - 4);
+        UNPACK64(len_b, _context.block + pm_len - 8);
 
         sha256_transf(&_context, _context.block, block_nb);
 
@@ -1281,20 +1606,10 @@ namespace Crypto {
 #endif /* !UNROLL_LOOPS */
     }
 
-    void SHA224::Input(const uint8_t message_array[], const uint16_t length)
+    void SHA224::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA224_BLOCK_SIZE) {
-                sha224_update(&_context, source, SHA224_BLOCK_SIZE);
-                source += SHA224_BLOCK_SIZE;
-                sizeToHandle -= SHA224_BLOCK_SIZE;
-            } else {
-                sha224_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
+        if (length > 0) {
+            sha224_update(&_context, message_array, length);
         }
     }
 
@@ -1318,7 +1633,7 @@ namespace Crypto {
  */
     SHA224& SHA224::operator<<(const uint8_t message_array[])
     {
-        uint16_t length = 0;
+        uint32_t length = 0;
 
         while (message_array[length] != '\0') {
             length++;
@@ -1356,15 +1671,16 @@ namespace Crypto {
     // --------------------------------------------------------------------------------------------
     // SHA512 functionality
     // --------------------------------------------------------------------------------------------
-    static void sha512_transf(SHA512::Context* ctx, const unsigned char* message, unsigned int block_nb)
+    static void sha512_transf(SHA512::Context* ctx, const unsigned char* message, uint64_t block_nb)
     {
         uint64_t w[80];
         uint64_t wv[8];
         uint64_t t1, t2;
         const unsigned char* sub_block;
-        int i, j;
+        uint64_t i;
+        int j;
 
-        for (i = 0; i < (int)block_nb; i++) {
+        for (i = 0; i < block_nb; i++) {
             sub_block = message + (i << 7);
 
 #ifndef UNROLL_LOOPS
@@ -1545,11 +1861,10 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha512_update(SHA512::Context* ctx, const unsigned char* message,
-        unsigned int len)
+    static void sha512_update(SHA512::Context* ctx, const unsigned char* message, uint64_t len)
     {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
+        uint64_t block_nb;
+        uint64_t new_len, rem_len, tmp_len;
         const unsigned char* shifted_message;
 
         tmp_len = SHA512_BLOCK_SIZE - ctx->len;
@@ -1558,7 +1873,7 @@ namespace Crypto {
         memcpy(&ctx->block[ctx->len], message, rem_len);
 
         if (ctx->len + len < SHA512_BLOCK_SIZE) {
-            ctx->len += len;
+            ctx->len += static_cast<uint32_t>(len);
             return;
         }
 
@@ -1575,7 +1890,7 @@ namespace Crypto {
         memcpy(ctx->block, &shifted_message[block_nb << 7],
             rem_len);
 
-        ctx->len = rem_len;
+        ctx->len = static_cast<uint32_t>(rem_len);
         ctx->tot_len += (block_nb + 1) << 7;
     }
 
@@ -1583,7 +1898,7 @@ namespace Crypto {
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64_t len_b;
 
 #ifndef UNROLL_LOOPS
         int i;
@@ -1596,7 +1911,8 @@ namespace Crypto {
 
         memset(_context.block + _context.len, 0, pm_len - _context.len);
         _context.block[_context.len] = 0x80;
-        UNPACK32(len_b, _context.block + pm_len - 4);
+        UNPACK64(len_b, _context.block + pm_len - 8);
+        UNPACK64((_context.tot_len + _context.len) >> 61, _context.block + pm_len - 16);
 
         sha512_transf(&_context, _context.block, block_nb);
 
@@ -1616,20 +1932,10 @@ namespace Crypto {
 #endif /* !UNROLL_LOOPS */
     }
 
-    void SHA512::Input(const uint8_t message_array[], const uint16_t length)
+    void SHA512::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA512_BLOCK_SIZE) {
-                sha512_update(&_context, source, SHA512_BLOCK_SIZE);
-                source += SHA512_BLOCK_SIZE;
-                sizeToHandle -= SHA512_BLOCK_SIZE;
-            } else {
-                sha512_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
+        if (length > 0) {
+            sha512_update(&_context, message_array, length);
         }
     }
 
@@ -1653,7 +1959,7 @@ namespace Crypto {
  */
     SHA512& SHA512::operator<<(const uint8_t message_array[])
     {
-        uint16_t length = 0;
+        uint32_t length = 0;
 
         while (message_array[length] != '\0') {
             length++;
@@ -1715,10 +2021,10 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha384_update(SHA512::Context* ctx, const unsigned char* message, unsigned int len)
+    static void sha384_update(SHA512::Context* ctx, const unsigned char* message, uint64_t len)
     {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
+        uint64_t block_nb;
+        uint64_t new_len, rem_len, tmp_len;
         const unsigned char* shifted_message;
 
         tmp_len = SHA384_BLOCK_SIZE - ctx->len;
@@ -1727,7 +2033,7 @@ namespace Crypto {
         memcpy(&ctx->block[ctx->len], message, rem_len);
 
         if (ctx->len + len < SHA384_BLOCK_SIZE) {
-            ctx->len += len;
+            ctx->len += static_cast<uint32_t>(len);
             return;
         }
 
@@ -1744,7 +2050,7 @@ namespace Crypto {
         memcpy(ctx->block, &shifted_message[block_nb << 7],
             rem_len);
 
-        ctx->len = rem_len;
+        ctx->len = static_cast<uint32_t>(rem_len);
         ctx->tot_len += (block_nb + 1) << 7;
     }
 
@@ -1752,7 +2058,7 @@ namespace Crypto {
     {
         unsigned int block_nb;
         unsigned int pm_len;
-        unsigned int len_b;
+        uint64_t len_b;
 
 #ifndef UNROLL_LOOPS
         int i;
@@ -1765,7 +2071,8 @@ namespace Crypto {
 
         memset(_context.block + _context.len, 0, pm_len - _context.len);
         _context.block[_context.len] = 0x80;
-        UNPACK32(len_b, _context.block + pm_len - 4);
+        UNPACK64(len_b, _context.block + pm_len - 8);
+        UNPACK64((_context.tot_len + _context.len) >> 61, _context.block + pm_len - 16);
 
         sha512_transf(&_context, _context.block, block_nb);
 
@@ -1783,20 +2090,10 @@ namespace Crypto {
 #endif /* !UNROLL_LOOPS */
     }
 
-    void SHA384::Input(const uint8_t message_array[], const uint16_t length)
+    void SHA384::Input(const uint8_t message_array[], const uint64_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA384_BLOCK_SIZE) {
-                sha384_update(&_context, source, SHA384_BLOCK_SIZE);
-                source += SHA384_BLOCK_SIZE;
-                sizeToHandle -= SHA384_BLOCK_SIZE;
-            } else {
-                sha384_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
+        if (length > 0) {
+            sha384_update(&_context, message_array, length);
         }
     }
 
@@ -1820,7 +2117,7 @@ namespace Crypto {
  */
     SHA384& SHA384::operator<<(const uint8_t message_array[])
     {
-        uint16_t length = 0;
+        uint32_t length = 0;
 
         while (message_array[length] != '\0') {
             length++;
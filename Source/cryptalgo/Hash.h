@@ -90,7 +90,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline SHA1(const uint8_t message_array[], const uint16_t length)
+        inline SHA1(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -106,8 +106,7 @@ namespace Crypto {
 
         void Reset()
         {
-            _lengthLow = 0;
-            _lengthHigh = 0;
+            _length = 0;
             _messageIndex = 0;
 
             H[0] = 0x67452301;
@@ -137,16 +136,22 @@ namespace Crypto {
         /*
          *  Provide input to SHA1
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         SHA1& operator<<(const uint8_t message_array[]);
         SHA1& operator<<(const uint8_t message_element);
 
     private:
         /*
-         *  Process the next 512 bits of the message
+         *  Process the next blocks of 512 bits of the message
          */
-        void ProcessMessageBlock();
+        void ProcessMessageBlocks(const uint8_t blocks[], const uint64_t count);
+        void ProcessMessageBlock(const uint8_t block[]);
 
         /*
          *  Pads the current message block to 512 bits
@@ -178,8 +183,7 @@ namespace Crypto {
 
         uint32_t H[5]; // Message digest buffers
 
-        uint32_t _lengthLow; // Message length in bits
-        uint32_t _lengthHigh; // Message length in bits
+        uint64_t _length; // Message length in bytes
 
         uint8_t _messageBlock[64]; // 512-bit message blocks
         uint32_t _messageIndex; // Index into message block array
@@ -206,7 +210,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline MD5(const uint8_t message_array[], const uint16_t length)
+        inline MD5(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -252,7 +256,12 @@ namespace Crypto {
         /*
          *  Provide input to MD5
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         MD5& operator<<(const uint8_t message_array[]);
         MD5& operator<<(const uint8_t message_element);
@@ -269,7 +278,7 @@ namespace Crypto {
     class EXTERNAL SHA256 {
     public:
         typedef struct {
-            uint32_t tot_len;
+            uint64_t tot_len;
             uint32_t len;
             uint8_t block[2 * (512 / 8)];
             uint32_t h[8];
@@ -284,7 +293,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline SHA256(const uint8_t message_array[], const uint16_t length)
+        inline SHA256(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -311,7 +320,12 @@ namespace Crypto {
         /*
          *  Provide input to SHA1
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         SHA256& operator<<(const uint8_t message_array[]);
         SHA256& operator<<(const uint8_t message_element);
@@ -334,7 +348,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline SHA224(const uint8_t message_array[], const uint16_t length)
+        inline SHA224(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -361,7 +375,12 @@ namespace Crypto {
         /*
          *  Provide input to SHA224
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         SHA224& operator<<(const uint8_t message_array[]);
         SHA224& operator<<(const uint8_t message_element);
@@ -377,7 +396,7 @@ namespace Crypto {
     class EXTERNAL SHA512 {
     public:
         typedef struct {
-            uint32_t tot_len;
+            uint64_t tot_len;
             uint32_t len;
             uint8_t block[2 * (1024 / 8)];
             uint64_t h[8];
@@ -392,7 +411,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline SHA512(const uint8_t message_array[], const uint16_t length)
+        inline SHA512(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -419,7 +438,12 @@ namespace Crypto {
         /*
          *  Provide input to SHA512
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         SHA512& operator<<(const uint8_t message_array[]);
         SHA512& operator<<(const uint8_t message_element);
@@ -442,7 +466,7 @@ namespace Crypto {
         {
             Reset();
         }
-        inline SHA384(const uint8_t message_array[], const uint16_t length)
+        inline SHA384(const uint8_t message_array[], const uint64_t length)
         {
             Reset();
 
@@ -469,7 +493,12 @@ namespace Crypto {
         /*
          *  Provide input to SHA384
          */
-        void Input(const uint8_t message_array[], const uint16_t length);
+        void Input(const uint8_t message_array[], const uint64_t length);
+        // Hash all data, e.g. a memory mapped Core::DataElementFile, in one go.
+        inline void Input(const Core::DataElement& data)
+        {
+            Input(data.Buffer(), data.Size());
+        }
 
         SHA384& operator<<(const uint8_t message_array[]);
         SHA384& operator<<(const uint8_t message_element);
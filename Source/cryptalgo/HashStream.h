@@ -22,7 +22,7 @@ namespace Crypto {
         virtual void Reset() = 0;
         virtual uint8_t* Result() = 0;
         virtual uint8_t Length() const = 0;
-        virtual void Input(const uint8_t block, const uint16_t length) = 0;
+        virtual void Input(const uint8_t block[], const uint64_t length) = 0;
     };
 
     template <typename HASHALGORITHM, const enum EnumHashType TYPE>
@@ -50,7 +50,7 @@ namespace Crypto {
     {
         return (HASHALGORITHM::Length());
     }
-    virtual void Input(const uint8_t block[], const uint16_t length)
+    virtual void Input(const uint8_t block[], const uint64_t length)
     {
         _hash.Input(block, length);
     }
@@ -10,6 +10,86 @@
 
 namespace OCDM {
 
+// A range of a sample, a number of clear bytes followed by a number of encrypted bytes, as in
+// the CENC (ISO/IEC 23001-7) subsample encryption.
+struct SubSample {
+    uint16_t ClearBytes;
+    uint32_t EncryptedBytes;
+};
+
+// If the subsample data of an exchange is set, it holds the ranges of the original sample, a
+// packed 16 bits clear and 32 bits encrypted count per range. The shared buffer then only holds
+// the encrypted bytes of the ranges, back to back, so the clear bytes are never transferred.
+class SubSampleMap {
+private:
+    SubSampleMap() = delete;
+    SubSampleMap(const SubSampleMap&) = delete;
+    SubSampleMap& operator=(const SubSampleMap&) = delete;
+
+public:
+    static constexpr uint16_t EntrySize = sizeof(uint16_t) + sizeof(uint32_t);
+
+    static uint16_t Encode(const uint16_t count, const SubSample entries[], const uint16_t maxLength, uint8_t buffer[])
+    {
+        uint16_t length = 0;
+
+        for (uint16_t index = 0; (index < count) && ((length + EntrySize) <= maxLength); index++, length += EntrySize) {
+            ::memcpy(&(buffer[length]), &(entries[index].ClearBytes), sizeof(uint16_t));
+            ::memcpy(&(buffer[length + sizeof(uint16_t)]), &(entries[index].EncryptedBytes), sizeof(uint32_t));
+        }
+
+        return (length);
+    }
+    static uint16_t Decode(const uint16_t length, const uint8_t buffer[], const uint16_t maxCount, SubSample entries[])
+    {
+        uint16_t count = 0;
+
+        for (uint16_t offset = 0; ((offset + EntrySize) <= length) && (count < maxCount); offset += EntrySize, count++) {
+            ::memcpy(&(entries[count].ClearBytes), &(buffer[offset]), sizeof(uint16_t));
+            ::memcpy(&(entries[count].EncryptedBytes), &(buffer[offset + sizeof(uint16_t)]), sizeof(uint32_t));
+        }
+
+        return (count);
+    }
+    // Total of the bytes, clear and encrypted, the ranges cover.
+    static uint64_t Length(const uint16_t count, const SubSample entries[])
+    {
+        uint64_t result = 0;
+        for (uint16_t index = 0; index < count; index++) {
+            result += entries[index].ClearBytes + static_cast<uint64_t>(entries[index].EncryptedBytes);
+        }
+        return (result);
+    }
+    static uint32_t Encrypted(const uint16_t count, const SubSample entries[])
+    {
+        uint32_t result = 0;
+        for (uint16_t index = 0; index < count; index++) {
+            result += entries[index].EncryptedBytes;
+        }
+        return (result);
+    }
+    // Copies the encrypted ranges of the sample to the packed buffer.
+    static void Gather(const uint16_t count, const SubSample entries[], const uint8_t sample[], uint8_t packed[])
+    {
+        for (uint16_t index = 0; index < count; index++) {
+            sample += entries[index].ClearBytes;
+            ::memcpy(packed, sample, entries[index].EncryptedBytes);
+            sample += entries[index].EncryptedBytes;
+            packed += entries[index].EncryptedBytes;
+        }
+    }
+    // Copies the packed (decrypted) buffer back to the encrypted ranges of the sample.
+    static void Scatter(const uint16_t count, const SubSample entries[], const uint8_t packed[], uint8_t sample[])
+    {
+        for (uint16_t index = 0; index < count; index++) {
+            sample += entries[index].ClearBytes;
+            ::memcpy(sample, packed, entries[index].EncryptedBytes);
+            sample += entries[index].EncryptedBytes;
+            packed += entries[index].EncryptedBytes;
+        }
+    }
+};
+
 class DataExchange : public WPEFramework::Core::SharedBuffer {
 private:
     DataExchange() = delete;
@@ -27,6 +107,9 @@ private:
         bool InitWithLast15;
     };
 
+public:
+    static constexpr uint16_t MaxSubSamples = sizeof(Administration::Sub) / SubSampleMap::EntrySize;
+
 public:
     DataExchange(const string& name)
         : WPEFramework::Core::SharedBuffer(name.c_str())
@@ -90,6 +173,26 @@ public:
             ::memcpy(admin->Sub, data, admin->SubLength);
         }
     }
+    // More entries than fit are refused, the map is left empty.
+    uint32_t SetSubSamples(const uint16_t count, const SubSample entries[])
+    {
+        Administration* admin = reinterpret_cast<Administration*>(AdministrationBuffer());
+        uint32_t result = WPEFramework::Core::ERROR_NONE;
+
+        if (count > MaxSubSamples) {
+            admin->SubLength = 0;
+            result = WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            admin->SubLength = SubSampleMap::Encode(count, entries, sizeof(Administration::Sub), admin->Sub);
+        }
+
+        return (result);
+    }
+    uint16_t SubSamples(const uint16_t maxCount, SubSample entries[]) const
+    {
+        const Administration* admin = reinterpret_cast<const Administration*>(AdministrationBuffer());
+        return (SubSampleMap::Decode(admin->SubLength, admin->Sub, maxCount, entries));
+    }
     void Write(const uint32_t length, const uint8_t* data)
     {
 
@@ -0,0 +1,482 @@
+#ifndef __SAMPLERING_H
+#define __SAMPLERING_H
+
+// ---- Include local include files ----
+#include "DataExchange.h"
+
+#include <atomic>
+
+#ifndef __WIN32__
+#include <semaphore.h>
+#endif
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+namespace OCDM {
+
+#ifndef __WIN32__
+
+// Rationale:
+// The DataExchange shares one sample buffer between the player and the CDM, so every sample is a
+// full round-trip (copy in, signal, wait, copy out) and only one sample per session can be in flight.
+// The SampleRing shares a set of slots instead. The player (client) acquires a free slot, writes
+// the encrypted sample straight into the shared memory of the slot and submits it. The CDM (server)
+// picks up the submitted slots in order, decrypts them in place and completes them. Meanwhile the
+// player can fill the next slots, so the CDM never waits for the player and the player only waits
+// for the samples it actually needs.
+// The states of the slots are atomics in the shared memory, the waiting is done on process shared
+// semaphores: Free counts the slots available to the player, Filled the slots waiting for the CDM
+// and every slot has its own Done semaphore the player can wait on.
+// A slot that the player gives up on (e.g. a timeout while the CDM is still working on it) is marked
+// ABANDONED, the CDM returns it to the free slots when it completes it.
+// Every player that opens the ring gets its own owner id. A slot can only be submitted, waited for and
+// released by the player that acquired it and only in a state that allows it, anything else is refused
+// with an error code, the shared memory can not be trusted to be used correctly by all players.
+class SampleRing : public WPEFramework::Core::DataElementFile {
+private:
+    SampleRing() = delete;
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+public:
+    enum state : uint32_t {
+        FREE,
+        ALLOCATED,
+        FILLED,
+        DECRYPTING,
+        DONE,
+        ABANDONED
+    };
+
+    static constexpr uint32_t InvalidSlot = static_cast<uint32_t>(~0);
+
+private:
+    static constexpr uint32_t Signature = 0x4F52494E; // "ORIN"
+    static constexpr uint32_t Alignment = 64;
+
+    struct Header {
+        uint32_t Signature;
+        uint32_t Slots;
+        uint32_t SlotSize;
+        uint32_t Stride;
+        std::atomic<uint32_t> Sequence;
+        std::atomic<uint32_t> Owners;
+        sem_t Free;
+        sem_t Filled;
+    };
+    struct Slot {
+        std::atomic<uint32_t> State;
+        std::atomic<uint32_t> Owner;
+        uint32_t Sequence;
+        uint32_t Status;
+        uint32_t Length;
+        uint8_t KeyId[17];
+        uint8_t IVLength;
+        uint8_t IV[24];
+        uint16_t SubLength;
+        uint8_t Sub[2048];
+        bool InitWithLast15;
+        sem_t Done;
+    };
+
+    static constexpr uint32_t Aligned(const uint32_t size)
+    {
+        return ((size + Alignment - 1) & ~(Alignment - 1));
+    }
+
+public:
+    // Client side, the player, opens the ring created by the CDM.
+    SampleRing(const string& name)
+        : WPEFramework::Core::DataElementFile(name, WPEFramework::Core::File::USER_READ | WPEFramework::Core::File::USER_WRITE | WPEFramework::Core::File::SHAREABLE)
+        , _header(reinterpret_cast<Header*>(DataElementFile::Buffer()))
+        , _owner(0)
+    {
+        if ((IsValid() == false) || (Size() < sizeof(Header)) || (_header->Signature != Signature) || (Size() < (Aligned(sizeof(Header)) + (static_cast<uint64_t>(_header->Slots) * _header->Stride)))) {
+            TRACE_L1("Sample ring %s is not valid.", name.c_str());
+            _header = nullptr;
+        } else {
+            // Owner 0 marks a slot without owner.
+            while (_owner == 0) {
+                _owner = _header->Owners.fetch_add(1) + 1;
+            }
+        }
+    }
+    // Server side, the CDM, creates the ring.
+    SampleRing(const string& name, const uint32_t slots, const uint32_t slotSize)
+        : WPEFramework::Core::DataElementFile(name,
+              WPEFramework::Core::File::USER_READ    |
+              WPEFramework::Core::File::USER_WRITE   |
+              WPEFramework::Core::File::GROUP_READ   |
+              WPEFramework::Core::File::GROUP_WRITE  |
+              WPEFramework::Core::File::SHAREABLE    |
+              WPEFramework::Core::File::CREATE,
+              Aligned(sizeof(Header)) + (slots * (Aligned(sizeof(Slot)) + Aligned(slotSize))))
+        , _header(reinterpret_cast<Header*>(DataElementFile::Buffer()))
+        , _owner(0)
+    {
+        ASSERT(slots > 0);
+
+        if (IsValid() == false) {
+            _header = nullptr;
+        } else {
+            ::memset(DataElementFile::Buffer(), 0, Aligned(sizeof(Header)) + (slots * Aligned(sizeof(Slot))));
+
+            _header->Slots = slots;
+            _header->SlotSize = slotSize;
+            _header->Stride = Aligned(sizeof(Slot)) + Aligned(slotSize);
+            _header->Sequence.store(0);
+            _header->Owners.store(0);
+
+            sem_init(&(_header->Free), 1, slots);
+            sem_init(&(_header->Filled), 1, 0);
+
+            for (uint32_t index = 0; index < slots; index++) {
+                Slot& entry(Entry(index));
+                entry.State.store(FREE);
+                entry.Owner.store(0);
+                sem_init(&(entry.Done), 1, 0);
+            }
+
+            // Only now the ring can be recognized by a client.
+            std::atomic_thread_fence(std::memory_order_release);
+            _header->Signature = Signature;
+        }
+    }
+    ~SampleRing()
+    {
+    }
+
+public:
+    inline bool IsOperational() const
+    {
+        return (_header != nullptr);
+    }
+    inline uint32_t Slots() const
+    {
+        return (_header->Slots);
+    }
+    inline uint32_t SlotSize() const
+    {
+        return (_header->SlotSize);
+    }
+    inline uint32_t State(const uint32_t slot) const
+    {
+        return (Entry(slot).State.load());
+    }
+    inline uint8_t* Buffer(const uint32_t slot)
+    {
+        return (&(reinterpret_cast<uint8_t*>(&(Entry(slot)))[Aligned(sizeof(Slot))]));
+    }
+    inline const uint8_t* Buffer(const uint32_t slot) const
+    {
+        return (&(reinterpret_cast<const uint8_t*>(&(Entry(slot)))[Aligned(sizeof(Slot))]));
+    }
+    inline uint32_t Length(const uint32_t slot) const
+    {
+        return (Entry(slot).Length);
+    }
+    inline uint32_t Status(const uint32_t slot) const
+    {
+        return (Entry(slot).Status);
+    }
+    // A slot this player acquired and did not submit yet, the sample and its parameters can be set.
+    inline bool IsAllocated(const uint32_t slot) const
+    {
+        return ((slot < _header->Slots) && (Entry(slot).Owner.load() == _owner) && (Entry(slot).State.load() == ALLOCATED));
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // Player side
+    // ------------------------------------------------------------------------------------------
+    uint32_t Acquire(const uint32_t waitTime, uint32_t& slot)
+    {
+        uint32_t result = Wait(_header->Free, waitTime);
+
+        slot = InvalidSlot;
+
+        if (result == WPEFramework::Core::ERROR_NONE) {
+            // The semaphore guarantees there is a free slot for us, other players might take
+            // the one we look at, so keep on looking.
+            uint32_t index = 0;
+            while (slot == InvalidSlot) {
+                uint32_t expected = FREE;
+                if (Entry(index).State.compare_exchange_strong(expected, ALLOCATED) == true) {
+                    Entry(index).Owner.store(_owner);
+                    slot = index;
+                }
+                index = (index + 1) % _header->Slots;
+            }
+        }
+
+        return (result);
+    }
+    void SetIV(const uint32_t slot, const uint8_t ivDataLength, const uint8_t ivData[])
+    {
+        Slot& entry(Entry(slot));
+        ASSERT(ivDataLength <= sizeof(Slot::IV));
+        entry.IVLength = (ivDataLength > sizeof(Slot::IV) ? sizeof(Slot::IV) : ivDataLength);
+        ::memcpy(entry.IV, ivData, entry.IVLength);
+        if (entry.IVLength < sizeof(Slot::IV)) {
+            ::memset(&(entry.IV[entry.IVLength]), 0, (sizeof(Slot::IV) - entry.IVLength));
+        }
+    }
+    void SetSubSampleData(const uint32_t slot, const uint16_t length, const uint8_t* data)
+    {
+        Slot& entry(Entry(slot));
+        entry.SubLength = (length > sizeof(Slot::Sub) ? sizeof(Slot::Sub) : length);
+        if (data != nullptr) {
+            ::memcpy(entry.Sub, data, entry.SubLength);
+        }
+    }
+    // More entries than fit are refused, the map is left empty.
+    uint32_t SetSubSamples(const uint32_t slot, const uint16_t count, const SubSample entries[])
+    {
+        Slot& entry(Entry(slot));
+        uint32_t result = WPEFramework::Core::ERROR_NONE;
+
+        if (count > (sizeof(Slot::Sub) / SubSampleMap::EntrySize)) {
+            entry.SubLength = 0;
+            result = WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH;
+        } else {
+            entry.SubLength = SubSampleMap::Encode(count, entries, sizeof(Slot::Sub), entry.Sub);
+        }
+
+        return (result);
+    }
+    void KeyId(const uint32_t slot, const uint8_t length, const uint8_t buffer[])
+    {
+        Slot& entry(Entry(slot));
+        ASSERT(length <= 16);
+        entry.KeyId[0] = (length <= 16 ? length : 16);
+        if (length != 0) {
+            ::memcpy(&(entry.KeyId[1]), buffer, entry.KeyId[0]);
+        }
+    }
+    void InitWithLast15(const uint32_t slot, const bool initWithLast15)
+    {
+        Entry(slot).InitWithLast15 = initWithLast15;
+    }
+    // Hands the sample, written in Buffer(slot), over to the CDM.
+    uint32_t Submit(const uint32_t slot, const uint32_t length)
+    {
+        uint32_t result = Check(slot);
+
+        if (result == WPEFramework::Core::ERROR_NONE) {
+            Slot& entry(Entry(slot));
+
+            // Only the owner moves a slot out of ALLOCATED, so it can not change underneath us.
+            if (entry.State.load() != ALLOCATED) {
+                result = WPEFramework::Core::ERROR_ILLEGAL_STATE;
+            } else if (length > _header->SlotSize) {
+                result = WPEFramework::Core::ERROR_INVALID_INPUT_LENGTH;
+            } else {
+                entry.Length = length;
+                entry.Status = 0;
+                entry.Sequence = _header->Sequence.fetch_add(1);
+                entry.State.store(FILLED);
+
+                sem_post(&(_header->Filled));
+            }
+        }
+
+        return (result);
+    }
+    // Waits till the CDM completed the slot, the decrypted sample is in Buffer(slot).
+    uint32_t Wait(const uint32_t slot, const uint32_t waitTime)
+    {
+        uint32_t result = Check(slot);
+
+        if (result == WPEFramework::Core::ERROR_NONE) {
+            const uint32_t current = Entry(slot).State.load();
+
+            if ((current != FILLED) && (current != DECRYPTING) && (current != DONE)) {
+                result = WPEFramework::Core::ERROR_ILLEGAL_STATE;
+            } else if ((result = Wait(Entry(slot).Done, waitTime)) == WPEFramework::Core::ERROR_NONE) {
+                ASSERT(Entry(slot).State.load() == DONE);
+            }
+        }
+
+        return (result);
+    }
+    // Returns the slot to the ring, whatever state it is in.
+    uint32_t Release(const uint32_t slot)
+    {
+        uint32_t result = Check(slot);
+
+        if (result == WPEFramework::Core::ERROR_NONE) {
+            Slot& entry(Entry(slot));
+            uint32_t current = entry.State.load();
+            bool released = false;
+
+            while (released == false) {
+                if (current == DECRYPTING) {
+                    // The CDM is still working on it, it will free it once completed.
+                    released = entry.State.compare_exchange_weak(current, ABANDONED);
+                } else if ((current == ALLOCATED) || (current == FILLED) || (current == DONE)) {
+                    // Nobody else can change these states, so the owner can be reset up front.
+                    entry.Owner.store(0);
+
+                    if ((released = entry.State.compare_exchange_weak(current, FREE)) == true) {
+                        // A completion we did not wait for should not wake the next user of the slot.
+                        while (sem_trywait(&(entry.Done)) == 0) {
+                        }
+                        sem_post(&(_header->Free));
+                    } else {
+                        entry.Owner.store(_owner);
+                    }
+                } else {
+                    result = WPEFramework::Core::ERROR_ALREADY_RELEASED;
+                    released = true;
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    // ------------------------------------------------------------------------------------------
+    // CDM side
+    // ------------------------------------------------------------------------------------------
+    // Takes the oldest submitted slot, the sample in Buffer(slot) can be decrypted in place.
+    uint32_t Next(const uint32_t waitTime, uint32_t& slot)
+    {
+        uint32_t result = WPEFramework::Core::ERROR_NONE;
+
+        slot = InvalidSlot;
+
+        while ((slot == InvalidSlot) && ((result = Wait(_header->Filled, waitTime)) == WPEFramework::Core::ERROR_NONE)) {
+            uint32_t oldest = InvalidSlot;
+
+            for (uint32_t index = 0; index < _header->Slots; index++) {
+                const Slot& entry(Entry(index));
+                if ((entry.State.load() == FILLED) && ((oldest == InvalidSlot) || (static_cast<int32_t>(entry.Sequence - Entry(oldest).Sequence) < 0))) {
+                    oldest = index;
+                }
+            }
+
+            uint32_t expected = FILLED;
+            if ((oldest != InvalidSlot) && (Entry(oldest).State.compare_exchange_strong(expected, DECRYPTING) == true)) {
+                slot = oldest;
+            }
+            // else the player released the slot it submitted, wait for the next one.
+        }
+
+        return (result);
+    }
+    const uint8_t* IVKey(const uint32_t slot) const
+    {
+        return (Entry(slot).IV);
+    }
+    uint8_t IVKeyLength(const uint32_t slot) const
+    {
+        return (Entry(slot).IVLength);
+    }
+    const uint8_t* KeyId(const uint32_t slot, uint8_t& length) const
+    {
+        const Slot& entry(Entry(slot));
+        length = entry.KeyId[0];
+        ASSERT(length <= 16);
+        return (length > 0 ? &(entry.KeyId[1]) : nullptr);
+    }
+    const uint8_t* SubSampleData(const uint32_t slot, uint16_t& length) const
+    {
+        const Slot& entry(Entry(slot));
+        length = entry.SubLength;
+        return (length > 0 ? entry.Sub : nullptr);
+    }
+    uint16_t SubSamples(const uint32_t slot, const uint16_t maxCount, SubSample entries[]) const
+    {
+        const Slot& entry(Entry(slot));
+        return (SubSampleMap::Decode(entry.SubLength, entry.Sub, maxCount, entries));
+    }
+    bool InitWithLast15(const uint32_t slot) const
+    {
+        return (Entry(slot).InitWithLast15);
+    }
+    uint32_t Completed(const uint32_t slot, const uint32_t status)
+    {
+        uint32_t result = WPEFramework::Core::ERROR_NONE;
+
+        if (slot >= _header->Slots) {
+            result = WPEFramework::Core::ERROR_BAD_REQUEST;
+        } else {
+            Slot& entry(Entry(slot));
+            uint32_t expected = DECRYPTING;
+
+            entry.Status = status;
+
+            if (entry.State.compare_exchange_strong(expected, DONE) == true) {
+                sem_post(&(entry.Done));
+            } else if (expected == ABANDONED) {
+                // Nobody is waiting for this one anymore.
+                entry.Owner.store(0);
+                entry.State.store(FREE);
+                sem_post(&(_header->Free));
+            } else {
+                // Not taken with Next().
+                result = WPEFramework::Core::ERROR_ILLEGAL_STATE;
+            }
+        }
+
+        return (result);
+    }
+
+private:
+    // A slot of the ring, acquired by this player.
+    uint32_t Check(const uint32_t slot) const
+    {
+        uint32_t result = WPEFramework::Core::ERROR_NONE;
+
+        if (slot >= _header->Slots) {
+            result = WPEFramework::Core::ERROR_BAD_REQUEST;
+        } else if ((_owner == 0) || (Entry(slot).Owner.load() != _owner)) {
+            result = WPEFramework::Core::ERROR_PRIVILIGED_REQUEST;
+        }
+
+        return (result);
+    }
+    inline Slot& Entry(const uint32_t slot)
+    {
+        ASSERT(slot < _header->Slots);
+        return (*reinterpret_cast<Slot*>(&(DataElementFile::Buffer()[Aligned(sizeof(Header)) + (slot * _header->Stride)])));
+    }
+    inline const Slot& Entry(const uint32_t slot) const
+    {
+        ASSERT(slot < _header->Slots);
+        return (*reinterpret_cast<const Slot*>(&(DataElementFile::Buffer()[Aligned(sizeof(Header)) + (slot * _header->Stride)])));
+    }
+    static uint32_t Wait(sem_t& semaphore, const uint32_t waitTime)
+    {
+        int result;
+
+        if (waitTime == WPEFramework::Core::infinite) {
+            while (((result = sem_wait(&semaphore)) != 0) && (errno == EINTR)) {
+            }
+        } else {
+            struct timespec structTime;
+
+            // Just like the SharedBuffer, sem_timedwait only supports CLOCK_REALTIME.
+            clock_gettime(CLOCK_REALTIME, &structTime);
+            structTime.tv_nsec += ((waitTime % 1000) * 1000 * 1000);
+            structTime.tv_sec += (waitTime / 1000) + (structTime.tv_nsec / 1000000000);
+            structTime.tv_nsec = structTime.tv_nsec % 1000000000;
+
+            while (((result = sem_timedwait(&semaphore, &structTime)) != 0) && (errno == EINTR)) {
+            }
+        }
+
+        return (result == 0 ? WPEFramework::Core::ERROR_NONE : WPEFramework::Core::ERROR_TIMEDOUT);
+    }
+
+private:
+    Header* _header;
+    uint32_t _owner;
+};
+
+#endif // __WIN32__
+
+} // namespace OCDM
+
+#endif // __SAMPLERING_H
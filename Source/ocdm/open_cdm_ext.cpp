@@ -204,6 +204,59 @@ OpenCDMError opencdm_session_clean_decrypt_context(struct OpenCDMSession* mOpenC
     return (OpenCDMError)mOpenCDMSession->CleanDecryptContext();
 }
 
+static_assert((sizeof(OpenCDMSubSample) == sizeof(OCDM::SubSample)) && (offsetof(OpenCDMSubSample, encryptedBytes) == offsetof(OCDM::SubSample, EncryptedBytes)),
+    "The subsample ranges of the C API and the exchange should be interchangeable.");
+
+OpenCDMError opencdm_session_decrypt_subsample(struct OpenCDMSession* session,
+    uint8_t sample[], const uint32_t sampleLength,
+    const OpenCDMSubSample subSamples[], const uint16_t subSampleCount,
+    const uint8_t* IV, const uint16_t IVLength,
+    const uint8_t* keyId, const uint16_t keyIdLength,
+    uint32_t initWithLast15)
+{
+    OpenCDMError result(ERROR_INVALID_SESSION);
+
+    if (session != nullptr) {
+        result = static_cast<OpenCDMError>(session->Decrypt(sample, sampleLength,
+            subSampleCount, reinterpret_cast<const OCDM::SubSample*>(subSamples),
+            IV, IVLength, keyId, keyIdLength, initWithLast15));
+    }
+
+    return (result);
+}
+
+OpenCDMError opencdm_session_acquire_sample(struct OpenCDMSession* session,
+    const uint32_t waitTime, uint32_t* slot, uint8_t** buffer, uint32_t* size)
+{
+    ASSERT(session != nullptr);
+    ASSERT((slot != nullptr) && (buffer != nullptr) && (size != nullptr));
+    return (OpenCDMError)session->AcquireSample(waitTime, *slot, *buffer, *size);
+}
+
+OpenCDMError opencdm_session_submit_sample(struct OpenCDMSession* session,
+    const uint32_t slot, const uint32_t length,
+    const uint8_t* IV, uint16_t IVLength,
+    const uint8_t* keyId, const uint16_t keyIdLength,
+    uint32_t initWithLast15)
+{
+    ASSERT(session != nullptr);
+    return (OpenCDMError)session->SubmitSample(slot, length, IV, IVLength, keyId, keyIdLength, initWithLast15);
+}
+
+OpenCDMError opencdm_session_wait_sample(struct OpenCDMSession* session,
+    const uint32_t slot, const uint32_t waitTime)
+{
+    ASSERT(session != nullptr);
+    return (OpenCDMError)session->WaitSample(slot, waitTime);
+}
+
+OpenCDMError opencdm_session_release_sample(struct OpenCDMSession* session,
+    const uint32_t slot)
+{
+    ASSERT(session != nullptr);
+    return (OpenCDMError)session->ReleaseSample(slot);
+}
+
 OpenCDMError opencdm_delete_key_store(struct OpenCDMSystem* system)
 {
     ASSERT(system != nullptr);
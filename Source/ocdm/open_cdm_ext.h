@@ -221,6 +221,94 @@ OpenCDMError opencdm_system_teardown(struct OpenCDMSystem* system);
  */
 OpenCDMError
 opencdm_session_clean_decrypt_context(struct OpenCDMSession* mOpenCDMSession);
+/**
+ * A range of a sample, clear bytes followed by encrypted bytes (CENC subsample).
+ */
+typedef struct {
+    uint16_t clearBytes;
+    uint32_t encryptedBytes;
+} OpenCDMSubSample;
+
+/**
+ * \brief Performs decryption of a sample with subsample encryption, in place.
+ * Only the encrypted ranges of the sample are handed to the CDM and overwritten
+ * with the clear data, the clear ranges are not copied nor touched.
+ * \param session OCDM Session.
+ * \param sample Buffer holding the sample, owned by the caller.
+ * \param sampleLength Length of the sample (in bytes).
+ * \param subSamples Clear/encrypted ranges of the sample, in order.
+ * \param subSampleCount Number of ranges, an all clear sample is not decrypted.
+ * \param IV Initial vector (IV) used during AES decryption.
+ * \param IVLength Length of IV buffer (in bytes).
+ * \param keyId Key ID to use for decryption.
+ * \param keyIdLength Length of the key ID (in bytes).
+ * \param initWithLast15 Whether decryption context needs to be initialized with
+ * last 15 bytes.
+ * \return Zero on success, ERROR_INVALID_DECRYPT_BUFFER if the ranges exceed the
+ *         sample or there are too many of them, non-zero on other errors.
+ */
+OpenCDMError opencdm_session_decrypt_subsample(struct OpenCDMSession* session,
+    uint8_t sample[], const uint32_t sampleLength,
+    const OpenCDMSubSample subSamples[], const uint16_t subSampleCount,
+    const uint8_t* IV, const uint16_t IVLength,
+    const uint8_t* keyId, const uint16_t keyIdLength,
+    uint32_t initWithLast15);
+
+/**
+ * \brief Acquires a free slot in the sample ring shared with the CDM.
+ * The encrypted sample is written directly into the returned buffer, no copy is
+ * made. Several slots can be acquired and submitted before waiting for the first.
+ * \param session OCDM Session.
+ * \param waitTime Time in ms to wait for a free slot.
+ * \param slot Output parameter, the acquired slot.
+ * \param buffer Output parameter, the memory of the slot.
+ * \param size Output parameter, the maximum sample size of the slot.
+ * \return Zero on success, ERROR_INVALID_DECRYPT_BUFFER if the CDM does not offer a
+ *         sample ring, in which case opencdm_session_decrypt should be used.
+ */
+OpenCDMError opencdm_session_acquire_sample(struct OpenCDMSession* session,
+    const uint32_t waitTime, uint32_t* slot, uint8_t** buffer, uint32_t* size);
+
+/**
+ * \brief Hands an acquired slot, holding an encrypted sample, over to the CDM.
+ * \param session OCDM Session.
+ * \param slot Slot returned by opencdm_session_acquire_sample.
+ * \param length Length (in bytes) of the sample in the slot.
+ * \param IV Initial vector (IV) used during AES decryption.
+ * \param IVLength Length of IV buffer (in bytes).
+ * \param keyId Key ID to use for decryption.
+ * \param keyIdLength Length of the key ID (in bytes).
+ * \param initWithLast15 Whether decryption context needs to be initialized with
+ * last 15 bytes.
+ * \return Zero on success, non-zero on error.
+ */
+OpenCDMError opencdm_session_submit_sample(struct OpenCDMSession* session,
+    const uint32_t slot, const uint32_t length,
+    const uint8_t* IV, uint16_t IVLength,
+    const uint8_t* keyId, const uint16_t keyIdLength,
+    uint32_t initWithLast15);
+
+/**
+ * \brief Waits till the CDM decrypted a submitted slot. The clear sample is
+ * available, in place, in the buffer of the slot.
+ * \param session OCDM Session.
+ * \param slot Submitted slot.
+ * \param waitTime Time in ms to wait for the decryption.
+ * \return Zero on success, non-zero on error or timeout.
+ */
+OpenCDMError opencdm_session_wait_sample(struct OpenCDMSession* session,
+    const uint32_t slot, const uint32_t waitTime);
+
+/**
+ * \brief Returns a slot to the sample ring. Every acquired slot must be released,
+ * also if it was never submitted or the wait failed.
+ * \param session OCDM Session.
+ * \param slot Slot returned by opencdm_session_acquire_sample.
+ * \return Zero on success, non-zero on error.
+ */
+OpenCDMError opencdm_session_release_sample(struct OpenCDMSession* session,
+    const uint32_t slot);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
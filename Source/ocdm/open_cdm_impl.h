@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DataExchange.h"
+#include "SampleRing.h"
 #include "IOCDM.h"
 #include "Module.h"
 #include "open_cdm.h"
@@ -62,6 +63,10 @@ private:
     }
 
 public:
+    // Locking: the process wide _systemLock only guards the creation and destruction of the accessor
+    // (the singleton and its reference count), the _adminLock of the accessor guards its sessions and key
+    // updates and every session has a lock of its own for its buffer. They may be taken in that order,
+    // never the other way around, so _systemLock is never taken with _adminLock or a session lock held.
     static OpenCDMAccessor* Instance()
     {
 
@@ -362,76 +367,173 @@ private:
     public:
         DataExchange(const string& bufferName)
             : OCDM::DataExchange(bufferName)
+            , _adminLock()
             , _busy(false)
+            , _ring(nullptr)
         {
+#ifndef __WIN32__
+            // A CDM that supports it, offers a ring of sample slots next to the single buffer.
+            if (Core::File(bufferName + _T(".ring")).Exists() == true) {
+                _ring = new OCDM::SampleRing(bufferName + _T(".ring"));
+
+                if (_ring->IsOperational() == false) {
+                    delete _ring;
+                    _ring = nullptr;
+                }
+            }
+#endif
 
-            TRACE_L1("Constructing buffer client side: %p - %s", this,
-                bufferName.c_str());
+            TRACE_L1("Constructing buffer client side: %p - %s (%s)", this,
+                bufferName.c_str(), (_ring != nullptr ? _T("ring") : _T("single")));
         }
         virtual ~DataExchange()
         {
             if (_busy == true) {
                 TRACE_L1("Destructed a DataExchange while still in progress. %p", this);
             }
+#ifndef __WIN32__
+            if (_ring != nullptr) {
+                delete _ring;
+            }
+#endif
             TRACE_L1("Destructing buffer client side: %p - %s", this,
                 OCDM::DataExchange::Name().c_str());
         }
 
     public:
+#ifndef __WIN32__
+        inline OCDM::SampleRing* Ring()
+        {
+            return (_ring);
+        }
+#endif
         uint32_t Decrypt(uint8_t* encryptedData, uint32_t encryptedDataLength,
             const uint8_t* ivData, uint16_t ivDataLength,
             const uint8_t* keyId, uint16_t keyIdLength,
             uint32_t initWithLast15 /* = 0 */)
+        {
+            return (Decrypt(encryptedData, encryptedDataLength, 0, nullptr, ivData, ivDataLength, keyId, keyIdLength, initWithLast15));
+        }
+        // Without subsamples the whole sample is exchanged, with subsamples only the encrypted
+        // ranges of the sample are, the clear ranges are not touched.
+        uint32_t Decrypt(uint8_t* sample, uint32_t sampleLength,
+            const uint16_t subSampleCount, const OCDM::SubSample subSamples[],
+            const uint8_t* ivData, uint16_t ivDataLength,
+            const uint8_t* keyId, uint16_t keyIdLength,
+            uint32_t initWithLast15)
         {
             int ret = 0;
+            const uint32_t length = (subSampleCount == 0 ? sampleLength : OCDM::SubSampleMap::Encrypted(subSampleCount, subSamples));
+
+#ifndef __WIN32__
+            if ((_ring != nullptr) && (length <= _ring->SlotSize())) {
+                uint32_t slot;
+
+                ret = OpenCDMError::ERROR_UNKNOWN;
+
+                // Every caller gets its own slot, so no lock is needed and the next
+                // sample can be submitted while this one is being decrypted.
+                if (_ring->Acquire(SampleWaitTime, slot) != WPEFramework::Core::ERROR_NONE) {
+                    TRACE_L1("No free slot in the sample ring within %d ms.", SampleWaitTime);
+                } else if (_ring->SetSubSamples(slot, subSampleCount, subSamples) != WPEFramework::Core::ERROR_NONE) {
+                    TRACE_L1("Too many subsamples: %d.", subSampleCount);
+                    ret = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+                    _ring->Release(slot);
+                } else {
+
+                    _ring->SetIV(slot, static_cast<uint8_t>(ivDataLength), ivData);
+                    _ring->KeyId(slot, static_cast<uint8_t>(keyIdLength), keyId);
+                    _ring->InitWithLast15(slot, initWithLast15 != 0);
+
+                    if (subSampleCount == 0) {
+                        ::memcpy(_ring->Buffer(slot), sample, length);
+                    } else {
+                        OCDM::SubSampleMap::Gather(subSampleCount, subSamples, sample, _ring->Buffer(slot));
+                    }
+
+                    if ((_ring->Submit(slot, length) == WPEFramework::Core::ERROR_NONE) && (_ring->Wait(slot, SampleWaitTime) == WPEFramework::Core::ERROR_NONE)) {
+                        if (subSampleCount == 0) {
+                            ::memcpy(sample, _ring->Buffer(slot), length);
+                        } else {
+                            OCDM::SubSampleMap::Scatter(subSampleCount, subSamples, _ring->Buffer(slot), sample);
+                        }
+                        ret = _ring->Status(slot);
+                    } else {
+                        TRACE_L1("Sample in slot %d not decrypted within %d ms.", slot, SampleWaitTime);
+                    }
+
+                    _ring->Release(slot);
+                }
 
-            // This works, because we know that the Audio and the Video streams are
-            // fed from
-            // the same process, so they will use the same critial section and thus
-            // will
-            // not interfere with each-other. If Audio and video will be located into
-            // two
-            // different processes, start using the administartion space to share a
-            // lock.
-            _systemLock.Lock();
+                return (ret);
+            }
+#endif
+
+            // The buffer is owned by this session only, so sessions (e.g. the Audio and the
+            // Video stream) do not wait for each other, only the users of this session do.
+            _adminLock.Lock();
 
             _busy = true;
 
             if (RequestProduce(WPEFramework::Core::infinite) == WPEFramework::Core::ERROR_NONE) {
 
                 SetIV(static_cast<uint8_t>(ivDataLength), ivData);
-                SetSubSampleData(0, nullptr);
                 KeyId(static_cast<uint8_t>(keyIdLength), keyId);
                 InitWithLast15(initWithLast15);
-                Write(encryptedDataLength, encryptedData);
-
-                // This will trigger the OpenCDMIServer to decrypt this memory...
-                Produced();
-
-                // Now we should wait till it is decrypted, that happens if the
-                // Producer, can run again.
-                if (RequestProduce(WPEFramework::Core::infinite) == WPEFramework::Core::ERROR_NONE) {
-
-                    // For nowe we just copy the clear data..
-                    Read(encryptedDataLength, encryptedData);
 
-                    // Get the status of the last decrypt.
-                    ret = Status();
-
-                    // And free the lock, for the next production Scenario..
+                if ((SetSubSamples(subSampleCount, subSamples) != WPEFramework::Core::ERROR_NONE) || (WPEFramework::Core::SharedBuffer::Size(length) == false)) {
+                    // The subsamples or the sample do not fit, nothing is handed to the OpenCDMIServer,
+                    // just free the lock again for the next production Scenario..
+                    ret = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
                     Consumed();
+                } else {
+                    if (subSampleCount == 0) {
+                        SetBuffer(0, length, sample);
+                    } else {
+                        OCDM::SubSampleMap::Gather(subSampleCount, subSamples, sample, Buffer());
+                    }
+
+                    // This will trigger the OpenCDMIServer to decrypt this memory...
+                    Produced();
+
+                    // Now we should wait till it is decrypted, that happens if the
+                    // Producer, can run again.
+                    if (RequestProduce(WPEFramework::Core::infinite) == WPEFramework::Core::ERROR_NONE) {
+
+                        // For nowe we just copy the clear data..
+                        if (subSampleCount == 0) {
+                            Read(length, sample);
+                        } else {
+                            OCDM::SubSampleMap::Scatter(subSampleCount, subSamples, Buffer(), sample);
+                        }
+
+                        // Get the status of the last decrypt.
+                        ret = Status();
+
+                        // And free the lock, for the next production Scenario..
+                        Consumed();
+                    }
                 }
             }
 
             _busy = false;
 
-            _systemLock.Unlock();
+            _adminLock.Unlock();
 
             return (ret);
         }
 
     private:
+        // A CDM that does not come back within this time is considered to be stuck.
+        static constexpr uint32_t SampleWaitTime = 5000;
+
+        WPEFramework::Core::CriticalSection _adminLock;
         bool _busy;
+#ifndef __WIN32__
+        OCDM::SampleRing* _ring;
+#else
+        void* _ring;
+#endif
     };
 
 public:
@@ -584,6 +686,126 @@ public:
         return (result);
     }
 
+    uint32_t Decrypt(uint8_t* sample, const uint32_t sampleLength,
+        const uint16_t subSampleCount, const OCDM::SubSample subSamples[],
+        const uint8_t* ivData, uint16_t ivDataLength,
+        const uint8_t* keyId, const uint16_t keyIdLength,
+        uint32_t initWithLast15)
+    {
+        uint32_t result = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+
+        if ((_decryptSession != nullptr) && (subSampleCount <= OCDM::DataExchange::MaxSubSamples) && (OCDM::SubSampleMap::Length(subSampleCount, subSamples) <= sampleLength)) {
+            if (OCDM::SubSampleMap::Encrypted(subSampleCount, subSamples) == 0) {
+                // All clear, nothing for the CDM to do.
+                result = OpenCDMError::ERROR_NONE;
+            } else {
+                result = _decryptSession->Decrypt(sample, sampleLength, subSampleCount, subSamples,
+                    ivData, ivDataLength, keyId, keyIdLength, initWithLast15);
+                if (result) {
+                    TRACE_L1("Decrypt() failed with return code: %x", result);
+                    result = OpenCDMError::ERROR_UNKNOWN;
+                }
+            }
+        }
+        return (result);
+    }
+
+    // Zero copy decryption, the sample is written into and decrypted in a slot of
+    // the sample ring shared with the CDM. Only available if the CDM offers a ring.
+    uint32_t AcquireSample(const uint32_t waitTime, uint32_t& slot, uint8_t*& buffer, uint32_t& size)
+    {
+        uint32_t result = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+#ifndef __WIN32__
+        OCDM::SampleRing* ring = (_decryptSession != nullptr ? _decryptSession->Ring() : nullptr);
+
+        if (ring != nullptr) {
+            uint32_t error = ring->Acquire(waitTime, slot);
+
+            if (error == Core::ERROR_NONE) {
+                buffer = ring->Buffer(slot);
+                size = ring->SlotSize();
+                result = OpenCDMError::ERROR_NONE;
+            } else {
+                TRACE_L1("Acquiring a sample slot failed: %d", error);
+                result = OpenCDMError::ERROR_UNKNOWN;
+            }
+        }
+#endif
+        return (result);
+    }
+    uint32_t SubmitSample(const uint32_t slot, const uint32_t length,
+        const uint8_t* ivData, uint16_t ivDataLength,
+        const uint8_t* keyId, const uint16_t keyIdLength,
+        uint32_t initWithLast15)
+    {
+        uint32_t result = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+#ifndef __WIN32__
+        OCDM::SampleRing* ring = (_decryptSession != nullptr ? _decryptSession->Ring() : nullptr);
+
+        if (ring != nullptr) {
+            uint32_t error = Core::ERROR_ILLEGAL_STATE;
+
+            // Only a slot acquired, and not yet submitted, by this player may be touched.
+            if (ring->IsAllocated(slot) == true) {
+                ring->SetIV(slot, static_cast<uint8_t>(ivDataLength), ivData);
+                ring->SetSubSampleData(slot, 0, nullptr);
+                ring->KeyId(slot, static_cast<uint8_t>(keyIdLength), keyId);
+                ring->InitWithLast15(slot, initWithLast15 != 0);
+                error = ring->Submit(slot, length);
+            }
+
+            if (error == Core::ERROR_NONE) {
+                result = OpenCDMError::ERROR_NONE;
+            } else {
+                TRACE_L1("Submitting sample slot %d failed: %d", slot, error);
+                result = OpenCDMError::ERROR_UNKNOWN;
+            }
+        }
+#endif
+        return (result);
+    }
+    uint32_t WaitSample(const uint32_t slot, const uint32_t waitTime)
+    {
+        uint32_t result = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+#ifndef __WIN32__
+        OCDM::SampleRing* ring = (_decryptSession != nullptr ? _decryptSession->Ring() : nullptr);
+
+        if (ring != nullptr) {
+            uint32_t error = ring->Wait(slot, waitTime);
+
+            if (error != Core::ERROR_NONE) {
+                TRACE_L1("Waiting for sample slot %d failed: %d", slot, error);
+                result = OpenCDMError::ERROR_UNKNOWN;
+            } else if (ring->Status(slot) != 0) {
+                TRACE_L1("Decrypt() of slot %d failed with return code: %x", slot, ring->Status(slot));
+                result = OpenCDMError::ERROR_UNKNOWN;
+            } else {
+                result = OpenCDMError::ERROR_NONE;
+            }
+        }
+#endif
+        return (result);
+    }
+    uint32_t ReleaseSample(const uint32_t slot)
+    {
+        uint32_t result = OpenCDMError::ERROR_INVALID_DECRYPT_BUFFER;
+#ifndef __WIN32__
+        OCDM::SampleRing* ring = (_decryptSession != nullptr ? _decryptSession->Ring() : nullptr);
+
+        if (ring != nullptr) {
+            uint32_t error = ring->Release(slot);
+
+            if (error == Core::ERROR_NONE) {
+                result = OpenCDMError::ERROR_NONE;
+            } else {
+                TRACE_L1("Releasing sample slot %d failed: %d", slot, error);
+                result = OpenCDMError::ERROR_UNKNOWN;
+            }
+        }
+#endif
+        return (result);
+    }
+
     uint32_t SessionIdExt() const
     {
         ASSERT(_sessionExt && "This method only works on OCDM::ISessionExt implementations.");
@@ -18,6 +18,8 @@ namespace PluginHost {
         , _deserializer(*this)
         , _text()
         , _offset(0)
+        , _backlog(0)
+        , _dropped(0)
         , _sendQueue()
     {
     }
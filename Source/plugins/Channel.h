@@ -191,6 +191,19 @@ namespace PluginHost {
         {
             return ((_state & 0x8000) != 0);
         }
+        // Number of notifications this channel dropped because its backlog was full.
+        inline uint32_t Dropped() const
+        {
+            return (_dropped);
+        }
+        inline uint32_t Pending() const
+        {
+            _adminLock.Lock();
+            uint32_t result = static_cast<uint32_t>(_sendQueue.size());
+            _adminLock.Unlock();
+
+            return (result);
+        }
         inline void Submit(const string& text)
         {
             if (IsOpen() == true) {
@@ -209,19 +222,32 @@ namespace PluginHost {
             }
         }
         inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry)
+        {
+            Submit(entry, false);
+        }
+        inline void Submit(const Core::ProxyType<Core::JSON::IElement>& entry, const bool notification)
         {
             if (IsOpen() == true) {
 
                 _adminLock.Lock();
 
-                _sendQueue.emplace_back(entry);
+                // A peer that does not read its notifications should not make us queue them forever. Responses
+                // are always queued, the peer asked for them and is waiting for them.
+                if ((notification == true) && (_backlog != 0) && (_sendQueue.size() >= _backlog)) {
+                    _dropped++;
+                    _adminLock.Unlock();
 
-                bool trigger = (_sendQueue.size() == 1);
+                    TRACE_L1("Channel %d has %d pending messages, notification dropped.", _ID, _backlog);
+                } else {
+                    _sendQueue.emplace_back(entry);
 
-                _adminLock.Unlock();
+                    bool trigger = (_sendQueue.size() == 1);
 
-                if (trigger == true) {
-                    BaseClass::Trigger();
+                    _adminLock.Unlock();
+
+                    if (trigger == true) {
+                        BaseClass::Trigger();
+                    }
                 }
             }
         }
@@ -251,6 +277,11 @@ namespace PluginHost {
         {
             _nameOffset = offset;
         }
+        // Maximum number of messages queued for this channel before notifications are dropped, 0 is unlimited.
+        inline void Backlog(const uint16_t backlog)
+        {
+            _backlog = backlog;
+        }
         inline void State(const ChannelState state, const bool notification)
         {
             Binary(state == RAW);
@@ -412,6 +443,8 @@ namespace PluginHost {
         DeserializerImpl _deserializer;
         string _text;
         uint32_t _offset;
+        uint16_t _backlog;
+        uint32_t _dropped;
         std::list<Package> _sendQueue;
 
         // All requests needed by any instance of this webserver are coming from this web server. They are extracted
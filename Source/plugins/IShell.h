@@ -195,13 +195,18 @@ namespace PluginHost {
         virtual reason Reason() const = 0;
 
         // Method to access, in the main process space, the channel factory to submit JSON objects to be send.
+        // A notification may be dropped for a channel that does not keep up, anything else is always queued.
         // This method will return a error if it is NOT in the main process.
-        virtual uint32_t Submit(const uint32_t Id, const Core::ProxyType<Core::JSON::IElement>& response) = 0;
+        virtual uint32_t Submit(const uint32_t Id, const Core::ProxyType<Core::JSON::IElement>& response, const bool notification) = 0;
 
         // Method to access, in the main space, a COM factory to instantiate objects out-of-process.
         // This method will return a nullptr if it is NOT in the main process.
         virtual ICOMLink* COMLink() = 0;
 
+        inline uint32_t Submit(const uint32_t Id, const Core::ProxyType<Core::JSON::IElement>& response)
+        {
+            return (Submit(Id, response, false));
+        }
         inline void Register(RPC::IRemoteConnection::INotification* sink)
         {
             ICOMLink* handler(COMLink());
@@ -5,6 +5,7 @@ namespace WPEFramework {
 
 namespace PluginHost {
 
+    /* static */ constexpr uint32_t JSONRPC::DefaultResponseTimeout;
     /* static */ Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> JSONRPC::_jsonRPCMessageFactory(4);
 }
 } // namespace WPEFramework::PluginHost
@@ -55,9 +55,74 @@ namespace PluginHost {
             STATE_REGISTRATION,
             STATE_UNREGISTRATION,
             STATE_EXISTS,
-            STATE_CUSTOM
+            STATE_CUSTOM,
+            STATE_DEFERRED
         };
 
+        // Calls to methods registered with a Core::JSONRPC::Connection, that did not get their response yet. The
+        // connection is the token to complete them with, through Response(), from whatever thread, whenever the
+        // result is there. Until then no thread is blocked on the call. If a ResponseTimeout() is set, a call that
+        // takes longer is completed with ERROR_TIMEDOUT, a call of a channel that is closed, is dropped. Responses
+        // for both are discarded.
+        typedef std::map<std::pair<uint32_t, uint32_t>, uint64_t> PendingMap;
+        // The last calls that got their response, timed out or of which the channel closed, to tell a late (or
+        // second) response from a response to a call that was never deferred, e.g. one without an id.
+        typedef std::deque<std::pair<uint32_t, uint32_t>> FinishedList;
+
+        enum call {
+            CALL_PENDING,
+            CALL_FINISHED,
+            CALL_UNKNOWN
+        };
+
+        class Expiry : public Core::IDispatchType<void> {
+        private:
+            Expiry() = delete;
+            Expiry(const Expiry&) = delete;
+            Expiry& operator=(const Expiry&) = delete;
+
+        public:
+            Expiry(JSONRPC* parent)
+                : _adminLock()
+                , _parent(parent)
+            {
+                ASSERT(parent != nullptr);
+            }
+            ~Expiry() override
+            {
+            }
+
+        public:
+            // The job may already be taken from the WorkerPool queue when its parent goes, so the parent is
+            // cut loose first. A running check is waited for.
+            void Cut()
+            {
+                _adminLock.Lock();
+                _parent = nullptr;
+                _adminLock.Unlock();
+            }
+            void Dispatch() override
+            {
+                _adminLock.Lock();
+
+                if (_parent != nullptr) {
+                    _parent->Expired();
+                }
+
+                _adminLock.Unlock();
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            JSONRPC* _parent;
+        };
+
+    public:
+        // No timeout, a deferred call is pending until it is answered or its channel closes.
+        static constexpr uint32_t DefaultResponseTimeout = 0; // ms
+        // Number of finished calls remembered.
+        static constexpr uint16_t FinishedCalls = 256;
+
     public:
         JSONRPC(const JSONRPC&) = delete;
         JSONRPC& operator=(const JSONRPC&) = delete;
@@ -65,20 +130,39 @@ namespace PluginHost {
             : _adminLock()
             , _handlers()
             , _service(nullptr)
+            , _pending()
+            , _finished()
+            , _responseTimeout(DefaultResponseTimeout)
+            , _scheduled(0)
+            , _cancelled(false)
+            , _expiring(false)
+            , _idle(true, true)
+            , _expiry(Core::ProxyType<Expiry>::Create(this))
         {
             std::vector<uint8_t> versions = { 1 };
 
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back(Core::JSONRPC::Handler::BatchNotificationFunction([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }), versions);
         }
         JSONRPC(const std::vector<uint8_t> versions)
             : _adminLock()
             , _handlers()
             , _service(nullptr)
+            , _pending()
+            , _finished()
+            , _responseTimeout(DefaultResponseTimeout)
+            , _scheduled(0)
+            , _cancelled(false)
+            , _expiring(false)
+            , _idle(true, true)
+            , _expiry(Core::ProxyType<Expiry>::Create(this))
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back(Core::JSONRPC::Handler::BatchNotificationFunction([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }), versions);
         }
         virtual ~JSONRPC()
         {
+            Cancel();
+
+            _expiry->Cut();
         }
 
     public:
@@ -111,12 +195,12 @@ namespace PluginHost {
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions);
+            _handlers.emplace_back(Core::JSONRPC::Handler::BatchNotificationFunction([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }), versions);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler& CreateHandler(const std::vector<uint8_t>& versions, const Core::JSONRPC::Handler& source)
         {
-            _handlers.emplace_back([&](const uint32_t id, const string& designator, const string& data) { Notify(id, designator, data); }, versions, source);
+            _handlers.emplace_back(Core::JSONRPC::Handler::BatchNotificationFunction([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) { Notify(ids, designator, data); }), versions, source);
             return (_handlers.back());
         }
         Core::JSONRPC::Handler* GetHandler(uint8_t version)
@@ -194,6 +278,8 @@ namespace PluginHost {
 
         //
         // Methods to send responses to inbound invokaction methods (a-synchronous callbacks)
+        // Responses to calls that timed out, or of which the channel is closed, are not send and report ERROR_UNAVAILABLE,
+        // just like a second response to the same call. Responses to calls that were never deferred are send as is.
         // ------------------------------------------------------------------------------------------------------------------------------
         template <typename JSONOBJECT>
         uint32_t Response(const Core::JSONRPC::Connection& channel, const JSONOBJECT& parameters)
@@ -204,27 +290,31 @@ namespace PluginHost {
         }
         uint32_t Response(const Core::JSONRPC::Connection& channel, const string& result)
         {
-            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
-
-            ASSERT(_service != nullptr);
-
-            message->Result = result;
-            message->Id = channel.Sequence();
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-
-            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
+            return (Complete(channel) != CALL_FINISHED ? SendResult(channel, result) : static_cast<uint32_t>(Core::ERROR_UNAVAILABLE));
         }
         uint32_t Response(const Core::JSONRPC::Connection& channel, const Core::JSONRPC::Error& result)
         {
-            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+            return (Complete(channel) != CALL_FINISHED ? SendError(channel, result) : static_cast<uint32_t>(Core::ERROR_UNAVAILABLE));
+        }
+        // Is the call still waiting for its response? Lengthy a-synchronous methods can use this to stop early.
+        bool IsPending(const Core::JSONRPC::Connection& channel) const
+        {
+            _adminLock.Lock();
 
-            ASSERT(_service != nullptr);
+            bool result = (_pending.find(std::make_pair(channel.ChannelId(), channel.Sequence())) != _pending.end());
 
-            message->Error = result;
-            message->Id = channel.Sequence();
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            _adminLock.Unlock();
 
-            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
+            return (result);
+        }
+        // Time (ms) an a-synchronous method gets to send its response, 0 (the default) is forever. Once it is
+        // passed, the caller gets ERROR_TIMEDOUT and a late Response() is dropped, it returns ERROR_UNAVAILABLE.
+        // Applies to the calls deferred after it is set.
+        void ResponseTimeout(const uint32_t waitTime)
+        {
+            _adminLock.Lock();
+            _responseTimeout = waitTime;
+            _adminLock.Unlock();
         }
 
     protected:
@@ -279,6 +369,13 @@ namespace PluginHost {
                     response->Result = Core::NumberType<uint32_t>(Core::ERROR_UNKNOWN_KEY).Text();
                 }
                 break;
+            case STATE_DEFERRED:
+                // Only calls with an id expect a response. Registered before the invoke, the method
+                // might respond before it even returns. Other than that, it is invoked as any other.
+                if (inbound.Id.IsSet() == true) {
+                    Defer(Core::JSONRPC::Connection(channelId, inbound.Id.Value()));
+                }
+                // Fall through
             case STATE_CUSTOM:
                 string result;
                 uint32_t code = source->Invoke(Core::JSONRPC::Connection(channelId, inbound.Id.Value()), inbound.FullMethod(), inbound.Parameters.Value(), result);
@@ -301,9 +398,9 @@ namespace PluginHost {
         state Destination(const string& designator, Core::JSONRPC::Handler*& source)
         {
             state result = STATE_INCORRECT_HANDLER;
-            string callsign(Core::JSONRPC::Message::Callsign(designator));
+            size_t length = Core::JSONRPC::Message::CallsignLength(designator);
 
-            if (callsign.empty() || (callsign == _callsign)) {
+            if ((length == 0) || (designator.compare(0, length, _callsign) == 0)) {
                 // Seems we are on the right handler..
                 // now see if someone supports this version
                 uint8_t version = Core::JSONRPC::Message::Version(designator);
@@ -318,22 +415,26 @@ namespace PluginHost {
                 if (index == _handlers.end()) {
                     result = STATE_INCORRECT_VERSION;
                 } else {
-                    string method(Core::JSONRPC::Message::Method(designator));
+                    size_t offset = Core::JSONRPC::Message::MethodOffset(designator, length);
 
-                    if (method == _T("register")) {
+                    if (designator.compare(offset, length, _T("register")) == 0) {
                         result = STATE_REGISTRATION;
                         source = &(*index);
-                    } else if (method == _T("unregister")) {
+                    } else if (designator.compare(offset, length, _T("unregister")) == 0) {
                         result = STATE_UNREGISTRATION;
                         source = &(*index);
-                    } else if (method == _T("exists")) {
+                    } else if (designator.compare(offset, length, _T("exists")) == 0) {
                         result = STATE_EXISTS;
                         source = &(*index);
-                    } else if (index->Exists(method) == Core::ERROR_NONE) {
-                        source = &(*index);
-                        result = STATE_CUSTOM;
                     } else {
-                        result = STATE_UNKNOWN_METHOD;
+                        bool asynchronous;
+
+                        if (index->Exists(&(designator.c_str()[offset]), length, asynchronous) == Core::ERROR_NONE) {
+                            source = &(*index);
+                            result = (asynchronous == true ? STATE_DEFERRED : STATE_CUSTOM);
+                        } else {
+                            result = STATE_UNKNOWN_METHOD;
+                        }
                     }
                 }
             }
@@ -352,7 +453,25 @@ namespace PluginHost {
             message->Designator = designator;
             message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
 
-            _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message));
+            _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(message), true);
+        }
+        void Notify(const std::vector<uint32_t>& ids, const string& designator, const string& parameters)
+        {
+            ASSERT(_service != nullptr);
+
+            Core::ProxyType<Core::JSONRPC::Notification> notification(Core::ProxyType<Core::JSONRPC::Notification>::Create(designator, parameters));
+
+            if (notification->IsStreamable() == false) {
+                // Too big to be shared, each channel gets a message of its own.
+                for (const uint32_t id : ids) {
+                    Notify(id, designator, parameters);
+                }
+            } else {
+                // Formatted once, all channels stream the very same element.
+                for (const uint32_t id : ids) {
+                    _service->Submit(id, Core::ProxyType<Core::JSON::IElement>(notification), true);
+                }
+            }
         }
         virtual void Activate(IShell* service) override
         {
@@ -361,9 +480,15 @@ namespace PluginHost {
 
             _service = service;
             _callsign = _service->Callsign();
+
+            _adminLock.Lock();
+            _cancelled = false;
+            _adminLock.Unlock();
         }
         virtual void Deactivate() override
         {
+            Cancel();
+
             HandlerList::iterator index(_handlers.begin());
 
             while (index != _handlers.end()) {
@@ -382,6 +507,186 @@ namespace PluginHost {
                 index->Close(id);
                 index++;
             }
+
+            // Nobody is left to read the responses of the pending calls of this channel.
+            _adminLock.Lock();
+
+            PendingMap::iterator loop(_pending.lower_bound(std::make_pair(id, 0u)));
+
+            while ((loop != _pending.end()) && (loop->first.first == id)) {
+                Finished(loop->first);
+                loop = _pending.erase(loop);
+            }
+
+            _adminLock.Unlock();
+        }
+
+    private:
+        void Defer(const Core::JSONRPC::Connection& channel)
+        {
+            _adminLock.Lock();
+
+            const uint64_t deadline = (_responseTimeout == 0 ? static_cast<uint64_t>(~0) : Core::Time::Now().Add(_responseTimeout).Ticks());
+
+            _pending[std::make_pair(channel.ChannelId(), channel.Sequence())] = deadline;
+
+            // Usually all calls get the same time, and a new call does not expire before the check that is scheduled.
+            // Rescheduled under the lock, so concurrent calls can not move the check past the earliest deadline.
+            if (((_scheduled == 0) || (deadline < _scheduled)) && (deadline != static_cast<uint64_t>(~0)) && (_cancelled == false) && (Core::WorkerPool::IsAvailable() == true)) {
+                _scheduled = deadline;
+                Reschedule(deadline);
+            }
+
+            _adminLock.Unlock();
+        }
+        // A pending call is finished by its response.
+        call Complete(const Core::JSONRPC::Connection& channel)
+        {
+            const std::pair<uint32_t, uint32_t> key(channel.ChannelId(), channel.Sequence());
+            call result = CALL_PENDING;
+
+            _adminLock.Lock();
+
+            PendingMap::iterator index(_pending.find(key));
+
+            if (index != _pending.end()) {
+                _pending.erase(index);
+                Finished(key);
+            } else if (std::find(_finished.begin(), _finished.end(), key) != _finished.end()) {
+                result = CALL_FINISHED;
+            } else {
+                result = CALL_UNKNOWN;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void Finished(const std::pair<uint32_t, uint32_t>& key)
+        {
+            if (_finished.size() >= FinishedCalls) {
+                _finished.pop_front();
+            }
+            _finished.push_back(key);
+        }
+        void Expired()
+        {
+            const uint64_t now = Core::Time::Now().Ticks();
+            uint64_t next = static_cast<uint64_t>(~0);
+            std::list<Core::JSONRPC::Connection> expired;
+
+            _adminLock.Lock();
+
+            // After Cancel() nothing is checked anymore, the check may have been taken from the queue just before.
+            if (_cancelled == false) {
+                // Cancel() waits for this check to finish, it still uses the service.
+                _expiring = true;
+                _idle.ResetEvent();
+
+                PendingMap::iterator index(_pending.begin());
+
+                while (index != _pending.end()) {
+                    if (index->second <= now) {
+                        expired.emplace_back(index->first.first, index->first.second);
+                        Finished(index->first);
+                        index = _pending.erase(index);
+                    } else {
+                        if (index->second < next) {
+                            next = index->second;
+                        }
+                        index++;
+                    }
+                }
+
+                _scheduled = (next != static_cast<uint64_t>(~0) ? next : 0);
+
+                if (_scheduled != 0) {
+                    Reschedule(next);
+                }
+            }
+
+            _adminLock.Unlock();
+
+            if ((expired.empty() == false) && (_service != nullptr)) {
+                Core::JSONRPC::Error error;
+
+                error.SetError(Core::ERROR_TIMEDOUT);
+                error.Text = Core::ErrorToString(Core::ERROR_TIMEDOUT);
+
+                for (const Core::JSONRPC::Connection& channel : expired) {
+                    TRACE_L1("No response on call %d of channel %d in time.", channel.Sequence(), channel.ChannelId());
+                    SendError(channel, error);
+                }
+            }
+
+            _adminLock.Lock();
+            _expiring = false;
+            _idle.SetEvent();
+            _adminLock.Unlock();
+        }
+        void Reschedule(const uint64_t time)
+        {
+            Core::ProxyType<Core::IDispatch> job(_expiry);
+
+            // There is only one check pending, at the earliest time a call can expire. Revoke does not wait for
+            // a running check, so this is safe under the lock.
+            Core::WorkerPool::Instance().Revoke(job);
+            Core::WorkerPool::Instance().Schedule(Core::Time(time), job);
+        }
+        void Cancel()
+        {
+            _adminLock.Lock();
+
+            bool scheduled = (_scheduled != 0);
+            bool expiring = _expiring;
+
+            _cancelled = true;
+
+            // Nobody is left to send the responses to.
+            PendingMap::const_iterator index(_pending.begin());
+
+            while (index != _pending.end()) {
+                Finished(index->first);
+                index++;
+            }
+
+            _pending.clear();
+            _scheduled = 0;
+
+            if (scheduled == true) {
+                Core::WorkerPool::Instance().Revoke(Core::ProxyType<Core::IDispatch>(_expiry));
+            }
+
+            _adminLock.Unlock();
+
+            // A check that is running may still send its timeouts, wait for it.
+            if (expiring == true) {
+                _idle.Lock(Core::infinite);
+            }
+        }
+        uint32_t SendResult(const Core::JSONRPC::Connection& channel, const string& result)
+        {
+            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+
+            ASSERT(_service != nullptr);
+
+            message->Result = result;
+            message->Id = channel.Sequence();
+            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+
+            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
+        }
+        uint32_t SendError(const Core::JSONRPC::Connection& channel, const Core::JSONRPC::Error& result)
+        {
+            Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message = _jsonRPCMessageFactory.Element();
+
+            ASSERT(_service != nullptr);
+
+            message->Error = result;
+            message->Id = channel.Sequence();
+            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+
+            return (_service->Submit(channel.ChannelId(), Core::ProxyType<Core::JSON::IElement>(message)));
         }
 
     private:
@@ -389,6 +694,14 @@ namespace PluginHost {
         std::list<Core::JSONRPC::Handler> _handlers;
         IShell* _service;
         string _callsign;
+        PendingMap _pending;
+        FinishedList _finished;
+        uint32_t _responseTimeout;
+        uint64_t _scheduled;
+        bool _cancelled;
+        bool _expiring;
+        Core::Event _idle;
+        Core::ProxyType<Expiry> _expiry;
 
         static Core::ProxyPoolType<Web::JSONBodyType<Core::JSONRPC::Message>> _jsonRPCMessageFactory;
     };
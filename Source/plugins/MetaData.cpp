@@ -202,11 +202,67 @@ ENUM_CONVERSION_BEGIN(PluginHost::MetaData::Channel::state)
     {
     }
 
+    MetaData::Server::Pool::Pool()
+        : Core::JSON::Container()
+    {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("cached"), &Cached);
+        Add(_T("pooled"), &Pooled);
+        Add(_T("idle"), &Idle);
+    }
+    MetaData::Server::Pool::Pool(const string& name, const uint32_t created, const uint32_t cached, const uint32_t pooled, const uint32_t idle)
+        : Core::JSON::Container()
+    {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("cached"), &Cached);
+        Add(_T("pooled"), &Pooled);
+        Add(_T("idle"), &Idle);
+
+        Name = name;
+        Created = created;
+        Cached = cached;
+        Pooled = pooled;
+        Idle = idle;
+    }
+    MetaData::Server::Pool::Pool(const Pool& copy)
+        : Core::JSON::Container()
+        , Name(copy.Name)
+        , Created(copy.Created)
+        , Cached(copy.Cached)
+        , Pooled(copy.Pooled)
+        , Idle(copy.Idle)
+    {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("cached"), &Cached);
+        Add(_T("pooled"), &Pooled);
+        Add(_T("idle"), &Idle);
+    }
+    MetaData::Server::Pool::~Pool()
+    {
+    }
+
+    MetaData::Server::Input::Input()
+        : Core::JSON::Container()
+    {
+        Add(_T("events"), &Events);
+        Add(_T("dropped"), &Dropped);
+        Add(_T("processed"), &Processed);
+        Add(_T("dispatched"), &Dispatched);
+    }
+    MetaData::Server::Input::~Input()
+    {
+    }
+
     MetaData::Server::Server()
     {
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
         Core::JSON::Container::Add(_T("occupation"), &PoolOccupation);
+        Core::JSON::Container::Add(_T("pools"), &Pools);
+        Core::JSON::Container::Add(_T("input"), &Keys);
     }
     MetaData::Server::~Server()
     {
@@ -133,6 +133,43 @@ namespace PluginHost {
         };
 
         class EXTERNAL Server : public Core::JSON::Container {
+        public:
+            // Usage of one of the object pools (Core::ProxyPoolType) of the server.
+            class EXTERNAL Pool : public Core::JSON::Container {
+            private:
+                Pool& operator=(const Pool&) = delete;
+
+            public:
+                Pool();
+                Pool(const string& name, const uint32_t created, const uint32_t cached, const uint32_t pooled, const uint32_t idle);
+                Pool(const Pool& copy);
+                ~Pool();
+
+            public:
+                Core::JSON::String Name;
+                Core::JSON::DecUInt32 Created;
+                Core::JSON::DecUInt32 Cached;
+                Core::JSON::DecUInt32 Pooled;
+                Core::JSON::DecUInt32 Idle;
+            };
+
+            // Key events handled by the input handler (VirtualInput), with their latency histograms.
+            class EXTERNAL Input : public Core::JSON::Container {
+            private:
+                Input(const Input&) = delete;
+                Input& operator=(const Input&) = delete;
+
+            public:
+                Input();
+                ~Input();
+
+            public:
+                Core::JSON::DecUInt32 Events;
+                Core::JSON::DecUInt32 Dropped;
+                Core::JSON::ArrayType<Core::JSON::DecUInt32> Processed;
+                Core::JSON::ArrayType<Core::JSON::DecUInt32> Dispatched;
+            };
+
         private:
             Server(const Server& copy) = delete;
             Server& operator=(const Server&) = delete;
@@ -144,12 +181,25 @@ namespace PluginHost {
             inline void Clear()
             {
                 ThreadPoolRuns.Clear();
+                Pools.Clear();
+                Keys.Clear();
+            }
+            template <typename POOL>
+            void AddPool(const string& name, const POOL& pool)
+            {
+                typename POOL::Statistics statistics;
+
+                pool.Measure(statistics);
+
+                Pools.Add(Pool(name, statistics.Created, statistics.Cached, statistics.Pooled, statistics.Idle));
             }
 
         public:
             Core::JSON::ArrayType<Core::JSON::DecUInt32> ThreadPoolRuns;
             Core::JSON::DecUInt32 PendingRequests;
             Core::JSON::DecUInt32 PoolOccupation;
+            Core::JSON::ArrayType<Pool> Pools;
+            Input Keys;
         };
 
         class EXTERNAL SubSystem : public Core::JSON::Container {
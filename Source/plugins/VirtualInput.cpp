@@ -107,6 +107,8 @@ namespace PluginHost
                 ChangeIterator updated(updatedKeys);
                 _parent.MapChanges(updated);
             }
+
+            _compiled.Compile(_keyMap);
         }
 
         return (result);
@@ -176,12 +178,21 @@ namespace PluginHost
         , _repeatKey(*this)
         , _modifiers(0)
         , _defaultMap(nullptr)
+        , _notifierLock()
         , _notifierMap()
+        , _keyTableMap(nullptr)
         , _pressedCode(0)
         , _repeatCounter(0)
         , _repeatLimit(0)
+        , _events(0)
+        , _dropped(0)
+        , _processed()
+        , _dispatched()
+        , _ring()
+        , _dispatcher(*this)
     {
         // The derived class shoud set, the initial value of the modifiers...
+        _dispatcher.Run();
     }
 #ifdef __WIN32__
 #pragma warning(default : 4355)
@@ -200,17 +211,17 @@ namespace PluginHost
 
         if (keyCode == static_cast<uint32_t>(~0)) {
 
-            _lock.Lock();
+            _notifierLock.Lock();
 
             // Only register a callback once !!
             ASSERT(std::find(_notifierList.begin(), _notifierList.end(), callback) == _notifierList.end());
 
             _notifierList.push_back(callback);
 
-            _lock.Unlock();
+            _notifierLock.Unlock();
 
         } else {
-            _lock.Lock();
+            _notifierLock.Lock();
 
             NotifierList& notifierList(_notifierMap[keyCode]);
 
@@ -219,7 +230,7 @@ namespace PluginHost
 
             notifierList.push_back(callback);
 
-            _lock.Unlock();
+            _notifierLock.Unlock();
         }
     }
 
@@ -230,7 +241,7 @@ namespace PluginHost
 
         if (keyCode == static_cast<uint32_t>(~0)) {
 
-            _lock.Lock();
+            _notifierLock.Lock();
 
             NotifierList::iterator position = std::find(_notifierList.begin(), _notifierList.end(), callback);
 
@@ -241,10 +252,10 @@ namespace PluginHost
                 _notifierList.erase(position);
             }
 
-            _lock.Unlock();
+            _notifierLock.Unlock();
         } else {
 
-            _lock.Lock();
+            _notifierLock.Lock();
 
             NotifierMap::iterator it(_notifierMap.find(keyCode));
 
@@ -267,7 +278,7 @@ namespace PluginHost
                 }
             }
 
-            _lock.Unlock();
+            _notifierLock.Unlock();
         }
     }
 
@@ -319,17 +330,25 @@ namespace PluginHost
     uint32_t VirtualInput::KeyEvent(const bool pressed, const uint32_t code, const string& table)
     {
         uint32_t result = Core::ERROR_UNKNOWN_TABLE;
+        const uint64_t ingress = Core::Time::Now().Ticks();
 
         _lock.Lock();
 
-        TableMap::const_iterator index(_mappingTables.find(table));
         const KeyMap* conversionTable = nullptr;
 
-        if (index == _mappingTables.end()) {
-            conversionTable = _defaultMap;
+        if ((_keyTableMap != nullptr) && (table == _keyTable)) {
+            // Keys tend to come from the same table, over and over again.
+            conversionTable = _keyTableMap;
         } else {
-            _keyTable = table;
-            conversionTable = &(index->second);
+            TableMap::const_iterator index(_mappingTables.find(table));
+
+            if (index == _mappingTables.end()) {
+                conversionTable = _defaultMap;
+            } else {
+                _keyTable = table;
+                _keyTableMap = &(index->second);
+                conversionTable = _keyTableMap;
+            }
         }
 
         if (conversionTable != nullptr) {
@@ -390,6 +409,10 @@ namespace PluginHost
 
                 event.Action = IVirtualInput::KeyData::COMPLETED;
                 Send(event);
+
+                _processed.Add(Core::Time::Now().Ticks() - ingress);
+
+                Queue((pressed ? IVirtualInput::KeyData::PRESSED : IVirtualInput::KeyData::RELEASED), sendCode, ingress);
             }
         }
 
@@ -400,10 +423,15 @@ namespace PluginHost
 
     void VirtualInput::RepeatKey(const uint32_t code)
     {
+        const uint64_t ingress = Core::Time::Now().Ticks();
+
         IVirtualInput::KeyData event;
         event.Action = IVirtualInput::KeyData::REPEAT;
         event.Code = code;
         Send(event);
+
+        Queue(IVirtualInput::KeyData::REPEAT, code, ingress);
+
         _repeatCounter--;
         if (!_repeatCounter)
             KeyEvent(false, _pressedCode, _keyTable);
@@ -479,7 +507,7 @@ namespace PluginHost
 
     void VirtualInput::DispatchRegisteredKey(const IVirtualInput::KeyData::type type, uint32_t code)
     {
-        _lock.Lock();
+        _notifierLock.Lock();
 
         for (INotifier* element : _notifierList) {
             element->Dispatch(type, code);
@@ -494,7 +522,39 @@ namespace PluginHost
             }
         }
 
-        _lock.Unlock();
+        _notifierLock.Unlock();
+    }
+
+    void VirtualInput::Queue(const IVirtualInput::KeyData::type type, const uint32_t code, const uint64_t ingress)
+    {
+        _events.fetch_add(1, std::memory_order_relaxed);
+
+        if (_ring.Push(type, code, ingress) == true) {
+            _dispatcher.Trigger();
+        } else {
+            // The notifiers can not keep up, rather drop a notification than stall the input.
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void VirtualInput::Dispatch()
+    {
+        KeyRing::Record record;
+
+        while (_ring.Pop(record) == true) {
+            DispatchRegisteredKey(record.Type, record.Code);
+
+            _dispatched.Add(Core::Time::Now().Ticks() - record.Ingress);
+        }
+    }
+
+    void VirtualInput::Measure(Statistics& statistics) const
+    {
+        statistics.Events = _events.load(std::memory_order_relaxed);
+        statistics.Dropped = _dropped.load(std::memory_order_relaxed);
+
+        _processed.Measure(statistics.Processed);
+        _dispatched.Measure(statistics.Dispatched);
     }
 
 #if !defined(__WIN32__) && !defined(__APPLE__)
@@ -82,6 +82,189 @@ namespace PluginHost {
             uint16_t _code;
         };
 
+    public:
+        // Key events on their way to the registered notifiers. Multiple producers (the callers of KeyEvent
+        // and the repeat timer) claim a slot with a compare and swap on the head, a single consumer, the
+        // KeyDispatcher, releases them again. Nobody ever waits for a lock in here.
+        class KeyRing {
+        private:
+            KeyRing(const KeyRing&) = delete;
+            KeyRing& operator=(const KeyRing&) = delete;
+
+        public:
+            static constexpr uint32_t Size = 64;
+
+            struct Record {
+                uint64_t Ingress;
+                uint32_t Code;
+                IVirtualInput::KeyData::type Type;
+            };
+
+        private:
+            struct Slot {
+                std::atomic<uint32_t> Sequence;
+                Record Data;
+            };
+
+        public:
+            KeyRing()
+                : _head(0)
+                , _tail(0)
+            {
+                for (uint32_t index = 0; index < Size; index++) {
+                    _slots[index].Sequence.store(index, std::memory_order_relaxed);
+                }
+            }
+            ~KeyRing()
+            {
+            }
+
+        public:
+            bool Push(const IVirtualInput::KeyData::type type, const uint32_t code, const uint64_t ingress)
+            {
+                uint32_t position = _head.load(std::memory_order_relaxed);
+                Slot* slot = nullptr;
+                bool full = false;
+
+                while ((slot == nullptr) && (full == false)) {
+                    Slot& candidate(_slots[position & (Size - 1)]);
+                    int32_t distance = static_cast<int32_t>(candidate.Sequence.load(std::memory_order_acquire) - position);
+
+                    if (distance < 0) {
+                        // The consumer did not release this slot yet, the ring is full.
+                        full = true;
+                    } else if (distance > 0) {
+                        position = _head.load(std::memory_order_relaxed);
+                    } else if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) == true) {
+                        slot = &candidate;
+                    }
+                }
+
+                if (slot != nullptr) {
+                    slot->Data.Ingress = ingress;
+                    slot->Data.Code = code;
+                    slot->Data.Type = type;
+                    slot->Sequence.store(position + 1, std::memory_order_release);
+                }
+
+                return (slot != nullptr);
+            }
+            // Only to be called from a single thread.
+            bool Pop(Record& record)
+            {
+                Slot& slot(_slots[_tail & (Size - 1)]);
+                bool available = (slot.Sequence.load(std::memory_order_acquire) == (_tail + 1));
+
+                if (available == true) {
+                    record = slot.Data;
+                    slot.Sequence.store(_tail + Size, std::memory_order_release);
+                    _tail++;
+                }
+
+                return (available);
+            }
+
+        private:
+            std::atomic<uint32_t> _head;
+            uint32_t _tail;
+            Slot _slots[Size];
+        };
+
+    private:
+        class KeyDispatcher : public Core::Thread {
+        private:
+            KeyDispatcher() = delete;
+            KeyDispatcher(const KeyDispatcher&) = delete;
+            KeyDispatcher& operator=(const KeyDispatcher&) = delete;
+
+        public:
+            KeyDispatcher(VirtualInput& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("KeyDispatcher"))
+                , _parent(parent)
+                , _signal(false, true)
+            {
+            }
+            virtual ~KeyDispatcher()
+            {
+                Stop();
+                _signal.SetEvent();
+                Wait(Core::Thread::STOPPED | Core::Thread::BLOCKED, Core::infinite);
+            }
+
+        public:
+            inline void Trigger()
+            {
+                _signal.SetEvent();
+            }
+
+        private:
+            virtual uint32_t Worker() override
+            {
+                _signal.Lock(Core::infinite);
+                _signal.ResetEvent();
+
+                // Everything pushed after the reset signals again, so nothing is left behind.
+                _parent.Dispatch();
+
+                return (0);
+            }
+
+        private:
+            VirtualInput& _parent;
+            Core::Event _signal;
+        };
+
+    public:
+        // Latencies are counted in power of two buckets of microseconds, bucket n holds the events that
+        // took less than 2^n us (bucket 0: less than 1 us), the last bucket holds all slower ones.
+        static constexpr uint8_t LatencyBuckets = 16;
+
+        struct Statistics {
+            uint32_t Events;
+            uint32_t Dropped;
+            uint32_t Processed[LatencyBuckets]; // From KeyEvent being called until the key is sent out.
+            uint32_t Dispatched[LatencyBuckets]; // From KeyEvent being called until the notifiers are called.
+        };
+
+        class LatencyHistogram {
+        private:
+            LatencyHistogram(const LatencyHistogram&) = delete;
+            LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        public:
+            LatencyHistogram()
+            {
+                for (uint8_t index = 0; index < LatencyBuckets; index++) {
+                    _buckets[index].store(0, std::memory_order_relaxed);
+                }
+            }
+            ~LatencyHistogram()
+            {
+            }
+
+        public:
+            void Add(const uint64_t microseconds)
+            {
+                uint8_t index = 0;
+
+                while ((index < (LatencyBuckets - 1)) && ((microseconds >> index) != 0)) {
+                    index++;
+                }
+
+                _buckets[index].fetch_add(1, std::memory_order_relaxed);
+            }
+            void Measure(uint32_t buckets[]) const
+            {
+                for (uint8_t index = 0; index < LatencyBuckets; index++) {
+                    buckets[index] = _buckets[index].load(std::memory_order_relaxed);
+                }
+            }
+
+        private:
+            std::atomic<uint32_t> _buckets[LatencyBuckets];
+        };
+
+    private:
         enum enumModifier {
             LEFTSHIFT = 0, //  0..3  bits are for LeftShift reference counting (max 15)
             RIGHTSHIFT = 4, //  4..7  bits are for RightShift reference counting (max 15)
@@ -92,6 +275,57 @@ namespace PluginHost {
         };
 
     public:
+        // Read only, sorted copy of a code table, compiled whenever the table changes. A lookup is a
+        // binary search over contiguous memory instead of a walk over the nodes of a std::map.
+        template <typename VALUE>
+        class FlatLookupType {
+        private:
+            typedef std::pair<uint32_t, VALUE> Entry;
+
+            FlatLookupType(const FlatLookupType<VALUE>&) = delete;
+            FlatLookupType<VALUE>& operator=(const FlatLookupType<VALUE>&) = delete;
+
+        public:
+            FlatLookupType()
+                : _entries()
+            {
+            }
+            FlatLookupType(FlatLookupType<VALUE>&& move)
+                : _entries(std::move(move._entries))
+            {
+            }
+            ~FlatLookupType()
+            {
+            }
+
+        public:
+            template <typename MAP>
+            void Compile(const MAP& source)
+            {
+                _entries.clear();
+                _entries.reserve(source.size());
+
+                // A std::map is ordered already, so the result is sorted as well.
+                for (typename MAP::const_iterator index(source.begin()); index != source.end(); index++) {
+                    _entries.emplace_back(index->first, index->second);
+                }
+            }
+            inline uint32_t Count() const
+            {
+                return (static_cast<uint32_t>(_entries.size()));
+            }
+            inline const VALUE* Find(const uint32_t code) const
+            {
+                typename std::vector<Entry>::const_iterator index(std::lower_bound(_entries.begin(), _entries.end(), code,
+                    [](const Entry& entry, const uint32_t key) { return (entry.first < key); }));
+
+                return ((index != _entries.end()) && (index->first == code) ? &(index->second) : nullptr);
+            }
+
+        private:
+            std::vector<Entry> _entries;
+        };
+
         class EXTERNAL KeyMap {
         public:
             enum modifier {
@@ -158,6 +392,8 @@ namespace PluginHost {
             KeyMap(KeyMap&&) = default;
             KeyMap(VirtualInput& parent)
                 : _parent(parent)
+                , _keyMap()
+                , _compiled()
                 , _passThrough(false)
             {
             }
@@ -192,9 +428,7 @@ namespace PluginHost {
 
             inline const ConversionInfo* operator[](const uint32_t code) const
             {
-                std::map<const uint32_t, const ConversionInfo>::const_iterator index(_keyMap.find(code));
-
-                return (index != _keyMap.end() ? &(index->second) : nullptr);
+                return (_compiled.Find(code));
             }
             inline bool Add(const uint32_t code, const uint16_t key, const uint16_t modifiers)
             {
@@ -207,6 +441,7 @@ namespace PluginHost {
                     element.Modifiers = modifiers;
 
                     _keyMap.insert(std::pair<const uint32_t, const ConversionInfo>(code, element));
+                    _compiled.Compile(_keyMap);
                     added = true;
                 }
                 return (added);
@@ -217,6 +452,7 @@ namespace PluginHost {
 
                 if (index != _keyMap.end()) {
                     _keyMap.erase(index);
+                    _compiled.Compile(_keyMap);
                 }
             }
 
@@ -231,6 +467,7 @@ namespace PluginHost {
         private:
             VirtualInput& _parent;
             LookupMap _keyMap;
+            FlatLookupType<ConversionInfo> _compiled;
             bool _passThrough;
         };
 
@@ -239,7 +476,7 @@ namespace PluginHost {
             virtual ~INotifier() {}
             virtual void Dispatch(const IVirtualInput::KeyData::type type, const uint32_t code) = 0;
         };
-        typedef std::map<const uint32_t, const uint32_t> PostLookupEntries;
+        typedef FlatLookupType<uint32_t> PostLookupEntries;
 
     private:
         class PostLookupTable : public Core::JSON::Container {
@@ -381,6 +618,9 @@ namespace PluginHost {
             TableMap::iterator index(_mappingTables.find(name));
 
             if (index != _mappingTables.end()) {
+                if (_keyTableMap == &(index->second)) {
+                    _keyTableMap = nullptr;
+                }
                 _mappingTables.erase(index);
             }
         }
@@ -388,6 +628,9 @@ namespace PluginHost {
         void Register(INotifier* callback, const uint32_t keyCode = ~0);
         void Unregister(const INotifier* callback, const uint32_t keyCode = ~0);
 
+        // Counts all key events handled so far, and how long it took to handle them.
+        void Measure(Statistics& statistics) const;
+
         // -------------------------------------------------------------------------------------------------------
         // Whenever a key is pressed or released, let this object know, it will take the proper arrangements and timings
         // to announce this key event to the linux system. Repeat event is triggered by the watchdog implementation
@@ -407,13 +650,12 @@ namespace PluginHost {
                 PostLookupTable info;
                 info.FromFile(data);
                 Core::JSON::ArrayType<PostLookupTable::Conversion>::Iterator index(info.Conversions.Elements());
+                std::map<uint32_t, uint32_t> conversions;
 
                 _lock.Lock();
 
                 PostLookupMap::iterator postMap(_postLookupTable.find(linkName));
-                if (postMap != _postLookupTable.end()) {
-                    postMap->second.clear();
-                } else {
+                if (postMap == _postLookupTable.end()) {
                     auto newElement = _postLookupTable.emplace(std::piecewise_construct,
                         std::make_tuple(linkName),
                         std::make_tuple());
@@ -427,11 +669,13 @@ namespace PluginHost {
                         from |= (Modifiers(index.Current().In.Mods) << 16);
                         to |= (Modifiers(index.Current().In.Mods) << 16);
 
-                        postMap->second.insert(std::pair<const uint32_t, const uint32_t>(from, to));
+                        conversions.insert(std::pair<const uint32_t, const uint32_t>(from, to));
                     }
                 }
 
-                if (postMap->second.size() == 0) {
+                postMap->second.Compile(conversions);
+
+                if (postMap->second.Count() == 0) {
                     _postLookupTable.erase(postMap);
                 }
 
@@ -455,6 +699,8 @@ namespace PluginHost {
         void ModifierKey(const IVirtualInput::KeyData::type type, const uint16_t modifiers);
         bool SendModifier(const IVirtualInput::KeyData::type type, const enumModifier mode);
         void DispatchRegisteredKey(const IVirtualInput::KeyData::type type, uint32_t code);
+        void Queue(const IVirtualInput::KeyData::type type, const uint32_t code, const uint64_t ingress);
+        void Dispatch();
 
         virtual void Send(const IVirtualInput::KeyData& data) = 0;
         virtual void Send(const IVirtualInput::MouseData& data) = 0;
@@ -481,13 +727,21 @@ namespace PluginHost {
         uint32_t _modifiers;
         std::map<const string, KeyMap> _mappingTables;
         KeyMap* _defaultMap;
+        Core::CriticalSection _notifierLock;
         NotifierList _notifierList;
         NotifierMap _notifierMap;
         PostLookupMap _postLookupTable;
         string _keyTable;
+        const KeyMap* _keyTableMap;
         uint32_t _pressedCode;
         uint16_t _repeatCounter;
         uint16_t _repeatLimit;
+        std::atomic<uint32_t> _events;
+        std::atomic<uint32_t> _dropped;
+        LatencyHistogram _processed;
+        LatencyHistogram _dispatched;
+        KeyRing _ring;
+        KeyDispatcher _dispatcher;
     };
 
 #if !defined(__WIN32__) && !defined(__APPLE__)
@@ -562,13 +816,13 @@ namespace PluginHost {
                         ASSERT(dynamic_cast<IVirtualInput::KeyMessage*>(&(*element)) != nullptr);
 
                         // See if we need to convert this keycode..
-                        PostLookupEntries::const_iterator index(_postLookup->find(copy.Parameters().Code));
-                        if (index == _postLookup->end()) {
+                        const uint32_t* code(_postLookup->Find(copy.Parameters().Code));
+                        if (code == nullptr) {
                             result = element;
                         } else {
 
                             _replacement->Parameters().Action = copy.Parameters().Action;
-                            _replacement->Parameters().Code = index->second;
+                            _replacement->Parameters().Code = *code;
                             result = Core::ProxyType<Core::IIPC>(_replacement);
                         }
                     }
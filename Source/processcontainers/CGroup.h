@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Module.h"
+
+#include "ProcessContainer.h"
+
+namespace WPEFramework {
+namespace ProcessContainers {
+
+    // Resource limits of a container, taken from the "limits" object of its configuration and
+    // enforced by the cgroup v2 controllers (cpu, cpuset and memory) of the container.
+    class Limits : public Core::JSON::Container {
+    public:
+        Limits(const Limits&) = delete;
+        Limits& operator=(const Limits&) = delete;
+
+        Limits()
+            : Core::JSON::Container()
+            , CPUQuota(0)
+            , CPUSet()
+            , MemoryLimit(0)
+        {
+            Add(_T("cpuquota"), &CPUQuota); // percentage of a single CPU the container may consume, e.g. 150 is one and a half CPU, 0 is unlimited
+            Add(_T("cpuset"), &CPUSet); // CPUs the container may run on, e.g. "0-1,3"
+            Add(_T("memorylimit"), &MemoryLimit); // MB the container may use before the OOM killer kicks in, 0 is unlimited
+        }
+        ~Limits() = default;
+
+    public:
+        Core::JSON::DecUInt16 CPUQuota;
+        Core::JSON::String CPUSet;
+        Core::JSON::DecUInt32 MemoryLimit;
+    };
+
+    // Translation of the Limits to the cgroup v2 interface files and of the accounting files to
+    // the IContainer::Usage. The READER is a functor returning the content of a cgroup file, so
+    // the same code serves a cgroup in the filesystem and a cgroup owned by LXC.
+    class CGroup {
+    private:
+        CGroup() = delete;
+        CGroup(const CGroup&) = delete;
+        CGroup& operator=(const CGroup&) = delete;
+
+    public:
+        static constexpr uint32_t CPUPeriod = 100000; // us
+
+        static string CPUMax(const uint16_t quota)
+        {
+            string result(_T("max"));
+
+            if (quota != 0) {
+                result = Core::NumberType<uint64_t>((static_cast<uint64_t>(quota) * CPUPeriod) / 100).Text();
+            }
+
+            return (result + ' ' + Core::NumberType<uint32_t>(CPUPeriod).Text());
+        }
+        static string MemoryMax(const uint32_t limit)
+        {
+            return (limit == 0 ? string(_T("max")) : Core::NumberType<uint64_t>(static_cast<uint64_t>(limit) * 1024 * 1024).Text());
+        }
+
+        template <typename READER>
+        static bool Measure(READER& reader, IContainerAdministrator::IContainer::Usage& usage)
+        {
+            string cpu(reader(_T("cpu.stat")));
+            string memory(reader(_T("memory.current")));
+
+            usage.CPUTime = Value(cpu, _T("usage_usec"));
+            usage.Throttled = Value(cpu, _T("throttled_usec"));
+            usage.Memory = Core::NumberType<uint64_t>(memory.c_str(), static_cast<uint32_t>(memory.length())).Value();
+            usage.Resident = Value(reader(_T("memory.stat")), _T("anon"));
+            usage.OOMEvents = static_cast<uint32_t>(Value(reader(_T("memory.events")), _T("oom")));
+
+            // Without cpu.stat, there is no cgroup to measure.
+            return (cpu.empty() == false);
+        }
+
+        // Flat keyed files contain a "<key> <value>" pair per line. A missing key reads as 0.
+        static uint64_t Value(const string& content, const TCHAR key[])
+        {
+            const size_t length = _tcslen(key);
+            size_t index = 0;
+            uint64_t result = 0;
+
+            while (index < content.length()) {
+                size_t end = content.find('\n', index);
+
+                if (end == string::npos) {
+                    end = content.length();
+                }
+                if (((index + length) < end) && (content.compare(index, length, key) == 0) && (content[index + length] == ' ')) {
+                    const size_t start = index + length + 1;
+                    result = Core::NumberType<uint64_t>(&(content[start]), static_cast<uint32_t>(end - start)).Value();
+                    break;
+                }
+
+                index = end + 1;
+            }
+
+            return (result);
+        }
+    };
+} // ProcessContainers
+} // WPEFramework
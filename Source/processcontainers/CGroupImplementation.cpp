@@ -0,0 +1,350 @@
+#include "Module.h"
+
+#include "ProcessContainer.h"
+#include "CGroup.h"
+
+#include "Tracing.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef CGROUP_ROOT
+#define CGROUP_ROOT "/sys/fs/cgroup/WPEFramework"
+#endif
+
+namespace WPEFramework {
+
+// Containers without a root filesystem or namespaces of their own: the hosting process is started in
+// a cgroup v2 group created for the container, which limits and accounts its CPU and memory usage.
+class CGroupContainerAdministrator : public ProcessContainers::IContainerAdministrator {
+private:
+    static constexpr const TCHAR* Controllers[] = { _T("cpu"), _T("cpuset"), _T("memory") };
+
+    static string Read(const string& fileName)
+    {
+        string result;
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+
+        if (fd >= 0) {
+            char buffer[4096];
+            ssize_t length;
+
+            while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                result.append(buffer, length);
+            }
+
+            ::close(fd);
+        }
+
+        return (result);
+    }
+    static bool Write(const string& fileName, const string& value)
+    {
+        bool result = false;
+        int fd = ::open(fileName.c_str(), O_WRONLY);
+
+        if (fd >= 0) {
+            result = (::write(fd, value.c_str(), value.length()) == static_cast<ssize_t>(value.length()));
+            ::close(fd);
+        }
+
+        return (result);
+    }
+    // Hands the controllers down to the children of the group. A write enabling several controllers at
+    // once fails as a whole if one of them is not available, so they are enabled one at a time.
+    static bool Delegate(const string& group)
+    {
+        bool result = true;
+
+        for (const TCHAR* controller : Controllers) {
+            if (Write(group + _T("cgroup.subtree_control"), string(_T("+")) + controller) == false) {
+                SYSLOG(Trace::Error, (_T("Could not enable the %s controller for %s, error: %d"), controller, group.c_str(), errno));
+                result = false;
+            }
+        }
+
+        return (result);
+    }
+
+public:
+    CGroupContainerAdministrator(const CGroupContainerAdministrator&) = delete;
+    CGroupContainerAdministrator& operator=(const CGroupContainerAdministrator&) = delete;
+
+    CGroupContainerAdministrator()
+        : _lock()
+        , _root(Core::Directory::Normalize(_T(CGROUP_ROOT)))
+    {
+        string parent(_root.substr(0, _root.find_last_of('/', _root.length() - 2) + 1));
+
+        // Processes are only allowed in the leaves of the hierarchy, the root holds the containers
+        // and hands the controllers down to them.
+        Delegate(parent);
+
+        if ((::mkdir(_root.c_str(), 0755) != 0) && (errno != EEXIST)) {
+            SYSLOG(Trace::Error, (_T("Could not create the container cgroup %s, error: %d"), _root.c_str(), errno));
+        } else {
+            Delegate(_root);
+        }
+
+        TRACE(ProcessContainers::ProcessContainerization, (_T("cgroup v2 containers in: %s"), _root.c_str()));
+    }
+
+    virtual ~CGroupContainerAdministrator()
+    {
+    }
+
+    class CGroupContainer : public ProcessContainers::IContainerAdministrator::IContainer {
+    private:
+        class Config : public Core::JSON::Container {
+        public:
+            Config(const Config&) = delete;
+            Config& operator=(const Config&) = delete;
+
+            Config()
+                : Core::JSON::Container()
+                , Limits()
+            {
+                Add(_T("limits"), &Limits);
+            }
+            ~Config() = default;
+
+        public:
+            ProcessContainers::Limits Limits;
+        };
+
+    public:
+        CGroupContainer(const CGroupContainer&) = delete;
+        CGroupContainer& operator=(const CGroupContainer&) = delete;
+
+        CGroupContainer(const string& name, const string& path, const string& configuration)
+            : _name(name)
+            , _path(path)
+            , _pid(0)
+            , _referenceCount(1)
+        {
+            Config config;
+            config.FromString(configuration);
+
+            // A left over of a previous run that is still populated is reused, it gets the new limits.
+            if ((::mkdir(_path.c_str(), 0755) != 0) && (errno != EEXIST)) {
+                SYSLOG(Trace::Error, (_T("Could not create cgroup %s, error: %d"), _path.c_str(), errno));
+            }
+
+            if ((config.Limits.CPUQuota.IsSet() == true) && (Write(_path + _T("cpu.max"), ProcessContainers::CGroup::CPUMax(config.Limits.CPUQuota.Value())) == false)) {
+                SYSLOG(Trace::Error, (_T("Could not apply the CPU quota to container %s"), _name.c_str()));
+            }
+            if ((config.Limits.CPUSet.IsSet() == true) && (Write(_path + _T("cpuset.cpus"), config.Limits.CPUSet.Value()) == false)) {
+                SYSLOG(Trace::Error, (_T("Could not apply the CPU set to container %s"), _name.c_str()));
+            }
+            if ((config.Limits.MemoryLimit.IsSet() == true) && (Write(_path + _T("memory.max"), ProcessContainers::CGroup::MemoryMax(config.Limits.MemoryLimit.Value())) == false)) {
+                SYSLOG(Trace::Error, (_T("Could not apply the memory limit to container %s"), _name.c_str()));
+            }
+        }
+        ~CGroupContainer()
+        {
+            // Only succeeds if no process is left in the group.
+            if (::rmdir(_path.c_str()) != 0) {
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] cgroup not removed, error: %d"), _name.c_str(), errno));
+            }
+        }
+
+    public:
+        const string& Id() const override
+        {
+            return _name;
+        }
+        pid_t Pid() const override
+        {
+            return _pid;
+        }
+        bool IsRunning() const override
+        {
+            // Reap the host process if it is gone, children it left behind keep the group populated.
+            bool result = Core::Process(static_cast<uint32_t>(_pid)).IsActive();
+
+            if (result == false) {
+                string events(Read(_path + _T("cgroup.events")));
+                result = (events.find(_T("populated 1")) != string::npos);
+            }
+
+            return (result);
+        }
+        bool Start(const string& command, ProcessContainers::IStringIterator& parameters) override
+        {
+            std::vector<const char*> params(parameters.Count() + 2);
+            parameters.Reset(0);
+            uint16_t pos = 0;
+            params[pos++] = command.c_str();
+
+            while (parameters.Next() == true) {
+                params[pos++] = parameters.Current().c_str();
+            }
+            params[pos++] = nullptr;
+            ASSERT(pos == parameters.Count() + 2);
+
+            // Prepared before the fork, the child may only use async-signal-safe calls.
+            const string procs(_path + _T("cgroup.procs"));
+
+            pid_t pid = ::fork();
+
+            if (pid == 0) {
+                // Join the group before exec, so not a single instruction of the host runs outside its limits.
+                int fd = ::open(procs.c_str(), O_WRONLY);
+
+                if ((fd < 0) || (::write(fd, "0", 1) != 1)) {
+                    _exit(EPERM);
+                }
+
+                ::close(fd);
+                ::execvp(params[0], const_cast<char**>(params.data()));
+                _exit(errno);
+            }
+
+            _pid = (pid > 0 ? pid : 0);
+
+            if (_pid != 0) {
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] was started successfully! pid=%u"), _name.c_str(), _pid));
+            } else {
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] could not be started!"), _name.c_str()));
+            }
+
+            return (_pid != 0);
+        }
+        bool Stop(const uint32_t timeout /*ms*/) override
+        {
+            bool force = true;
+
+            if (Core::Process(static_cast<uint32_t>(_pid)).IsActive() == true) {
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container name [%s] Stop activated"), _name.c_str()));
+
+                ::kill(_pid, SIGTERM);
+
+                // Without a timeout the container is only asked to stop, it is not killed.
+                force = (timeout != 0);
+
+                if (timeout != 0) {
+                    uint64_t end = Core::Time::Now().Add(timeout).Ticks();
+
+                    while ((IsRunning() == true) && ((timeout == Core::infinite) || (Core::Time::Now().Ticks() < end))) {
+                        SleepMs(50);
+                    }
+                }
+            }
+
+            if ((force == true) && (IsRunning() == true)) {
+                // The host is gone or did not stop in time, anything left behind is killed in one go.
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container name [%s] is killed"), _name.c_str()));
+
+                if (Write(_path + _T("cgroup.kill"), _T("1")) == false) {
+                    string procs(Read(_path + _T("cgroup.procs")));
+                    size_t index = 0;
+
+                    while (index < procs.length()) {
+                        size_t end = procs.find('\n', index);
+                        end = (end == string::npos ? procs.length() : end);
+                        ::kill(Core::NumberType<pid_t>(&(procs[index]), static_cast<uint32_t>(end - index)).Value(), SIGKILL);
+                        index = end + 1;
+                    }
+                }
+            }
+
+            return ((timeout == 0) || (IsRunning() == false));
+        }
+        bool Measure(Usage& usage) const override
+        {
+            const string& path(_path);
+
+            auto reader = [&path](const TCHAR item[]) -> string {
+                return (Read(path + item));
+            };
+
+            return (ProcessContainers::CGroup::Measure(reader, usage));
+        }
+
+        void AddRef() const override
+        {
+            Core::InterlockedIncrement(_referenceCount);
+        }
+        uint32_t Release() const override
+        {
+            uint32_t result = Core::ERROR_NONE;
+
+            if (Core::InterlockedDecrement(_referenceCount) == 0) {
+                TRACE(ProcessContainers::ProcessContainerization, (_T("Container [%s] released"), _name.c_str()));
+
+                delete this;
+                result = Core::ERROR_DESTRUCTION_SUCCEEDED;
+            }
+            return (result);
+        }
+
+    private:
+        const string _name;
+        const string _path;
+        pid_t _pid;
+        mutable uint32_t _referenceCount;
+    };
+
+    // Lifetime management
+    void AddRef() const override
+    {
+    }
+    uint32_t Release() const override
+    {
+        return Core::ERROR_NONE;
+    }
+
+    ProcessContainers::IContainerAdministrator::IContainer* Container(const string& name,
+        ProcessContainers::IStringIterator& searchpaths,
+        const string& logpath,
+        const string& configuration) override;
+
+    void Logging(const string& /* logpath */, const string& /* logid */, const string& /* logging */) override
+    {
+        // Nothing is logged on behalf of the container, the host process does its own logging.
+    }
+
+private:
+    mutable Core::CriticalSection _lock;
+    const string _root;
+};
+
+constexpr const TCHAR* CGroupContainerAdministrator::Controllers[];
+
+ProcessContainers::IContainerAdministrator::IContainer* CGroupContainerAdministrator::Container(const string& name,
+    ProcessContainers::IStringIterator& /* searchpaths */,
+    const string& logpath,
+    const string& configuration)
+{
+    // No container definitions to look for. The log path is the volatile directory of the
+    // plugin (.../<callsign>/), its last segment gives the group a recognizable, unique name.
+    string group(logpath);
+
+    while ((group.empty() == false) && (group[group.length() - 1] == '/')) {
+        group.resize(group.length() - 1);
+    }
+    group = group.substr(group.find_last_of('/') + 1);
+
+    if (group.empty() == true) {
+        group = name;
+    }
+
+    _lock.Lock();
+
+    ProcessContainers::IContainerAdministrator::IContainer* container = new CGroupContainer(name, _root + group + '/', configuration);
+
+    _lock.Unlock();
+
+    return container;
+}
+
+ProcessContainers::IContainerAdministrator& ProcessContainers::IContainerAdministrator::Instance()
+{
+    static CGroupContainerAdministrator& myCGroupContainerAdministrator = Core::SingletonType<CGroupContainerAdministrator>::Instance();
+
+    return myCGroupContainerAdministrator;
+}
+
+} //namespace WPEFramework
@@ -1,6 +1,7 @@
 #include "Module.h"
 
 #include "ProcessContainer.h"
+#include "CGroup.h"
 
 #include "Tracing.h"
 #include <lxc/lxccontainer.h>
@@ -68,6 +69,7 @@ public:
                 : Core::JSON::Container()
                 , ConsoleLogging("0")
                 , ConfigItems()
+                , Limits()
 #ifdef __DEBUG__
                 , Attach(false)
 #endif
@@ -75,6 +77,7 @@ public:
                 Add(_T("console"), &ConsoleLogging); // should be a power of 2 when converted to bytes. Valid size prefixes are 'KB', 'MB', 'GB', 0 is off, auto is auto determined
 
                 Add(_T("items"), &ConfigItems);
+                Add(_T("limits"), &Limits);
 
 #ifdef __DEBUG__
                 Add(_T("attach"), &Attach);
@@ -85,6 +88,7 @@ public:
 
             Core::JSON::String ConsoleLogging;
             Core::JSON::ArrayType<ConfigItem> ConfigItems;
+            ProcessContainers::Limits Limits;
 #ifdef __DEBUG__
             Core::JSON::Boolean Attach;
 #endif
@@ -129,6 +133,17 @@ public:
                 _lxccontainer->set_config_item(_lxccontainer, "lxc.console.logfile", filename.c_str());
             }
 
+            // Limits are applied before the explicit items, so an item can still override them.
+            if (config.Limits.CPUQuota.IsSet() == true) {
+                _lxccontainer->set_config_item(_lxccontainer, "lxc.cgroup2.cpu.max", ProcessContainers::CGroup::CPUMax(config.Limits.CPUQuota.Value()).c_str());
+            }
+            if (config.Limits.CPUSet.IsSet() == true) {
+                _lxccontainer->set_config_item(_lxccontainer, "lxc.cgroup2.cpuset.cpus", config.Limits.CPUSet.Value().c_str());
+            }
+            if (config.Limits.MemoryLimit.IsSet() == true) {
+                _lxccontainer->set_config_item(_lxccontainer, "lxc.cgroup2.memory.max", ProcessContainers::CGroup::MemoryMax(config.Limits.MemoryLimit.Value()).c_str());
+            }
+
             Core::JSON::ArrayType<Config::ConfigItem>::Iterator index(config.ConfigItems.Elements());
             while( index.Next() == true ) {
                 _lxccontainer->set_config_item(_lxccontainer, index.Current().Key.Value().c_str(), index.Current().Value.Value().c_str());
@@ -147,6 +162,7 @@ public:
 
         bool Start(const string& command, ProcessContainers::IStringIterator& parameters) override;
         bool Stop(const uint32_t timeout /*ms*/) override;
+        bool Measure(Usage& usage) const override;
 
         void AddRef() const override {
             WPEFramework::Core::InterlockedIncrement(_referenceCount);
@@ -328,6 +344,24 @@ bool LXCContainerAdministrator::LCXContainer::Stop(const uint32_t timeout /*ms*/
     return result;
 }
 
+bool LXCContainerAdministrator::LCXContainer::Measure(Usage& usage) const {
+    bool result = false;
+
+    if( _lxccontainer->is_running(_lxccontainer) == true ) {
+        LxcContainerType* container = _lxccontainer;
+
+        auto reader = [container](const TCHAR item[]) -> string {
+            char buffer[4096];
+            int length = container->get_cgroup_item(container, item, buffer, sizeof(buffer));
+            return (length > 0 ? string(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1)) : string());
+        };
+
+        result = ProcessContainers::CGroup::Measure(reader, usage);
+    }
+
+    return result;
+}
+
 bool LXCContainerAdministrator::LCXContainer::IsRunning() const {
     return _lxccontainer->is_running(_lxccontainer);
 }
@@ -10,6 +10,15 @@ namespace ProcessContainers {
     struct IContainerAdministrator {
 
         struct IContainer {
+            // Resource usage of all processes running in the container, as accounted by its cgroup.
+            struct Usage {
+                uint64_t CPUTime; // us of CPU time consumed
+                uint64_t Throttled; // us the container was throttled because its CPU quota was used up
+                uint64_t Memory; // bytes charged to the container (including page cache)
+                uint64_t Resident; // bytes of anonymous memory, the resident set of the processes
+                uint32_t OOMEvents; // times the memory limit was hit and the OOM killer had to be invoked
+            };
+
             IContainer() = default;
             virtual ~IContainer() = default;
 
@@ -18,6 +27,7 @@ namespace ProcessContainers {
             virtual bool IsRunning() const = 0;
             virtual bool Start(const string& command, IStringIterator& parameters) = 0; // returns true when started
             virtual bool Stop(const uint32_t timeout /*ms*/) = 0; // returns true when stopped, note if timeout == 0 asynchronous
+            virtual bool Measure(Usage& usage) const = 0; // returns true when the usage could be read
 
             virtual void AddRef() const = 0;
             virtual uint32_t Release() const = 0;
@@ -1081,7 +1081,7 @@ namespace ProxyStubs {
         {
             return (nullptr);
         }
-        virtual uint32_t Submit(const uint32_t, const Core::ProxyType<Core::JSON::IElement>&) override
+        virtual uint32_t Submit(const uint32_t, const Core::ProxyType<Core::JSON::IElement>&, const bool) override
         {
             return (Core::ERROR_UNAVAILABLE);
         }
@@ -80,7 +80,7 @@ namespace Web
 		if (_mode == JSONWebToken::SHA256) {
             TCHAR signature[((Crypto::SHA256HMAC::Length * 8) / 6) + 4];
             Crypto::SHA256HMAC hash(_key);
-            hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length()));
+            hash.Input(reinterpret_cast<const uint8_t*>(token.c_str()), token.length());
             const uint8_t* inputSignature = hash.Result(); // 32 length
            
             convertedLength = Core::URL::Base64Encode(inputSignature, hash.Length, signature, sizeof(signature), false);
@@ -151,7 +151,7 @@ namespace Web
 				uint8_t signature[Crypto::SHA256HMAC::Length];
                 if (Core::URL::Base64Decode(token.substr(pos + 1).c_str(), static_cast<uint16_t>(token.length() - pos - 1), signature, sizeof(signature), nullptr) == sizeof(signature)) {
 
-					hash.Input(reinterpret_cast<const uint8_t*>(token.substr(0, pos).c_str()), static_cast<uint16_t>(pos * sizeof(TCHAR)));
+					hash.Input(reinterpret_cast<const uint8_t*>(token.substr(0, pos).c_str()), pos * sizeof(TCHAR));
 					result = (::memcmp(hash.Result(), signature, sizeof(signature)) == 0);
 				}
             }
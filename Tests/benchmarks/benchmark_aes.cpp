@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+#include <chrono>
+#include <functional>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+static constexpr uint32_t BufferSize = 1024 * 1024;
+static constexpr uint32_t Rounds = 64;
+
+static void Measure(const char name[], const std::function<void()>& operation)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t index = 0; index < Rounds; index++) {
+        operation();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("  %-20s: %6u MB/s\n", name, static_cast<uint32_t>((static_cast<uint64_t>(BufferSize >> 20) * Rounds * 1000000) / (duration > 0 ? duration : 1)));
+}
+
+// AES-128 on the table implementation and, if the CPU has it, on the hardware path.
+TEST(Benchmark_AES, throughput)
+{
+    const std::vector<uint8_t> key(16, 0x11);
+    const std::vector<uint8_t> iv(16, 0x22);
+    std::vector<uint8_t> data(BufferSize, 0xA5);
+
+    Crypto::AESEncryption ctr(Crypto::AES_CTR);
+    Crypto::AESDecryption cbc(Crypto::AES_CBC);
+    Crypto::AESGCM gcm;
+    ctr.Key(key.size(), key.data());
+    cbc.Key(key.size(), key.data());
+    gcm.Key(key.size(), key.data());
+
+    for (int hardware = 0; hardware <= 1; hardware++) {
+        const bool accelerated = (mbedtls_aes_hw_acceleration(hardware) != 0);
+
+        if ((hardware == 0) || (accelerated == true)) {
+            printf("%s\n", (accelerated ? "Hardware" : "Tables"));
+
+            Measure("AES-128-CTR", [&]() { ctr.InitialVector(iv.data()); ctr.Encrypt(data.size(), data.data(), data.data()); });
+            Measure("AES-128-CBC decrypt", [&]() { cbc.InitialVector(iv.data()); cbc.Decrypt(data.size(), data.data(), data.data()); });
+            Measure("AES-128-GCM", [&]() { gcm.Start(12, iv.data()); gcm.Encrypt(data.size(), data.data(), data.data()); });
+        }
+    }
+}
+
+} // Benchmarks
+} // WPEFramework
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+#include <chrono>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+template <typename HASHALGORITHM>
+static void Throughput(const char name[])
+{
+    static constexpr uint32_t BlockSize = 64 * 1024;
+    static constexpr uint32_t Rounds = 1024;
+
+    std::vector<uint8_t> data(BlockSize, 0xA5);
+    HASHALGORITHM hash;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t index = 0; index < Rounds; index++) {
+        hash.Input(data.data(), data.size());
+    }
+    EXPECT_NE(hash.Result(), nullptr);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    const uint64_t megabytes = (static_cast<uint64_t>(BlockSize) * Rounds) >> 20;
+    printf("%-8s: %6u MB/s\n", name, static_cast<uint32_t>((megabytes * 1000000) / (duration > 0 ? duration : 1)));
+}
+
+TEST(Benchmark_Hash, throughput)
+{
+    Throughput<Crypto::MD5>("MD5");
+    Throughput<Crypto::SHA1>("SHA1");
+    Throughput<Crypto::SHA256>("SHA256");
+    Throughput<Crypto::SHA512>("SHA512");
+}
+
+} // Benchmarks
+} // WPEFramework
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <chrono>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+class PingTarget {
+public:
+    PingTarget(const PingTarget&) = delete;
+    PingTarget& operator=(const PingTarget&) = delete;
+
+    PingTarget()
+        : _calls(0)
+    {
+    }
+    ~PingTarget() = default;
+
+public:
+    uint32_t Ping()
+    {
+        _calls++;
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Calls() const
+    {
+        return (_calls);
+    }
+
+private:
+    uint32_t _calls;
+};
+
+// Time per Invoke, from a full designator to the registered method, for a handler with 64 methods.
+TEST(Benchmark_JSONRPC, dispatch)
+{
+    const uint32_t rounds = 100000;
+
+    PingTarget target;
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+
+    for (uint32_t index = 0; index < 60; index++) {
+        handler.Register<void, void>(_T("method") + Core::NumberType<uint32_t>(index).Text(), &PingTarget::Ping, &target);
+    }
+    handler.Register<void, void>(_T("ping"), &PingTarget::Ping, &target);
+    handler.Register<void, void>(_T("zzz"), &PingTarget::Ping, &target);
+    handler.Register<void, void>(_T("interfacestatistics"), &PingTarget::Ping, &target);
+
+    const string designators[] = { _T("Test.1.ping"), _T("Test.1.method42"), _T("Test.1.zzz"), _T("Test.1.ping@3"), _T("Test.1.interfacestatistics") };
+    string response;
+
+    for (const string& designator : designators) {
+        const string method(Core::JSONRPC::Message::FullMethod(designator));
+        const uint32_t before = target.Calls();
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            handler.Invoke(Core::JSONRPC::Connection(1, round), method, EMPTY_STRING, response);
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        printf("Dispatch of %-28s: %8.1f ns per call\n", designator.c_str(), static_cast<double>(duration) / rounds);
+
+        EXPECT_EQ(target.Calls() - before, rounds);
+    }
+}
+
+} // Benchmarks
+} // WPEFramework
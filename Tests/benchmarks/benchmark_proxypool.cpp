@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <chrono>
+#include <thread>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+class PoolElement {
+public:
+    PoolElement(const PoolElement&) = delete;
+    PoolElement& operator=(const PoolElement&) = delete;
+
+    PoolElement()
+        : _value(0)
+    {
+    }
+    ~PoolElement() = default;
+
+public:
+    void Clear()
+    {
+        _value = 0;
+    }
+    uint32_t Value() const
+    {
+        return (_value);
+    }
+    void Value(const uint32_t value)
+    {
+        _value = value;
+    }
+
+private:
+    uint32_t _value;
+};
+
+// Time per element, taken from the pool, used and released again by every thread, just like a
+// request that is allocated, processed and returned.
+static double Throughput(Core::ProxyPoolType<PoolElement>& pool, const uint8_t threads)
+{
+    const uint32_t rounds = 100000;
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint8_t index = 0; index < threads; index++) {
+        workers.emplace_back([&pool, rounds]() {
+            for (uint32_t round = 0; round < rounds; round++) {
+                Core::ProxyType<PoolElement> first(pool.Element());
+                Core::ProxyType<PoolElement> second(pool.Element());
+                first->Value(round);
+                second->Value(first->Value());
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    return (static_cast<double>(duration) / (static_cast<double>(rounds) * threads * 2));
+}
+
+TEST(Benchmark_ProxyPool, throughput)
+{
+    for (uint8_t threads = 1; threads <= 8; threads <<= 1) {
+        Core::ProxyPoolType<PoolElement> shared(4, 0);
+        Core::ProxyPoolType<PoolElement> cached(4);
+
+        const double sharedTime = Throughput(shared, threads);
+        const double cachedTime = Throughput(cached, threads);
+
+        printf("%u threads: shared queue %6.1f ns, thread caches %6.1f ns per element\n", threads, sharedTime, cachedTime);
+    }
+}
+
+} // Benchmarks
+} // WPEFramework
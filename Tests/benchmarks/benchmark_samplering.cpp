@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <ocdm/DataExchange.h>
+#include <ocdm/SampleRing.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace WPEFramework {
+namespace Benchmarks {
+
+static constexpr uint32_t SampleSize = 64 * 1024;
+static constexpr uint32_t Samples = 2000;
+static constexpr uint8_t Key = 0x5A;
+
+// The CDM side of the benchmark, just touching every byte of the sample, as a null CDM would.
+static void NullDecrypt(uint8_t data[], const uint32_t length)
+{
+    for (uint32_t index = 0; index < length; index++) {
+        data[index] ^= Key;
+    }
+}
+
+static void Report(const TCHAR label[], const int64_t duration)
+{
+    printf("%-24s: %8.1f us per sample, %8.1f MB/s\n", label,
+        static_cast<double>(duration) / Samples,
+        (static_cast<double>(Samples) * SampleSize) / static_cast<double>(duration));
+}
+
+// The current scheme, a single buffer, every sample is a full round-trip with the CDM.
+TEST(Benchmark_SampleRing, single)
+{
+    const string name(_T("/tmp/ocdm_benchmark_single"));
+    uint8_t sample[SampleSize];
+    std::atomic<bool> running(true);
+
+    OCDM::DataExchange server(name, SampleSize);
+    OCDM::DataExchange client(name);
+
+    std::thread cdm([&]() {
+        while (running == true) {
+            if (server.RequestConsume(100) == Core::ERROR_NONE) {
+                NullDecrypt(server.Buffer(), static_cast<uint32_t>(server.Size()));
+                server.Status(0);
+                server.Consumed();
+            }
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t index = 0; index < Samples; index++) {
+        ::memset(sample, static_cast<uint8_t>(index), sizeof(sample));
+
+        if (client.RequestProduce(Core::infinite) == Core::ERROR_NONE) {
+            client.Write(sizeof(sample), sample);
+            client.Produced();
+
+            if (client.RequestProduce(Core::infinite) == Core::ERROR_NONE) {
+                client.Read(sizeof(sample), sample);
+                client.Consumed();
+            }
+        }
+    }
+
+    Report(_T("Single buffer"), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    running = false;
+    cdm.join();
+
+    Core::File(name).Destroy();
+    Core::File(name + _T(".admin")).Destroy();
+}
+
+// The sample ring, with a given number of samples in flight, decrypted in place in the slot.
+static void Ring(const uint32_t depth)
+{
+    const string name(_T("/tmp/ocdm_benchmark_ring"));
+    std::atomic<bool> running(true);
+
+    OCDM::SampleRing server(name, 8, SampleSize);
+    OCDM::SampleRing client(name);
+
+    ASSERT_TRUE(server.IsOperational());
+    ASSERT_TRUE(client.IsOperational());
+
+    std::thread cdm([&]() {
+        uint32_t slot;
+
+        while (running == true) {
+            if (server.Next(100, slot) == Core::ERROR_NONE) {
+                NullDecrypt(server.Buffer(slot), server.Length(slot));
+                server.Completed(slot, 0);
+            }
+        }
+    });
+
+    std::vector<uint32_t> inflight(depth);
+    uint32_t submitted = 0;
+    uint32_t completed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (completed < Samples) {
+        // Keep the pipeline filled.
+        while (((submitted - completed) < depth) && (submitted < Samples)) {
+            uint32_t& slot(inflight[submitted % depth]);
+
+            client.Acquire(Core::infinite, slot);
+            ::memset(client.Buffer(slot), static_cast<uint8_t>(submitted), SampleSize);
+            client.Submit(slot, SampleSize);
+            submitted++;
+        }
+
+        uint32_t slot = inflight[completed % depth];
+
+        client.Wait(slot, Core::infinite);
+        client.Release(slot);
+        completed++;
+    }
+
+    string label(_T("Sample ring, depth ") + Core::NumberType<uint32_t>(depth).Text());
+    Report(label.c_str(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    running = false;
+    cdm.join();
+
+    Core::File(name).Destroy();
+}
+
+TEST(Benchmark_SampleRing, ring)
+{
+    Ring(1);
+    Ring(4);
+    Ring(8);
+}
+
+} // Benchmarks
+} // WPEFramework
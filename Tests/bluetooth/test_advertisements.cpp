@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <bluetooth/bluetooth.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A synthetic scan, modelled after what a controller reports: every line is an EVT_LE_ADVERTISING_REPORT
+// as it would be read from the socket, with the milliseconds since the start of the scan. Three beacons repeat
+// their advertisement every 100ms, the third one changes its payload (battery level) halfway.
+struct Event {
+    uint32_t Offset;
+    uint8_t Length;
+    uint8_t Packet[64];
+};
+
+#define BEACON(ADDRESS, LEVEL) \
+    0x00, 0x01, ADDRESS, 0x34, 0x12, 0xEF, 0xBE, 0xAD, 0x0B, \
+    0x02, 0x01, 0x06, 0x07, 0xFF, 0x4C, 0x00, 0x02, 0x15, LEVEL, 0x01, 0xC4
+
+#define REPORT(ADDRESS, LEVEL) { HCI_EVENT_PKT, EVT_LE_META_EVENT, 23, EVT_LE_ADVERTISING_REPORT, 1, BEACON(ADDRESS, LEVEL) }
+#define REPORTS(ADDRESS1, ADDRESS2, LEVEL) { HCI_EVENT_PKT, EVT_LE_META_EVENT, 44, EVT_LE_ADVERTISING_REPORT, 2, BEACON(ADDRESS1, 0x64), BEACON(ADDRESS2, LEVEL) }
+
+static const uint8_t ReportSize = 26;
+static const uint8_t BatchSize = 47;
+
+static void Replay(const std::function<void(const Event&)>& handler)
+{
+    // The scan covers 1 second, 10 rounds of all beacons.
+    static const Event scan[] = {
+        { 0, ReportSize, REPORT(0x01, 0x64) },
+        { 3, BatchSize, REPORTS(0x02, 0x03, 0x50) },
+        { 100, ReportSize, REPORT(0x01, 0x64) },
+        { 104, BatchSize, REPORTS(0x02, 0x03, 0x50) },
+        { 201, ReportSize, REPORT(0x01, 0x64) },
+        { 203, BatchSize, REPORTS(0x02, 0x03, 0x50) },
+        { 300, ReportSize, REPORT(0x01, 0x64) },
+        { 302, BatchSize, REPORTS(0x02, 0x03, 0x50) },
+        { 400, ReportSize, REPORT(0x01, 0x64) },
+        { 405, BatchSize, REPORTS(0x02, 0x03, 0x50) },
+        { 500, ReportSize, REPORT(0x01, 0x64) },
+        { 502, BatchSize, REPORTS(0x02, 0x03, 0x4F) },
+        { 600, ReportSize, REPORT(0x01, 0x64) },
+        { 601, BatchSize, REPORTS(0x02, 0x03, 0x4F) },
+        { 700, ReportSize, REPORT(0x01, 0x64) },
+        { 703, BatchSize, REPORTS(0x02, 0x03, 0x4F) },
+        { 800, ReportSize, REPORT(0x01, 0x64) },
+        { 802, BatchSize, REPORTS(0x02, 0x03, 0x4F) },
+        { 900, ReportSize, REPORT(0x01, 0x64) },
+        { 904, BatchSize, REPORTS(0x02, 0x03, 0x4F) },
+    };
+
+    for (const Event& entry : scan) {
+        handler(entry);
+    }
+}
+
+// Feeds the reports of a packet to the filter, the way the HCISocket does.
+static uint16_t Ingest(Bluetooth::AdvertisementFilter& filter, const Event& entry, const uint64_t now)
+{
+    const uint8_t* segment = &(entry.Packet[5]);
+    uint16_t passed = 0;
+
+    for (uint8_t loop = 0; loop < entry.Packet[4]; loop++) {
+        const uint16_t size = sizeof(le_advertising_info) + reinterpret_cast<const le_advertising_info*>(segment)->length + 1;
+
+        if (filter.Ingest(segment, size, now) == true) {
+            passed++;
+        }
+        segment = &(segment[size]);
+    }
+
+    EXPECT_EQ(segment, &(entry.Packet[entry.Length]));
+
+    return (passed);
+}
+
+TEST(Bluetooth_AdvertisementFilter, disabled)
+{
+    Bluetooth::AdvertisementFilter filter;
+    uint16_t passed = 0;
+
+    // Unless configured, every report is passed on as is.
+    Replay([&](const Event& entry) {
+        passed += Ingest(filter, entry, static_cast<uint64_t>(entry.Offset + 1) * Core::Time::TicksPerMillisecond);
+    });
+
+    EXPECT_EQ(passed, 30u);
+    EXPECT_EQ(filter.Advertisers(), 0u);
+    EXPECT_EQ(filter.Flush(Core::Time::Now().Ticks(), [](const le_advertising_info&) {}), 0u);
+}
+
+TEST(Bluetooth_AdvertisementFilter, replay)
+{
+    Bluetooth::AdvertisementFilter filter(10000, 250);
+    uint32_t batches = 0;
+    uint32_t delivered = 0;
+    uint8_t lastLevel = 0;
+
+    Replay([&](const Event& entry) {
+        const uint64_t now = static_cast<uint64_t>(entry.Offset + 1) * Core::Time::TicksPerMillisecond;
+
+        EXPECT_EQ(Ingest(filter, entry, now), 0);
+
+        if (filter.IsDue(now) == true) {
+            batches++;
+            delivered += filter.Flush(now, [&lastLevel](const le_advertising_info& info) {
+                EXPECT_EQ(info.length, 11);
+                if (info.bdaddr.b[0] == 0x03) {
+                    lastLevel = info.data[9];
+                }
+            });
+        }
+    });
+
+    // All three beacons once, the changed one once more.
+    EXPECT_EQ(delivered, 4u);
+    EXPECT_EQ(lastLevel, 0x4F);
+    EXPECT_LE(batches, 5u);
+    EXPECT_EQ(filter.Advertisers(), 3u);
+
+    Bluetooth::AdvertisementFilter::Statistics statistics;
+    filter.Measure(statistics);
+    EXPECT_EQ(statistics.Received, 30u);
+    EXPECT_EQ(statistics.Suppressed, 26u);
+    EXPECT_EQ(statistics.Delivered, 4u);
+    EXPECT_EQ(statistics.Overflow, 0u);
+}
+
+TEST(Bluetooth_AdvertisementFilter, window)
+{
+    Bluetooth::AdvertisementFilter filter(1000, 0);
+    uint32_t delivered = 0;
+
+    // Replayed 5 times back to back: an unchanged advertisement is reported again once the window passed.
+    for (uint8_t round = 0; round < 5; round++) {
+        Replay([&](const Event& entry) {
+            const uint64_t now = static_cast<uint64_t>((round * 1000) + entry.Offset + 1) * Core::Time::TicksPerMillisecond;
+
+            Ingest(filter, entry, now);
+            delivered += filter.Flush(now, [](const le_advertising_info&) {});
+        });
+    }
+
+    // 3 beacons per round plus the change in the first round. Later rounds start with the
+    // changed payload, so they see it as changed again as well.
+    EXPECT_EQ(delivered, 4u + (4u * 4u));
+}
+
+TEST(Bluetooth_AdvertisementFilter, capacity)
+{
+    Bluetooth::AdvertisementFilter filter(1000, 250);
+    uint8_t report[] = { BEACON(0x00, 0x64) };
+    uint16_t passed = 0;
+
+    // Far more advertisers than fit, the ones that do not fit are passed on unfiltered.
+    for (uint16_t index = 0; index < 512; index++) {
+        report[2] = (index & 0xFF);
+        report[3] = (index >> 8);
+        passed += (filter.Ingest(report, sizeof(report), Core::Time::TicksPerMillisecond) ? 1 : 0);
+    }
+
+    EXPECT_EQ(filter.Advertisers() + passed, 512);
+    EXPECT_NE(passed, 0);
+
+    filter.Flush(Core::Time::TicksPerMillisecond, [](const le_advertising_info&) {});
+
+    // Half of them keeps on advertising.
+    const uint16_t stored = filter.Advertisers();
+    for (uint16_t index = 0; index < stored; index += 2) {
+        report[2] = (index & 0xFF);
+        report[3] = (index >> 8);
+        EXPECT_FALSE(filter.Ingest(report, sizeof(report), 1500 * Core::Time::TicksPerMillisecond));
+    }
+
+    // Once the window passed, advertisers that went silent make room for new ones.
+    report[4] = 0x99;
+    EXPECT_FALSE(filter.Ingest(report, sizeof(report), 2000 * Core::Time::TicksPerMillisecond));
+    EXPECT_EQ(filter.Advertisers(), (stored / 2) + 1);
+
+    // The ones that stayed are still found after the removals around them.
+    report[4] = 0x12;
+    for (uint16_t index = 0; index < stored; index += 2) {
+        report[2] = (index & 0xFF);
+        report[3] = (index >> 8);
+        EXPECT_FALSE(filter.Ingest(report, sizeof(report), 2001 * Core::Time::TicksPerMillisecond));
+    }
+    EXPECT_EQ(filter.Advertisers(), (stored / 2) + 1);
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <bluetooth/bluetooth.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// The socket is never opened, the test plays the controller: it takes the commands the socket
+// wants to send and feeds it the events a controller would return.
+class ControllerSocket : public Bluetooth::HCISocket {
+public:
+    ControllerSocket(const ControllerSocket&) = delete;
+    ControllerSocket& operator=(const ControllerSocket&) = delete;
+
+    ControllerSocket()
+        : Bluetooth::HCISocket()
+        , Events(0)
+        , Reports(0)
+    {
+    }
+    ~ControllerSocket() override = default;
+
+public:
+    // The opcodes of all commands the socket is allowed to send now.
+    uint16_t Drain(uint16_t opcodes[], const uint16_t maxCount)
+    {
+        uint8_t buffer[1024];
+        uint16_t count = 0;
+
+        while ((count < maxCount) && (static_cast<Core::SocketPort&>(*this).SendData(buffer, sizeof(buffer)) != 0)) {
+            opcodes[count++] = (buffer[1] | (buffer[2] << 8));
+        }
+
+        return (count);
+    }
+    uint16_t Feed(uint8_t buffer[], const uint16_t length)
+    {
+        return (static_cast<Core::SocketPort&>(*this).ReceiveData(buffer, length));
+    }
+
+    uint32_t Events;
+    uint32_t Reports;
+
+protected:
+    void Update(const hci_event_hdr&) override
+    {
+        Events++;
+    }
+    void Update(const le_advertising_info&) override
+    {
+        Reports++;
+    }
+};
+
+static uint16_t CommandComplete(uint8_t buffer[], const uint8_t credits, const uint16_t opcode)
+{
+    buffer[0] = HCI_EVENT_PKT;
+    buffer[1] = EVT_CMD_COMPLETE;
+    buffer[2] = EVT_CMD_COMPLETE_SIZE + 1;
+    buffer[3] = credits;
+    buffer[4] = (opcode & 0xFF);
+    buffer[5] = (opcode >> 8);
+    buffer[6] = 0; // status
+
+    return (1 + HCI_EVENT_HDR_SIZE + EVT_CMD_COMPLETE_SIZE + 1);
+}
+
+TEST(Bluetooth_HCISocket, pipeline)
+{
+    typedef Bluetooth::HCISocket::Command::ScanEnableLE Command;
+
+    ControllerSocket socket;
+    uint8_t buffer[64];
+    uint16_t opcodes[8];
+    uint32_t completed = 0;
+
+    for (uint8_t index = 0; index < 6; index++) {
+        Command command;
+        command.Clear();
+        socket.Execute<Command>(1000, command, [&completed](Command&, const uint32_t error) {
+            EXPECT_EQ(error, Core::ERROR_NONE);
+            completed++;
+        });
+    }
+
+    // The controller starts with room for a single command.
+    EXPECT_EQ(socket.Drain(opcodes, 8), 1);
+    EXPECT_EQ(opcodes[0], Command::ID);
+
+    // Completing it announces room for four, an unrelated event in the same read is passed on.
+    uint16_t length = CommandComplete(buffer, 4, Command::ID);
+    buffer[length++] = HCI_EVENT_PKT;
+    buffer[length++] = EVT_CONN_REQUEST;
+    buffer[length++] = 0;
+
+    EXPECT_EQ(socket.Feed(buffer, length), length);
+    EXPECT_EQ(completed, 1u);
+    EXPECT_EQ(socket.Events, 1u);
+    EXPECT_EQ(socket.Drain(opcodes, 8), 4);
+
+    for (uint8_t index = 0; index < 4; index++) {
+        length = CommandComplete(buffer, 1, Command::ID);
+        socket.Feed(buffer, length);
+    }
+    EXPECT_EQ(completed, 5u);
+    EXPECT_EQ(socket.Drain(opcodes, 8), 1);
+
+    length = CommandComplete(buffer, 1, Command::ID);
+    socket.Feed(buffer, length);
+    EXPECT_EQ(completed, 6u);
+
+    // Nothing in flight anymore, so a completion is just an event.
+    length = CommandComplete(buffer, 1, Command::ID);
+    socket.Feed(buffer, length);
+    EXPECT_EQ(socket.Events, 2u);
+    EXPECT_EQ(socket.Drain(opcodes, 8), 0);
+}
+
+TEST(Bluetooth_HCISocket, expiry)
+{
+    typedef Bluetooth::HCISocket::Command::ScanEnableLE Command;
+
+    ControllerSocket socket;
+    uint16_t opcodes[2];
+    uint32_t result = Core::ERROR_NONE;
+
+    Command command;
+    command.Clear();
+    socket.Execute<Command>(10, command, [&result](Command&, const uint32_t error) {
+        result = error;
+    });
+
+    SleepMs(50);
+
+    EXPECT_EQ(socket.Drain(opcodes, 2), 0);
+    EXPECT_EQ(result, Core::ERROR_TIMEDOUT);
+}
+
+TEST(Bluetooth_HCISocket, advertisements)
+{
+    ControllerSocket socket;
+    uint8_t buffer[64] = { HCI_EVENT_PKT, EVT_LE_META_EVENT, 0, EVT_LE_ADVERTISING_REPORT, 2 };
+    uint16_t length = 5;
+
+    for (uint8_t entry = 0; entry < 2; entry++) {
+        ::memset(&(buffer[length]), 0, sizeof(le_advertising_info));
+        buffer[length + offsetof(le_advertising_info, bdaddr)] = entry;
+        buffer[length + offsetof(le_advertising_info, length)] = 3;
+        length += sizeof(le_advertising_info);
+        buffer[length++] = 0x02;
+        buffer[length++] = 0x01;
+        buffer[length++] = 0x06;
+        buffer[length++] = 0xC0; // RSSI
+    }
+    buffer[2] = static_cast<uint8_t>(length - (1 + HCI_EVENT_HDR_SIZE));
+
+    // Filtering is opt-in, by default every report is passed on.
+    EXPECT_EQ(socket.Feed(buffer, length), length);
+    EXPECT_EQ(socket.Reports, 2u);
+    EXPECT_EQ(socket.Events, 0u);
+
+    EXPECT_EQ(socket.Feed(buffer, length), length);
+    EXPECT_EQ(socket.Reports, 4u);
+
+    // Once switched on, both advertisers are reported once more and repeating them is filtered out.
+    socket.Filtering(10000, 0);
+    EXPECT_EQ(socket.Feed(buffer, length), length);
+    EXPECT_EQ(socket.Reports, 6u);
+
+    EXPECT_EQ(socket.Feed(buffer, length), length);
+    EXPECT_EQ(socket.Reports, 6u);
+    EXPECT_EQ(socket.Events, 0u);
+}
+
+} // Tests
+} // WPEFramework
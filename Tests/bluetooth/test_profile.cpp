@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <bluetooth/bluetooth.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A stored attribute database: a Generic Access service with the device name and a Battery service
+// with a notifying battery level.
+static const uint8_t Database[] = {
+    'G', 'A', 'T', 'T', 0x01,
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10,
+    0x02, 0x00,
+    // Generic Access, 0x0001 - 0x0007
+    0x02, 0x00, 0x18, 0x01, 0x00, 0x07, 0x00, 0x01, 0x00,
+    // Device Name at 0x0003, read
+    0x02, 0x00, 0x2A, 0x03, 0x00, 0x02, 0x03, 0x00, 0x00, 0x00,
+    // Battery, 0x0008 - 0x000C
+    0x02, 0x0F, 0x18, 0x08, 0x00, 0x0C, 0x00, 0x01, 0x00,
+    // Battery Level at 0x000A, read and notify, with its client configuration at 0x000B
+    0x02, 0x19, 0x2A, 0x0A, 0x00, 0x12, 0x0C, 0x00, 0x01, 0x00,
+    0x02, 0x02, 0x29, 0x0B, 0x00
+};
+
+static void Write(const string& fileName, const uint8_t data[], const uint32_t length)
+{
+    Core::File file(fileName);
+    ASSERT_TRUE(file.Create());
+    ASSERT_EQ(file.Write(data, length), length);
+}
+
+TEST(Bluetooth_Profile, restore)
+{
+    const string stored(_T("/tmp/bluetooth_test_gatt"));
+    const string copy(_T("/tmp/bluetooth_test_gatt_copy"));
+
+    Write(stored, Database, sizeof(Database));
+
+    Bluetooth::Profile profile(false);
+
+    EXPECT_EQ(profile.Load(stored), Core::ERROR_NONE);
+    EXPECT_TRUE(profile.IsValid());
+
+    const Bluetooth::Profile::Service* battery = profile[Bluetooth::UUID(Bluetooth::Profile::Service::BatteryService)];
+    ASSERT_NE(battery, nullptr);
+    EXPECT_EQ(battery->Handle(), 0x0008);
+    EXPECT_EQ(battery->Max(), 0x000C);
+
+    const Bluetooth::Profile::Service::Characteristic* level = (*battery)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::BatteryLevel)];
+    ASSERT_NE(level, nullptr);
+    EXPECT_EQ(level->Handle(), 0x000A);
+    EXPECT_EQ(level->Rights(), 0x12);
+
+    const Bluetooth::Profile::Service::Characteristic::Descriptor* configuration = (*level)[Bluetooth::UUID(Bluetooth::Profile::Service::Characteristic::Descriptor::ClientCharacteristicConfiguration)];
+    ASSERT_NE(configuration, nullptr);
+    EXPECT_EQ(configuration->Handle(), 0x000B);
+
+    // Storing it again gives the exact same database.
+    EXPECT_EQ(profile.Save(copy), Core::ERROR_NONE);
+
+    Core::File file(copy);
+    ASSERT_TRUE(file.Open(true));
+    ASSERT_EQ(file.Size(), sizeof(Database));
+
+    uint8_t buffer[sizeof(Database)];
+    EXPECT_EQ(file.Read(buffer, sizeof(buffer)), sizeof(buffer));
+    EXPECT_EQ(::memcmp(buffer, Database, sizeof(Database)), 0);
+
+    Core::File(stored).Destroy();
+    Core::File(copy).Destroy();
+}
+
+TEST(Bluetooth_Profile, corrupted)
+{
+    const string stored(_T("/tmp/bluetooth_test_gatt_corrupted"));
+    Bluetooth::Profile profile(false);
+
+    EXPECT_EQ(profile.Load(stored), Core::ERROR_UNAVAILABLE);
+
+    Write(stored, Database, sizeof(Database) - 1);
+    EXPECT_EQ(profile.Load(stored), Core::ERROR_INVALID_INPUT_LENGTH);
+    EXPECT_FALSE(profile.IsValid());
+
+    uint8_t database[sizeof(Database)];
+    ::memcpy(database, Database, sizeof(database));
+    database[4] = 0x02;
+    Write(stored, database, sizeof(database));
+    EXPECT_EQ(profile.Load(stored), Core::ERROR_INVALID_SIGNATURE);
+
+    Core::File(stored).Destroy();
+}
+
+} // Tests
+} // WPEFramework
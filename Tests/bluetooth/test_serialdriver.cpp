@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/drivers/SerialDriver.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+TEST(Bluetooth_SerialDriver, h4)
+{
+    Bluetooth::H4Framing framing;
+    uint16_t skip = 0;
+
+    // Command complete event, split over two reads, followed by an ACL packet.
+    const uint8_t stream[] = { 0x04, 0x0E, 0x04, 0x01, 0x03, 0x0C, 0x00, 0x02, 0x40, 0x00, 0x02, 0x00, 0xAA, 0xBB };
+
+    EXPECT_EQ(framing.Frame(stream, 2, skip), 0);
+    EXPECT_EQ(framing.Frame(stream, 6, skip), 0);
+    EXPECT_EQ(framing.Frame(stream, sizeof(stream), skip), 7);
+    EXPECT_EQ(skip, 0);
+    EXPECT_EQ(framing.Frame(&stream[7], sizeof(stream) - 7, skip), 7);
+
+    // Line noise before a packet is skipped, byte by byte.
+    const uint8_t noise[] = { 0xFF, 0x04, 0x0E, 0x00 };
+    EXPECT_EQ(framing.Frame(noise, sizeof(noise), skip), 0);
+    EXPECT_EQ(skip, 1);
+    EXPECT_EQ(framing.Frame(&noise[1], sizeof(noise) - 1, skip), 3);
+    EXPECT_EQ(skip, 0);
+}
+
+TEST(Bluetooth_SerialDriver, h5)
+{
+    Bluetooth::H5Framing framing;
+    uint16_t skip = 0;
+
+    const uint8_t stream[] = { 0x12, 0x34, 0xC0, 0xC0, 0x00, 0x2F, 0xDB, 0xDC, 0xC0, 0xC0, 0x01 };
+
+    EXPECT_EQ(framing.Frame(stream, sizeof(stream), skip), 0);
+    EXPECT_EQ(skip, 2);
+    EXPECT_EQ(framing.Frame(&stream[2], sizeof(stream) - 2, skip), 0);
+    EXPECT_EQ(skip, 1);
+    EXPECT_EQ(framing.Frame(&stream[3], sizeof(stream) - 3, skip), 6);
+    EXPECT_EQ(skip, 0);
+    EXPECT_EQ(framing.Frame(&stream[9], sizeof(stream) - 9, skip), 0);
+    EXPECT_EQ(skip, 0);
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <broadcast/broadcast.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A tuner that locks on any frequency, except the ones it is told to reject.
+class FakeTuner : public Broadcast::ITuner {
+public:
+    FakeTuner(const FakeTuner&) = delete;
+    FakeTuner& operator=(const FakeTuner&) = delete;
+
+    FakeTuner()
+        : _lock()
+        , _state(IDLE)
+        , _tuned()
+        , _rejected()
+    {
+    }
+    ~FakeTuner() override = default;
+
+public:
+    void Reject(const uint16_t frequency)
+    {
+        _rejected.push_back(frequency);
+    }
+    void Busy()
+    {
+        _state = LOCKED;
+    }
+    std::vector<uint16_t> Tuned() const
+    {
+        _lock.Lock();
+        std::vector<uint16_t> result(_tuned);
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    uint32_t Properties() const override
+    {
+        return (DVB | Terrestrial);
+    }
+    uint16_t Id() const override
+    {
+        return (0);
+    }
+    state State() const override
+    {
+        return (_state);
+    }
+    uint32_t Tune(const uint16_t frequency, const Broadcast::Modulation, const uint32_t, const uint16_t, const Broadcast::SpectralInversion) override
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+        if (std::find(_rejected.begin(), _rejected.end(), frequency) == _rejected.end()) {
+            _lock.Lock();
+            _tuned.push_back(frequency);
+            _lock.Unlock();
+
+            result = Core::ERROR_NONE;
+        }
+
+        return (result);
+    }
+    uint32_t Prepare(const uint16_t) override
+    {
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Filter(const uint16_t, const uint8_t, Broadcast::ISection*) override
+    {
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Attach(const uint8_t) override
+    {
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Detach(const uint8_t) override
+    {
+        return (Core::ERROR_NONE);
+    }
+
+private:
+    mutable Core::CriticalSection _lock;
+    state _state;
+    std::vector<uint16_t> _tuned;
+    std::vector<uint16_t> _rejected;
+};
+
+class ScanResult : public Broadcast::ScanScheduler::ICallback {
+public:
+    ScanResult(const ScanResult&) = delete;
+    ScanResult& operator=(const ScanResult&) = delete;
+
+    ScanResult()
+        : _lock()
+        , _completed(false, true)
+        , _completions(0)
+        , _scanned()
+        , _failed()
+    {
+    }
+    ~ScanResult() override = default;
+
+public:
+    uint32_t Wait(const uint32_t waitTime)
+    {
+        uint32_t result = _completed.Lock(waitTime);
+        _completed.ResetEvent();
+
+        return (result);
+    }
+    uint32_t Completions() const
+    {
+        return (_completions);
+    }
+    std::map<Broadcast::ITuner*, std::vector<uint16_t>> Scanned() const
+    {
+        _lock.Lock();
+        std::map<Broadcast::ITuner*, std::vector<uint16_t>> result(_scanned);
+        _lock.Unlock();
+
+        return (result);
+    }
+    std::vector<uint16_t> Failed() const
+    {
+        _lock.Lock();
+        std::vector<uint16_t> result(_failed);
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    void Scanned(Broadcast::ITuner* tuner, const uint16_t frequency) override
+    {
+        _lock.Lock();
+        _scanned[tuner].push_back(frequency);
+        _lock.Unlock();
+    }
+    void Failed(Broadcast::ITuner*, const uint16_t frequency) override
+    {
+        _lock.Lock();
+        _failed.push_back(frequency);
+        _lock.Unlock();
+    }
+    void Completed() override
+    {
+        _completions++;
+        _completed.SetEvent();
+    }
+
+private:
+    mutable Core::CriticalSection _lock;
+    Core::Event _completed;
+    std::atomic<uint32_t> _completions;
+    std::map<Broadcast::ITuner*, std::vector<uint16_t>> _scanned;
+    std::vector<uint16_t> _failed;
+};
+
+static Broadcast::ScanScheduler::Transponder Transponder(const uint16_t frequency)
+{
+    return (Broadcast::ScanScheduler::Transponder(frequency, Broadcast::QAM64, 8000000, Broadcast::FEC_1_2, Broadcast::Auto));
+}
+
+TEST(Broadcast_ScanScheduler, empty)
+{
+    FakeTuner tuner;
+    ScanResult result;
+    Broadcast::ScanScheduler scheduler(100, &result);
+
+    // Nothing to scan, the scan completes right away and a next one can be started.
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_NONE);
+    EXPECT_EQ(result.Wait(0), Core::ERROR_NONE);
+    EXPECT_EQ(result.Completions(), 1u);
+    EXPECT_FALSE(scheduler.IsScanning());
+    EXPECT_TRUE(tuner.Tuned().empty());
+
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_NONE);
+    EXPECT_EQ(result.Completions(), 2u);
+
+    // Without an idle tuner, there is nothing to scan with.
+    tuner.Busy();
+    scheduler.Add(Transponder(474));
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_UNAVAILABLE);
+    EXPECT_FALSE(scheduler.IsScanning());
+}
+
+TEST(Broadcast_ScanScheduler, singleTuner)
+{
+    FakeTuner tuner;
+    ScanResult result;
+    Broadcast::ScanScheduler scheduler(20, &result);
+
+    scheduler.Add(Transponder(474));
+    scheduler.Add(Transponder(482));
+    scheduler.Add(Transponder(618));
+    scheduler.Add(Transponder(706));
+
+    // A transponder that does not lock is skipped, the others are still scanned.
+    tuner.Reject(618);
+
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_NONE);
+    EXPECT_TRUE(scheduler.IsScanning());
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_INPROGRESS);
+
+    ASSERT_EQ(result.Wait(2000), Core::ERROR_NONE);
+    EXPECT_EQ(result.Completions(), 1u);
+    EXPECT_FALSE(scheduler.IsScanning());
+
+    EXPECT_EQ(tuner.Tuned(), std::vector<uint16_t>({ 474, 482, 706 }));
+    EXPECT_EQ(result.Scanned()[&tuner], std::vector<uint16_t>({ 474, 482, 706 }));
+    EXPECT_EQ(result.Failed(), std::vector<uint16_t>({ 618 }));
+
+    // Only the last transponder fails, the scan still completes.
+    scheduler.Add(Transponder(474));
+    scheduler.Add(Transponder(618));
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_NONE);
+    ASSERT_EQ(result.Wait(2000), Core::ERROR_NONE);
+    EXPECT_EQ(result.Completions(), 2u);
+    EXPECT_FALSE(scheduler.IsScanning());
+}
+
+TEST(Broadcast_ScanScheduler, multipleTuners)
+{
+    FakeTuner first;
+    FakeTuner second;
+    FakeTuner busy;
+    ScanResult result;
+    Broadcast::ScanScheduler scheduler(100, &result);
+
+    busy.Busy();
+
+    scheduler.Add(Transponder(474));
+    scheduler.Add(Transponder(482));
+    scheduler.Add(Transponder(618));
+    scheduler.Add(Transponder(706));
+
+    EXPECT_EQ(scheduler.Start({ &first, &second, &busy }), Core::ERROR_NONE);
+
+    // Both idle tuners are on a transponder at the same time.
+    EXPECT_EQ(first.Tuned(), std::vector<uint16_t>({ 474 }));
+    EXPECT_EQ(second.Tuned(), std::vector<uint16_t>({ 482 }));
+
+    ASSERT_EQ(result.Wait(2000), Core::ERROR_NONE);
+    EXPECT_EQ(result.Completions(), 1u);
+
+    // Every transponder is scanned once, the tuners split the work, the busy one is left alone.
+    std::map<Broadcast::ITuner*, std::vector<uint16_t>> scanned(result.Scanned());
+    EXPECT_EQ(scanned[&first].size(), 2u);
+    EXPECT_EQ(scanned[&second].size(), 2u);
+    EXPECT_TRUE(busy.Tuned().empty());
+
+    std::vector<uint16_t> all(scanned[&first]);
+    all.insert(all.end(), scanned[&second].begin(), scanned[&second].end());
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(all, std::vector<uint16_t>({ 474, 482, 618, 706 }));
+}
+
+TEST(Broadcast_ScanScheduler, collected)
+{
+    FakeTuner tuner;
+    ScanResult result;
+
+    // A dwell time that would never end within the test, the tables are reported complete instead.
+    Broadcast::ScanScheduler scheduler(60000, &result);
+
+    scheduler.Add(Transponder(474));
+    scheduler.Add(Transponder(482));
+
+    EXPECT_EQ(scheduler.Start({ &tuner }), Core::ERROR_NONE);
+
+    scheduler.Collected(&tuner);
+    while (tuner.Tuned().size() < 2) {
+        SleepMs(5);
+    }
+    EXPECT_EQ(result.Scanned()[&tuner], std::vector<uint16_t>({ 474 }));
+
+    scheduler.Collected(&tuner);
+    ASSERT_EQ(result.Wait(2000), Core::ERROR_NONE);
+    EXPECT_EQ(result.Scanned()[&tuner], std::vector<uint16_t>({ 474, 482 }));
+
+    // Once done, there is nothing to collect anymore.
+    scheduler.Collected(&tuner);
+    EXPECT_EQ(result.Completions(), 1u);
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <broadcast/broadcast.h>
+#include <broadcast/TunerAdministrator.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A long form section as it is found in a transport stream: header, payload and CRC.
+class RawSection {
+public:
+    RawSection() = delete;
+    RawSection(const RawSection&) = delete;
+    RawSection& operator=(const RawSection&) = delete;
+
+    RawSection(const uint8_t tableId, const uint16_t extension, const uint8_t version, const uint8_t number, const uint8_t last, const string& payload)
+        : _length(static_cast<uint16_t>(8 + payload.length() + 4))
+    {
+        const uint16_t sectionLength = _length - 3;
+
+        _buffer[0] = tableId;
+        _buffer[1] = 0xB0 | ((sectionLength >> 8) & 0x0F);
+        _buffer[2] = (sectionLength & 0xFF);
+        _buffer[3] = (extension >> 8);
+        _buffer[4] = (extension & 0xFF);
+        _buffer[5] = 0xC1 | ((version & 0x1F) << 1);
+        _buffer[6] = number;
+        _buffer[7] = last;
+        ::memcpy(&(_buffer[8]), payload.c_str(), payload.length());
+
+        const uint32_t crc = Core::DataElement(_length - 4, _buffer).CRC32(0, _length - 4);
+        _buffer[_length - 4] = (crc >> 24) & 0xFF;
+        _buffer[_length - 3] = (crc >> 16) & 0xFF;
+        _buffer[_length - 2] = (crc >> 8) & 0xFF;
+        _buffer[_length - 1] = crc & 0xFF;
+    }
+    ~RawSection() = default;
+
+public:
+    Broadcast::MPEG::Section Section()
+    {
+        return (Broadcast::MPEG::Section(Core::DataElement(_length, _buffer)));
+    }
+
+private:
+    uint16_t _length;
+    uint8_t _buffer[64];
+};
+
+// A consumer like the SDT/NIT parsers, every extension of the table is reassembled on its own.
+class TableCollector : public Broadcast::ISection {
+public:
+    TableCollector(const TableCollector&) = delete;
+    TableCollector& operator=(const TableCollector&) = delete;
+
+    TableCollector()
+        : _tables()
+        , _received(0)
+    {
+    }
+    ~TableCollector() override = default;
+
+public:
+    void Handle(const Broadcast::MPEG::Section& section) override
+    {
+        _received++;
+
+        std::map<uint16_t, Broadcast::MPEG::Table>::iterator index(_tables.find(section.Extension()));
+
+        if (index == _tables.end()) {
+            index = _tables.emplace(std::piecewise_construct,
+                               std::forward_as_tuple(section.Extension()),
+                               std::forward_as_tuple(Core::ProxyType<Core::DataStore>::Create(512)))
+                        .first;
+        }
+
+        EXPECT_TRUE(index->second.AddSection(section));
+    }
+    uint32_t Received() const
+    {
+        return (_received);
+    }
+    bool IsValid(const uint16_t extension) const
+    {
+        std::map<uint16_t, Broadcast::MPEG::Table>::const_iterator index(_tables.find(extension));
+        return ((index != _tables.end()) && (index->second.IsValid() == true));
+    }
+    string Data(const uint16_t extension) const
+    {
+        const Core::DataElement& data(_tables.find(extension)->second.Data());
+        return (string(reinterpret_cast<const char*>(data.Buffer()), static_cast<size_t>(data.Size())));
+    }
+
+private:
+    std::map<uint16_t, Broadcast::MPEG::Table> _tables;
+    uint32_t _received;
+};
+
+TEST(Broadcast_SectionFilter, interleavedExtensions)
+{
+    // Two extensions of the same table (e.g. the SDT of two other transport streams), their sections
+    // interleaved and repeated, as they are found in a multiplex.
+    RawSection a0(0x46, 0x0001, 3, 0, 2, _T("AA"));
+    RawSection a1(0x46, 0x0001, 3, 1, 2, _T("BB"));
+    RawSection a2(0x46, 0x0001, 3, 2, 2, _T("CC"));
+    RawSection b0(0x46, 0x0002, 7, 0, 1, _T("xx"));
+    RawSection b1(0x46, 0x0002, 7, 1, 1, _T("yy"));
+
+    RawSection* cycle[] = { &a0, &b0, &a1, &b1, &a2 };
+
+    TableCollector collector;
+    Broadcast::TunerAdministrator::SectionFilter filter;
+    filter.Callback(&collector);
+
+    for (uint8_t round = 0; round < 3; round++) {
+        for (RawSection* section : cycle) {
+            filter.Handle(section->Section());
+        }
+    }
+
+    // Every section is offered once, the repetitions are dropped and both tables are complete.
+    EXPECT_EQ(collector.Received(), 5u);
+    EXPECT_EQ(filter.Dropped(), 10u);
+    EXPECT_TRUE(collector.IsValid(0x0001));
+    EXPECT_TRUE(collector.IsValid(0x0002));
+    EXPECT_EQ(collector.Data(0x0001), _T("AABBCC"));
+    EXPECT_EQ(collector.Data(0x0002), _T("xxyy"));
+
+    // A new version of one extension is offered again, the other one is still dropped.
+    RawSection b0v8(0x46, 0x0002, 8, 0, 1, _T("XX"));
+    RawSection b1v8(0x46, 0x0002, 8, 1, 1, _T("YY"));
+
+    filter.Handle(b0v8.Section());
+    filter.Handle(a0.Section());
+    filter.Handle(b1v8.Section());
+
+    EXPECT_EQ(collector.Received(), 7u);
+    EXPECT_EQ(filter.Dropped(), 11u);
+    EXPECT_TRUE(collector.IsValid(0x0002));
+    EXPECT_EQ(collector.Data(0x0002), _T("XXYY"));
+
+    filter.Callback(nullptr);
+}
+
+TEST(Broadcast_SectionFilter, otherMultiplex)
+{
+    // EIT other: the same service_id in two transport streams, telling them apart takes the
+    // transport_stream_id and original_network_id at the start of the payload.
+    RawSection eitA(0x4F, 0x0101, 1, 0, 0, string("\x00\x01\x20\x85" "AA", 6));
+    RawSection eitB(0x4F, 0x0101, 1, 0, 0, string("\x00\x02\x20\x85" "BB", 6));
+    RawSection eitC(0x4F, 0x0101, 1, 0, 0, string("\x00\x01\x20\x86" "CC", 6));
+
+    // SDT other: the same transport_stream_id in two original networks.
+    RawSection sdtA(0x46, 0x0001, 4, 0, 0, string("\x20\x85\xFF" "aa", 5));
+    RawSection sdtB(0x46, 0x0001, 4, 0, 0, string("\x20\x86\xFF" "bb", 5));
+
+    // The NIT has no such fields, the payload does not matter.
+    RawSection nitA(0x41, 0x3001, 2, 0, 0, _T("xxxx"));
+    RawSection nitB(0x41, 0x3001, 2, 0, 0, _T("yyyy"));
+
+    RawSection* cycle[] = { &eitA, &sdtA, &eitB, &nitA, &sdtB, &eitC, &nitB };
+
+    TableCollector collector;
+    Broadcast::TunerAdministrator::SectionFilter filter;
+    filter.Callback(&collector);
+
+    for (uint8_t round = 0; round < 3; round++) {
+        for (RawSection* section : cycle) {
+            filter.Handle(section->Section());
+        }
+    }
+
+    // Every EIT and SDT once, the second NIT section is a repetition of the first one.
+    EXPECT_EQ(collector.Received(), 6u);
+    EXPECT_EQ(filter.Dropped(), 15u);
+
+    filter.Callback(nullptr);
+}
+
+TEST(Broadcast_SectionFilter, tableExtension)
+{
+    RawSection a0(0x46, 0x0001, 3, 0, 1, _T("AA"));
+    RawSection b0(0x46, 0x0002, 3, 0, 1, _T("xx"));
+    RawSection b1(0x46, 0x0002, 3, 1, 1, _T("yy"));
+
+    Broadcast::MPEG::Table table(Core::ProxyType<Core::DataStore>::Create(512));
+
+    // A section of another extension, even with the same version, is not part of the table so far.
+    EXPECT_TRUE(table.AddSection(a0.Section()));
+    EXPECT_TRUE(table.AddSection(b0.Section()));
+    EXPECT_FALSE(table.IsValid());
+    EXPECT_EQ(table.Extension(), 0x0002);
+
+    EXPECT_TRUE(table.AddSection(b1.Section()));
+    EXPECT_TRUE(table.IsValid());
+    EXPECT_EQ(string(reinterpret_cast<const char*>(table.Data().Buffer()), static_cast<size_t>(table.Data().Size())), _T("xxyy"));
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+class RequestData : public Core::JSON::Container {
+public:
+    RequestData(const RequestData&) = delete;
+    RequestData& operator=(const RequestData&) = delete;
+
+    RequestData()
+        : Core::JSON::Container()
+        , Value(0)
+        , Name()
+    {
+        Add(_T("value"), &Value);
+        Add(_T("name"), &Name);
+    }
+    ~RequestData() = default;
+
+public:
+    Core::JSON::DecUInt32 Value;
+    Core::JSON::String Name;
+};
+
+TEST(Core_BlockCache, reuse)
+{
+    // A released block is handed out again to the next request of the same size class.
+    void* first = Core::BlockCache::Allocate(24);
+    Core::BlockCache::Free(first, 24);
+    void* second = Core::BlockCache::Allocate(30);
+    EXPECT_EQ(first, second);
+    Core::BlockCache::Free(second, 30);
+
+    // Large blocks go straight to the heap.
+    void* large = Core::BlockCache::Allocate(4096);
+    EXPECT_NE(large, nullptr);
+    Core::BlockCache::Free(large, 4096);
+
+    // Released on another thread, it is kept by that thread.
+    void* migrating = Core::BlockCache::Allocate(100);
+    std::thread other([migrating]() {
+        Core::BlockCache::Free(migrating, 100);
+        EXPECT_EQ(Core::BlockCache::Allocate(100), migrating);
+        Core::BlockCache::Free(migrating, 100);
+    });
+    other.join();
+}
+
+TEST(Core_BlockCache, statistics)
+{
+    Core::BlockCache::Statistics before;
+    Core::BlockCache::Statistics after;
+
+    Core::BlockCache::Measure(before);
+
+    // The first block of a class on a fresh thread comes from the heap, once released it is kept and
+    // served again. Large blocks are never kept.
+    std::thread other([&before, &after]() {
+        Core::BlockCache::Measure(before);
+
+        void* block = Core::BlockCache::Allocate(200);
+        Core::BlockCache::Free(block, 200);
+        block = Core::BlockCache::Allocate(200);
+        Core::BlockCache::Free(block, 200);
+
+        void* large = Core::BlockCache::Allocate(4096);
+        Core::BlockCache::Free(large, 4096);
+
+        Core::BlockCache::Measure(after);
+    });
+    other.join();
+
+    EXPECT_EQ(before.Cached, 0u);
+    EXPECT_EQ(before.Heap, 0u);
+    EXPECT_EQ(before.Kept, 0u);
+    EXPECT_EQ(after.Cached, 1u);
+    EXPECT_EQ(after.Heap, 2u);
+    EXPECT_EQ(after.Kept, 2u);
+}
+
+TEST(Core_BlockCache, string)
+{
+    Core::BlockCache::Statistics before;
+    Core::BlockCache::Statistics after;
+
+    // A value beyond the small string buffer takes a block, released again when the string goes.
+    {
+        Core::JSON::String value;
+        value = _T("a value that does not fit the small string buffer");
+    }
+
+    Core::BlockCache::Measure(before);
+
+    {
+        Core::JSON::String value;
+        value = _T("a value that does not fit the small string buffer");
+        EXPECT_EQ(value.Value(), _T("a value that does not fit the small string buffer"));
+    }
+
+    Core::BlockCache::Measure(after);
+
+    EXPECT_EQ(after.Heap, before.Heap);
+    EXPECT_GT(after.Cached, before.Cached);
+    EXPECT_EQ(after.Kept - before.Kept, after.Cached - before.Cached);
+}
+
+// Building, parsing and serializing a per request parameter object, as the JSON-RPC handlers do, in
+// steady state takes all its blocks from the ones released by the previous request.
+TEST(Core_BlockCache, request)
+{
+    const uint32_t rounds = 1000;
+    const string parameters(_T("{\"value\":12,\"name\":\"a name that is too long for the small string buffer\"}"));
+    string response;
+
+    Core::BlockCache::Statistics before;
+    Core::BlockCache::Statistics after;
+
+    for (uint32_t round = 0; round <= rounds; round++) {
+        if (round == 1) {
+            Core::BlockCache::Measure(before);
+        }
+
+        RequestData data;
+        data.FromString(parameters);
+        data.Value = data.Value.Value() + 1;
+        data.ToString(response);
+    }
+
+    Core::BlockCache::Measure(after);
+
+    EXPECT_EQ(response, _T("{\"value\":13,\"name\":\"a name that is too long for the small string buffer\"}"));
+
+    EXPECT_EQ(after.Heap, before.Heap);
+    EXPECT_GE(after.Cached - before.Cached, rounds * 3);
+    EXPECT_EQ(after.Kept - before.Kept, after.Cached - before.Cached);
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
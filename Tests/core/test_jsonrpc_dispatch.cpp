@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+class DispatchTarget {
+public:
+    class Data : public Core::JSON::Container {
+    public:
+        Data(const Data&) = delete;
+        Data& operator=(const Data&) = delete;
+
+        Data()
+            : Core::JSON::Container()
+            , Value(0)
+        {
+            Add(_T("value"), &Value);
+        }
+        ~Data() = default;
+
+    public:
+        Core::JSON::DecUInt32 Value;
+    };
+
+public:
+    DispatchTarget(const DispatchTarget&) = delete;
+    DispatchTarget& operator=(const DispatchTarget&) = delete;
+
+    DispatchTarget()
+        : _calls(0)
+        , _value(0)
+    {
+    }
+    ~DispatchTarget() = default;
+
+public:
+    uint32_t Ping()
+    {
+        _calls++;
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Set(const Data& data)
+    {
+        _calls++;
+        _value = data.Value.Value();
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Get(Data& data)
+    {
+        _calls++;
+        data.Value = _value;
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Calls() const
+    {
+        return (_calls);
+    }
+
+private:
+    uint32_t _calls;
+    uint32_t _value;
+};
+
+// Every form of a designator reaches the registered method, for a handler with 64 methods.
+TEST(Core_JSONRPC, dispatch)
+{
+    const uint32_t rounds = 16;
+
+    DispatchTarget target;
+    Core::JSONRPC::Handler handler([](const uint32_t, const string&, const string&) {}, { 1 });
+
+    for (uint32_t index = 0; index < 60; index++) {
+        handler.Register<void, void>(_T("method") + Core::NumberType<uint32_t>(index).Text(), &DispatchTarget::Ping, &target);
+    }
+    handler.Register<void, void>(_T("ping"), &DispatchTarget::Ping, &target);
+    handler.Register<DispatchTarget::Data, void>(_T("set"), &DispatchTarget::Set, &target);
+    handler.Register<void, DispatchTarget::Data>(_T("get"), &DispatchTarget::Get, &target);
+    handler.Register<void, void>(_T("zzz"), &DispatchTarget::Ping, &target);
+    handler.Register<void, void>(_T("interfacestatistics"), &DispatchTarget::Ping, &target);
+
+    EXPECT_EQ(handler.Exists(_T("ping")), Core::ERROR_NONE);
+    EXPECT_EQ(handler.Exists(_T("pin")), Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(handler.Exists(_T("pingpong")), Core::ERROR_UNKNOWN_KEY);
+
+    const string designators[] = { _T("Test.1.ping"), _T("Test.1.method42"), _T("Test.1.zzz"), _T("Test.1.ping@3"), _T("Test.1.interfacestatistics") };
+    string response;
+
+    for (const string& designator : designators) {
+        const string method(Core::JSONRPC::Message::FullMethod(designator));
+        const uint32_t before = target.Calls();
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, round), method, EMPTY_STRING, response), Core::ERROR_NONE) << designator;
+        }
+
+        EXPECT_EQ(target.Calls() - before, rounds) << designator;
+    }
+
+    // Unregistered names, even when sharing a prefix with a registered one, reach nothing.
+    const uint32_t before = target.Calls();
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("pin"), EMPTY_STRING, response), Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("method60"), EMPTY_STRING, response), Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("method420"), EMPTY_STRING, response), Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(target.Calls(), before);
+
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("set"), _T("{\"value\":42}"), response), Core::ERROR_NONE);
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("get"), EMPTY_STRING, response), Core::ERROR_NONE);
+    EXPECT_EQ(response, _T("{\"value\":42}"));
+    EXPECT_EQ(handler.Invoke(Core::JSONRPC::Connection(1, 1), _T("unknown"), EMPTY_STRING, response), Core::ERROR_UNKNOWN_KEY);
+
+    handler.Unregister(_T("ping"));
+    EXPECT_EQ(handler.Exists(_T("ping")), Core::ERROR_UNKNOWN_KEY);
+    EXPECT_EQ(handler.Exists(_T("set")), Core::ERROR_NONE);
+}
+
+TEST(Core_JSONRPC, designator)
+{
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Controller.1.status")), 1);
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Test.12.ping@3")), 12);
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("status")), static_cast<uint8_t>(~0));
+
+    // The version ends at the first non digit, a segment without digits is no version.
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Controller.status")), 0);
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("a.b.c@x")), 0);
+    EXPECT_EQ(Core::JSONRPC::Message::Version(_T("Controller.1a.status")), 0);
+
+    EXPECT_EQ(Core::JSONRPC::Message::Callsign(_T("Controller.1.status@eth0")), _T("Controller"));
+    EXPECT_EQ(Core::JSONRPC::Message::Method(_T("Controller.1.status@eth0")), _T("status"));
+    EXPECT_EQ(Core::JSONRPC::Message::Index(_T("Controller.1.status@eth0")), _T("eth0"));
+}
+
+} // Tests
+} // WPEFramework
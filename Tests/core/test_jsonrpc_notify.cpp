@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// Subscribes the given number of channels to an event, half of them through a designator, and checks
+// that a notification reaches all of them with a single call per designator.
+static void FanOut(const uint32_t subscribers)
+{
+    const uint32_t rounds = 100;
+    const string parameters(_T("{\"state\":\"activated\",\"callsign\":\"Controller\"}"));
+
+    uint32_t calls = 0;
+    uint32_t delivered = 0;
+    std::map<string, uint32_t> methods;
+
+    Core::JSONRPC::Handler handler(
+        Core::JSONRPC::Handler::BatchNotificationFunction([&](const std::vector<uint32_t>& ids, const string& designator, const string& data) {
+            Core::ProxyType<Core::JSONRPC::Notification> notification(Core::ProxyType<Core::JSONRPC::Notification>::Create(designator, data));
+
+            EXPECT_TRUE(notification->IsStreamable());
+
+            calls++;
+            delivered += static_cast<uint32_t>(ids.size());
+            methods[designator] += static_cast<uint32_t>(ids.size());
+        }),
+        { 1 });
+
+    for (uint32_t index = 0; index < subscribers; index++) {
+        Core::JSONRPC::Message response;
+
+        handler.Subscribe(index + 1, _T("statechange"), ((index & 1) == 0 ? string() : string(_T("client.events"))), response);
+        EXPECT_EQ(response.Result.Value(), _T("0"));
+    }
+
+    for (uint32_t round = 0; round < rounds; round++) {
+        EXPECT_EQ(handler.Notify(_T("statechange"), Core::JSON::String(parameters)), Core::ERROR_NONE);
+    }
+
+    // One batch per designator, every subscriber gets every notification.
+    EXPECT_EQ(calls, rounds * (subscribers > 1 ? 2 : 1));
+    EXPECT_EQ(delivered, rounds * subscribers);
+    EXPECT_EQ(methods[_T("statechange")], rounds * ((subscribers + 1) / 2));
+    EXPECT_EQ(methods[_T("client.events.statechange")], rounds * (subscribers / 2));
+
+    // A closed channel no longer receives anything.
+    handler.Close(1);
+    delivered = 0;
+    handler.Notify(_T("statechange"));
+    EXPECT_EQ(delivered, subscribers - 1);
+}
+
+TEST(Core_JSONRPC, notification)
+{
+    Core::JSONRPC::Notification notification(_T("client.events.statechange"), _T("{\"state\":1}"));
+    string text;
+    char buffer[8];
+    uint16_t offset = 0;
+
+    // Streamed in small chunks, the element itself is not changed, the position is the offset.
+    do {
+        uint16_t loaded = notification.Serialize(buffer, sizeof(buffer), offset);
+        text.append(buffer, loaded);
+    } while (offset != 0);
+
+    EXPECT_EQ(text, notification.Text());
+    EXPECT_NE(text.find(_T("\"method\":\"client.events.statechange\"")), string::npos);
+    EXPECT_NE(text.find(_T("\"params\":{\"state\":1}")), string::npos);
+}
+
+TEST(Core_JSONRPC, fanout)
+{
+    FanOut(1);
+    FanOut(10);
+    FanOut(100);
+    FanOut(1000);
+}
+
+} // Tests
+} // WPEFramework
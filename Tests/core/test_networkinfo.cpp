@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// Plays the kernel side of the rtnetlink socket: builds the datagrams the kernel multicasts when
+// adapters and addresses come and go.
+class FakeNetlink {
+public:
+    FakeNetlink(const FakeNetlink&) = delete;
+    FakeNetlink& operator=(const FakeNetlink&) = delete;
+
+    FakeNetlink()
+        : _length(0)
+    {
+        ::memset(_buffer, 0, sizeof(_buffer));
+    }
+    ~FakeNetlink() = default;
+
+public:
+    void Link(const bool add, const uint32_t index, const string& name, const uint8_t mac[6])
+    {
+        struct nlmsghdr* header = Start(add ? RTM_NEWLINK : RTM_DELLINK);
+        struct ifinfomsg* info = reinterpret_cast<struct ifinfomsg*>(NLMSG_DATA(header));
+
+        info->ifi_family = AF_UNSPEC;
+        info->ifi_index = index;
+        header->nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+
+        Attribute(header, IFLA_IFNAME, name.c_str(), static_cast<uint16_t>(name.length() + 1));
+        Attribute(header, IFLA_ADDRESS, mac, 6);
+
+        _length += NLMSG_ALIGN(header->nlmsg_len);
+    }
+    void Address(const bool add, const uint32_t index, const string& address, const uint8_t prefix)
+    {
+        struct nlmsghdr* header = Start(add ? RTM_NEWADDR : RTM_DELADDR);
+        struct ifaddrmsg* info = reinterpret_cast<struct ifaddrmsg*>(NLMSG_DATA(header));
+        uint8_t raw[16];
+        const bool ipv6 = (address.find(':') != string::npos);
+
+        ::inet_pton(ipv6 ? AF_INET6 : AF_INET, address.c_str(), raw);
+
+        info->ifa_family = (ipv6 ? AF_INET6 : AF_INET);
+        info->ifa_prefixlen = prefix;
+        info->ifa_index = index;
+        header->nlmsg_len = NLMSG_LENGTH(sizeof(struct ifaddrmsg));
+
+        Attribute(header, (ipv6 ? IFA_ADDRESS : IFA_LOCAL), raw, (ipv6 ? 16 : 4));
+
+        _length += NLMSG_ALIGN(header->nlmsg_len);
+    }
+    void Send()
+    {
+        Core::AdapterIterator::Ingest(_buffer, _length);
+        ::memset(_buffer, 0, sizeof(_buffer));
+        _length = 0;
+    }
+
+private:
+    struct nlmsghdr* Start(const uint16_t type)
+    {
+        struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(&(_buffer[_length]));
+        header->nlmsg_type = type;
+        header->nlmsg_flags = 0;
+        header->nlmsg_seq = 0;
+        header->nlmsg_pid = 0;
+        return (header);
+    }
+    void Attribute(struct nlmsghdr* header, const uint16_t type, const void* data, const uint16_t length)
+    {
+        struct rtattr* attribute = reinterpret_cast<struct rtattr*>(reinterpret_cast<uint8_t*>(header) + NLMSG_ALIGN(header->nlmsg_len));
+        attribute->rta_type = type;
+        attribute->rta_len = RTA_LENGTH(length);
+        ::memcpy(RTA_DATA(attribute), data, length);
+        header->nlmsg_len = NLMSG_ALIGN(header->nlmsg_len) + RTA_ALIGN(attribute->rta_len);
+    }
+
+private:
+    uint16_t _length;
+    uint8_t _buffer[1024];
+};
+
+static const uint32_t FakeIndex = 4242;
+static const uint8_t FakeMAC[] = { 0x02, 0x00, 0x5E, 0x10, 0x20, 0x30 };
+
+TEST(Core_NetworkInfo, incremental)
+{
+    FakeNetlink kernel;
+    const uint16_t adapters = Core::AdapterIterator().Count();
+    uint32_t version = Core::AdapterIterator::Version();
+
+    // A new adapter shows up, without reloading anything.
+    kernel.Link(true, FakeIndex, _T("fake0"), FakeMAC);
+    kernel.Send();
+
+    EXPECT_NE(Core::AdapterIterator::Version(), version);
+    version = Core::AdapterIterator::Version();
+
+    Core::AdapterIterator adapter(_T("fake0"));
+    ASSERT_TRUE(adapter.IsValid());
+    EXPECT_EQ(adapter.Count(), adapters + 1);
+    EXPECT_EQ(adapter.MACAddress(':'), _T("02:00:5E:10:20:30"));
+    EXPECT_EQ(adapter.IPV4Addresses().Count(), 0);
+
+    // It gets an address, reported twice as the kernel does when the lifetime changes.
+    kernel.Address(true, FakeIndex, _T("192.168.42.7"), 24);
+    kernel.Address(true, FakeIndex, _T("192.168.42.7"), 24);
+    kernel.Send();
+
+    EXPECT_NE(Core::AdapterIterator::Version(), version);
+
+    Core::IPV4AddressIterator ipv4(adapter.IPV4Addresses());
+    ASSERT_EQ(ipv4.Count(), 1);
+    ASSERT_TRUE(ipv4.Next());
+    EXPECT_EQ(ipv4.Address().HostAddress(), _T("192.168.42.7"));
+    EXPECT_EQ(ipv4.Address().Mask(), 24);
+
+    // An IPv6 address comes, the IPv4 address goes, in a single datagram.
+    kernel.Address(true, FakeIndex, _T("fd00::7"), 64);
+    kernel.Address(false, FakeIndex, _T("192.168.42.7"), 24);
+    kernel.Send();
+
+    EXPECT_EQ(adapter.IPV4Addresses().Count(), 0);
+    EXPECT_EQ(adapter.IPV6Addresses().Count(), 1);
+
+    // The iterator taken before the change does not hand out the removed address.
+    EXPECT_FALSE(ipv4.Address().IsValid());
+
+    // Addresses of adapters that are unknown are not applied.
+    version = Core::AdapterIterator::Version();
+    kernel.Address(true, FakeIndex + 1, _T("192.168.43.7"), 24);
+    kernel.Send();
+    EXPECT_EQ(Core::AdapterIterator::Version(), version);
+
+    // And the adapter goes away again.
+    kernel.Link(false, FakeIndex, _T("fake0"), FakeMAC);
+    kernel.Send();
+
+    EXPECT_NE(Core::AdapterIterator::Version(), version);
+    EXPECT_EQ(Core::AdapterIterator().Count(), adapters);
+    EXPECT_FALSE(Core::AdapterIterator(_T("fake0")).IsValid());
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <sys/wait.h>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+class ExitSink : public Core::ProcessObserver::ICallback {
+public:
+    ExitSink(const ExitSink&) = delete;
+    ExitSink& operator=(const ExitSink&) = delete;
+
+    ExitSink()
+        : _exited(false, true)
+        , _pid(0)
+        , _count(0)
+    {
+    }
+    ~ExitSink() override = default;
+
+public:
+    void Exited(const uint32_t pid) override
+    {
+        _pid = pid;
+        _count++;
+        _exited.SetEvent();
+    }
+    uint32_t Wait(const uint32_t waitTime)
+    {
+        return (_exited.Lock(waitTime));
+    }
+    uint32_t Pid() const
+    {
+        return (_pid);
+    }
+    uint32_t Count() const
+    {
+        return (_count);
+    }
+
+private:
+    Core::Event _exited;
+    std::atomic<uint32_t> _pid;
+    std::atomic<uint32_t> _count;
+};
+
+static void Interrupted(int)
+{
+}
+
+TEST(Core_ProcessObserver, waitInterrupted)
+{
+    struct sigaction action;
+    struct sigaction previous;
+
+    // Without SA_RESTART, the signal breaks a pending poll() with EINTR.
+    ::memset(&action, 0, sizeof(action));
+    action.sa_handler = Interrupted;
+    ::sigemptyset(&action.sa_mask);
+    ASSERT_EQ(::sigaction(SIGUSR1, &action, &previous), 0);
+
+    pid_t child = ::fork();
+
+    if (child == 0) {
+        ::usleep(300000);
+        ::_exit(0);
+    }
+
+    ASSERT_GT(child, 0);
+
+    const pthread_t waiter = ::pthread_self();
+    std::thread signaller([waiter]() {
+        ::usleep(100000);
+        ::pthread_kill(waiter, SIGUSR1);
+    });
+
+    Core::Process process(static_cast<uint32_t>(child));
+
+    // The signal does not end the wait, only the exit of the process does.
+    EXPECT_EQ(process.WaitProcessCompleted(5000), Core::ERROR_NONE);
+    EXPECT_FALSE(process.IsActive());
+
+    signaller.join();
+
+    ::waitpid(child, nullptr, WNOHANG);
+    ::sigaction(SIGUSR1, &previous, nullptr);
+}
+
+TEST(Core_ProcessObserver, exit)
+{
+    ExitSink sink;
+    Core::ProcessObserver observer(&sink);
+
+    pid_t child = ::fork();
+
+    if (child == 0) {
+        ::usleep(200000);
+        ::_exit(0);
+    }
+
+    ASSERT_GT(child, 0);
+
+    uint32_t result = observer.Open(static_cast<uint32_t>(child));
+
+    if (result == Core::ERROR_UNAVAILABLE) {
+        // No pidfd on this kernel, the owner of the observer falls back to polling.
+        printf("No pidfd support, process exits can not be observed.\n");
+        ::waitpid(child, nullptr, 0);
+    } else {
+        EXPECT_EQ(result, Core::ERROR_NONE);
+        EXPECT_FALSE(observer.HasExited());
+
+        // The exit is reported without waiting for (or reaping) the child.
+        EXPECT_EQ(sink.Wait(2000), Core::ERROR_NONE);
+        EXPECT_EQ(sink.Pid(), static_cast<uint32_t>(child));
+        EXPECT_TRUE(observer.HasExited());
+
+        int status = -1;
+        EXPECT_EQ(::waitpid(child, &status, 0), child);
+        EXPECT_TRUE(WIFEXITED(status));
+
+        observer.Close();
+
+        // Reported exactly once.
+        EXPECT_EQ(sink.Count(), 1u);
+
+        // Once reaped, there is nothing left to observe.
+        EXPECT_EQ(observer.Open(static_cast<uint32_t>(child)), Core::ERROR_PROCESS_TERMINATED);
+    }
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+class PoolElement {
+public:
+    PoolElement(const PoolElement&) = delete;
+    PoolElement& operator=(const PoolElement&) = delete;
+
+    PoolElement()
+        : _value(0)
+    {
+    }
+    ~PoolElement() = default;
+
+public:
+    void Clear()
+    {
+        _value = 0;
+    }
+    uint32_t Value() const
+    {
+        return (_value);
+    }
+    void Value(const uint32_t value)
+    {
+        _value = value;
+    }
+
+private:
+    uint32_t _value;
+};
+
+// Every thread takes a few elements from the pool, uses them and releases them again, just like a
+// request that is allocated, processed and returned.
+static void Exercise(Core::ProxyPoolType<PoolElement>& pool, const uint8_t threads, const uint32_t rounds)
+{
+    std::vector<std::thread> workers;
+
+    for (uint8_t index = 0; index < threads; index++) {
+        workers.emplace_back([&pool, rounds]() {
+            for (uint32_t round = 0; round < rounds; round++) {
+                Core::ProxyType<PoolElement> first(pool.Element());
+                Core::ProxyType<PoolElement> second(pool.Element());
+                EXPECT_EQ(first->Value(), 0u);
+                EXPECT_EQ(second->Value(), 0u);
+                first->Value(round + 1);
+                second->Value(first->Value());
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+TEST(Core_ProxyPool, concurrent)
+{
+    const uint32_t rounds = 10000;
+
+    for (uint8_t threads = 1; threads <= 8; threads <<= 1) {
+        Core::ProxyPoolType<PoolElement> shared(4, 0);
+        Core::ProxyPoolType<PoolElement> cached(4);
+        Core::ProxyPoolType<PoolElement>::Statistics statistics;
+
+        Exercise(shared, threads, rounds);
+        Exercise(cached, threads, rounds);
+
+        // Every request is either a hit, on a magazine or on the shared queue, or a new element,
+        // and once all threads are done, every element is back in the pool.
+        shared.Measure(statistics);
+        EXPECT_EQ(statistics.Cached, 0u);
+        EXPECT_EQ(statistics.Created + statistics.Pooled, 2 * rounds * threads);
+        EXPECT_EQ(statistics.Idle, statistics.Created);
+
+        cached.Measure(statistics);
+        EXPECT_EQ(statistics.Created + statistics.Cached + statistics.Pooled, 2 * rounds * threads);
+        EXPECT_EQ(statistics.Idle, statistics.Created);
+
+        EXPECT_EQ(cached.Trim(), statistics.Idle);
+        EXPECT_EQ(shared.Trim(), shared.CreatedElements());
+        EXPECT_EQ(cached.QueuedElements(), 0u);
+    }
+}
+
+TEST(Core_ProxyPool, statistics)
+{
+    Core::ProxyPoolType<PoolElement> pool(2);
+    Core::ProxyPoolType<PoolElement>::Statistics statistics;
+
+    {
+        Core::ProxyType<PoolElement> first(pool.Element());
+        Core::ProxyType<PoolElement> second(pool.Element());
+        first->Value(42);
+    }
+
+    pool.Measure(statistics);
+    EXPECT_EQ(statistics.Created, 2u);
+    EXPECT_EQ(statistics.Cached, 0u);
+    EXPECT_EQ(statistics.Idle, 2u);
+
+    // Reused, and cleared on the way back.
+    {
+        Core::ProxyType<PoolElement> element(pool.Element());
+        EXPECT_EQ(element->Value(), 0u);
+    }
+
+    pool.Measure(statistics);
+    EXPECT_EQ(statistics.Created, 2u);
+    EXPECT_EQ(statistics.Cached + statistics.Pooled, 1u);
+
+    EXPECT_EQ(pool.Trim(1), 1u);
+    pool.Measure(statistics);
+    EXPECT_EQ(statistics.Idle, 1u);
+    EXPECT_EQ(pool.Trim(), 1u);
+    EXPECT_EQ(pool.QueuedElements(), 0u);
+}
+
+} // Tests
+} // WPEFramework
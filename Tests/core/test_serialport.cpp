@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A serial port on the slave side of a pseudo terminal, that keeps all it receives.
+class FramedPort : public Core::SerialPort {
+public:
+    FramedPort() = delete;
+    FramedPort(const FramedPort&) = delete;
+    FramedPort& operator=(const FramedPort&) = delete;
+
+    FramedPort(const string& name)
+        : Core::SerialPort(name)
+        , _lock()
+        , _received()
+    {
+    }
+    ~FramedPort() override
+    {
+    }
+
+public:
+    uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+    {
+        return (0);
+    }
+    uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+    {
+        _lock.Lock();
+        _received.emplace_back(reinterpret_cast<const char*>(dataFrame), receivedSize);
+        _lock.Unlock();
+
+        return (receivedSize);
+    }
+    void StateChange() override
+    {
+    }
+
+    std::vector<string> Wait(const uint8_t count, const uint32_t waitTime)
+    {
+        uint32_t waited = 0;
+
+        _lock.Lock();
+        while ((_received.size() < count) && (waited < waitTime)) {
+            _lock.Unlock();
+            SleepMs(10);
+            waited += 10;
+            _lock.Lock();
+        }
+        std::vector<string> result(_received);
+        _received.clear();
+        _lock.Unlock();
+
+        return (result);
+    }
+
+private:
+    Core::CriticalSection _lock;
+    std::vector<string> _received;
+};
+
+class Terminal {
+public:
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    Terminal()
+        : _master(::posix_openpt(O_RDWR | O_NOCTTY))
+    {
+        EXPECT_NE(_master, -1);
+        EXPECT_EQ(::grantpt(_master), 0);
+        EXPECT_EQ(::unlockpt(_master), 0);
+    }
+    ~Terminal()
+    {
+        ::close(_master);
+    }
+
+public:
+    string Name() const
+    {
+        return (::ptsname(_master));
+    }
+    void Write(const uint8_t data[], const uint16_t length)
+    {
+        EXPECT_EQ(::write(_master, data, length), length);
+    }
+
+private:
+    int _master;
+};
+
+TEST(Core_SerialPort, framing)
+{
+    Terminal terminal;
+    FramedPort port(terminal.Name());
+
+    // A type byte and a big endian 16 bits length, followed by the payload.
+    Core::SerialPort::LengthFraming framing(3, 1, 2, true);
+    port.Framing(&framing);
+
+    ASSERT_EQ(port.Open(0), Core::ERROR_NONE);
+    port.Configuration(Core::SerialPort::BAUDRATE_115200, Core::SerialPort::OFF, 64, 64);
+
+    // Two complete frames and the start of a third in one go, the rest of the third one later.
+    const uint8_t first[] = { 0x01, 0x00, 0x02, 'a', 'b', 0x02, 0x00, 0x00, 0x03, 0x00, 0x04, 'w', 'x' };
+    const uint8_t second[] = { 'y', 'z' };
+
+    terminal.Write(first, sizeof(first));
+    std::vector<string> frames(port.Wait(2, 2000));
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0], string("\x01\x00\x02" "ab", 5));
+    EXPECT_EQ(frames[1], string("\x02\x00\x00", 3));
+
+    terminal.Write(second, sizeof(second));
+    frames = port.Wait(1, 2000);
+
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], string("\x03\x00\x04" "wxyz", 7));
+
+    // More frames than fit in the buffer at once, they wrap over its end.
+    uint8_t burst[120];
+    for (uint8_t index = 0; index < 20; index++) {
+        burst[(index * 6) + 0] = index;
+        burst[(index * 6) + 1] = 0x00;
+        burst[(index * 6) + 2] = 0x03;
+        burst[(index * 6) + 3] = index;
+        burst[(index * 6) + 4] = index;
+        burst[(index * 6) + 5] = index;
+    }
+    terminal.Write(burst, sizeof(burst));
+    frames = port.Wait(20, 2000);
+
+    ASSERT_EQ(frames.size(), 20u);
+    for (uint8_t index = 0; index < 20; index++) {
+        EXPECT_EQ(frames[index], string(reinterpret_cast<const char*>(&burst[index * 6]), 6));
+    }
+
+    port.Close(Core::infinite);
+    port.Framing(nullptr);
+}
+
+TEST(Core_SerialPort, delimiter)
+{
+    Terminal terminal;
+    FramedPort port(terminal.Name());
+
+    Core::SerialPort::DelimiterFraming framing('\n');
+    port.Framing(&framing);
+
+    ASSERT_EQ(port.Open(0), Core::ERROR_NONE);
+    port.Configuration(Core::SerialPort::BAUDRATE_115200, Core::SerialPort::OFF, 64, 64);
+
+    const uint8_t lines[] = { 'O', 'K', '\n', 'E', 'R', 'R', 'O', 'R', '\n', 'R', 'I' };
+    terminal.Write(lines, sizeof(lines));
+
+    std::vector<string> frames(port.Wait(2, 2000));
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0], _T("OK\n"));
+    EXPECT_EQ(frames[1], _T("ERROR\n"));
+
+    const uint8_t rest[] = { 'N', 'G', '\n' };
+    terminal.Write(rest, sizeof(rest));
+
+    frames = port.Wait(1, 2000);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], _T("RING\n"));
+
+    port.Close(Core::infinite);
+    port.Framing(nullptr);
+}
+
+TEST(Core_SerialPort, batch)
+{
+    Terminal terminal;
+    FramedPort port(terminal.Name());
+
+    ASSERT_EQ(port.Open(0), Core::ERROR_NONE);
+    port.Configuration(Core::SerialPort::BAUDRATE_115200, Core::SerialPort::OFF, 64, 64);
+    // The port is only reported readable once 8 bytes are in.
+    port.SetReadBatch(8, 0);
+
+    const uint8_t data[] = { '0', '1', '2', '3', '4', '5', '6', '7' };
+    terminal.Write(data, 4);
+    EXPECT_EQ(port.Wait(1, 300).size(), 0u);
+    terminal.Write(&data[4], 4);
+    std::vector<string> chunks(port.Wait(1, 2000));
+    ASSERT_EQ(chunks.size(), 1u);
+    EXPECT_EQ(chunks[0], _T("01234567"));
+
+    port.Close(Core::infinite);
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
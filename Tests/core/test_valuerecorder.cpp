@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+typedef Core::RecorderType<uint64_t, 1> Recorder;
+
+const char g_recordingName[] = "testrecording01";
+
+void CleanUpRecording()
+{
+   Core::Directory directory(_T("."), (string(g_recordingName) + _T(".*")).c_str());
+
+   while (directory.Next() == true) {
+       Core::File(directory.Current()).Destroy();
+   }
+}
+
+TEST(Core_ValueRecorder, retention)
+{
+   CleanUpRecording();
+
+   {
+       Core::ProxyType<Recorder::Writer> writer = Recorder::Writer::Create(g_recordingName, 2);
+
+       for (uint32_t index = 1; index <= 3000; index++) {
+           writer->Record(1000 + (index * 7));
+       }
+
+       // 3000 recordings do not fit in 3 blocks of 1 KB, so the oldest files must have been dropped.
+       EXPECT_GT(writer->Oldest(), 0u);
+       EXPECT_FALSE(Core::File(string(g_recordingName) + ".0").Exists());
+
+       Recorder::Reader reader(writer, 0);
+       uint64_t previous = 0;
+       uint32_t count = 0;
+
+       while (reader.Next() == true) {
+           if (count != 0) {
+               EXPECT_EQ(reader.Value(), previous + 7);
+           }
+           previous = reader.Value();
+           count++;
+       }
+
+       EXPECT_GT(count, 0u);
+       EXPECT_LT(count, 3000u);
+       EXPECT_EQ(previous, 1000u + (3000 * 7));
+   }
+
+   CleanUpRecording();
+}
+
+}
+}
@@ -0,0 +1,129 @@
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static std::vector<uint8_t> Binary(const char hex[])
+    {
+        std::vector<uint8_t> result(strlen(hex) / 2);
+        Core::FromHexString(hex, result.data(), static_cast<uint16_t>(result.size()));
+        return (result);
+    }
+
+    static string Hex(const uint8_t data[], const uint32_t length)
+    {
+        string result;
+        Core::ToHexString(data, length, result);
+        return (result);
+    }
+
+    // Runs the test on the hardware path (if the CPU has it) and on the table implementation.
+    template <typename TEST>
+    static void BothImplementations(TEST test)
+    {
+        mbedtls_aes_hw_acceleration(0);
+        test();
+        mbedtls_aes_hw_acceleration(1);
+        test();
+    }
+
+    TEST(AES, ecb_known_answer)
+    {
+        BothImplementations([]() {
+            // FIPS-197, appendix C.1
+            const std::vector<uint8_t> key(Binary("000102030405060708090a0b0c0d0e0f"));
+            const std::vector<uint8_t> plain(Binary("00112233445566778899aabbccddeeff"));
+            uint8_t cipher[16];
+            uint8_t decrypted[16];
+
+            Crypto::AESEncryption encryption(Crypto::AES_ECB);
+            encryption.Key(key.size(), key.data());
+            encryption.Encrypt(plain.size(), plain.data(), cipher);
+            EXPECT_EQ(Hex(cipher, sizeof(cipher)), "69c4e0d86a7b0430d8cdb78070b4c55a");
+
+            Crypto::AESDecryption decryption(Crypto::AES_ECB);
+            decryption.Key(key.size(), key.data());
+            decryption.Decrypt(sizeof(cipher), cipher, decrypted);
+            EXPECT_EQ(memcmp(decrypted, plain.data(), sizeof(decrypted)), 0);
+        });
+    }
+
+    TEST(AES, ctr_known_answer_streaming)
+    {
+        BothImplementations([]() {
+            // NIST SP 800-38A, F.5.1, fed in pieces that do not align with the blocks.
+            const std::vector<uint8_t> key(Binary("2b7e151628aed2a6abf7158809cf4f3c"));
+            const std::vector<uint8_t> counter(Binary("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+            std::vector<uint8_t> data(Binary("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"));
+
+            Crypto::AESEncryption encryption(Crypto::AES_CTR);
+            encryption.Key(key.size(), key.data());
+            encryption.InitialVector(counter.data());
+            encryption.Encrypt(5, &data[0], &data[0]);
+            encryption.Encrypt(20, &data[5], &data[5]);
+            encryption.Encrypt(7, &data[25], &data[25]);
+            EXPECT_EQ(Hex(data.data(), data.size()), "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff");
+
+            Crypto::AESDecryption decryption(Crypto::AES_CTR);
+            decryption.Key(key.size(), key.data());
+            decryption.InitialVector(counter.data());
+            decryption.Decrypt(data.size(), data.data(), data.data());
+            EXPECT_EQ(Hex(data.data(), data.size()), "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51");
+        });
+    }
+
+    TEST(AES, gcm_known_answer)
+    {
+        BothImplementations([]() {
+            // The GCM specification (McGrew and Viega), test case 3
+            const std::vector<uint8_t> key(Binary("feffe9928665731c6d6a8f9467308308"));
+            const std::vector<uint8_t> iv(Binary("cafebabefacedbaddecaf888"));
+            const std::vector<uint8_t> plain(Binary("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255"));
+            std::vector<uint8_t> data(plain);
+            uint8_t tag[16];
+
+            Crypto::AESGCM gcm;
+            EXPECT_EQ(gcm.Key(key.size(), key.data()), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Start(iv.size(), iv.data()), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Encrypt(data.size(), data.data(), data.data()), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Tag(sizeof(tag), tag), Core::ERROR_NONE);
+            EXPECT_EQ(Hex(data.data(), data.size()), "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985");
+            EXPECT_EQ(Hex(tag, sizeof(tag)), "4d5c2af327cd64a62cf35abd2ba6fab4");
+
+            EXPECT_EQ(gcm.Start(iv.size(), iv.data()), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Decrypt(17, &data[0], &data[0]), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Decrypt(data.size() - 17, &data[17], &data[17]), Core::ERROR_NONE);
+            EXPECT_EQ(gcm.Verify(sizeof(tag), tag), Core::ERROR_NONE);
+            EXPECT_EQ(data, plain);
+        });
+    }
+
+    TEST(AES, gcm_rejects_modified_data)
+    {
+        const std::vector<uint8_t> key(32, 0x42);
+        const std::vector<uint8_t> iv(12, 0x24);
+        const std::vector<uint8_t> aad(Binary("feedfacedeadbeeffeedfacedeadbeefabaddad2"));
+        std::vector<uint8_t> data(1000, 0x55);
+        uint8_t tag[16];
+
+        Crypto::AESGCM gcm;
+        gcm.Key(key.size(), key.data());
+        gcm.Start(iv.size(), iv.data(), aad.size(), aad.data());
+        gcm.Encrypt(data.size(), data.data(), data.data());
+        gcm.Tag(sizeof(tag), tag);
+
+        data[500] ^= 0x01;
+        gcm.Start(iv.size(), iv.data(), aad.size(), aad.data());
+        gcm.Decrypt(data.size(), data.data(), data.data());
+        EXPECT_EQ(gcm.Verify(sizeof(tag), tag), Core::ERROR_INVALID_SIGNATURE);
+
+        EXPECT_EQ(gcm.Encrypt(data.size(), data.data(), data.data()), Core::ERROR_ILLEGAL_STATE);
+    }
+
+} // namespace Tests
+} // namespace WPEFramework
@@ -0,0 +1,116 @@
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    template <typename HASHALGORITHM>
+    static string Digest(const uint8_t data[], const uint64_t length)
+    {
+        HASHALGORITHM hash;
+        hash.Input(data, length);
+
+        string result;
+        Core::ToHexString(hash.Result(), HASHALGORITHM::Length, result);
+        return (result);
+    }
+
+    template <typename HASHALGORITHM>
+    static string Digest(const char text[])
+    {
+        return (Digest<HASHALGORITHM>(reinterpret_cast<const uint8_t*>(text), strlen(text)));
+    }
+
+    // Digest of the message fed in chunks of the given size, to cross the block boundaries in all
+    // possible ways.
+    template <typename HASHALGORITHM>
+    static string Chunked(const std::vector<uint8_t>& data, const uint32_t chunk)
+    {
+        HASHALGORITHM hash;
+        uint64_t offset = 0;
+
+        while (offset < data.size()) {
+            uint64_t size = std::min(static_cast<uint64_t>(chunk), static_cast<uint64_t>(data.size() - offset));
+            hash.Input(&(data[offset]), size);
+            offset += size;
+        }
+
+        string result;
+        Core::ToHexString(hash.Result(), HASHALGORITHM::Length, result);
+        return (result);
+    }
+
+    template <typename HASHALGORITHM>
+    static void Consistent()
+    {
+        std::vector<uint8_t> data(4099);
+
+        for (uint32_t index = 0; index < data.size(); index++) {
+            data[index] = static_cast<uint8_t>(index * 7 + 3);
+        }
+
+        const string whole = Digest<HASHALGORITHM>(data.data(), data.size());
+        const uint32_t chunks[] = { 1, 3, 55, 56, 63, 64, 65, 111, 112, 127, 128, 129, 1000 };
+
+        for (const uint32_t chunk : chunks) {
+            EXPECT_EQ(Chunked<HASHALGORITHM>(data, chunk), whole) << "chunk size " << chunk;
+        }
+    }
+
+    TEST(Hash, known_answers_empty)
+    {
+        EXPECT_EQ(Digest<Crypto::MD5>(""), "d41d8cd98f00b204e9800998ecf8427e");
+        EXPECT_EQ(Digest<Crypto::SHA1>(""), "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+        EXPECT_EQ(Digest<Crypto::SHA224>(""), "d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f");
+        EXPECT_EQ(Digest<Crypto::SHA256>(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        EXPECT_EQ(Digest<Crypto::SHA384>(""), "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b");
+        EXPECT_EQ(Digest<Crypto::SHA512>(""), "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+    }
+
+    TEST(Hash, known_answers_abc)
+    {
+        EXPECT_EQ(Digest<Crypto::MD5>("abc"), "900150983cd24fb0d6963f7d28e17f72");
+        EXPECT_EQ(Digest<Crypto::SHA1>("abc"), "a9993e364706816aba3e25717850c26c9cd0d89d");
+        EXPECT_EQ(Digest<Crypto::SHA224>("abc"), "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+        EXPECT_EQ(Digest<Crypto::SHA256>("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        EXPECT_EQ(Digest<Crypto::SHA384>("abc"), "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+        EXPECT_EQ(Digest<Crypto::SHA512>("abc"), "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    }
+
+    TEST(Hash, known_answers_two_blocks)
+    {
+        const char message[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+        EXPECT_EQ(Digest<Crypto::SHA1>(message), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+        EXPECT_EQ(Digest<Crypto::SHA256>(message), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    }
+
+    TEST(Hash, split_input_consistent)
+    {
+        Consistent<Crypto::MD5>();
+        Consistent<Crypto::SHA1>();
+        Consistent<Crypto::SHA224>();
+        Consistent<Crypto::SHA256>();
+        Consistent<Crypto::SHA384>();
+        Consistent<Crypto::SHA512>();
+    }
+
+    TEST(Hash, data_element_input)
+    {
+        uint8_t buffer[] = { 'a', 'b', 'c' };
+        Core::DataElement element(sizeof(buffer), buffer);
+
+        Crypto::SHA256 hash;
+        hash.Input(element);
+
+        string result;
+        Core::ToHexString(hash.Result(), Crypto::SHA256::Length, result);
+        EXPECT_EQ(result, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    }
+
+} // namespace Tests
+} // namespace WPEFramework
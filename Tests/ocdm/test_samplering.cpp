@@ -0,0 +1,341 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <ocdm/DataExchange.h>
+#include <ocdm/SampleRing.h>
+
+#include <atomic>
+#include <thread>
+
+#include <sys/stat.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+static constexpr uint32_t SampleSize = 64 * 1024;
+static constexpr uint32_t Samples = 256;
+static constexpr uint8_t Key = 0x5A;
+
+// The null CDM "decrypts" by XOR-ing the sample with a fixed key, so the player can verify
+// it got its own sample back, processed.
+static void NullDecrypt(uint8_t data[], const uint32_t length)
+{
+    for (uint32_t index = 0; index < length; index++) {
+        data[index] ^= Key;
+    }
+}
+
+static void Fill(uint8_t data[], const uint32_t length, const uint32_t sample)
+{
+    ::memset(data, static_cast<uint8_t>(sample), length);
+}
+
+static bool Verify(const uint8_t data[], const uint32_t length, const uint32_t sample)
+{
+    return ((data[0] == (static_cast<uint8_t>(sample) ^ Key)) && (data[length - 1] == (static_cast<uint8_t>(sample) ^ Key)));
+}
+
+// The current scheme, a single buffer, every sample is a full round-trip with the CDM.
+TEST(OCDM_SampleRing, single)
+{
+    const string name(_T("/tmp/ocdm_test_single"));
+    uint8_t sample[SampleSize];
+    uint32_t failures = 0;
+    std::atomic<bool> running(true);
+
+    OCDM::DataExchange server(name, SampleSize);
+    OCDM::DataExchange client(name);
+
+    std::thread cdm([&]() {
+        while (running == true) {
+            if (server.RequestConsume(100) == Core::ERROR_NONE) {
+                NullDecrypt(server.Buffer(), static_cast<uint32_t>(server.Size()));
+                server.Status(0);
+                server.Consumed();
+            }
+        }
+    });
+
+    for (uint32_t index = 0; index < Samples; index++) {
+        Fill(sample, sizeof(sample), index);
+
+        if (client.RequestProduce(Core::infinite) == Core::ERROR_NONE) {
+            client.Write(sizeof(sample), sample);
+            client.Produced();
+
+            if (client.RequestProduce(Core::infinite) == Core::ERROR_NONE) {
+                client.Read(sizeof(sample), sample);
+                client.Consumed();
+            }
+        }
+
+        failures += (Verify(sample, sizeof(sample), index) == false ? 1 : 0);
+    }
+
+    running = false;
+    cdm.join();
+
+    EXPECT_EQ(failures, 0u);
+
+    Core::File(name).Destroy();
+    Core::File(name + _T(".admin")).Destroy();
+}
+
+// The sample ring, with a given number of samples in flight. The samples are written into and
+// decrypted in the slot, the player only reads the clear sample in place.
+static void Ring(const uint32_t depth)
+{
+    const string name(_T("/tmp/ocdm_test_ring"));
+    uint32_t failures = 0;
+    std::atomic<bool> running(true);
+
+    OCDM::SampleRing server(name, 8, SampleSize);
+    OCDM::SampleRing client(name);
+
+    ASSERT_TRUE(server.IsOperational());
+    ASSERT_TRUE(client.IsOperational());
+    EXPECT_EQ(client.Slots(), 8u);
+    EXPECT_EQ(client.SlotSize(), SampleSize);
+
+    std::thread cdm([&]() {
+        uint32_t slot;
+
+        while (running == true) {
+            if (server.Next(100, slot) == Core::ERROR_NONE) {
+                NullDecrypt(server.Buffer(slot), server.Length(slot));
+                server.Completed(slot, 0);
+            }
+        }
+    });
+
+    std::vector<uint32_t> inflight(depth);
+    uint32_t submitted = 0;
+    uint32_t completed = 0;
+
+    while (completed < Samples) {
+        // Keep the pipeline filled.
+        while (((submitted - completed) < depth) && (submitted < Samples)) {
+            uint32_t& slot(inflight[submitted % depth]);
+
+            EXPECT_EQ(client.Acquire(Core::infinite, slot), Core::ERROR_NONE);
+
+            Fill(client.Buffer(slot), SampleSize, submitted);
+            client.Submit(slot, SampleSize);
+            submitted++;
+        }
+
+        uint32_t slot = inflight[completed % depth];
+
+        if ((client.Wait(slot, Core::infinite) != Core::ERROR_NONE) || (client.Status(slot) != 0) || (Verify(client.Buffer(slot), client.Length(slot), completed) == false)) {
+            failures++;
+        }
+
+        client.Release(slot);
+        completed++;
+    }
+
+    running = false;
+    cdm.join();
+
+    EXPECT_EQ(failures, 0u);
+
+    Core::File(name).Destroy();
+}
+
+TEST(OCDM_SampleRing, pipeline)
+{
+    Ring(1);
+    Ring(4);
+    Ring(8);
+}
+
+// A slot given up on while the CDM works on it, is returned to the ring by the CDM.
+TEST(OCDM_SampleRing, abandon)
+{
+    const string name(_T("/tmp/ocdm_test_abandon"));
+    uint32_t slot;
+    uint32_t other;
+    uint32_t processing;
+
+    OCDM::SampleRing server(name, 1, 1024);
+    OCDM::SampleRing client(name);
+
+    EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+    EXPECT_EQ(client.Acquire(0, other), Core::ERROR_TIMEDOUT);
+
+    client.Submit(slot, 16);
+    EXPECT_EQ(server.Next(0, processing), Core::ERROR_NONE);
+    EXPECT_EQ(processing, slot);
+    EXPECT_EQ(client.Wait(slot, 10), Core::ERROR_TIMEDOUT);
+
+    client.Release(slot);
+    EXPECT_EQ(client.State(slot), static_cast<uint32_t>(OCDM::SampleRing::ABANDONED));
+    EXPECT_EQ(client.Acquire(0, other), Core::ERROR_TIMEDOUT);
+    EXPECT_EQ(other, static_cast<uint32_t>(OCDM::SampleRing::InvalidSlot));
+
+    server.Completed(processing, 0);
+    EXPECT_EQ(client.State(slot), static_cast<uint32_t>(OCDM::SampleRing::FREE));
+    EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+
+    // Submitted, but released before the CDM got to it.
+    client.Submit(slot, 16);
+    client.Release(slot);
+    EXPECT_EQ(server.Next(0, processing), Core::ERROR_TIMEDOUT);
+    EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+    client.Release(slot);
+
+    Core::File(name).Destroy();
+}
+
+// Slots can only be used by the player that acquired them, in the order acquire, submit, wait, release.
+TEST(OCDM_SampleRing, ownership)
+{
+    const string name(_T("/tmp/ocdm_test_ownership"));
+    uint32_t slot;
+    uint32_t processing;
+    struct stat info;
+
+    OCDM::SampleRing server(name, 2, 1024);
+    OCDM::SampleRing client(name);
+    OCDM::SampleRing other(name);
+
+    // Shared with the group of the CDM, not with everyone.
+    ASSERT_EQ(::stat(name.c_str(), &info), 0);
+    EXPECT_EQ((info.st_mode & S_IRWXO), 0u);
+
+    EXPECT_EQ(client.Release(0), Core::ERROR_PRIVILIGED_REQUEST);
+    EXPECT_EQ(client.Submit(2, 16), Core::ERROR_BAD_REQUEST);
+
+    EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+    EXPECT_TRUE(client.IsAllocated(slot));
+    EXPECT_FALSE(other.IsAllocated(slot));
+
+    // Not submitted yet.
+    EXPECT_EQ(client.Wait(slot, 0), Core::ERROR_ILLEGAL_STATE);
+    EXPECT_EQ(client.Submit(slot, 2048), Core::ERROR_INVALID_INPUT_LENGTH);
+
+    // Another player can not touch it.
+    EXPECT_EQ(other.Submit(slot, 16), Core::ERROR_PRIVILIGED_REQUEST);
+    EXPECT_EQ(other.Wait(slot, 0), Core::ERROR_PRIVILIGED_REQUEST);
+    EXPECT_EQ(other.Release(slot), Core::ERROR_PRIVILIGED_REQUEST);
+    EXPECT_EQ(client.State(slot), static_cast<uint32_t>(OCDM::SampleRing::ALLOCATED));
+
+    EXPECT_EQ(client.Submit(slot, 16), Core::ERROR_NONE);
+    EXPECT_EQ(client.Submit(slot, 16), Core::ERROR_ILLEGAL_STATE);
+    EXPECT_FALSE(client.IsAllocated(slot));
+
+    // The CDM can only complete what it took.
+    EXPECT_EQ(server.Completed(slot, 0), Core::ERROR_ILLEGAL_STATE);
+    EXPECT_EQ(server.Next(0, processing), Core::ERROR_NONE);
+    EXPECT_EQ(server.Completed(processing, 0), Core::ERROR_NONE);
+
+    EXPECT_EQ(client.Wait(slot, 0), Core::ERROR_NONE);
+    EXPECT_EQ(client.Release(slot), Core::ERROR_NONE);
+
+    // Released once, the second time it is not ours anymore.
+    EXPECT_EQ(client.Release(slot), Core::ERROR_PRIVILIGED_REQUEST);
+    EXPECT_EQ(client.State(slot), static_cast<uint32_t>(OCDM::SampleRing::FREE));
+
+    // Given up on while the CDM works on it, releasing it again is refused.
+    EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+    EXPECT_EQ(client.Submit(slot, 16), Core::ERROR_NONE);
+    EXPECT_EQ(server.Next(0, processing), Core::ERROR_NONE);
+    EXPECT_EQ(client.Release(slot), Core::ERROR_NONE);
+    EXPECT_EQ(client.Release(slot), Core::ERROR_ALREADY_RELEASED);
+    EXPECT_EQ(client.Wait(slot, 0), Core::ERROR_ILLEGAL_STATE);
+    EXPECT_EQ(server.Completed(processing, 0), Core::ERROR_NONE);
+    EXPECT_EQ(client.State(slot), static_cast<uint32_t>(OCDM::SampleRing::FREE));
+
+    Core::File(name).Destroy();
+}
+
+// Only the encrypted ranges of a subsample encrypted sample travel through the exchange.
+TEST(OCDM_SampleRing, subsamples)
+{
+    const string name(_T("/tmp/ocdm_test_subsamples"));
+    const OCDM::SubSample ranges[] = { { 128, 1024 }, { 16, 0 }, { 300, 4096 }, { 64, 16 } };
+    const uint16_t count = sizeof(ranges) / sizeof(ranges[0]);
+    const uint32_t length = static_cast<uint32_t>(OCDM::SubSampleMap::Length(count, ranges)) + 10;
+    std::vector<uint8_t> sample(length);
+    std::vector<uint8_t> reference(length);
+
+    for (uint32_t index = 0; index < length; index++) {
+        sample[index] = static_cast<uint8_t>(index);
+    }
+    reference = sample;
+
+    OCDM::DataExchange server(name, SampleSize);
+    OCDM::DataExchange client(name);
+
+    client.SetSubSamples(count, ranges);
+    EXPECT_TRUE(client.Size(OCDM::SubSampleMap::Encrypted(count, ranges)));
+    OCDM::SubSampleMap::Gather(count, ranges, sample.data(), client.Buffer());
+
+    // The CDM side gets the ranges and just the encrypted bytes.
+    OCDM::SubSample received[OCDM::DataExchange::MaxSubSamples];
+    EXPECT_EQ(server.SubSamples(OCDM::DataExchange::MaxSubSamples, received), count);
+    EXPECT_EQ(received[2].ClearBytes, 300);
+    EXPECT_EQ(received[2].EncryptedBytes, 4096u);
+    EXPECT_EQ(OCDM::SubSampleMap::Encrypted(count, received), 1024u + 4096u + 16u);
+    NullDecrypt(server.Buffer(), OCDM::SubSampleMap::Encrypted(count, received));
+
+    OCDM::SubSampleMap::Scatter(count, ranges, client.Buffer(), sample.data());
+
+    // Clear ranges are untouched, encrypted ranges are processed.
+    uint32_t offset = 0;
+    for (const OCDM::SubSample& range : ranges) {
+        for (uint32_t index = 0; index < range.ClearBytes; index++, offset++) {
+            EXPECT_EQ(sample[offset], reference[offset]);
+        }
+        for (uint32_t index = 0; index < range.EncryptedBytes; index++, offset++) {
+            EXPECT_EQ(sample[offset], reference[offset] ^ Key);
+        }
+    }
+    EXPECT_EQ(sample[length - 1], reference[length - 1]);
+
+    Core::File(name).Destroy();
+    Core::File(name + _T(".admin")).Destroy();
+}
+
+// More subsamples than the administration holds are refused, not truncated.
+TEST(OCDM_SampleRing, subsampleLimit)
+{
+    const string name(_T("/tmp/ocdm_test_subsamplelimit"));
+    const uint16_t count = OCDM::DataExchange::MaxSubSamples + 1;
+    std::vector<OCDM::SubSample> ranges(count);
+    OCDM::SubSample received[OCDM::DataExchange::MaxSubSamples];
+
+    for (OCDM::SubSample& range : ranges) {
+        range.ClearBytes = 16;
+        range.EncryptedBytes = 16;
+    }
+
+    {
+        OCDM::DataExchange server(name, SampleSize);
+        OCDM::DataExchange client(name);
+
+        EXPECT_EQ(client.SetSubSamples(count - 1, ranges.data()), Core::ERROR_NONE);
+        EXPECT_EQ(server.SubSamples(OCDM::DataExchange::MaxSubSamples, received), count - 1);
+
+        EXPECT_EQ(client.SetSubSamples(count, ranges.data()), Core::ERROR_INVALID_INPUT_LENGTH);
+        EXPECT_EQ(server.SubSamples(OCDM::DataExchange::MaxSubSamples, received), 0);
+    }
+
+    Core::File(name).Destroy();
+    Core::File(name + _T(".admin")).Destroy();
+
+    {
+        OCDM::SampleRing server(name, 1, 1024);
+        OCDM::SampleRing client(name);
+        uint32_t slot;
+
+        EXPECT_EQ(client.Acquire(0, slot), Core::ERROR_NONE);
+        EXPECT_EQ(client.SetSubSamples(slot, count - 1, ranges.data()), Core::ERROR_NONE);
+        EXPECT_EQ(client.SetSubSamples(slot, count, ranges.data()), Core::ERROR_INVALID_INPUT_LENGTH);
+        EXPECT_EQ(client.Release(slot), Core::ERROR_NONE);
+    }
+
+    Core::File(name).Destroy();
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+#include <sys/socket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A channel on one end of a socket pair. It never upgrades to a websocket, so everything submitted stays queued.
+class QueueChannel : public PluginHost::Channel {
+public:
+    QueueChannel(const QueueChannel&) = delete;
+    QueueChannel& operator=(const QueueChannel&) = delete;
+
+    QueueChannel(const SOCKET& connector, const uint16_t backlog)
+        : PluginHost::Channel(connector, Core::NodeId())
+    {
+        State(JSONRPC, true);
+        Backlog(backlog);
+        Open(0);
+    }
+    ~QueueChannel() override
+    {
+        Close(Core::infinite);
+    }
+
+private:
+    void LinkBody(Core::ProxyType<PluginHost::Request>&) override
+    {
+    }
+    void Received(Core::ProxyType<PluginHost::Request>&) override
+    {
+    }
+    void Send(const Core::ProxyType<Web::Response>&) override
+    {
+    }
+    void Send(const Core::ProxyType<Core::JSON::IElement>&) override
+    {
+    }
+    Core::ProxyType<Core::JSON::IElement> Element(const string&) override
+    {
+        return (Core::ProxyType<Core::JSON::IElement>());
+    }
+    void Received(Core::ProxyType<Core::JSON::IElement>&) override
+    {
+    }
+    uint16_t SendData(uint8_t*, const uint16_t) override
+    {
+        return (0);
+    }
+    uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+    {
+        return (receivedSize);
+    }
+    void Received(const string&) override
+    {
+    }
+    void StateChange() override
+    {
+    }
+};
+
+TEST(Plugins_Channel, backlog)
+{
+    const uint16_t backlog = 8;
+    int sockets[2];
+
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+    {
+        QueueChannel channel(sockets[0], backlog);
+        Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>::Create());
+        Core::ProxyType<Core::JSONRPC::Notification> notification(Core::ProxyType<Core::JSONRPC::Notification>::Create(_T("client.events.statechange"), _T("{\"state\":1}")));
+
+        ASSERT_TRUE(channel.IsOpen());
+
+        // Notifications, shared or a message of their own, fill the queue up to the backlog, the rest is dropped.
+        for (uint16_t index = 0; index < (2 * backlog); index++) {
+            if ((index & 1) == 0) {
+                channel.Submit(Core::ProxyType<Core::JSON::IElement>(notification), true);
+            } else {
+                channel.Submit(Core::ProxyType<Core::JSON::IElement>(message), true);
+            }
+        }
+
+        EXPECT_EQ(channel.Pending(), static_cast<uint32_t>(backlog));
+        EXPECT_EQ(channel.Dropped(), static_cast<uint32_t>(backlog));
+
+        // Responses are never dropped, not even with a full backlog.
+        channel.Submit(Core::ProxyType<Core::JSON::IElement>(message));
+        channel.Submit(Core::ProxyType<Core::JSON::IElement>(message), false);
+
+        EXPECT_EQ(channel.Pending(), static_cast<uint32_t>(backlog + 2));
+        EXPECT_EQ(channel.Dropped(), static_cast<uint32_t>(backlog));
+
+        // Still full, the next notification is dropped as well.
+        channel.Submit(Core::ProxyType<Core::JSON::IElement>(notification), true);
+
+        EXPECT_EQ(channel.Pending(), static_cast<uint32_t>(backlog + 2));
+        EXPECT_EQ(channel.Dropped(), static_cast<uint32_t>(backlog + 1));
+    }
+
+    ::close(sockets[1]);
+}
+
+TEST(Plugins_Channel, unlimited)
+{
+    const uint32_t count = 512;
+    int sockets[2];
+
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+
+    {
+        // Without a backlog nothing is dropped.
+        QueueChannel channel(sockets[0], 0);
+        Core::ProxyType<Core::JSONRPC::Notification> notification(Core::ProxyType<Core::JSONRPC::Notification>::Create(_T("statechange"), _T("{}")));
+
+        ASSERT_TRUE(channel.IsOpen());
+
+        for (uint32_t index = 0; index < count; index++) {
+            channel.Submit(Core::ProxyType<Core::JSON::IElement>(notification), true);
+        }
+
+        EXPECT_EQ(channel.Pending(), count);
+        EXPECT_EQ(channel.Dropped(), 0u);
+    }
+
+    ::close(sockets[1]);
+}
+
+} // Tests
+} // WPEFramework
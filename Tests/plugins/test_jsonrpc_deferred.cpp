@@ -0,0 +1,463 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+// A shell that keeps what the plugin sends to its channels. Submitting can be made slow, to have the
+// plugin go while a response is still on its way.
+class ResponseShell : public PluginHost::IShell {
+public:
+    struct Sent {
+        uint32_t Channel;
+        uint32_t Id;
+        int32_t Code;
+        string Result;
+        bool Notification;
+    };
+
+public:
+    ResponseShell(const ResponseShell&) = delete;
+    ResponseShell& operator=(const ResponseShell&) = delete;
+
+    ResponseShell()
+        : _adminLock()
+        , _submitted(false, true)
+        , _sent()
+        , _delay(0)
+        , _busy(false)
+    {
+    }
+    ~ResponseShell() override = default;
+
+public:
+    void Delay(const uint32_t waitTime)
+    {
+        _delay = waitTime;
+    }
+    bool IsBusy() const
+    {
+        return (_busy);
+    }
+    uint32_t Wait(const uint32_t waitTime)
+    {
+        return (_submitted.Lock(waitTime));
+    }
+    std::vector<Sent> Collect()
+    {
+        _adminLock.Lock();
+        std::vector<Sent> result(_sent);
+        _sent.clear();
+        _submitted.ResetEvent();
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response, const bool notification) override
+    {
+        Core::ProxyType<Web::JSONBodyType<Core::JSONRPC::Message>> message(response);
+
+        // Shared notifications are no message, all others are.
+        EXPECT_TRUE((message.IsValid() == true) || (notification == true));
+
+        _busy = true;
+
+        if (_delay != 0) {
+            SleepMs(_delay);
+        }
+
+        _adminLock.Lock();
+        if (message.IsValid() == true) {
+            _sent.push_back({ id, static_cast<uint32_t>(message->Id.Value()), message->Error.Code.Value(), message->Result.Value(), notification });
+        } else {
+            _sent.push_back({ id, 0, 0, string(), notification });
+        }
+        _submitted.SetEvent();
+        _adminLock.Unlock();
+
+        _busy = false;
+
+        return (Core::ERROR_NONE);
+    }
+    string Callsign() const override
+    {
+        return (_T("Test"));
+    }
+
+    void AddRef() const override
+    {
+    }
+    uint32_t Release() const override
+    {
+        return (Core::ERROR_NONE);
+    }
+    void* QueryInterface(const uint32_t) override
+    {
+        return (nullptr);
+    }
+    void EnableWebServer(const string&, const string&) override
+    {
+    }
+    void DisableWebServer() override
+    {
+    }
+    string Version() const override
+    {
+        return (string());
+    }
+    string Model() const override
+    {
+        return (string());
+    }
+    bool Background() const override
+    {
+        return (false);
+    }
+    string Accessor() const override
+    {
+        return (string());
+    }
+    string WebPrefix() const override
+    {
+        return (string());
+    }
+    string Locator() const override
+    {
+        return (string());
+    }
+    string ClassName() const override
+    {
+        return (string());
+    }
+    string Versions() const override
+    {
+        return (string());
+    }
+    string PersistentPath() const override
+    {
+        return (string());
+    }
+    string VolatilePath() const override
+    {
+        return (string());
+    }
+    string DataPath() const override
+    {
+        return (string());
+    }
+    string ProxyStubPath() const override
+    {
+        return (string());
+    }
+    string ConfigSubstitution(const string& input) const override
+    {
+        return (input);
+    }
+    bool AutoStart() const override
+    {
+        return (false);
+    }
+    bool Resumed() const override
+    {
+        return (false);
+    }
+    string HashKey() const override
+    {
+        return (string());
+    }
+    string ConfigLine() const override
+    {
+        return (string());
+    }
+    bool IsSupported(const uint8_t) const override
+    {
+        return (true);
+    }
+    PluginHost::ISubSystem* SubSystems() override
+    {
+        return (nullptr);
+    }
+    void Notify(const string&) override
+    {
+    }
+    void Register(PluginHost::IPlugin::INotification*) override
+    {
+    }
+    void Unregister(PluginHost::IPlugin::INotification*) override
+    {
+    }
+    state State() const override
+    {
+        return (ACTIVATED);
+    }
+    void* QueryInterfaceByCallsign(const uint32_t, const string&) override
+    {
+        return (nullptr);
+    }
+    uint32_t Activate(const reason) override
+    {
+        return (Core::ERROR_NONE);
+    }
+    uint32_t Deactivate(const reason) override
+    {
+        return (Core::ERROR_NONE);
+    }
+    reason Reason() const override
+    {
+        return (REQUESTED);
+    }
+    ICOMLink* COMLink() override
+    {
+        return (nullptr);
+    }
+
+private:
+    Core::CriticalSection _adminLock;
+    Core::Event _submitted;
+    std::vector<Sent> _sent;
+    std::atomic<uint32_t> _delay;
+    std::atomic<bool> _busy;
+};
+
+// A plugin with a single method that answers later, the connections of its calls are kept for the test.
+class DeferredPlugin : public PluginHost::JSONRPC {
+public:
+    DeferredPlugin(const DeferredPlugin&) = delete;
+    DeferredPlugin& operator=(const DeferredPlugin&) = delete;
+
+    DeferredPlugin()
+        : PluginHost::JSONRPC()
+        , _calls()
+    {
+        static_cast<Core::JSONRPC::Handler&>(*this).Register(_T("wait"), [this](const Core::JSONRPC::Connection& channel, const string&) { _calls.push_back(channel); });
+    }
+    ~DeferredPlugin() override = default;
+
+public:
+    void AddRef() const override
+    {
+    }
+    uint32_t Release() const override
+    {
+        return (Core::ERROR_NONE);
+    }
+    void* QueryInterface(const uint32_t) override
+    {
+        return (nullptr);
+    }
+
+    // The framework reaches these through the IDispatcher interface.
+    void Attach(PluginHost::IShell* service)
+    {
+        static_cast<PluginHost::IDispatcher&>(*this).Activate(service);
+    }
+    void Detach()
+    {
+        static_cast<PluginHost::IDispatcher&>(*this).Deactivate();
+    }
+    void Close(const uint32_t channel)
+    {
+        static_cast<PluginHost::IDispatcher&>(*this).Closed(channel);
+    }
+    Core::JSONRPC::Connection Call(const uint32_t channel, const uint32_t id)
+    {
+        Core::JSONRPC::Message message;
+        message.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message.Id = id;
+        message.Designator = _T("Test.1.wait");
+
+        Core::ProxyType<Core::JSONRPC::Message> response(Invoke(channel, message));
+
+        // No direct response, it is send once the plugin has it.
+        EXPECT_FALSE(response.IsValid());
+        EXPECT_FALSE(_calls.empty());
+
+        return (_calls.back());
+    }
+    void Subscribe(const uint32_t channel, const string& event)
+    {
+        Core::JSONRPC::Message message;
+        message.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+        message.Id = 100;
+        message.Designator = _T("Test.1.register");
+        message.Parameters = _T("{\"event\":\"") + event + _T("\",\"id\":\"client\"}");
+
+        Core::ProxyType<Core::JSONRPC::Message> response(Invoke(channel, message));
+
+        EXPECT_TRUE(response.IsValid());
+        EXPECT_EQ(response->Result.Value(), _T("0"));
+    }
+
+private:
+    std::vector<Core::JSONRPC::Connection> _calls;
+};
+
+class Pool : public Core::WorkerPoolType<2> {
+public:
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    Pool()
+        : Core::WorkerPoolType<2>(Core::Thread::DefaultStackSize())
+    {
+        Run();
+    }
+    ~Pool() override = default;
+};
+
+TEST(Plugins_JSONRPC, deferred)
+{
+    Pool pool;
+    ResponseShell shell;
+    DeferredPlugin plugin;
+
+    plugin.Attach(&shell);
+
+    // Without a timeout set, a call is pending until it gets its response.
+    const Core::JSONRPC::Connection call(plugin.Call(7, 1));
+    SleepMs(100);
+    EXPECT_TRUE(plugin.IsPending(call));
+    EXPECT_TRUE(shell.Collect().empty());
+
+    EXPECT_EQ(plugin.Response(call, string(_T("\"done\""))), Core::ERROR_NONE);
+    EXPECT_FALSE(plugin.IsPending(call));
+
+    std::vector<ResponseShell::Sent> sent(shell.Collect());
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0].Channel, 7u);
+    EXPECT_EQ(sent[0].Id, 1u);
+    EXPECT_EQ(sent[0].Result, _T("\"done\""));
+
+    // Answered only once.
+    EXPECT_EQ(plugin.Response(call, string(_T("\"again\""))), Core::ERROR_UNAVAILABLE);
+
+    // A closed channel drops its calls.
+    const Core::JSONRPC::Connection closed(plugin.Call(8, 2));
+    plugin.Close(8);
+    EXPECT_EQ(plugin.Response(closed, string(_T("\"late\""))), Core::ERROR_UNAVAILABLE);
+    EXPECT_TRUE(shell.Collect().empty());
+
+    // A call that was never deferred, e.g. an a-synchronous call without an id, is answered as is.
+    EXPECT_EQ(plugin.Response(Core::JSONRPC::Connection(7, 5), string(_T("\"direct\""))), Core::ERROR_NONE);
+
+    sent = shell.Collect();
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0].Id, 5u);
+    EXPECT_EQ(sent[0].Result, _T("\"direct\""));
+
+    plugin.Detach();
+}
+
+TEST(Plugins_JSONRPC, notification)
+{
+    ResponseShell shell;
+    DeferredPlugin plugin;
+
+    plugin.Attach(&shell);
+    plugin.Subscribe(7, _T("statechange"));
+    plugin.Subscribe(8, _T("statechange"));
+
+    // Shared or, when too big to share, a message per channel, both may be dropped by a channel.
+    EXPECT_EQ(plugin.Notify(_T("statechange")), Core::ERROR_NONE);
+    EXPECT_EQ(plugin.Notify(_T("statechange"), Core::JSON::String(string(65520, 'x'))), Core::ERROR_NONE);
+
+    std::vector<ResponseShell::Sent> sent(shell.Collect());
+    ASSERT_EQ(sent.size(), 4u);
+
+    for (const ResponseShell::Sent& entry : sent) {
+        EXPECT_TRUE(entry.Notification);
+    }
+
+    // A response never is.
+    const Core::JSONRPC::Connection call(plugin.Call(7, 1));
+    EXPECT_EQ(plugin.Response(call, string(_T("\"done\""))), Core::ERROR_NONE);
+
+    sent = shell.Collect();
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_FALSE(sent[0].Notification);
+
+    plugin.Detach();
+}
+
+TEST(Plugins_JSONRPC, expired)
+{
+    Pool pool;
+    ResponseShell shell;
+    DeferredPlugin plugin;
+
+    plugin.Attach(&shell);
+    plugin.ResponseTimeout(100);
+
+    const Core::JSONRPC::Connection first(plugin.Call(7, 1));
+    const Core::JSONRPC::Connection second(plugin.Call(7, 2));
+    const Core::JSONRPC::Connection answered(plugin.Call(7, 3));
+
+    EXPECT_EQ(plugin.Response(answered, string(_T("\"done\""))), Core::ERROR_NONE);
+    EXPECT_EQ(shell.Collect().size(), 1u);
+
+    // Both calls left are timed out by the same check.
+    EXPECT_EQ(shell.Wait(2000), Core::ERROR_NONE);
+    SleepMs(50);
+
+    std::vector<ResponseShell::Sent> sent(shell.Collect());
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0].Id, 1u);
+    EXPECT_EQ(sent[0].Code, static_cast<int32_t>(Core::ERROR_TIMEDOUT));
+    EXPECT_EQ(sent[1].Id, 2u);
+    EXPECT_EQ(sent[1].Code, static_cast<int32_t>(Core::ERROR_TIMEDOUT));
+
+    // A late response is dropped.
+    EXPECT_FALSE(plugin.IsPending(first));
+    EXPECT_EQ(plugin.Response(second, string(_T("\"late\""))), Core::ERROR_UNAVAILABLE);
+    EXPECT_TRUE(shell.Collect().empty());
+
+    plugin.Detach();
+}
+
+TEST(Plugins_JSONRPC, cancelled)
+{
+    Pool pool;
+    ResponseShell shell;
+
+    {
+        DeferredPlugin plugin;
+
+        plugin.Attach(&shell);
+        plugin.ResponseTimeout(50);
+
+        // Deactivated before the check, nothing is send after it.
+        plugin.Call(7, 1);
+        plugin.Detach();
+
+        SleepMs(200);
+        EXPECT_TRUE(shell.Collect().empty());
+
+        // Deactivated while the timeouts are being send, it waits for them.
+        plugin.Attach(&shell);
+        shell.Delay(300);
+        plugin.Call(7, 2);
+
+        while (shell.IsBusy() == false) {
+            SleepMs(5);
+        }
+
+        plugin.Detach();
+        EXPECT_FALSE(shell.IsBusy());
+        EXPECT_EQ(shell.Collect().size(), 1u);
+        shell.Delay(0);
+
+        // Destructed with a check scheduled.
+        plugin.Attach(&shell);
+        plugin.Call(7, 3);
+    }
+
+    SleepMs(200);
+    EXPECT_TRUE(shell.Collect().empty());
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
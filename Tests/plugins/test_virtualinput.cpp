@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+typedef PluginHost::VirtualInput::KeyRing KeyRing;
+typedef PluginHost::VirtualInput::LatencyHistogram LatencyHistogram;
+
+static const uint32_t RingSize = KeyRing::Size;
+
+TEST(Plugins_VirtualInput, ringFullEmpty)
+{
+    KeyRing ring;
+    KeyRing::Record record;
+
+    EXPECT_FALSE(ring.Pop(record));
+
+    for (uint32_t index = 0; index < RingSize; index++) {
+        EXPECT_TRUE(ring.Push(IVirtualInput::KeyData::PRESSED, index, 1000 + index));
+    }
+
+    // Full, the next key is refused, not overwriting the oldest one.
+    EXPECT_FALSE(ring.Push(IVirtualInput::KeyData::RELEASED, 0xFFFF, 0));
+
+    for (uint32_t index = 0; index < RingSize; index++) {
+        ASSERT_TRUE(ring.Pop(record));
+        EXPECT_EQ(record.Code, index);
+        EXPECT_EQ(record.Ingress, 1000u + index);
+        EXPECT_EQ(record.Type, IVirtualInput::KeyData::PRESSED);
+    }
+
+    EXPECT_FALSE(ring.Pop(record));
+
+    // Once a slot is released, it can be claimed again.
+    EXPECT_TRUE(ring.Push(IVirtualInput::KeyData::REPEAT, 42, 0));
+    ASSERT_TRUE(ring.Pop(record));
+    EXPECT_EQ(record.Code, 42u);
+    EXPECT_EQ(record.Type, IVirtualInput::KeyData::REPEAT);
+}
+
+TEST(Plugins_VirtualInput, ringWraparound)
+{
+    KeyRing ring;
+    KeyRing::Record record;
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    // Batches that do not divide the ring size, so the head and tail wrap at every position.
+    const uint32_t batch = (RingSize / 2) + 3;
+
+    for (uint32_t round = 0; round < 16; round++) {
+        for (uint32_t index = 0; index < batch; index++) {
+            EXPECT_TRUE(ring.Push(IVirtualInput::KeyData::PRESSED, pushed, 0));
+            pushed++;
+        }
+        while (ring.Pop(record) == true) {
+            EXPECT_EQ(record.Code, popped);
+            popped++;
+        }
+        EXPECT_EQ(popped, pushed);
+    }
+
+    // Wrapped around with a few in flight: fill it up from an odd position.
+    EXPECT_TRUE(ring.Push(IVirtualInput::KeyData::PRESSED, pushed++, 0));
+    for (uint32_t index = 1; index < RingSize; index++) {
+        EXPECT_TRUE(ring.Push(IVirtualInput::KeyData::PRESSED, pushed++, 0));
+    }
+    EXPECT_FALSE(ring.Push(IVirtualInput::KeyData::PRESSED, pushed, 0));
+
+    while (ring.Pop(record) == true) {
+        EXPECT_EQ(record.Code, popped);
+        popped++;
+    }
+    EXPECT_EQ(popped, pushed);
+}
+
+TEST(Plugins_VirtualInput, ringProducers)
+{
+    const uint32_t producers = 4;
+    const uint32_t keys = 5000;
+
+    KeyRing ring;
+    std::vector<std::thread> threads;
+    uint32_t next[producers] = {};
+    uint32_t received = 0;
+
+    for (uint32_t producer = 0; producer < producers; producer++) {
+        threads.emplace_back([&ring, producer, keys]() {
+            for (uint32_t index = 0; index < keys; index++) {
+                // A full ring refuses the key, retry once the consumer made room.
+                while (ring.Push(IVirtualInput::KeyData::PRESSED, (producer << 16) | index, producer) == false) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // The order between producers is not defined, but the keys of every single producer come out
+    // in the order they went in, none lost, none duplicated.
+    while (received < (producers * keys)) {
+        KeyRing::Record record;
+
+        if (ring.Pop(record) == true) {
+            const uint32_t producer = (record.Code >> 16);
+
+            ASSERT_LT(producer, producers);
+            EXPECT_EQ(record.Ingress, producer);
+            EXPECT_EQ(record.Code & 0xFFFF, next[producer]);
+            next[producer] = (record.Code & 0xFFFF) + 1;
+            received++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    KeyRing::Record record;
+    EXPECT_FALSE(ring.Pop(record));
+
+    for (uint32_t producer = 0; producer < producers; producer++) {
+        EXPECT_EQ(next[producer], keys);
+    }
+}
+
+TEST(Plugins_VirtualInput, lookup)
+{
+    PluginHost::VirtualInput::FlatLookupType<uint32_t> lookup;
+    std::map<uint32_t, uint32_t> table;
+
+    lookup.Compile(table);
+    EXPECT_EQ(lookup.Count(), 0u);
+    EXPECT_EQ(lookup.Find(0), nullptr);
+
+    table.emplace(10, 100);
+    table.emplace(20, 200);
+    table.emplace(30, 300);
+    lookup.Compile(table);
+
+    EXPECT_EQ(lookup.Count(), 3u);
+    ASSERT_NE(lookup.Find(10), nullptr);
+    EXPECT_EQ(*lookup.Find(10), 100u);
+    ASSERT_NE(lookup.Find(30), nullptr);
+    EXPECT_EQ(*lookup.Find(30), 300u);
+
+    // Around and in between the entries nothing is found.
+    EXPECT_EQ(lookup.Find(0), nullptr);
+    EXPECT_EQ(lookup.Find(15), nullptr);
+    EXPECT_EQ(lookup.Find(31), nullptr);
+
+    // Inserted, and at the edges of the table.
+    table.emplace(15, 150);
+    table.emplace(0, 1);
+    table.emplace(0xFFFFFFFF, 2);
+    lookup.Compile(table);
+
+    EXPECT_EQ(lookup.Count(), 6u);
+    ASSERT_NE(lookup.Find(15), nullptr);
+    EXPECT_EQ(*lookup.Find(15), 150u);
+    ASSERT_NE(lookup.Find(0), nullptr);
+    EXPECT_EQ(*lookup.Find(0), 1u);
+    ASSERT_NE(lookup.Find(0xFFFFFFFF), nullptr);
+    EXPECT_EQ(*lookup.Find(0xFFFFFFFF), 2u);
+
+    // Erased, the neighbours are still found.
+    table.erase(20);
+    lookup.Compile(table);
+
+    EXPECT_EQ(lookup.Count(), 5u);
+    EXPECT_EQ(lookup.Find(20), nullptr);
+    ASSERT_NE(lookup.Find(15), nullptr);
+    EXPECT_EQ(*lookup.Find(15), 150u);
+    ASSERT_NE(lookup.Find(30), nullptr);
+    EXPECT_EQ(*lookup.Find(30), 300u);
+}
+
+TEST(Plugins_VirtualInput, lookupCollision)
+{
+    PluginHost::VirtualInput::FlatLookupType<uint32_t> lookup;
+    std::map<uint32_t, uint32_t> table;
+
+    // Codes only differing in the upper bits (the modifiers of a key) are separate entries.
+    table.emplace(0x00000041, 1);
+    table.emplace(0x00010041, 2);
+    table.emplace(0x00100041, 3);
+    table.emplace(0x80000041, 4);
+    lookup.Compile(table);
+
+    ASSERT_NE(lookup.Find(0x00000041), nullptr);
+    EXPECT_EQ(*lookup.Find(0x00000041), 1u);
+    ASSERT_NE(lookup.Find(0x00010041), nullptr);
+    EXPECT_EQ(*lookup.Find(0x00010041), 2u);
+    ASSERT_NE(lookup.Find(0x00100041), nullptr);
+    EXPECT_EQ(*lookup.Find(0x00100041), 3u);
+    ASSERT_NE(lookup.Find(0x80000041), nullptr);
+    EXPECT_EQ(*lookup.Find(0x80000041), 4u);
+    EXPECT_EQ(lookup.Find(0x00000141), nullptr);
+
+    // A moved table finds the same entries.
+    PluginHost::VirtualInput::FlatLookupType<uint32_t> moved(std::move(lookup));
+    EXPECT_EQ(moved.Count(), 4u);
+    ASSERT_NE(moved.Find(0x00010041), nullptr);
+    EXPECT_EQ(*moved.Find(0x00010041), 2u);
+}
+
+TEST(Plugins_VirtualInput, histogram)
+{
+    const uint8_t last = PluginHost::VirtualInput::LatencyBuckets - 1;
+
+    LatencyHistogram histogram;
+    uint32_t buckets[PluginHost::VirtualInput::LatencyBuckets];
+
+    histogram.Measure(buckets);
+    for (uint8_t index = 0; index <= last; index++) {
+        EXPECT_EQ(buckets[index], 0u);
+    }
+
+    // Bucket n holds the latencies below 2^n us, from 2^(n-1) us on.
+    histogram.Add(0);
+    histogram.Add(1);
+    histogram.Add(2);
+    histogram.Add(3);
+    histogram.Add(4);
+    histogram.Add(7);
+    histogram.Add(8);
+    histogram.Add((1ull << (last - 1)) - 1);
+
+    // The last bucket catches everything slower.
+    histogram.Add(1ull << (last - 1));
+    histogram.Add((1ull << last) - 1);
+    histogram.Add(1ull << last);
+    histogram.Add(~0ull);
+
+    histogram.Measure(buckets);
+
+    EXPECT_EQ(buckets[0], 1u);
+    EXPECT_EQ(buckets[1], 1u);
+    EXPECT_EQ(buckets[2], 2u);
+    EXPECT_EQ(buckets[3], 2u);
+    EXPECT_EQ(buckets[4], 1u);
+    EXPECT_EQ(buckets[last - 1], 1u);
+    EXPECT_EQ(buckets[last], 4u);
+
+    uint32_t total = 0;
+    for (uint8_t index = 0; index <= last; index++) {
+        total += buckets[index];
+    }
+    EXPECT_EQ(total, 12u);
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <processcontainers/CGroup.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+typedef ProcessContainers::CGroup CGroup;
+
+TEST(ProcessContainers_CGroup, cpuMax)
+{
+    EXPECT_EQ(CGroup::CPUMax(0), _T("max 100000"));
+    EXPECT_EQ(CGroup::CPUMax(1), _T("1000 100000"));
+    EXPECT_EQ(CGroup::CPUMax(100), _T("100000 100000"));
+    EXPECT_EQ(CGroup::CPUMax(150), _T("150000 100000"));
+    EXPECT_EQ(CGroup::CPUMax(0xFFFF), _T("65535000 100000"));
+}
+
+TEST(ProcessContainers_CGroup, memoryMax)
+{
+    EXPECT_EQ(CGroup::MemoryMax(0), _T("max"));
+    EXPECT_EQ(CGroup::MemoryMax(1), _T("1048576"));
+    EXPECT_EQ(CGroup::MemoryMax(64), _T("67108864"));
+
+    // Does not wrap around beyond 4GB.
+    EXPECT_EQ(CGroup::MemoryMax(8192), _T("8589934592"));
+    EXPECT_EQ(CGroup::MemoryMax(0xFFFFFFFF), _T("4503599626321920"));
+}
+
+TEST(ProcessContainers_CGroup, value)
+{
+    const string stat(_T("usage_usec 123456\nuser_usec 100000\nsystem_usec 23456\nnr_periods 10\nthrottled_usec 789"));
+
+    EXPECT_EQ(CGroup::Value(stat, _T("usage_usec")), 123456u);
+    EXPECT_EQ(CGroup::Value(stat, _T("system_usec")), 23456u);
+
+    // The last line does not need a line feed.
+    EXPECT_EQ(CGroup::Value(stat, _T("throttled_usec")), 789u);
+
+    // Only whole keys match, a missing key reads as 0.
+    EXPECT_EQ(CGroup::Value(stat, _T("usage")), 0u);
+    EXPECT_EQ(CGroup::Value(stat, _T("sec")), 0u);
+    EXPECT_EQ(CGroup::Value(stat, _T("nr_throttled")), 0u);
+    EXPECT_EQ(CGroup::Value(string(), _T("usage_usec")), 0u);
+
+    // A key sharing its prefix with an earlier one.
+    const string events(_T("low 0\nhigh 0\nmax 4\noom_kill 3\noom 2\n"));
+
+    EXPECT_EQ(CGroup::Value(events, _T("oom")), 2u);
+    EXPECT_EQ(CGroup::Value(events, _T("oom_kill")), 3u);
+    EXPECT_EQ(CGroup::Value(events, _T("max")), 4u);
+
+    // A key without a value, or an empty line, does not break the scan.
+    EXPECT_EQ(CGroup::Value(_T("oom\n\nanon 4096\n"), _T("anon")), 4096u);
+    EXPECT_EQ(CGroup::Value(_T("oom\n\nanon 4096\n"), _T("oom")), 0u);
+
+    // Values beyond 32 bits.
+    EXPECT_EQ(CGroup::Value(_T("anon 8589934592\n"), _T("anon")), 8589934592ull);
+}
+
+TEST(ProcessContainers_CGroup, measure)
+{
+    std::map<string, string> files;
+
+    auto reader = [&files](const TCHAR item[]) -> string {
+        std::map<string, string>::const_iterator index(files.find(item));
+        return (index != files.end() ? index->second : string());
+    };
+
+    ProcessContainers::IContainerAdministrator::IContainer::Usage usage;
+
+    // Without a cgroup there is nothing to measure.
+    EXPECT_FALSE(CGroup::Measure(reader, usage));
+
+    files[_T("cpu.stat")] = _T("usage_usec 2000000\nuser_usec 1500000\nsystem_usec 500000\nnr_periods 20\nnr_throttled 5\nthrottled_usec 250000\n");
+    files[_T("memory.current")] = _T("10485760\n");
+    files[_T("memory.stat")] = _T("anon 4194304\nfile 6291456\n");
+    files[_T("memory.events")] = _T("low 0\nhigh 0\nmax 7\noom 1\noom_kill 1\n");
+
+    EXPECT_TRUE(CGroup::Measure(reader, usage));
+    EXPECT_EQ(usage.CPUTime, 2000000u);
+    EXPECT_EQ(usage.Throttled, 250000u);
+    EXPECT_EQ(usage.Memory, 10485760u);
+    EXPECT_EQ(usage.Resident, 4194304u);
+    EXPECT_EQ(usage.OOMEvents, 1u);
+
+    Core::Singleton::Dispose();
+}
+
+} // Tests
+} // WPEFramework
@@ -1067,6 +1067,29 @@ def GenerateStubs(output_file, source_file, defaults = "", scan_only = False):
 
     return interfaces
 
+# -------------------------------------------------------------------------
+# Writes the index of interfaces a proxy stub library provides. The index lets RPC::Administrator postpone
+# loading the library until one of its interfaces is actually used.
+
+def WriteIndex(index_file, interfaces):
+    library = os.path.splitext(os.path.basename(index_file))[0] + ".so"
+    ids = []
+    for f in interfaces:
+        if not isinstance(f.id, (long, int)):
+            # Without all the IDs the library can not be loaded on demand, it will be loaded at startup.
+            log.Warn("can't evaluate interface ID \"%s\" of %s, no index written" % (str(f.id), f.obj.full_name), f.file)
+            if os.path.isfile(index_file):
+                os.remove(index_file)
+            return
+        if f.id not in ids:
+            ids.append(f.id)
+
+    with open(index_file, "w") as file:
+        file.write("{\n")
+        file.write("  \"library\": \"%s\",\n" % library)
+        file.write("  \"interfaces\": [ %s ]\n" % ", ".join([str(i) for i in ids]))
+        file.write("}\n")
+
 # -------------------------------------------------------------------------
 # entry point
 
@@ -1084,6 +1107,7 @@ if __name__ == "__main__":
     argparser.add_argument("--no-warnings", dest="no_warnings", action="store_true", default=False, help="suppress all warnings (default: show warnings)")
     argparser.add_argument("--keep", dest="keep_incomplete", action="store_true", default=False, help="keep incomplete files (default: remove partially generated files)")
     argparser.add_argument("--verbose", dest="verbose", action="store_true", default=False, help="enable verbose output (default: verbose output disabled)")
+    argparser.add_argument("--index", dest="index_file", metavar="FILE", type=str, action="store", default=None, help="write an index of the generated interface IDs, allows the library to be loaded on demand\n(the library name is derived from the index file name, e.g. libMarshalling.json for libMarshalling.so)")
     args = argparser.parse_args(sys.argv[1:])
     DEFAULT_DEFINITIONS_FILE = args.extra_include
     INDENT_SIZE = args.indent_size if (args.indent_size > 0 and args.indent_size < 32) else INDENT_SIZE
@@ -1094,6 +1118,7 @@ if __name__ == "__main__":
     EMIT_TRACES = args.traces
     scan_only = args.scan_ids
     keep_incomplete = args.keep_incomplete
+    index_file = args.index_file
 
     if INTERFACE_NAMESPACE[0:2] != "::":
         INTERFACE_NAMESPACE = "::" + INTERFACE_NAMESPACE
@@ -1173,6 +1198,9 @@ if __name__ == "__main__":
                 elif BE_VERBOSE:
                     log.Warn("can't evaluate interface ID \"%s\" of %s" % (str(f.id), f.obj.full_name), f.file)
 
+            if index_file and not scan_only:
+                WriteIndex(index_file, sorted_faces)
+
             print ""
             print ("ProxyStubGenerator: All done. %i file%s processed" % (len(interface_files) - len(skipped), "s" if len(interface_files) - len(skipped) > 1 else "")) + \
                 ((" (%i file%s skipped)" % (len(skipped), "s" if len(skipped) > 1 else "")) if skipped else "") + \
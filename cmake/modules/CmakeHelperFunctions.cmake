@@ -731,7 +731,7 @@ function(ProxyStubGenerator)
     endif()
 
     set(optionsArgs SCAN_IDS TRACES OLD_CPP NO_WARNINGS KEEP VERBOSE)
-    set(oneValueArgs INCLUDE NAMESPACE INDENT)
+    set(oneValueArgs INCLUDE NAMESPACE INDENT INDEX)
     set(multiValueArgs INPUT)
 
     cmake_parse_arguments(Argument "${optionsArgs}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
@@ -780,10 +780,19 @@ function(ProxyStubGenerator)
         list(APPEND _execute_command  "--indent" "${Argument_INDENT}")
     endif()
 
-    foreach(_input ${Argument_INPUT})
-        execute_process(COMMAND ${PYTHON_EXECUTABLE} ${_execute_command} ${_input} RESULT_VARIABLE rv)
+    if (Argument_INDEX)
+        # The index has to cover all the inputs, so they are handled in one go.
+        list(APPEND _execute_command  "--index" "${Argument_INDEX}")
+        execute_process(COMMAND ${PYTHON_EXECUTABLE} ${_execute_command} ${Argument_INPUT} RESULT_VARIABLE rv)
         if(NOT ${rv} EQUAL 0)
             message(FATAL_ERROR "ProxyStubGenerator generator failed.")
         endif()
-    endforeach(_input)
+    else()
+        foreach(_input ${Argument_INPUT})
+            execute_process(COMMAND ${PYTHON_EXECUTABLE} ${_execute_command} ${_input} RESULT_VARIABLE rv)
+            if(NOT ${rv} EQUAL 0)
+                message(FATAL_ERROR "ProxyStubGenerator generator failed.")
+            endif()
+        endforeach(_input)
+    endif()
 endfunction(ProxyStubGenerator)